@@ -0,0 +1,548 @@
+/*****************************************************************************/
+/* 1.System Name  : STKinf (LTS's STK interface processing Server)           */
+/* 2.Program ID   : bcrsim.c                                                 */
+/* 3.Description  :  BCR simulator (STKinf / )           */
+/*                   BCR  ڱ IP (loopback alias)  STKinf.bcr.port*/
+/*                    ޾ bcr_SendRecv  û Ѵ           */
+/*                    0x05 : read  ->   6 byte ID (camera BCR    */
+/*                           7 byte), read и "?"                        */
+/*                    0x04 : read  ( 0x05  )                 */
+/*                  output port BCR  ֱ STKinf  s_port+3  ڱ */
+/*                  IP  Ͽ ID 6 byte + NUL               */
+/*                  usage : bcrsim -p port [-a ip -n cnt] [-f file] [-l ms]  */
+/*                                 [-m pct] [-c pct] [-s pct] [-r pct]       */
+/*                                 [-o pct -u sec -H host:port] [-i sec]     */
+/*                    -p port   : STKinf.bcr.port                            */
+/*                    -a ip     :  BCR ù IP, -n  ϳ  IP */
+/*                    -l ms     : read  (ms Ǵ min:max, ⺻ 50)       */
+/*                    -m pct    : read  ("?") Ȯ                       */
+/*                    -c pct    : camera BCR (7 byte ID)                 */
+/*                    -s pct    : Pod ID ('S'  ) Ȯ                  */
+/*                    -r pct    :  ڸ RST   Ȯ           */
+/*                    -o pct    : output port BCR                        */
+/*                    -u sec    : output port BCR  ۽  (⺻ 10)   */
+/*                    -H h:port : output ۽  (STKinf s_port+3)         */
+/*                    -i sec    :   ֱ (⺻ 10, 0 :  )    */
+/*                  -f file  BCR  ϸ     option*/
+/*                    BCR <ip> [delay=ms|min:max] [misread=pct] [camera=0|1] */
+/*                        [pod=pct] [refuse=pct] [push=sec] [id=ID]          */
+/*                    refuse=100 ̸ listen  ʴ´ (connect refused)   */
+/* 4.In/Out Table : None                                                     */
+/* 5.Functions    :                                                          */
+/*    main - bcrsim main function                                            */
+/*    bs_usage - usage print function                                        */
+/*    bs_rand - per thread uniform random function                           */
+/*    bs_delay - option delay parse function                                 */
+/*    bs_add - virtual reader add function                                   */
+/*    bs_loadFile - reader file load function                                */
+/*    bs_makeID - carrier ID make function                                   */
+/*    bs_listen - reader listen function                                     */
+/*    bs_acceptThread - reader accept thread function                        */
+/*    bs_connThread - reader connection thread function                      */
+/*    bs_pushThread - output port push thread function                       */
+/*    bs_statThread - statistics print thread function                       */
+/* 6.Notification :                                                          */
+/*                  build : gcc -O2 -o bcrsim bcrsim.c -lpthread -lm         */
+/*****************************************************************************/
+
+/*---------------------------------------------------------------------------*/
+/* System Include Files                                                      */
+/*---------------------------------------------------------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <math.h>
+#include <time.h>
+#include <unistd.h>
+#include <signal.h>
+#include <pthread.h>
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <arpa/inet.h>
+/*---------------------------------------------------------------------------*/
+/* Application Include Files                                                 */
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+/* Constants, Macro Declaration                                              */
+/*---------------------------------------------------------------------------*/
+#ifndef true
+#define true                1
+#define false               0
+#endif
+#define BCRLEN              7           /* STKinf  ѹ д ũ*/
+#define BS_MAXREADER        4096
+#define BS_READ             0x05        /* read              */
+#define BS_STOP             0x04        /* read              */
+
+/*---------------------------------------------------------------------------*/
+/* Structure Declaration                                                     */
+/*---------------------------------------------------------------------------*/
+typedef struct _BS_READER {
+    int    no;                          /* BCR ȣ                  */
+    struct in_addr ip;                  /* BCR IP                    */
+    double dMin;                        /* read  ּ (ms)       */
+    double dMax;                        /* read  ִ (ms)       */
+    double misPct;                      /* read  Ȯ            */
+    int    camera;                      /* 1 : 7 byte ID             */
+    double podPct;                      /* 'S' Pod ID Ȯ           */
+    double refPct;                      /*  RST Ȯ             */
+    double pushSec;                     /* output  , 0 : */
+    char   id[BCRLEN+1];                /*  ID ("" : )       */
+    int    lsock;
+    long   seq;                         /*  ID Ϸùȣ          */
+} BS_READER;
+
+typedef struct _BS_CONN {
+    BS_READER *r;
+    int    sock;
+} BS_CONN;
+
+/*---------------------------------------------------------------------------*/
+/* Function Declaration                                                      */
+/*---------------------------------------------------------------------------*/
+void bs_usage(char *);
+double bs_rand(unsigned int *);
+int bs_delay(char *, double *, double *);
+BS_READER * bs_add(struct in_addr );
+int bs_loadFile(char *);
+int bs_makeID(BS_READER *, unsigned int *, char *);
+int bs_listen(BS_READER *);
+void * bs_acceptThread(void *arg);
+void * bs_connThread(void *arg);
+void * bs_pushThread(void *arg);
+void * bs_statThread(void *arg);
+
+/*---------------------------------------------------------------------------*/
+/* Global Variable Declaration                                               */
+/*---------------------------------------------------------------------------*/
+BS_READER gReader[BS_MAXREADER];
+int    gReaderCnt = 0;
+int    gPort      = 0;                  /* -p STKinf.bcr.port        */
+struct sockaddr_in gPushAddr;           /* -H STKinf s_port+3        */
+
+/* option ⺻ (file  BCR     ̰ ) */
+double gDMin     = 50;                  /* -l                        */
+double gDMax     = 50;
+double gMisPct   = 0;                   /* -m                        */
+double gCamPct   = 0;                   /* -c                        */
+double gPodPct   = 0;                   /* -s                        */
+double gRefPct   = 0;                   /* -r                        */
+double gOutPct   = 0;                   /* -o                        */
+double gPushSec  = 10;                  /* -u                        */
+int    gStatIntv = 10;                  /* -i                        */
+
+long gConn    = 0;                      /*                   */
+long gRefused = 0;                      /* RST             */
+long gRead    = 0;                      /* 0x05                    */
+long gMisread = 0;                      /* "?"                 */
+long gPod     = 0;                      /* 'S' ID              */
+long gStop    = 0;                      /* 0x04                    */
+long gPush    = 0;                      /* output ۽           */
+long gPushErr = 0;                      /* output ۽           */
+
+/*****************************************************************************/
+/* 1.Function Name: main                                                     */
+/* 2.Description  : option/file   BCR   listen, output port    */
+/*                  BCR  ۽ thread                                   */
+/* 3.Parameters   : int argc, char *argv[]                                   */
+/* 4.Return Value : int                                                      */
+/*****************************************************************************/
+int main(int argc, char *argv[])
+{
+    char *base = NULL, *file = NULL, *push = NULL, *p;
+    int  cnt = 0, opt, i, nListen = 0;
+    struct in_addr ip;
+    BS_READER *r;
+    pthread_t tid;
+
+    while((opt = getopt(argc, argv, "p:a:n:f:l:m:c:s:r:o:u:H:i:")) != -1){
+        switch(opt){
+            case 'p' : gPort = atoi(optarg);            break;
+            case 'a' : base = optarg;                   break;
+            case 'n' : cnt = atoi(optarg);              break;
+            case 'f' : file = optarg;                   break;
+            case 'm' : gMisPct = atof(optarg);          break;
+            case 'c' : gCamPct = atof(optarg);          break;
+            case 's' : gPodPct = atof(optarg);          break;
+            case 'r' : gRefPct = atof(optarg);          break;
+            case 'o' : gOutPct = atof(optarg);          break;
+            case 'u' : gPushSec = atof(optarg);         break;
+            case 'H' : push = optarg;                   break;
+            case 'i' : gStatIntv = atoi(optarg);        break;
+            case 'l' :
+                if(bs_delay(optarg, &gDMin, &gDMax) == false) bs_usage(argv[0]);
+                break;
+            default  : bs_usage(argv[0]);
+        }
+    }
+    if(gPort <= 0 || (base == NULL && file == NULL) || (base != NULL && cnt <= 0)){
+        bs_usage(argv[0]);
+    }
+    memset(&gPushAddr, 0x00, sizeof(gPushAddr));
+    if(push != NULL){
+        if((p = strchr(push, ':')) == NULL) bs_usage(argv[0]);
+        *p = 0x00;
+        gPushAddr.sin_family = AF_INET;
+        gPushAddr.sin_addr.s_addr = inet_addr(push);
+        gPushAddr.sin_port = htons(atoi(p + 1));
+    }
+
+    /* -n  BCR. camera/output port BCR  100   տ pct  */
+    for(i = 0; base != NULL && i < cnt; i++){
+        ip.s_addr = htonl(ntohl(inet_addr(base)) + i);
+        if((r = bs_add(ip)) == NULL) break;
+        r->camera  = (i % 100 < gCamPct) ? 1 : 0;
+        r->pushSec = (i % 100 < gOutPct) ? gPushSec : 0;
+    }
+    if(file != NULL && bs_loadFile(file) == false) return 1;
+
+    signal(SIGPIPE, SIG_IGN);
+    for(i = 0; i < gReaderCnt; i++){
+        r = &gReader[i];
+        if(r->refPct < 100){
+            if(bs_listen(r) == false) return 1;
+            if(pthread_create(&tid, NULL, bs_acceptThread, (void *)r) != 0){
+                fprintf(stderr, "ERROR: BCR[%s] accept thread create fail\n", inet_ntoa(r->ip));
+                return 1;
+            }
+            pthread_detach(tid);
+            nListen++;
+        }
+        if(r->pushSec > 0){
+            if(push == NULL){
+                fprintf(stderr, "ERROR: BCR[%s] output port BCR need -H host:port\n", inet_ntoa(r->ip));
+                return 1;
+            }
+            if(pthread_create(&tid, NULL, bs_pushThread, (void *)r) == 0) pthread_detach(tid);
+        }
+    }
+    printf("INFO : bcrsim BCR[%d] LISTEN[%d] PORT[%d]\n", gReaderCnt, nListen, gPort);
+    fflush(stdout);
+
+    if(gStatIntv > 0){
+        bs_statThread(NULL);
+    }
+    while(1) pause();
+    return 0;
+}
+
+/*****************************************************************************/
+/* 1.Function Name: bs_usage                                                 */
+/* 2.Description  : usage                                          */
+/* 3.Parameters   : char *prog       - program ̸                          */
+/* 4.Return Value : None                                                     */
+/*****************************************************************************/
+void bs_usage(char *prog)
+{
+    fprintf(stderr, "usage : %s -p port [-a firstIP -n cnt] [-f file] [-l ms|min:max]\n"
+                    "          [-m misreadPct] [-c cameraPct] [-s podPct] [-r refusePct]\n"
+                    "          [-o outputPct -u pushSec -H host:port] [-i sec]\n"
+                    "  file : BCR <ip> [delay=ms|min:max] [misread=pct] [camera=0|1]\n"
+                    "             [pod=pct] [refuse=pct] [push=sec] [id=ID]\n", prog);
+    exit(1);
+}
+
+/*****************************************************************************/
+/* 1.Function Name: bs_rand                                                  */
+/* 2.Description  : thread  seed  [0,1) յ                         */
+/* 3.Parameters   : unsigned int *seed - thread seed                         */
+/* 4.Return Value : double                                                   */
+/*****************************************************************************/
+double bs_rand(unsigned int *seed)
+{
+    return (double)rand_r(seed) / ((double)RAND_MAX + 1.0);
+}
+
+/*****************************************************************************/
+/* 1.Function Name: bs_delay                                                 */
+/* 2.Description  : "ms" Ǵ "min:max"  ؼ                            */
+/* 3.Parameters   : char *s          - ڿ                                */
+/*                  double *dMin, double *dMax -  (ms)                   */
+/* 4.Return Value : true - , false -                             */
+/*****************************************************************************/
+int bs_delay(char *s, double *dMin, double *dMax)
+{
+    int n = sscanf(s, "%lf:%lf", dMin, dMax);
+
+    if(n == 1) *dMax = *dMin;
+    return (n >= 1 && *dMin >= 0 && *dMax >= *dMin) ? true : false;
+}
+
+/*****************************************************************************/
+/* 1.Function Name: bs_add                                                   */
+/* 2.Description  : option ⺻  BCR ߰                          */
+/* 3.Parameters   : struct in_addr ip - BCR IP                               */
+/* 4.Return Value : BS_READER * - BCR, NULL - ִ ʰ                      */
+/*****************************************************************************/
+BS_READER * bs_add(struct in_addr ip)
+{
+    BS_READER *r;
+
+    if(gReaderCnt >= BS_MAXREADER){
+        fprintf(stderr, "ERROR: BCR count over [%d]\n", BS_MAXREADER);
+        return NULL;
+    }
+    r = &gReader[gReaderCnt];
+    memset(r, 0x00, sizeof(BS_READER));
+    r->no     = gReaderCnt++;
+    r->ip     = ip;
+    r->dMin   = gDMin;
+    r->dMax   = gDMax;
+    r->misPct = gMisPct;
+    r->podPct = gPodPct;
+    r->refPct = gRefPct;
+    r->lsock  = -1;
+    return r;
+}
+
+/*****************************************************************************/
+/* 1.Function Name: bs_loadFile                                              */
+/* 2.Description  : BCR   file . '#'  ּ                       */
+/* 3.Parameters   : char *file       -  file                             */
+/* 4.Return Value : true - , false -                                 */
+/*****************************************************************************/
+int bs_loadFile(char *file)
+{
+    FILE *fp;
+    char line[512], *tok, *save, *val;
+    int  lineNo = 0, ok;
+    struct in_addr ip;
+    BS_READER *r = NULL;
+
+    if((fp = fopen(file, "r")) == NULL){
+        fprintf(stderr, "ERROR: BCR file [%s] open fail errno[%d]\n", file, errno);
+        return false;
+    }
+    while(fgets(line, sizeof(line), fp) != NULL){
+        lineNo++;
+        if((tok = strtok_r(line, " \t\r\n", &save)) == NULL || tok[0] == '#') continue;
+        ok = (strcmp(tok, "BCR") == 0 && (tok = strtok_r(NULL, " \t\r\n", &save)) != NULL &&
+              inet_aton(tok, &ip) != 0 && (r = bs_add(ip)) != NULL) ? true : false;
+        while(ok && (tok = strtok_r(NULL, " \t\r\n", &save)) != NULL){
+            if((val = strchr(tok, '=')) == NULL){
+                ok = false;
+                break;
+            }
+            *val++ = 0x00;
+            if(strcmp(tok, "delay") == 0)        ok = bs_delay(val, &r->dMin, &r->dMax);
+            else if(strcmp(tok, "misread") == 0) r->misPct = atof(val);
+            else if(strcmp(tok, "camera") == 0)  r->camera = atoi(val);
+            else if(strcmp(tok, "pod") == 0)     r->podPct = atof(val);
+            else if(strcmp(tok, "refuse") == 0)  r->refPct = atof(val);
+            else if(strcmp(tok, "push") == 0)    r->pushSec = atof(val);
+            else if(strcmp(tok, "id") == 0 && strlen(val) <= BCRLEN) strcpy(r->id, val);
+            else ok = false;
+        }
+        if(ok == false){
+            fprintf(stderr, "ERROR: BCR file [%s] line[%d] invalid\n", file, lineNo);
+            fclose(fp);
+            return false;
+        }
+    }
+    fclose(fp);
+    return true;
+}
+
+/*****************************************************************************/
+/* 1.Function Name: bs_makeID                                                */
+/* 2.Description  :  carrier ID. id=   װ,  'C' (Pod   */
+/*                  ̸ 'S') + BCR ȣ 2 ڸ + Ϸùȣ 3 ڸ, camera    */
+/*                  BCR    byte  δ (STKinf  6 byte  ڸ) */
+/* 3.Parameters   : BS_READER *r     - BCR                                   */
+/*                  unsigned int *seed - thread seed                         */
+/*                  char *id         -  (BCRLEN+1)                       */
+/* 4.Return Value : int - ID                                             */
+/*****************************************************************************/
+int bs_makeID(BS_READER *r, unsigned int *seed, char *id)
+{
+    long seq = __sync_fetch_and_add(&r->seq, 1);
+    int  pod = (bs_rand(seed) * 100 < r->podPct) ? 1 : 0;
+
+    if(r->id[0] != 0x00){
+        strcpy(id, r->id);
+    } else {
+        sprintf(id, "%c%02d%03ld", pod ? 'S' : 'C', r->no % 100, seq % 1000);
+        if(r->camera) strcat(id, "0");
+    }
+    if(id[0] == 'S') __sync_fetch_and_add(&gPod, 1);
+    return strlen(id);
+}
+
+/*****************************************************************************/
+/* 1.Function Name: bs_listen                                                */
+/* 2.Description  : BCR IP:port  listen                                    */
+/* 3.Parameters   : BS_READER *r     - BCR                                   */
+/* 4.Return Value : true - , false -                                 */
+/*****************************************************************************/
+int bs_listen(BS_READER *r)
+{
+    struct sockaddr_in addr;
+    int on = 1;
+
+    if((r->lsock = socket(AF_INET, SOCK_STREAM, 0)) < 0){
+        fprintf(stderr, "ERROR: socket create fail errno[%d]\n", errno);
+        return false;
+    }
+    setsockopt(r->lsock, SOL_SOCKET, SO_REUSEADDR, &on, sizeof(on));
+    memset(&addr, 0x00, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(gPort);
+    addr.sin_addr = r->ip;
+    if(bind(r->lsock, (struct sockaddr *)&addr, sizeof(addr)) < 0 || listen(r->lsock, 16) < 0){
+        fprintf(stderr, "ERROR: BCR[%s:%d] bind/listen fail errno[%d]\n", inet_ntoa(r->ip), gPort, errno);
+        close(r->lsock);
+        return false;
+    }
+    return true;
+}
+
+/*****************************************************************************/
+/* 1.Function Name: bs_acceptThread                                          */
+/* 2.Description  : BCR  . refuse Ȯ̸ RST  ٷ ´        */
+/* 3.Parameters   : void *arg        - BS_READER                             */
+/* 4.Return Value : None                                                     */
+/*****************************************************************************/
+void * bs_acceptThread(void *arg)
+{
+    BS_READER *r = (BS_READER *)arg;
+    unsigned int seed = (unsigned int)time(NULL) ^ (r->no * 2654435761u);
+    struct linger lg = { 1, 0 };
+    BS_CONN *c;
+    pthread_t tid;
+    int sock, on = 1;
+
+    while(1){
+        if((sock = accept(r->lsock, NULL, NULL)) < 0){
+            if(errno != EINTR) sleep(1);
+            continue;
+        }
+        __sync_fetch_and_add(&gConn, 1);
+        if(r->refPct > 0 && bs_rand(&seed) * 100 < r->refPct){
+            setsockopt(sock, SOL_SOCKET, SO_LINGER, &lg, sizeof(lg));
+            close(sock);
+            __sync_fetch_and_add(&gRefused, 1);
+            continue;
+        }
+        setsockopt(sock, IPPROTO_TCP, TCP_NODELAY, &on, sizeof(on));
+        if((c = (BS_CONN *)malloc(sizeof(BS_CONN))) == NULL){
+            close(sock);
+            continue;
+        }
+        c->r = r;
+        c->sock = sock;
+        if(pthread_create(&tid, NULL, bs_connThread, (void *)c) != 0){
+            close(sock);
+            free(c);
+            continue;
+        }
+        pthread_detach(tid);
+    }
+    return NULL;
+}
+
+/*****************************************************************************/
+/* 1.Function Name: bs_connThread                                            */
+/* 2.Description  :    ó. STKinf  BCR pool      */
+/*                  Ƿ   0x05/0x04  ݺؼ ޴´          */
+/* 3.Parameters   : void *arg        - BS_CONN                               */
+/* 4.Return Value : None                                                     */
+/*****************************************************************************/
+void * bs_connThread(void *arg)
+{
+    BS_CONN *c = (BS_CONN *)arg;
+    BS_READER *r = c->r;
+    unsigned int seed = (unsigned int)time(NULL) ^ (unsigned int)(c->sock << 12) ^ r->no;
+    char cmd[16], id[BCRLEN+1];
+    double ms;
+    int n, i, len, ok = true;
+
+    while(ok && (n = recv(c->sock, cmd, sizeof(cmd), 0)) > 0){
+        for(i = 0; ok && i < n; i++){
+            if(cmd[i] == BS_STOP){
+                __sync_fetch_and_add(&gStop, 1);
+                continue;
+            }
+            if(cmd[i] != BS_READ) continue;
+            __sync_fetch_and_add(&gRead, 1);
+            ms = r->dMin + (r->dMax - r->dMin) * bs_rand(&seed);
+            if(ms > 0) usleep((useconds_t)(ms * 1000));
+            if(r->misPct > 0 && bs_rand(&seed) * 100 < r->misPct){
+                strcpy(id, "?");
+                len = 1;
+                __sync_fetch_and_add(&gMisread, 1);
+            } else {
+                len = bs_makeID(r, &seed, id);
+            }
+            if(send(c->sock, id, len, 0) != len) ok = false;
+        }
+    }
+    close(c->sock);
+    free(c);
+    return NULL;
+}
+
+/*****************************************************************************/
+/* 1.Function Name: bs_pushThread                                            */
+/* 2.Description  : output port BCR.  push  ()  BCR IP   */
+/*                  s_port+3  Ͽ ID 6 byte + NUL (BCRLEN) ۽       */
+/*                  (bcr_outputRequest  7 byte, strlen 6  ޴´)        */
+/* 3.Parameters   : void *arg        - BS_READER                             */
+/* 4.Return Value : None                                                     */
+/*****************************************************************************/
+void * bs_pushThread(void *arg)
+{
+    BS_READER *r = (BS_READER *)arg;
+    unsigned int seed = (unsigned int)time(NULL) ^ (r->no * 40503u);
+    struct sockaddr_in src;
+    char id[BCRLEN+1], buf[16];
+    int sock;
+
+    while(1){
+        usleep((useconds_t)(-r->pushSec * 1000000.0 * log(1.0 - bs_rand(&seed))));
+
+        memset(id, 0x00, sizeof(id));
+        bs_makeID(r, &seed, id);
+        id[BCRLEN - 1] = 0x00;
+
+        if((sock = socket(AF_INET, SOCK_STREAM, 0)) < 0){
+            __sync_fetch_and_add(&gPushErr, 1);
+            continue;
+        }
+        memset(&src, 0x00, sizeof(src));
+        src.sin_family = AF_INET;
+        src.sin_addr = r->ip;
+        if(bind(sock, (struct sockaddr *)&src, sizeof(src)) < 0 ||
+           connect(sock, (struct sockaddr *)&gPushAddr, sizeof(gPushAddr)) < 0 ||
+           send(sock, id, BCRLEN, 0) != BCRLEN){
+            __sync_fetch_and_add(&gPushErr, 1);
+            close(sock);
+            continue;
+        }
+        /* STKinf  ó    ٸ */
+        while(recv(sock, buf, sizeof(buf), 0) > 0);
+        close(sock);
+        __sync_fetch_and_add(&gPush, 1);
+    }
+    return NULL;
+}
+
+/*****************************************************************************/
+/* 1.Function Name: bs_statThread                                            */
+/* 2.Description  : -i ֱ                                    */
+/* 3.Parameters   : void *arg        - ̻                                */
+/* 4.Return Value : None                                                     */
+/*****************************************************************************/
+void * bs_statThread(void *arg)
+{
+    (void)arg;
+    while(1){
+        sleep(gStatIntv);
+        printf("STAT : CONN[%ld] REFUSED[%ld] READ[%ld] MISREAD[%ld] POD[%ld] STOP[%ld] PUSH[%ld] PUSHERR[%ld]\n",
+               gConn, gRefused, gRead, gMisread, gPod, gStop, gPush, gPushErr);
+        fflush(stdout);
+    }
+    return NULL;
+}
@@ -11,36 +11,30 @@
 /*    freeThreadInfo - thread funtion resource free                          */
 /*    signalHandler - system shut down resource free                         */
 /*    stk_recv - STK client message recv function                            */
+/*    view_open - STK request frame view open function                       */
+/*    view_u32 - STK request view 4 byte field read function                 */
+/*    view_decode - STK request view to Ridian request decode function       */
+/*    stk_writeReply - STK reply encode and write function                   */
+/*    stk_writeAll - non-blocking STK socket full write function             */
+/*    wire_find - message type wire descriptor lookup function               */
+/*    wire_swap - descriptor driven byte order change function               */
+/*    frm_init - length prefixed frame reader init function                  */
+/*    frm_read - length prefixed frame reader function                       */
 /*    stk_rAssociateUnit - Logical connect function                          */
-/*    stk_rAssociateUnit_hton - Endian change function                       */
-/*    stk_rAssociateUnit_ntoh - Endian change function                       */
 /*    stk_rAssociateUnitErrReply - Logical connect error function            */
 /*    stk_rClose - STK client connection close function                      */
-/*    stk_rClose_hton - Endian change function                               */
-/*    stk_rClose_ntoh - Endian change function                               */
+/*    stk_buildProfile - STK profile build function                          */
 /*    stk_rConnect - STK client connection function                          */
-/*    stk_rConnect_hton - Endian change function                             */
-/*    stk_rConnect_ntoh - Endian change function                             */
 /*    stk_rDisassociateUnit - Logical disconnect function                    */
-/*    stk_rDisassociateUnit_hton - Endian change function                    */
-/*    stk_rDisassociateUnit_ntoh - Endian change function                    */
 /*    stk_rDisassociateUnitErrReply - Logcial disconnect error function      */
 /*    stk_rDisplayMsg - Teltag write function                                */
-/*    stk_rDisplayMsg_hton - Endian change function                          */
-/*    stk_rDisplayMsg_ntoh - Endian change function                          */
 /*    stk_rDisplayMsgErrReply - Teltag write error function                  */
 /*    stk_rLogicalToPhysicalUnit - Logical To Physical function(teltag)      */
 /*    stk_rLogicalToPhysicalSensor - Logical To Physical function            */
 /*    stk_rListUnitAtIrt - Teltag info read function                         */
-/*    stk_rListUnitAtIrt_hton - Endian change function                       */
-/*    stk_rListUnitAtIrt_ntoh - Endian change function                       */
 /*    stk_rListUnitAtIrtErrReply - Teltag info read error function           */
 /*    stk_rPhysicalToLogicalSensor - IrtName request function                */
-/*    stk_rPhysicalToLogicalSensor_hton - Endian change function             */
-/*    stk_rPhysicalToLogicalSensor_ntoh - Endian change function             */
 /*    stk_rReadMemory - Logical info request function                        */
-/*    stk_rReadMemory_hton - Endian change function                          */
-/*    stk_rReadMemory_ntoh - Endian change function                          */
 /*    stk_rReadMemoryErrReply - Logical info request error function          */
 /*    GetBcrIDByLogicalID - Cassete ID DB query function                     */
 /*    GetBcrIPByIrt - BCR IP DB query function                               */
@@ -61,22 +55,141 @@
 /*    rid_connect - Ridian server connect module function                    */
 /*    rid_close - Ridian server close module function                        */
 /*    rid_SendRecv - Ridian server send and recv module function             */
+/*    rid_exchange - Ridian server send and recv on a pooled connection      */
+/*    rid_poolStart - Ridian connection pool start function                  */
+/*    rid_lease - Ridian connection pool lease function                      */
+/*    rid_release - Ridian connection pool return function                   */
+/*    rid_alive - Ridian idle connection liveness check function             */
+/*    rid_poolThread - Ridian connection pool health check thread            */
+/*    rid_check - Ridian availability check function                         */
+/*    rid_pipeThread - Ridian pipelined connection reader thread             */
+/*    rid_pipeSendRecv - Ridian pipelined send and recv function             */
 /*    lts_inputRequest - LTSsvr LOT/Reticle input process function           */
 /*    lts_outputRequest - LTSsvr LOT/Reticle output process function         */
 /*    lts_rAssociateUnit - LTSsvr Reticle connect function                   */
 /*    lts_rDisassociateUnit - LTSsvr Reticle disconnect function             */
 /*    lts_SendRecv - LTSsvr send and recv module function                    */
+/*    lts_poolStart - LTSsvr connection pool start function                  */
+/*    lts_connThread - LTSsvr pooled connection reply/reconnect thread       */
+/*    lts_poolSendRecv - LTSsvr pooled send and recv function                */
+/*    lts_directSendRecv - LTSsvr per-exchange send and recv function        */
+/*    bcrc_start - BCR connection manager start function                     */
+/*    bcrc_find - BCR connection manager reader search/register function     */
+/*    bcrc_connect - BCR connect function (connect timeout)                  */
+/*    bcrc_alive - BCR idle connection liveness check function               */
+/*    bcrc_lease - BCR connection lease function                             */
+/*    bcrc_release - BCR connection return function                          */
+/*    bcrc_thread - BCR connection warm-up/liveness check thread             */
+/*    bcr_readPoolStart - BCR read thread pool start function                */
+/*    bcr_readStart - BCR read start function (concurrent with Ridian)       */
+/*    bcr_readThread - BCR read pool thread function                         */
+/*    bcr_readJoin - BCR read join function                                  */
 /*    stk_RecvLogSvr - STK recv message LOGsvr write                         */
 /*    stk_SendLogSvr - STK send message LOGsvr write                         */
 /*    stk_MakeSendMsg - STK make send message function                       */
+/*    tpl_init - reply template table build function                         */
+/*    tpl_build - reply template build function                              */
+/*    tpl_find - reply template lookup function                              */
+/*    tpl_stamp - reply template time field patch function                   */
+/*    tpl_send - reply template write function                               */
+/*    wire_result - reply result field read function                         */
+/*    stat_init - request latency histogram init function                    */
+/*    stat_shard - per thread histogram shard get function                   */
+/*    stat_release - histogram shard release function (thread exit)          */
+/*    stat_bucket - latency to histogram bucket function                     */
+/*    stat_upper - histogram bucket upper bound function                     */
+/*    stat_record - request latency record function                          */
+/*    stat_merge - histogram shard merge function                            */
+/*    stat_format - Prometheus text format function                          */
+/*    stat_healthStart - health/metrics listener start function              */
+/*    stat_healthThread - health/metrics listener thread function            */
+/*    stat_serve - health/metrics connection serve function                  */
+/*    trace_begin - request stage trace start function                       */
+/*    trace_now - stage start time function                                  */
+/*    trace_span - stage end record function                                 */
+/*    trace_add - stage record function                                      */
+/*    trace_ctx - trace port/lot set function                                */
+/*    trace_end - request stage trace end / slow record function             */
 /*    bigToLitts - Endian change function                                    */
 /*    bigToLittl - Endian change function                                    */ 
 /*    msgVerify - MSG Verify function                                        */                 
+/*    stk_initSession - STK session initialize function                      */
+/*    stk_dispatchMsg - STK recv message dispatch function                   */
+/*    bcr_getOutputPort - BCR output port lookup function                    */
+/*    bcr_outputRequest - BCR output cassette process function               */
+/*    reactor_run - reactor mode main loop                                   */
+/*    reactor_ioThread - reactor I/O thread function                         */
+/*    reactor_ioLoop - reactor epoll event loop                              */
+/*    reactor_accept - reactor listen socket accept function                 */
+/*    reactor_readStk - reactor STK socket read function                     */
+/*    reactor_readBcr - reactor BCR socket read function                     */
+/*    reactor_frameLen - reactor STK frame length check function             */
+/*    reactor_stkTask - reactor STK frame handler task                       */
+/*    reactor_bcrTask - reactor BCR cassette handler task                    */
+/*    reactor_rearm - reactor session re-arm function                        */
+/*    reactor_closeSession - reactor session close function                  */
+/*    reactor_sweep - reactor idle session check function                    */
+/*    reactor_defer - reactor task submit retry register function            */
+/*    reactor_retryDeferred - reactor deferred task submit retry function    */
+/*    exec_start - work-stealing executor start function                     */
+/*    exec_submit - executor task submit function                            */
+/*    exec_take - executor task take/steal function                          */
+/*    exec_workerThread - executor worker thread function                    */
+/*    stk_admit - thread mode connection admission function                  */
+/*    stk_leave - thread mode connection slot release function               */
+/*    db_init - DB SQL text table init function                              */
+/*    db_lease - thread DB session get function                              */
+/*    db_release - DB session release function                               */
+/*    db_query - DB session query function                                   */
+/*    db_update - DB session update function                                 */
+/*    db_exec - SQL text table execute function                              */
+/*    db_frameIn - session frame to eDB global frame copy function           */
+/*    db_frameOut - eDB global result to session frame copy function         */
+/*    db_execStat - SQL text table execute counter log function              */
+/*    db_fetchRow - result set row parse function                            */
+/*    db_fetchNext - multi-row result set row parse function                 */
+/*    db_colStr - result set column copy function                            */
+/*    topo_start - port topology index start function                        */
+/*    topo_hash - port topology index hash function                          */
+/*    topo_lookup - port topology snapshot search function                   */
+/*    topo_link - port topology hash chain link function                     */
+/*    topo_colCpy - port topology column copy function                       */
+/*    topo_load - port topology index load/swap function                     */
+/*    topo_refreshThread - port topology index refresh thread function       */
+/*    topo_request - port topology index on-demand refresh function          */
+/*    topo_negCheck - port topology negative cache check function            */
+/*    topo_find - port topology index lookup function                        */
+/*    exec_trySubmit - executor non-blocking task submit function            */
+/*    exec_enqueue - executor task queueing function                         */
+/*    lot_prefetch - lot page speculative prefetch start function            */
+/*    lot_prefetchTask - lot page prefetch task function                     */
+/*    lot_prefetchThread - lot page prefetch thread function (thread mode)   */
+/*    lot_prefetchTake - lot page prefetch result take function              */
+/*    lotc_init - shared lot page cache create function                      */
+/*    lotc_hash - shared lot page cache hash function                        */
+/*    lotc_find - shared lot page cache search function                      */
+/*    lotc_unlink - shared lot page cache entry remove function              */
+/*    lotc_gen - shared lot page cache invalidation generation function      */
+/*    lotc_read - shared lot page cache read function                        */
+/*    lotc_put - shared lot page cache store function                        */
+/*    lotc_invalidate - shared lot page cache invalidate function            */
+/*    logq_start - LOGsvr shipping queue/thread start function               */
+/*    logq_push - LOGsvr shipping queue enqueue function                     */
+/*    logq_pop - LOGsvr shipping queue dequeue function                      */
+/*    logq_ship - LOGsvr log record write function                           */
+/*    logq_thread - LOGsvr shipping thread function                          */
+/*    logq_wait - LOGsvr shipping thread idle wait function                  */
 /* 6.Notification :                                                          */
 /*   Ver.  ID/Name   Organization    Date       Comment                      */
 /*   1.0  CHOI.H.G   GYURICOM       2005.03.21  Original Prototype           */
 /*****************************************************************************/
 
+/*---------------------------------------------------------------------------*/
+/* System Include Files                                                      */
+/*---------------------------------------------------------------------------*/
+#include <sys/epoll.h>
+#include <stddef.h>
+#include <poll.h>
 /*---------------------------------------------------------------------------*/
 /* Application Include Files                                                 */
 /*---------------------------------------------------------------------------*/
@@ -103,6 +216,461 @@
 #define INFO                3
 #define DEBUG               5
 
+#define IOMODE_THREAD       0           /* thread per STK connection */
+#define IOMODE_REACTOR      1           /* epoll reactor             */
+
+#define IOKIND_STKLISTEN    1
+#define IOKIND_BCRLISTEN    2
+#define IOKIND_STK          3
+#define IOKIND_BCR          4
+
+#define REACTOR_MAXEVENTS   64
+#define REACTOR_MAXIO       16
+#define EXEC_MAXWORKER      64
+#define STK_IDLE_TIMEOUT    (60*60)     /* stk_recv select timeout   */
+#define REACTOR_RETRY_MS    10          /* deferred submit õ(ms)*/
+#define STK_WRITE_TIMEOUT   10          /*  write ()       */
+#define BCR_RECV_TIMEOUT    10          /* bcrMsgThread recv timeout */
+#define DB_STAT_INTERVAL    60          /*  log ֱ()         */
+
+/* SQL text table ID (gDbStmt index) */
+#define STMT_CST_NAME           0       /* getCstName                */
+#define STMT_LOGICAL_ID         1       /* GetLogicalIDByBcrID       */
+#define STMT_LOGICAL_EMPTY      2       /* GetLogicalIDByBcrIDEmpty  */
+#define STMT_POD_CST_ID         3       /* getPodIDToCstID           */
+#define STMT_IRT_NAME           4       /* GetIrtNameByIrt           */
+#define STMT_BCR_IP             5       /* GetBcrIPByIrt             */
+#define STMT_BCR_INFO           6       /* GetBcrInfoByBcrIP         */
+#define STMT_LOCATION           7       /* GetLocationByBcrID        */
+#define STMT_CUR_HIST           8       /* GetCurrentHistoryByBcrID  */
+#define STMT_STK_BY_IP          9       /* GetStkTypeByIP            */
+#define STMT_STK_BY_NAME        10      /* GetStkTypeByStkName       */
+#define STMT_TAG_ID             11      /* GetTagIDByBcrID           */
+#define STMT_BCR_BY_TAG         12      /* GetBcrIDByTagID           */
+#define STMT_BCR_BY_LOGICAL     13      /* GetBcrIDByLogicalID       */
+#define STMT_BCRTAG_INS         14      /* InsertBcrTagMapping       */
+#define STMT_TOPO_PORT          15      /* topo_load                 */
+#define STMT_LOT_PAGE           16      /* GetLotInfo (1 round trip) */
+#define STMT_MAX                17
+
+/* DB session : thread  SQL/bind frame (eDB.h ʿ). eDB  process
+ * global frame ϳ ϹǷ    msg_mtx  ȭȴ */
+typedef struct _DB_SESSION {
+    int  stmt;                          /* sqlframe   STMT_xx */
+    SQLFRAME  sqlframe;
+    BINDFRAME bindframe;
+} DB_SESSION;
+
+/* SQL text table : helper   ִ SQL text     .
+ * prepare    ึ SQL text  bind  eDB  ѱ */
+typedef struct _DB_STMT {
+    char *name;
+    char *sql;
+    int  update;                        /* 1 : eDB_update      */
+    long exec;                          /*  Ƚ                 */
+    int  nbind;                         /*  bind  (:vN ִ밪) */
+} DB_STMT;
+
+#define DB_MAXCOL           24
+#define DB_COL_NONE         -1          /*  column               */
+#define DB_COL_NULL         0           /* NULL column               */
+#define DB_COL_OK           1
+
+/* result_str("^COL=VAL^...")  Ű column ( ) */
+typedef struct _DB_COL {
+    char *name;
+    int  nameLen;
+    char *val;
+    int  len;
+    int  isNull;
+} DB_COL;
+
+typedef struct _DB_ROW {
+    int    ncol;
+    DB_COL col[DB_MAXCOL];
+} DB_ROW;
+
+#define DB_ISNULL(row, i)   ((i) >= (row)->ncol || (row)->col[i].isNull)
+#define DB_COLCMP(c, s, n)  ((c)->len >= (n) && memcmp((c)->val, s, n) == 0)
+
+#define TOPO_KEY_ID         0           /* IRT ID                    */
+#define TOPO_KEY_NAME       1           /* IRT name (PORT_ID)        */
+#define TOPO_KEY_IP         2           /* BCR IP                    */
+#define TOPO_NKEY           3
+#define TOPO_HASHSIZE       1024        /* bucket  (2^n)           */
+#define TOPO_MAXPORT        8192
+#define TOPO_REFRESH        600         /* ⺻ refresh ֱ()     */
+#define TOPO_MINGAP         10          /* refresh ּ ()     */
+#define TOPO_BATCH          50          /* SELECT 1ȸ д row   */
+#define TOPO_NEGSIZE        256         /* negative cache ũ (2^n) */
+
+#define LOTINFO_SIZE        (32*6)      /* rReadMemory 0x400~0x4BF   */
+#define LOTPF_MAX           64          /* prefetch slot           */
+#define LOTPF_TTL           30          /* غ page ȿð()  */
+#define LOTPF_WAIT          5           /*  prefetch ()  */
+#define LOTPF_EMPTY         0
+#define LOTPF_PENDING       1
+#define LOTPF_READY         2
+
+#define LOTC_MAXSIZE        4096
+#define LOTC_HASHSIZE       1024        /* bucket  (2^n)           */
+
+#define LOGQ_SIZE           1024        /* ⺻ LOGsvr queue ũ    */
+#define LOGQ_MAXSIZE        65536
+#define LOGQ_SPIN           64          /* drop-oldest õ ѵ   */
+#define LOGQ_BATCH          16          /* wakeup  ִ  record */
+#define LOGQ_RETRY          1           /* LOGsvr  ()    */
+
+#define LTS_MAXCONN         8           /* LTSsvr pool ִ    */
+#define LTS_MAXPEND         256         /*   request ִ    */
+#define LTS_TIMEOUT         30          /* LTSsvr  ()      */
+#define LTS_RETRY           1           /* LTSsvr  ()    */
+#define LTS_MSGID_MAX       30000       /* pool  οϴ msgID    */
+
+#define BCRC_MAX            512         /*  BCR reader ִ      */
+#define BCRC_CHECK          10          /* liveness check ֱ()   */
+#define BCRC_CONN_TIMEOUT   3           /* BCR connect timeout()   */
+#define BCRC_BACKOFF_MAX    30          /*   reader õ ִ () */
+#define BCR_READERS         8           /* barcode read thread     */
+#define RID_MAXPOOL         64          /* Ridian pool ִ    */
+#define RID_LEASE_WAIT      10          /* pool lease ()       */
+#define RID_CHECK           10          /* health check ֱ()     */
+#define RID_MAXPIPE         16          /*    ִ     */
+#define RID_TIMEOUT         30          /* pipeline  ()    */
+#define RID_RETRY           1           /* pipeline  ()  */
+#define RID_FRAMEBUF        65536       /* Ridian frame buffer       */
+
+#define STAT_MAXTYPE        16          /*  msgType slot ִ    */
+#define STAT_SUBBITS        2           /* 2^n  sub bucket bit */
+#define STAT_SUB            (1 << STAT_SUBBITS)
+#define STAT_NBUCKET        112         /* ~2^28 usec            */
+#define STAT_EXPORT_FROM    23          /* export ù bucket (128us)  */
+#define STAT_LINEMAX        256         /* /metrics   ִ   */
+#define STAT_HTTP_WAIT      500         /* û line (ms)        */
+
+#define STAT_RES_OK         0           /* result 0                  */
+#define STAT_RES_ERR        1           /* result TPL_ERR            */
+#define STAT_RES_OTHER      2           /* ׿ result               */
+#define STAT_RES_NONE       3           /*               */
+#define STAT_NRESULT        4
+
+#define TRACE_MAXSPAN       16          /* û  stage ִ    */
+#define TRACE_SLOW          1000        /* slow  ⺻(ms)      */
+
+#define RIDP_FREE           0
+#define RIDP_WAIT           1           /*                   */
+#define RIDP_DONE           2           /*                   */
+#define RIDP_GARBAGE        3           /* ̰ ٸ  ()   */
+#define RIDP_FAIL           4           /*   Ǵ        */
+#define RIDP_ABANDON        5           /* ûڰ timeout   */
+
+#define BCRC_IDLE           0
+#define BCRC_BUSY           1           /* lease  Ǵ       */
+
+/* rListUnitAtIrt   GetLotInfo  (rReadMemory 0x400  Һ) */
+typedef struct _LOT_PREFETCH {
+    int    state;                       /* LOTPF_xx                  */
+    int    result;                      /* GetLotInfo            */
+    int    gen;                         /* ȸ ۽ lotc_gen      */
+    time_t time;                        /* û/Ϸ ð            */
+    char   lotID[24];
+    char   page[LOTINFO_SIZE];
+    char   errmsg[256];
+} LOT_PREFETCH;
+
+/*  STK session  ϴ LOT page image (lotInfo 192 byte) */
+typedef struct _LOT_CACHE {
+    int    used;
+    int    next;                        /* hash chain (-1 : )      */
+    time_t loadTime;                    /* TTL                   */
+    time_t lastUse;                     /*  á  eviction  */
+    char   lotID[24];
+    char   page[LOTINFO_SIZE];
+} LOT_CACHE;
+
+/* LOGsvr   record : bounded MPMC ring  slot               */
+/* seq  slot  ѱǷ producer/consumer  lock    */
+typedef struct _LOG_REC {
+    volatile unsigned int seq;          /* slot sequence             */
+    char dest[10];                      /* "->RIDsvr", "<-STK01"   */
+    char name[30];                      /* message name              */
+    char body[BUFSIZ];
+} LOG_REC;
+
+/* LTSsvr pool  : û  thread    Ằ    */
+/* lts_connThread  ޾ msgID   request  Ѵ      */
+typedef struct _LTS_CONN {
+    int  idx;
+    int  sock;                          /* -1 :            */
+    int  inflight;                      /*   request     */
+    pthread_mutex_t wmtx;               /* sendMessage ȭ        */
+} LTS_CONN;
+
+/* LTSsvr   request */
+typedef struct _LTS_PEND {
+    int  used;
+    int  msgID;
+    int  conn;                          /*  LTS_CONN index     */
+    int  done;                          /* 0:, 1:, -1:   */
+    char *r_msgName;
+    char *recvBuf;
+    pthread_cond_t cond;
+} LTS_PEND;
+
+/* 2 byte length prefix frame reader. ѹ recv   ŭ ޾ ΰ
+ * ϼ frame  ߶󳽴. buf  ȣڰ ϸ maxLen ̻̾ Ѵ */
+typedef struct _FRAME_RD {
+    int    sock;
+    int    bigEndian;                   /* 1 : length  big-endian (STK) */
+    int    maxLen;                      /* ̺  length     */
+    int    resyncOn;                    /* 0 : header   (STK) */
+    int    cap;
+    int    head;                        /* buf[head..tail) ó byte */
+    int    tail;
+    long   resync;                      /* resync   byte   */
+    char  *name;                        /* log   ̸          */
+    char  *buf;
+} FRAME_RD;
+
+/* STK client û frame  read-only view. ڿ field  buf  ü
+ *  ٷ а,  field  VIEW_U32    ȯѴ.
+ * buf  frame ڰ 0  ä recv buffer (BUFSIZ) ̴ */
+typedef struct _STK_VIEW {
+    char  *buf;                         /* frame  (network order) */
+    int    len;                         /* frame  (header )  */
+    char   type;                        /* msgType                   */
+} STK_VIEW;
+
+#define VIEW_U32(v, T, f)   view_u32((v), offsetof(T, f))
+
+/* msgstruct.h ü byte order ȯ descriptor. ü 2/4/8 byte
+ *  field  offset   ϰ (width 0  ), encode/decode 
+ * msgType   gWireTab   . 1 byte field  ڿ
+ * ȯ ʿ䰡 Ƿ  ʴ´.
+ * WL   field   bigToLittl ȯ byte ״ Ѵ.
+ * osLong   4 byte  ٲ [BE32][00 00 00 00]  ǰ, osShort 
+ * bigToLittl   unitCategory   16 bit (0 Ǵ -1)  ´.
+ * STK   byte   Ƿ  STK   ٲ ʴ´ */
+#define WIRE_MAXTYPE        128         /* msgType ִ밪 + 1        */
+#define WIRE_MAXFIELD       12          /* ü ȯ field ִ  */
+
+typedef struct _WIRE_FIELD {
+    unsigned short off;                 /* ü  offset          */
+    unsigned short width;               /* 2/4/8 (|WIRE_LEGACY), 0:*/
+} WIRE_FIELD;
+
+typedef struct _WIRE_MSG {
+    char  *name;                        /* NULL :  ʴ type */
+    int    reqSize;                     /* û ü ũ          */
+    int    repSize;                     /*  ü ũ          */
+    WIRE_FIELD result;                  /*  result field       */
+    WIRE_FIELD req[WIRE_MAXFIELD];
+    WIRE_FIELD rep[WIRE_MAXFIELD];
+} WIRE_MSG;
+
+#define WIRE_LEGACY         0x100       /*  bigToLittl 32bit ȯ*/
+#define WIRE_WIDTH(f)       ((f)->width & 0xFF)
+
+#define WF(T, f)            { offsetof(T, f), sizeof(((T *)0)->f) }
+#define WL(T, f)            { offsetof(T, f), WIRE_LEGACY | sizeof(((T *)0)->f) }
+
+#define WIRE_GENREQ         { WF(rGenRequest, msgLen), WF(rGenRequest, itemType), \
+                              WL(rGenRequest, period) }
+#define WIRE_GENREP         { WF(rGenReply, msgLen), WF(rGenReply, result) }
+#define WIRE_SIMPLEREP      { WF(rSimpleReply, msgLen), WF(rSimpleReply, result) }
+
+/* ⵿  δ  template. msgType   (result 0)  error
+ * (TPL_ERR)  host order  network order  ѹ  ־,
+ * ErrReply  stk_MakeSendMsg    field (ð, addr) 
+ * Ѵ */
+#define TPL_MAXBUF          256         /* template  ִ ũ   */
+#define TPL_ERR             11          /* STK  ִ error result  */
+
+typedef struct _REPLY_TPL {
+    char   type;                        /* msgType                   */
+    int    result;
+    int    size;                        /*  ũ (= msgLen)      */
+    long   host[TPL_MAXBUF / sizeof(long)];  /* host order (log )  */
+    long   wire[TPL_MAXBUF / sizeof(long)];  /* network order       */
+} REPLY_TPL;
+
+/* û óð histogram.  usec ̰ bucket  2^n  STAT_SUB 
+ *  log-linear (HDR ,  25% ̳) ̴. shard  thread  ϳ
+ *  (writer  ϳ lock/RMW  ), /metrics û  ģ.
+ * thread   shard  踦  ä  thread  Ѵ */
+typedef struct _STAT_HIST {
+    unsigned long cnt;
+    unsigned long sum;                  /* usec հ                 */
+    unsigned long bucket[STAT_NBUCKET];
+} STAT_HIST;
+
+typedef struct _STAT_SHARD {
+    int    owner;                       /* 1 :  thread   */
+    struct _STAT_SHARD *next;
+    STAT_HIST h[STAT_MAXTYPE][STAT_NRESULT];
+} STAT_SHARD;
+
+/* shard  writer   thread (tlStat) ϳ̶ а   ̿
+ *  . atomic store      ƴ϶ ÿ
+ * д stat_merge      ʰ ϱ  ̴ */
+#define STAT_INC(v, n)      __atomic_store_n(&(v), (v) + (n), __ATOMIC_RELAXED)
+
+/* û ϳ stage . thread  ϳ (tlTrace) ̰ stk_dispatchMsg 
+ * /Ѵ. stage  trace_now  ð  trace_span  ,
+ * ü ð STKinf.trace.slow    record  .
+ * stage ̸ ڿ  (DB  statement ̸)  Ѵ */
+typedef struct _TRACE_SPAN {
+    const char *name;
+    unsigned int start;                 /* û ۺ usec        */
+    unsigned int dur;                   /* usec                      */
+} TRACE_SPAN;
+
+typedef struct _TRACE {
+    int    on;                          /* 1 :                 */
+    int    n;
+    int    drop;                        /* TRACE_MAXSPAN ʰ stage  */
+    struct timespec t0;                 /* û  (MONOTONIC)     */
+    char   port[32];
+    char   lot[32];
+    TRACE_SPAN span[TRACE_MAXSPAN];
+} TRACE;
+
+/* pipeline 忡  ٸ Ridian request */
+typedef struct _RID_PEND {
+    int    state;                       /* RIDP_xxx                  */
+    char   type;                        /* ۽ message type         */
+    unsigned short int r_size;          /* ϴ          */
+    char  *r_buff;
+    pthread_cond_t cond;
+} RID_PEND;
+
+/* process  Ridian  (lease ߿  thread  )
+ * pipeline 忡  request   ۽ϰ  ۽ (FIFO)
+ *  ¦  */
+typedef struct _RID_CONN {
+    int  idx;
+    int  sock;                          /* -1 : ̿ (lease  ) */
+    int  busy;                          /* lease  Ǵ health check  */
+    int  inflight;                      /* pipeline :  pend  */
+    int  head;                          /* pipeline : fifo  ġ */
+    int  cnt;                           /* pipeline : fifo       */
+    int  reset;                         /* pipeline : timeout,   */
+    int  fifo[RID_MAXPIPE];             /* ۽  pend index    */
+    RID_PEND pend[RID_MAXPIPE];
+    pthread_mutex_t wmtx;               /* pipeline : ۽   */
+    FRAME_RD rd;                        /*  frame reader         */
+    char    *rbuf;                      /* rd  buffer (RID_FRAMEBUF) */
+} RID_CONN;
+
+/*  BCR reader  warm  (reader IP  1) */
+typedef struct _BCR_CONN {
+    char   ip[20];
+    int    sock;                        /* -1 : ̿               */
+    int    state;                       /* BCRC_IDLE/BCRC_BUSY       */
+    int    backoff;                     /*   н () */
+    time_t retryAt;                     /*  ð  connect  */
+    long   conn;                        /* connect               */
+    long   connFail;
+    long   connUs;                      /* connect (usec)        */
+    long   connMax;
+    long   read;                        /* 0x05 ~   Ƚ     */
+    long   readUs;                      /* read (usec)           */
+    long   readMax;
+    long   reuse;                       /* warm            */
+    long   dead;                        /*  warm  ߰     */
+    long   logged;                      /*   log  read   */
+} BCR_CONN;
+
+/* rListUnitAtIrt  Ridian ȸ ÿ ϴ barcode read */
+typedef struct _BCR_READ {
+    struct _BCR_READ *next;             /* read pool  list       */
+    int          started;               /* 1 : read pool       */
+    int          done;                  /* 1 : read Ϸ (gBcrrMtx)  */
+    int          result;                /* bcr_SendRecv          */
+    char         *bcrIP;
+    STK_PROFILE  *prof;
+    char         barcodeID[12];
+    char         errmsg[BUFSIZ];
+    struct timespec t0;                 /* read                  */
+    struct timespec t1;                 /* read Ϸ                 */
+} BCR_READ;
+
+/* port topology 1 row (LTSSTKPORTINFO + LTSTERMINAL) */
+typedef struct _TOPO_PORT {
+    char irtID[12];
+    char irtName[30];
+    char bcrIP[20];
+    char portType[8];                   /* PT01/PT02/PT03        */
+    char bcrName[24];                   /* SCANNER_ID                */
+    char stkName[24];
+    int  next[TOPO_NKEY];               /* hash chain (-1 : )      */
+} TOPO_PORT;
+
+/* index   key :  key  reload  ݺ û ʰ Ѵ */
+typedef struct _TOPO_NEG {
+    int    kind;                        /* TOPO_KEY_xx               */
+    char   key[32];
+    time_t time;                        /*  reload û ð   */
+} TOPO_NEG;
+
+/* topology snapshot :    ʴ´. reader  gTopoLock  read
+ * lock   ȸ ϸ, ü snapshot  write lock  reader 
+ *    ٷ Ѵ */
+typedef struct _TOPO_INDEX {
+    int    nport;
+    TOPO_PORT *port;
+    int    head[TOPO_NKEY][TOPO_HASHSIZE];
+    time_t loadTime;
+} TOPO_INDEX;
+
+/* STK client session (thread/reactor mode ) */
+typedef struct _STK_SESSION {
+    int     kind;                       /* IOKIND_xxx                */
+    int     csock;                      /* client socket             */
+    char    stkIP[20];
+    char    stkName[15];
+    STK_PROFILE prof;                   /* rConnect  ȿ        */
+    int     endFlag;
+    char    lotInfo[32*6];
+    /* reactor mode  */
+    int     ioIdx;                      /*  I/O thread           */
+    int     busy;                       /* handler task ó       */
+    void    (*deferred)(void *);        /* queue full : submit õ */
+    int     eof;                        /* peer                  */
+    time_t  lastRecv;
+    int     rlen;
+    char    rbuf[BUFSIZ];               /* thread mode frame buf  */
+    struct _STK_SESSION *prev;
+    struct _STK_SESSION *next;
+} STK_SESSION;
+
+/* reactor I/O thread */
+typedef struct _STK_IOTHREAD {
+    int     idx;
+    int     epfd;
+    pthread_t tid;
+    pthread_mutex_t mtx;                /* session list lock         */
+    STK_SESSION *head;
+    int     deferred;                   /* deferred session        */
+} STK_IOTHREAD;
+
+/* reactor handler task */
+typedef struct _STK_TASK {
+    void    (*func)(void *);
+    void    *arg;
+    struct _STK_TASK *next;
+} STK_TASK;
+
+/* work-stealing executor worker */
+typedef struct _STK_WORKER {
+    int     idx;
+    pthread_t tid;
+    pthread_mutex_t mtx;                /* task queue lock           */
+    STK_TASK *head;
+    STK_TASK *tail;
+    volatile int cnt;                   /* queue   task      */
+} STK_WORKER;
+
 /*---------------------------------------------------------------------------*/
 /* Local Function Prototype Declaration                                      */
 /*---------------------------------------------------------------------------*/
@@ -115,46 +683,107 @@ void signalHandler(int sig);
 void waitConnection(pthread_attr_t *, int ,char *, char *, int , char *);
 int createBcrWaitThread(pthread_attr_t *, unsigned int , int , char *);
 
+void stk_initSession(STK_SESSION *, int , int , char *);
+int stk_dispatchMsg(STK_SESSION *, char *, char *);
+int bcr_getOutputPort(char *, char *, char *, char *, STK_PROFILE *, char *);
+int bcr_outputRequest(char *, char *, char *, char *, STK_PROFILE *, char *, int , char *);
+
+void reactor_run(pthread_attr_t *, int , int , char *);
+void * reactor_ioThread(void *arg);
+void reactor_ioLoop(STK_IOTHREAD *);
+void reactor_accept(STK_SESSION *);
+void reactor_readStk(STK_IOTHREAD *, STK_SESSION *);
+void reactor_readBcr(STK_IOTHREAD *, STK_SESSION *);
+int reactor_frameLen(STK_SESSION *, char *);
+void reactor_stkTask(void *);
+void reactor_bcrTask(void *);
+void reactor_rearm(STK_SESSION *);
+void reactor_closeSession(STK_SESSION *);
+void reactor_sweep(STK_IOTHREAD *);
+void reactor_defer(STK_IOTHREAD *, STK_SESSION *, void (*)(void *));
+void reactor_retryDeferred(STK_IOTHREAD *);
+int exec_start(pthread_attr_t *, char *);
+int exec_submit(void (*)(void *), void *);
+int exec_trySubmit(void (*)(void *), void *);
+int exec_enqueue(void (*)(void *), void *, int );
+STK_TASK * exec_take(int );
+void * exec_workerThread(void *arg);
+void stk_admit(int , char *);
+void stk_leave();
+int db_init(char *);
+DB_SESSION * db_lease();
+void db_release(DB_SESSION *);
+int db_query(DB_SESSION *, int , int );
+int db_update(DB_SESSION *);
+int db_exec(DB_SESSION *, int , int );
+void db_frameIn(DB_SESSION *);
+void db_frameOut(DB_SESSION *);
+void db_execStat();
+int db_fetchRow(DB_SESSION *, DB_ROW *);
+int db_fetchNext(DB_SESSION *, char **, DB_ROW *);
+int db_colStr(DB_ROW *, int , char *);
+int topo_start(pthread_attr_t *, char *);
+int topo_load(char *);
+unsigned int topo_hash(char *);
+int topo_lookup(TOPO_INDEX *, int , char *);
+void topo_link(TOPO_INDEX *, int , int , char *);
+void topo_colCpy(DB_ROW *, int , char *, int );
+void * topo_refreshThread(void *arg);
+void topo_request();
+int topo_negCheck(int , char *);
+int topo_find(int , char *, TOPO_PORT *);
+
 int readConfig(int *, int *, int *, char *, char *, char *, char *, char *);
-int stk_recv(int , char *, char *, char *);
-int stk_rAssociateUnit(int , int *, char *, char *, int , char *);
-int stk_rAssociateUnit_hton(rGenRequest *);
-int stk_rAssociateUnit_ntoh(rGenReply *);
+int stk_recv(FRAME_RD *, char *, char *, char *);
+void frm_init(FRAME_RD *, int , int , int , int , char *, int , char *);
+int frm_read(FRAME_RD *, char **, int , char *);
+int view_open(STK_VIEW *, char *, char *);
+unsigned int view_u32(STK_VIEW *, int );
+int view_decode(STK_VIEW *, void *, int );
+int stk_writeReply(int , void *, int );
+int stk_writeAll(int , void *, int );
+WIRE_MSG * wire_find(char );
+void wire_swap(WIRE_FIELD *, void *, int );
+int stk_rAssociateUnit(int , STK_VIEW *, STK_PROFILE *, char *);
 int stk_rAssociateUnitErrReply(int , char *, char *, int , char *);
-int stk_rClose(int , char *, char *, char *);
-int stk_rClose_hton(rSimpleRequest *);
-int stk_rClose_ntoh(rSimpleReply *);
-int stk_rConnect(int , char *, char *, char *);
-int stk_rConnect_hton(rConnectRequest *);
-int stk_rConnect_ntoh(rConnectReply *);
-int stk_rDisassociateUnit(int , int *, char *, char *, int , char *);
-int stk_rDisassociateUnit_hton(rGenRequest *);
-int stk_rDisassociateUnit_ntoh(rGenReply *);
+int stk_rClose(int , STK_VIEW *, char *, char *);
+int stk_buildProfile(char *, STK_PROFILE *, char *);
+int stk_rConnect(int , STK_VIEW *, char *, char *);
+int stk_rDisassociateUnit(int , STK_VIEW *, STK_PROFILE *, char *);
 int stk_rDisassociateUnitErrReply(int , char *, char *, int , char *);
-int stk_rDisplayMsg(int , int *, char *, char *, int , char *);
-int stk_rDisplayMsg_hton(rPostLineRequest *);
-int stk_rDisplayMsg_ntoh(rSimpleReply *);
+int stk_rDisplayMsg(int , STK_VIEW *, STK_PROFILE *, char *);
 int stk_rDisplayMsgErrReply(int , char *, char *, int , char *);
-int stk_rLogicalToPhysicalUnit(int , int *, char *, char *, char *, char *);
-int stk_rListUnitAtIrt(int , int *, char *, char *, int , char *);
-int stk_rListUnitAtIrt_hton(rQuerySensorRequest *);
-int stk_rListUnitAtIrt_ntoh(rQuerySensorReply *);
+int stk_rLogicalToPhysicalUnit(int , char *, char *, STK_PROFILE *, char *);
+int stk_rListUnitAtIrt(int , STK_VIEW *, STK_PROFILE *, char *);
 int stk_rListUnitAtIrtErrReply(int , char *, char *, int , char *);
-int stk_rLogicalToPhysicalSensor(int *, char *, char *, char *);
-int stk_rPhysicalToLogicalSensor(int , char *, char *, char *);
-int stk_rPhysicalToLogicalSensor_hton(rGenRequest *);
-int stk_rPhysicalToLogicalSensor_ntoh(rGenReply *);
-int stk_rReadMemory(int , char *, char *, int ,char *, char *);
-int stk_rReadMemory_hton(rReadRAMRequest *);
-int stk_rReadMemory_ntoh( rReadRAMReply *);
+int stk_rLogicalToPhysicalSensor(char *, STK_PROFILE *, char *);
+int stk_rPhysicalToLogicalSensor(int , STK_VIEW *, char *, char *);
+int stk_rReadMemory(int , STK_VIEW *, STK_PROFILE *, char *, char *);
 int stk_rReadMemoryErrReply(int , char *, char *, int ,char *, char *);
 
 int GetBcrIDByLogicalID(char *, char *, char *);
-int GetNextCleanData(char *, char *, char *, char *);
 int GetBcrIPByIrt(char *, char *, char *, char *, char *);
 int GetIrtNameByIrt(char *, char *, char *);
 int GetLogicalIDByBcrID(char *, char *, char *);
 int GetLotInfo(char *, char *, char *);
+void lot_prefetch(char *);
+void lot_prefetchTask(void *);
+void * lot_prefetchThread(void *arg);
+int lot_prefetchTake(char *, char *, char *);
+int lotc_init(int , char *);
+unsigned int lotc_hash(char *);
+int lotc_find(char *);
+void lotc_unlink(int );
+int lotc_gen(char *);
+int lotc_read(char *, int , int , char *);
+void lotc_put(char *, char *, int );
+void lotc_invalidate(char *);
+int logq_start(pthread_attr_t *, char *);
+int logq_push(char *, char *, char *);
+int logq_pop(LOG_REC *);
+int logq_ship(char *, char *, char *, char *);
+void * logq_thread(void *arg);
+void logq_wait(void);
 int GetStkTypeByIP(char *, char *, char *);
 int GetTagIDByBcrID(char *, char *, char *);
 int GetBcrIDByTagID(char *, char *, char *);
@@ -165,27 +794,73 @@ int getErrorReceiver(char *, char *);
 int InsertBcrTagMapping(char *, char *, char *, char *);
 
 int bcr_connect(char *);
-int bcr_SendRecv(char *, char *,char *, char *);
+int bcr_SendRecv(char *, char *, STK_PROFILE *, char *);
+int bcrc_start(pthread_attr_t *, char *);
+int bcrc_find(char *);
+int bcrc_connect(char *, long *);
+int bcrc_alive(int );
+int bcrc_lease(char *, int *, char *);
+void bcrc_release(int , int , int , long );
+void * bcrc_thread(void *arg);
+int bcr_readPoolStart(pthread_attr_t *, char *);
+void bcr_readStart(BCR_READ *, char *, STK_PROFILE *);
+void * bcr_readThread(void *arg);
+void bcr_readJoin(BCR_READ *);
 
 int rid_connect(char *);
-char rid_SendRecv(int *, char *, unsigned short int, char *, unsigned short int, char *);
-int rid_close(int , char *);
+char rid_SendRecv(char *, unsigned short int, char *, unsigned short int, STK_PROFILE *);
+char rid_exchange(RID_CONN *, char *, unsigned short int, char *, unsigned short int, STK_PROFILE *);
+int rid_close(STK_PROFILE *);
+int rid_poolStart(pthread_attr_t *, char *);
+int rid_lease(char *);
+void rid_release(int , int );
+int rid_alive(int );
+void * rid_poolThread(void *arg);
+int rid_check(char *);
+void * rid_pipeThread(void *arg);
+char rid_pipeSendRecv(char *, unsigned short int, char *, unsigned short int, STK_PROFILE *);
 
 int hht_connect();
 int hht_SendRecv(char *, char *, char *, char *);
 int hht_sendErrMsg(char *, char *, char *);
 
-int lts_inputRequest(int , char *, char *, char *, char *, char *);
-int lts_outputRequest(int , char *, char *, char *, char *, char *);
-int lts_rAssociateUnit(int , char *, char *, char *, char *, char *);
-int lts_rDisassociateUnit(int , char *, char *, char *, char *, char *);
+int lts_inputRequest(STK_PROFILE *, char *, char *, char *, char *);
+int lts_outputRequest(STK_PROFILE *, char *, char *, char *, char *);
+int lts_rAssociateUnit(STK_PROFILE *, char *, char *, char *, char *);
+int lts_rDisassociateUnit(STK_PROFILE *, char *, char *, char *, char *);
 int lts_SendRecv(int , char *, char *, char *, char *, char *);
+int lts_poolStart(pthread_attr_t *, char *);
+void * lts_connThread(void *arg);
+int lts_poolSendRecv(char *, char *, char *, char *, char *);
+int lts_directSendRecv(int , char *, char *, char *, char *, char *);
 
 int stk_RecvLogSvr(void *, char , char *, char *, int);
 int stk_SendLogSvr(void *, char , char *, char *, int);
 int stk_MakeSendMsg(void *, void * , char, char *);
+int tpl_init(char *);
+REPLY_TPL * tpl_build(char , int );
+REPLY_TPL * tpl_find(char , int );
+void tpl_stamp(REPLY_TPL *, void *, int );
+int tpl_send(int , REPLY_TPL *);
+int wire_result(WIRE_MSG *, void *);
+int stat_init(char *);
+STAT_SHARD * stat_shard();
+void stat_release(void *);
+int stat_bucket(unsigned long );
+unsigned long stat_upper(int );
+void stat_record(char , int , struct timespec *);
+void stat_merge(STAT_HIST *);
+int stat_format(STAT_HIST *, char *, int );
+int stat_healthStart(pthread_attr_t *, unsigned int , int , char *);
+void * stat_healthThread(void *arg);
+void stat_serve(int , STAT_HIST *, char *, int );
+void trace_begin(struct timespec *);
+void trace_now(struct timespec *);
+void trace_span(const char *, struct timespec *);
+void trace_add(const char *, struct timespec *, struct timespec *);
+void trace_ctx(char *, char *);
+void trace_end(char *, char , int );
 
-int getRecipe(char *, char *);
 //ASML 
 int getCstName(char *, char *, char *);
 
@@ -194,6 +869,59 @@ unsigned int bigToLittl(unsigned int);
 int msgVerify(char);
 
 /* GLOBAL   */
+/* msgType  wire descriptor (WIRE_MSG ) */
+WIRE_MSG gWireTab[WIRE_MAXTYPE] = {
+    [msgTypeConnectRequest] = { "rConnect",
+        sizeof(rConnectRequest), sizeof(rConnectReply), WF(rConnectReply, result),
+        { WF(rConnectRequest, msgLen) },
+        { WF(rConnectReply, msgLen), WF(rConnectReply, result),
+          WF(rConnectReply, major), WF(rConnectReply, minor),
+          WF(rConnectReply, point) } },
+    [msgTypeCloseRequest] = { "rClose",
+        sizeof(rSimpleRequest), sizeof(rSimpleReply), WF(rSimpleReply, result),
+        { WF(rSimpleRequest, msgLen) },
+        WIRE_SIMPLEREP },
+    [msgTypePTLSensor] = { "rPhysicalToLogicalSensor",
+        sizeof(rGenRequest), sizeof(rGenReply), WF(rGenReply, result),
+        WIRE_GENREQ, WIRE_GENREP },
+    [msgTypeLTPSensor] = { "rLogicalToPhysicalSensor",
+        sizeof(rGenRequest), sizeof(rGenReply), WF(rGenReply, result),
+        WIRE_GENREQ, WIRE_GENREP },
+    [msgTypeQuerySensorLoc] = { "rListUnitAtIrt",
+        sizeof(rQuerySensorRequest), sizeof(rQuerySensorReply), WF(rQuerySensorReply, result),
+        { WF(rQuerySensorRequest, msgLen), WL(rQuerySensorRequest, pingTime),
+          WL(rQuerySensorRequest, numItems) },
+        { WF(rQuerySensorReply, msgLen), WF(rQuerySensorReply, result),
+          WF(rQuerySensorReply, totalNum), WF(rQuerySensorReply, numItems),
+          WF(rQuerySensorReply, responseMsg.unittype),
+          WL(rQuerySensorReply, responseMsg.updateTime),
+          WL(rQuerySensorReply, responseMsg.moveTime),
+          WL(rQuerySensorReply, responseMsg.motionTime),
+          WL(rQuerySensorReply, responseMsg.unitCategory),
+          WF(rQuerySensorReply, responseMsg.sensorCategory) } },
+    [msgTypeReadMemory] = { "rReadMemory",
+        sizeof(rReadRAMRequest), sizeof(rReadRAMReply), WF(rReadRAMReply, result),
+        { WF(rReadRAMRequest, msgLen), WF(rReadRAMRequest, period),
+          WF(rReadRAMRequest, addr) },
+        { WF(rReadRAMReply, msgLen), WF(rReadRAMReply, result),
+          WF(rReadRAMReply, addr) } },
+    [msgTypeAssociateUnit] = { "rAssociateUnit",
+        sizeof(rGenRequest), sizeof(rGenReply), WF(rGenReply, result),
+        WIRE_GENREQ, WIRE_GENREP },
+    [msgTypeDisassociateUnit] = { "rDisassociateUnit",
+        sizeof(rGenRequest), sizeof(rGenReply), WF(rGenReply, result),
+        WIRE_GENREQ, WIRE_GENREP },
+    [msgTypeDisplayMsg] = { "rDisplayMsg",
+        sizeof(rPostLineRequest), sizeof(rSimpleReply), WF(rSimpleReply, result),
+        { WF(rPostLineRequest, msgLen), WF(rPostLineRequest, line),
+          WL(rPostLineRequest, period) },
+        WIRE_SIMPLEREP },
+    [msgTypeLTPUnit] = { "rLogicalToPhysicalUnit",
+        sizeof(rGenRequest), sizeof(rGenReply), WF(rGenReply, result),
+        WIRE_GENREQ, WIRE_GENREP },
+};
+REPLY_TPL *gReplyTpl[WIRE_MAXTYPE][2];   /* [msgType][0:, 1:error] */
+
 char ltsFile[256]={0,};
 char logFile[256]={0,};
 char RIDSERVER_IP[20]={0,};
@@ -206,8 +934,851 @@ int  RETRY = 2;
 int  gLotParallelMaint = 1;		    /* , ȯϷ ÷ */
 int  gReticleParallelMaint = 1;		/* , ȯϷ ÷ */
 
+int  gIoMode = IOMODE_THREAD;       /* STKinf.io.mode            */
+int  gIoThreads = 2;                /* reactor I/O thread count  */
+/*
+ * handler task  BCR(7*RETRY), Ridian(10*RETRY)  worker 
+ *  ٸ. session  task   ̹Ƿ STK   
+ * worker      STK  worker    и.
+ * STKinf.handler.threads  STK    + (BCR output port, lot
+ * prefetch) ̻ Ѵ.
+ */
+int  gHandlerThreads = 8;           /* executor worker count     */
+int  gHandlerQueue = 1024;          /* executor queued task max  */
+int  gSessionCnt = 0;               /* reactor STK session count */
+
+STK_IOTHREAD gIoThread[REACTOR_MAXIO];
+STK_SESSION  gStkListen;
+STK_SESSION  gBcrListen;
+int          gIoNext = 0;
+
+STK_WORKER gWorker[EXEC_MAXWORKER];  /* work-stealing executor   */
+__thread int tlWorkerIdx = -1;       /*  thread  worker index */
+unsigned int gExecNext = 0;
+int  gExecQueued  = 0;              /* queue   task    */
+int  gExecIdle    = 0;              /*  worker           */
+int  gExecHigh    = 0;              /* gExecQueued ִ밪        */
+long gExecBlocked = 0;              /* backpressure  Ƚ    */
+long gExecSteal   = 0;              /* steal Ƚ                */
+long gExecDone    = 0;              /* ó Ϸ task            */
+pthread_mutex_t gExecMtx   = PTHREAD_MUTEX_INITIALIZER;
+pthread_cond_t  gExecCond  = PTHREAD_COND_INITIALIZER;
+pthread_cond_t  gExecSpace = PTHREAD_COND_INITIALIZER;
+pthread_cond_t  gAdmitCond = PTHREAD_COND_INITIALIZER;
+
+__thread DB_SESSION tlDb;           /*  thread  DB session */
+int gDbBindUsed = 0;                /* eDB global   bind  (msg_mtx) */
+time_t gDbStatTime = 0;
+
+int  gTopoRefresh = TOPO_REFRESH;   /* STKinf.topo.refresh (0:̻) */
+TOPO_INDEX *gTopo = NULL;           /*  snapshot (gTopoLock) */
+pthread_rwlock_t gTopoLock = PTHREAD_RWLOCK_INITIALIZER;
+int  gTopoReq     = 0;              /* on-demand refresh û    */
+long gTopoHit     = 0;
+long gTopoMiss    = 0;
+long gTopoNegHit  = 0;              /* negative cache   reload û */
+TOPO_NEG gTopoNeg[TOPO_NEGSIZE];    /* gTopoMtx  ȣ          */
+pthread_mutex_t gTopoMtx  = PTHREAD_MUTEX_INITIALIZER;
+pthread_cond_t  gTopoCond = PTHREAD_COND_INITIALIZER;
+
+int  gLotPrefetch = 1;              /* STKinf.lot.prefetch       */
+LOT_PREFETCH gLotPf[LOTPF_MAX];
+long gLotPfIssue  = 0;              /* prefetch              */
+long gLotPfHit    = 0;              /* Ϸ page           */
+long gLotPfWaitHit = 0;             /*  prefetch    */
+long gLotPfMiss   = 0;              /* prefetch  ( ȸ) */
+long gLotPfWasted = 0;              /*  ʰ         */
+long gLotPfSkip   = 0;              /* slot/queue    */
+time_t gLotPfStatTime = 0;
+pthread_mutex_t gLotPfMtx  = PTHREAD_MUTEX_INITIALIZER;
+pthread_cond_t  gLotPfCond = PTHREAD_COND_INITIALIZER;
+
+int  gLotcSize    = 256;            /* STKinf.lot.cache.size (0:̻) */
+int  gLotcTTL     = 60;             /* STKinf.lot.cache.ttl () */
+LOT_CACHE *gLotc  = NULL;
+int  gLotcHead[LOTC_HASHSIZE];
+int  gLotcGen[LOTC_HASHSIZE];       /* bucket  invalidation Ƚ */
+int  gLotcCnt     = 0;
+long gLotcHit     = 0;
+long gLotcMiss    = 0;
+long gLotcPut     = 0;
+long gLotcStale   = 0;              /* ȸ invalidate Ǿ  put */
+long gLotcInval   = 0;
+long gLotcEvict   = 0;
+time_t gLotcStatTime = 0;
+pthread_mutex_t gLotcMtx = PTHREAD_MUTEX_INITIALIZER;
+
+int  gLogqSize    = LOGQ_SIZE;      /* STKinf.log.queue (0: ) */
+LOG_REC *gLogq    = NULL;           /* LOGsvr  ring          */
+unsigned int gLogqMask = 0;
+volatile unsigned int gLogqEnq = 0; /*  enqueue ġ         */
+volatile unsigned int gLogqDeq = 0; /*  dequeue ġ         */
+int  gLogqHigh    = 0;              /* queue depth ִ밪        */
+long gLogqIn      = 0;              /* enqueue  record         */
+long gLogqSent    = 0;              /* LOGsvr  Ϸ          */
+long gLogqDrop    = 0;              /* queue full/ з  record */
+long gLogqFail    = 0;              /* LOGsvr            */
+long gLogqReconn  = 0;              /* LOGsvr  Ƚ        */
+volatile int gLogqSleep = 0;        /* shipping thread     */
+pthread_mutex_t gLogqMtx  = PTHREAD_MUTEX_INITIALIZER;
+pthread_cond_t  gLogqCond = PTHREAD_COND_INITIALIZER;
+
+int  gLtsPoolSize = 0;              /* STKinf.lts.pool (0:û ) */
+LTS_CONN gLtsConn[LTS_MAXCONN];
+LTS_PEND gLtsPend[LTS_MAXPEND];
+int  gLtsMsgID    = 0;              /*  ο msgID         */
+int  gLtsInflight = 0;              /*   request       */
+int  gLtsHigh     = 0;              /* gLtsInflight ִ밪       */
+long gLtsReq      = 0;              /* pool  request         */
+long gLtsDirect   = 0;              /* pool  Ұ   */
+long gLtsTimeout  = 0;              /*   timeout         */
+long gLtsFail     = 0;              /*             */
+long gLtsOrphan   = 0;              /* ڰ          */
+long gLtsReconn   = 0;              /* LTSsvr  Ƚ        */
+time_t gLtsStatTime = 0;
+pthread_mutex_t gLtsMtx = PTHREAD_MUTEX_INITIALIZER;
+
+int  gBcrcOn      = 1;              /* STKinf.bcr.pool (0:read  ) */
+BCR_CONN gBcrc[BCRC_MAX];
+int  gBcrcCnt     = 0;
+long gBcrcFull    = 0;              /* table full    lease */
+int  gBcrConcurrent = 1;            /* STKinf.bcr.concurrent     */
+BCR_READ *gBcrrHead = NULL;         /* read pool  list       */
+BCR_READ *gBcrrTail = NULL;
+int  gBcrrIdle    = 0;              /*  read thread    */
+pthread_mutex_t gBcrrMtx  = PTHREAD_MUTEX_INITIALIZER;
+pthread_cond_t  gBcrrCond = PTHREAD_COND_INITIALIZER;   /* ۾  */
+pthread_cond_t  gBcrrDone = PTHREAD_COND_INITIALIZER;   /* read Ϸ */
+
+int  gRidPoolSize = 8;              /* STKinf.rid.pool.size      */
+RID_CONN gRidPool[RID_MAXPOOL];
+long gRidLease    = 0;              /* lease Ƚ                */
+long gRidWaited   = 0;              /*    ߻         */
+long gRidTimeout  = 0;              /* RID_LEASE_WAIT ʰ       */
+long gRidConn     = 0;              /* Ridian connect Ƚ       */
+long gRidDead     = 0;              /* /       */
+pthread_mutex_t gRidMtx  = PTHREAD_MUTEX_INITIALIZER;
+pthread_cond_t  gRidCond = PTHREAD_COND_INITIALIZER;
+int  gRidPipeline = 1;              /* STKinf.rid.pipeline (1:lease) */
+long gRidPipeReq  = 0;              /* pipeline û           */
+int  gRidPipeHigh = 0;              /*  ִ       */
+long gRidPipeFail = 0;              /* /timeout          */
+long gRidGarbage  = 0;              /* ̰ ٸ           */
+long gRidOrphan   = 0;              /*  request      */
+long gRidDesync   = 0;              /* type ġ     */
+long gRidReset    = 0;              /* timeout       */
+time_t gRidStatTime = 0;
+
+int  gStatMetrics = 0;              /* STKinf.stat.metrics (0:L4 ) */
+signed char gStatSlot[WIRE_MAXTYPE];   /* msgType -> histogram slot */
+char *gStatName[STAT_MAXTYPE];      /* slot  msg label         */
+int  gStatTypes   = 0;              /*  slot           */
+STAT_SHARD *gStatHead = NULL;       /* shard  (߰ )    */
+pthread_key_t gStatKey;             /* thread  shard ݳ  */
+__thread STAT_SHARD *tlStat = NULL; /*  thread  shard      */
+__thread int tlReplyResult = -1;    /*    result */
+int  gStatSock = -1;                /* health/metrics listen socket */
+int  gTraceSlow   = TRACE_SLOW;     /* STKinf.trace.slow (ms, 0:̻) */
+__thread TRACE tlTrace;             /*  thread  û trace */
+pthread_mutex_t gBcrcMtx = PTHREAD_MUTEX_INITIALIZER;
+
+DB_STMT gDbStmt[STMT_MAX] = {
+    [STMT_CST_NAME]       = { "CST_NAME",
+        "SELECT RTRIM(CST_ID) CST_ID, RTRIM(CST_NAME) CST_NAME FROM LTSCST WHERE CST_ID=:v1" },
+    [STMT_LOGICAL_ID]     = { "LOGICAL_ID",
+        "SELECT RTRIM(CST_ID) CST_ID, RTRIM(LOGICAL_ID) LOGICAL_ID, LENGTH(RTRIM(LOGICAL_ID)) L_LENGTH FROM LTSCST WHERE CST_ID=:v1" },
+    [STMT_LOGICAL_EMPTY]  = { "LOGICAL_EMPTY",
+        "SELECT DECODE (LOGICAL_ID, ' ', 'ZZEMPTY-' || CST_ID, LOGICAL_ID) LOGICAL_ID FROM LTSCST WHERE CST_ID = :v1" },
+    [STMT_POD_CST_ID]     = { "POD_CST_ID",
+        "SELECT RTRIM(LOGICAL_ID) CST_ID FROM LTSCST WHERE CST_ID =:v1" },
+    [STMT_IRT_NAME]       = { "IRT_NAME",
+        "SELECT PORT_ID FROM ltsstkportinfo WHERE IRT_ID=:v1" },
+    [STMT_BCR_IP]         = { "BCR_IP",
+        "SELECT A.IRT_ID, B.IP_ADDR, PORT_TYPE FROM LTSSTKPORTINFO A, LTSTERMINAL B "
+        "WHERE  A.PORT_ID = :v1 "
+        "AND A.SCANNER_ID = B.SCANNER_ID" },
+    [STMT_BCR_INFO]       = { "BCR_INFO",
+        "SELECT PORT_ID, PORT_TYPE,SCANNER_ID,STK_ID FROM LTSSTKPORTINFO "
+        "WHERE SCANNER_ID=(SELECT SCANNER_ID FROM LTSTERMINAL WHERE IP_ADDR=:v1)" },
+    [STMT_LOCATION]       = { "LOCATION",
+        "SELECT RTRIM(CST_ID) CST_ID, RTRIM(LOCATION) LOCATION, RTRIM(PORT_ID) PORT_ID FROM LTSCST WHERE CST_ID=:v1" },
+    [STMT_CUR_HIST]       = { "CUR_HIST",
+        "SELECT RTRIM(LOGICAL_ID) LOGICAL_ID, RTRIM(LOCATION) LOCATION FROM LTSINOUT_HIST "
+        "WHERE CST_ID=:v1 "
+        "AND LOCATION=:v2 "
+        "AND BOUND='IN' "
+        "AND CREATE_DATE = (SELECT MAX(CREATE_DATE) FROM LTSINOUT_HIST WHERE CST_ID=:v3)" },
+    [STMT_STK_BY_IP]      = { "STK_BY_IP",
+        "SELECT STK_TYPE, STK_ID FROM LTSSTK WHERE IP_ADDR=:v1" },
+    [STMT_STK_BY_NAME]    = { "STK_BY_NAME",
+        "SELECT STK_TYPE, STK_ID FROM LTSSTK WHERE STK_ID=:v1" },
+    [STMT_TAG_ID]         = { "TAG_ID",
+        "SELECT TAG_ID FROM LTSBCRTAG WHERE BARCODE=:v1" },
+    [STMT_BCR_BY_TAG]     = { "BCR_BY_TAG",
+        "SELECT BARCODE FROM LTSBCRTAG WHERE TAG_ID=:v1" },
+    /*2022.12.05  Bar Code Reading     ϴ  ߻. RTRIM ʿ */
+    [STMT_BCR_BY_LOGICAL] = { "BCR_BY_LOGICAL",
+        "SELECT RTRIM(CST_ID) CST_ID, RTRIM(LOGICAL_ID) LOGICAL_ID FROM LTSLOGICAL WHERE LOGICAL_ID=RTRIM(:v1)" },
+    [STMT_BCRTAG_INS]     = { "BCRTAG_INS",
+        "INSERT INTO LTSBCRTAG VALUES(:v1, :v2, :v3, sysdate)", 1 },
+    /* PORT_ID  :v2 row  д´ (:v1 =  PORT_ID) */
+    [STMT_TOPO_PORT]      = { "TOPO_PORT",
+        "SELECT * FROM (SELECT A.PORT_ID, A.IRT_ID, A.PORT_TYPE, A.SCANNER_ID, A.STK_ID, B.IP_ADDR "
+        "FROM LTSSTKPORTINFO A, LTSTERMINAL B "
+        "WHERE A.PORT_ID > :v1 "
+        "AND A.SCANNER_ID = B.SCANNER_ID(+) "
+        "ORDER BY A.PORT_ID) WHERE ROWNUM <= :v2" },
+    /* LOT , hold, 켱, recipe,   1ȸ ȸ.
+     *  row  ִ 켱/recipe   1 row fetch   ù row */
+    [STMT_LOT_PAGE]       = { "LOT_PAGE",
+        "SELECT A.LOT_ID, RTRIM(A.QTY_1) QUANTITY, "
+        "'['||DECODE(A.LOT_PRIORITY,'8','8','7','7','9','D1','6','D2','5','5',' ')||'] ' LOT_PRI, "
+        "A.OPER OPERATION, "
+        "C.OPER_DESC DESCRIPTION , "
+        "A.RECIPE RECIPEID, A.FLOW BLOCK, B.FLOW_DESC DESCRIPTION2, "
+        "A.LOT_DESC PRODUCT, "
+        "(SELECT MAX(H.HOLD_CODE) FROM MESMGR.MWIPMHDSTS H "
+        "WHERE H.LOT_ID = A.LOT_ID AND H.HOLD_CODE IN ('CUST', 'DMHD')) HOLD_CODE, "
+        "(SELECT SUBSTR(P.PRIORITY,1,2) FROM CERSABNINS P "
+        "WHERE P.LOT_ID = A.LOT_ID AND P.FLOW = A.FLOW AND P.OPER = A.OPER AND ROWNUM = 1) TEMP_COUNT, "
+        "(SELECT RTRIM(R.RES_CMF_25) FROM MRASRESDEF R "
+        "WHERE R.FACTORY = 'AFB1' AND ROWNUM = 1 AND R.RES_ID = "
+        "(SELECT SUBSTR(S.EQ_ID,1,6) FROM LSUSER.LS_EQ_LOT_SEQ_NEW S "
+        "WHERE S.FACILITY = 'AFB1' AND S.LOT_NO = A.LOT_ID AND S.ROUTE = A.FLOW AND S.OPER = A.OPER AND ROWNUM = 1)) NEXT_STK, "
+        "(SELECT L.RECIPE FROM MRCPLOTRCP L WHERE L.LOT_ID = A.LOT_ID AND ROWNUM = 1) RCP_LOT, "
+        "(SELECT M.RECIPE FROM MRCPMFODEF M "
+        "WHERE M.FACTORY = A.FACTORY AND M.OPT_LEVEL = '1' AND M.MAT_ID = A.MAT_ID "
+        "AND M.FLOW = A.FLOW AND M.OPER = A.OPER AND ROWNUM = 1) RCP_MFO1, "
+        "(SELECT M.RECIPE FROM MRCPMFODEF M "
+        "WHERE M.FACTORY = A.FACTORY AND M.OPT_LEVEL = '2' AND M.MAT_ID = ' ' "
+        "AND M.FLOW = A.FLOW AND M.OPER = A.OPER AND ROWNUM = 1) RCP_MFO2, "
+        "(SELECT RTRIM(G.CST_ID) FROM LTSLOGICAL G "
+        "WHERE G.LOGICAL_ID = RTRIM(A.LOT_ID) AND ROWNUM = 1) CST_ID, "
+        "(SELECT TO_CHAR (SYSDATE + NVL(RTRIM(T.CST_CMF_3),0) ,'YYYY/MM/DD') FROM LTSCST T "
+        "WHERE ROWNUM = 1 AND T.CST_ID = "
+        "(SELECT RTRIM(G.CST_ID) FROM LTSLOGICAL G WHERE G.LOGICAL_ID = RTRIM(A.LOT_ID) AND ROWNUM = 1)) NEXT_CLEAN "
+        "FROM MWIPLOTSTS A,MWIPFLWDEF B,MWIPOPRDEF C "
+        "WHERE  A.FLOW = B.FLOW "
+        "AND A.OPER = C.OPER "
+        "AND A.FACTORY=B.FACTORY "
+        "AND A.FACTORY=C.FACTORY "
+        "AND A.LOT_ID = :v1" },
+};
+
+
+
+
+/*****************************************************************************/
+/* 1.Function Name: db_init                                                  */
+/* 2.Description  : SQL text  bind   (SQL  :vN  ִ N)          */
+/* 3.Parameters   : char *msg     - error message                            */
+/* 4.Return Value : true  -                                              */
+/*                  false -                                              */
+/*****************************************************************************/
+int db_init(char *msg)
+{
+    int i, n;
+    char *p;
+
+    gDbStatTime = time(NULL);
+    for(i = 0; i < STMT_MAX; i++){
+        for(p = gDbStmt[i].sql; p != NULL && (p = strchr(p, ':')) != NULL; p++){
+            if((p[1] == 'v' || p[1] == 'V') && (n = atoi(&p[2])) > gDbStmt[i].nbind){
+                gDbStmt[i].nbind = n;
+            }
+        }
+    }
+    return true;
+}
+
+/*****************************************************************************/
+/* 1.Function Name: db_lease                                                 */
+/* 2.Description  :  thread  DB session  ʱȭϿ ش         */
+/*                  helper  session  øؼ  ʴ´                */
+/* 3.Parameters   : None                                                     */
+/* 4.Return Value : DB_SESSION *  - frame  ʱȭ session                */
+/*****************************************************************************/
+DB_SESSION * db_lease()
+{
+    DB_SESSION *dbs = &tlDb;
+
+    /*  helper  SQL//bind   ʵ frame ü ʱȭ */
+    memset( &dbs->sqlframe, 0x00, sizeof(SQLFRAME) );
+    memset( &dbs->bindframe, 0x00, sizeof(BINDFRAME) );
+    dbs->stmt = -1;
+
+    return dbs;
+}
+
+/*****************************************************************************/
+/* 1.Function Name: db_release                                               */
+/* 2.Description  : DB session  , DB_STAT_INTERVAL   log   */
+/* 3.Parameters   : DB_SESSION *dbs - db_lease   session               */
+/* 4.Return Value : None                                                     */
+/*****************************************************************************/
+void db_release(DB_SESSION *dbs)
+{
+    time_t now = time(NULL);
+    time_t last = gDbStatTime;
+
+    if(now - last >= DB_STAT_INTERVAL &&
+       __sync_bool_compare_and_swap(&gDbStatTime, last, now)){
+        db_execStat();
+    }
+}
+
+/*****************************************************************************/
+/* 1.Function Name: db_query                                                 */
+/* 2.Description  : session frame  eDB_query                         */
+/*                  eDB driver  process global frame ϳ ϹǷ     */
+/*                  DB ȣ msg_mtx  ȭǸ ÿ   .   */
+/*                  session  frame غ/ ؼ lock ۿ ϰ     */
+/*                  ̰, lock ȿ  bind   ̸ Ѵ  */
+/* 3.Parameters   : DB_SESSION *dbs - lease  session                       */
+/*                  int cmd         - eDB command                            */
+/*                  int nrow        - fetch row                            */
+/* 4.Return Value : eDB_query                                            */
+/*****************************************************************************/
+int db_query(DB_SESSION *dbs, int cmd, int nrow)
+{
+    int ret_i;
+    struct timespec ts;
+
+    trace_now(&ts);
+    pthread_mutex_lock(&msg_mtx);
+    trace_span("msg_mtx", &ts);
+    db_frameIn(dbs);
+    ret_i = eDB_query( cmd, (char *)0, nrow );
+    db_frameOut(dbs);
+    pthread_mutex_unlock(&msg_mtx);
+
+    return ret_i;
+}
+
+/*****************************************************************************/
+/* 1.Function Name: db_update                                                */
+/* 2.Description  : session frame  eDB_update                        */
+/* 3.Parameters   : DB_SESSION *dbs - lease  session                       */
+/* 4.Return Value : eDB_update                                           */
+/*****************************************************************************/
+int db_update(DB_SESSION *dbs)
+{
+    int ret_i;
+    struct timespec ts;
+
+    trace_now(&ts);
+    pthread_mutex_lock(&msg_mtx);
+    trace_span("msg_mtx", &ts);
+    db_frameIn(dbs);
+    ret_i = eDB_update();
+    db_frameOut(dbs);
+    pthread_mutex_unlock(&msg_mtx);
+
+    return ret_i;
+}
+
+/*****************************************************************************/
+/* 1.Function Name: db_exec                                                  */
+/* 2.Description  : SQL text table  SQL                                */
+/*                  gDbStmt  SQL text  session frame  Ͽ     */
+/* 3.Parameters   : DB_SESSION *dbs - lease  session                       */
+/*                  int stmt        - STMT_xx                                */
+/*                  int nrow        - fetch row                            */
+/* 4.Return Value : eDB_query/eDB_update                                 */
+/*****************************************************************************/
+int db_exec(DB_SESSION *dbs, int stmt, int nrow)
+{
+    DB_STMT *st = &gDbStmt[stmt];
+    struct timespec ts;
+    int ret_i;
+
+    strcpy(dbs->sqlframe.sqlstat_str, st->sql);
+    dbs->stmt = stmt;
+    __sync_fetch_and_add(&st->exec, 1);
+
+    trace_now(&ts);
+    if(st->update){
+        ret_i = db_update(dbs);
+    } else {
+        ret_i = db_query(dbs, SQL_COMMAND, nrow);
+    }
+    trace_span(st->name, &ts);
+    return ret_i;
+}
+
+/*****************************************************************************/
+/* 1.Function Name: db_frameIn                                               */
+/* 2.Description  : session  SQL  statement   bind  eDB global   */
+/*                  frame  Ѵ.    ̹   bind  */
+/*                    (msg_mtx   ȣ)                     */
+/* 3.Parameters   : DB_SESSION *dbs - lease  session                       */
+/* 4.Return Value : None                                                     */
+/*****************************************************************************/
+void db_frameIn(DB_SESSION *dbs)
+{
+    int i, n = (dbs->stmt >= 0) ? gDbStmt[dbs->stmt].nbind : 0;
+
+    strcpy( ga_sqlframe_stt.sqlstat_str, dbs->sqlframe.sqlstat_str );
+    ga_sqlframe_stt.result_str[0] = 0x00;
+    for(i = 0; i < n; i++){
+        strcpy( ga_bindframe_stt.bind_str[i], dbs->bindframe.bind_str[i] );
+    }
+    for(; i < gDbBindUsed; i++){
+        ga_bindframe_stt.bind_str[i][0] = 0x00;
+    }
+    gDbBindUsed = n;
+}
+
+/*****************************************************************************/
+/* 1.Function Name: db_frameOut                                              */
+/* 2.Description  : eDB global  ̸ŭ session   (msg_mtx )  */
+/* 3.Parameters   : DB_SESSION *dbs - lease  session                       */
+/* 4.Return Value : None                                                     */
+/*****************************************************************************/
+void db_frameOut(DB_SESSION *dbs)
+{
+    int len = strlen(ga_sqlframe_stt.result_str);
+
+    if(len >= (int)sizeof(dbs->sqlframe.result_str)){
+        len = sizeof(dbs->sqlframe.result_str) - 1;
+    }
+    memcpy( dbs->sqlframe.result_str, ga_sqlframe_stt.result_str, len );
+    dbs->sqlframe.result_str[len] = 0x00;
+}
+
+/*****************************************************************************/
+/* 1.Function Name: db_execStat                                              */
+/* 2.Description  : SQL text   Ƚ log                                */
+/* 3.Parameters   : None                                                     */
+/* 4.Return Value : None                                                     */
+/*****************************************************************************/
+void db_execStat()
+{
+    int i;
+    char errmsg[BUFSIZ];
+
+    for(i = 0; i < STMT_MAX; i++){
+        if(gDbStmt[i].exec == 0) continue;
+        sprintf(errmsg, "INFO : DB sql[%s] exec[%ld]", gDbStmt[i].name, gDbStmt[i].exec);
+        logMessage(INFO, errmsg);
+    }
+}
+
+/*****************************************************************************/
+/* 1.Function Name: db_fetchRow                                              */
+/* 2.Description  : session result_str  ѹ scan Ͽ column ġ   */
+/*                  row  session buffer  ŰǷ db_release   */
+/*                  ȿϴ.  ų '-'  ϸ NULL         */
+/* 3.Parameters   : DB_SESSION *dbs - db_exec   session              */
+/*                  DB_ROW *row     - column                             */
+/* 4.Return Value : column                                               */
+/*****************************************************************************/
+int db_fetchRow(DB_SESSION *dbs, DB_ROW *row)
+{
+    char *p = dbs->sqlframe.result_str;
+    char *eq, *end;
+    DB_COL *col;
+
+    row->ncol = 0;
+    if(*p != '^') return 0;
+    p++;
+
+    while(*p != 0x00 && row->ncol < DB_MAXCOL){
+        if((eq = strchr(p, '=')) == NULL) break;
+        if((end = strchr(eq + 1, '^')) == NULL) break;
+
+        col = &row->col[row->ncol++];
+        col->name    = p;
+        col->nameLen = eq - p;
+        col->val     = eq + 1;
+        col->len     = end - col->val;
+        col->isNull  = (col->len == 0 || col->val[0] == '-');
+        p = end + 1;
+    }
+    return row->ncol;
+}
+
+/*****************************************************************************/
+/* 1.Function Name: db_fetchNext                                             */
+/* 2.Description  :  row  fetch  result_str   row  scan    */
+/*                  ù column ̸ ٽ ų '^^' ̸  row ̴.  */
+/*                   ߸ row  column  ڶǷ ȣ   */
+/* 3.Parameters   : DB_SESSION *dbs - db_exec   session              */
+/*                  char **pos      - scan ġ (ó ȣ NULL)           */
+/*                  DB_ROW *row     - column                             */
+/* 4.Return Value : column  (0 :  ̻ row )                       */
+/*****************************************************************************/
+int db_fetchNext(DB_SESSION *dbs, char **pos, DB_ROW *row)
+{
+    char *p = (*pos == NULL) ? dbs->sqlframe.result_str : *pos;
+    char *eq, *end;
+    DB_COL *col;
+
+    row->ncol = 0;
+    if(*p == '^') p++;
+
+    while(*p != 0x00 && *p != '^' && row->ncol < DB_MAXCOL){
+        if((eq = strchr(p, '=')) == NULL) break;
+        if((end = strchr(eq + 1, '^')) == NULL) break;
+        if(row->ncol > 0 && eq - p == row->col[0].nameLen &&
+           memcmp(p, row->col[0].name, eq - p) == 0) break;
+
+        col = &row->col[row->ncol++];
+        col->name    = p;
+        col->nameLen = eq - p;
+        col->val     = eq + 1;
+        col->len     = end - col->val;
+        col->isNull  = (col->len == 0 || col->val[0] == '-');
+        p = end + 1;
+    }
+    *pos = p;
+    return row->ncol;
+}
+
+/*****************************************************************************/
+/* 1.Function Name: db_colStr                                                */
+/* 2.Description  : column  ڿ  (NULL/ column  ״)   */
+/* 3.Parameters   : DB_ROW *row     - db_fetchRow                        */
+/*                  int idx         - select  column index               */
+/*                  char *out       -  buffer (MAX_ITEMS ̻)         */
+/* 4.Return Value : DB_COL_OK / DB_COL_NULL / DB_COL_NONE                    */
+/*****************************************************************************/
+int db_colStr(DB_ROW *row, int idx, char *out)
+{
+    DB_COL *col;
+    int len;
+
+    if(idx >= row->ncol) return DB_COL_NONE;
+    col = &row->col[idx];
+    if(col->isNull) return DB_COL_NULL;
+
+    len = (col->len < MAX_ITEMS) ? col->len : MAX_ITEMS - 1;
+    memcpy(out, col->val, len);
+    out[len] = 0x00;
+    return DB_COL_OK;
+}
+
+/*****************************************************************************/
+/* 1.Function Name: topo_start                                               */
+/* 2.Description  : port topology index  load  refresh thread      */
+/*                   load н helper  DB ȸ Ѵ            */
+/* 3.Parameters   : pthread_attr_t *attr -  Ӽ                       */
+/*                  char *msg            - error message                     */
+/* 4.Return Value : 0 - , -1 -                                       */
+/*****************************************************************************/
+int topo_start(pthread_attr_t *attr, char *msg)
+{
+    pthread_t tid;
+
+    if(gTopoRefresh == 0){
+        sprintf(msg, "INFO : port topology index disabled");
+        logMessage(INFO, msg);
+        return 0;
+    }
+    if(topo_load(msg) == false){
+        logMessage(ERROR, msg);
+    }
+    if(pthread_create(&tid, attr, topo_refreshThread, NULL) != 0){
+        sprintf(msg, "ERROR: port topology refresh thread create fail errno[%d]", errno);
+        return -1;
+    }
+    return 0;
+}
+
+/*****************************************************************************/
+/* 1.Function Name: topo_hash                                                */
+/* 2.Description  : topology index hash Լ                                 */
+/* 3.Parameters   : char *key - hash key                                     */
+/* 4.Return Value : bucket index                                             */
+/*****************************************************************************/
+unsigned int topo_hash(char *key)
+{
+    unsigned int h = 5381;
+
+    while(*key != 0x00){
+        h = (h << 5) + h + (unsigned char)*key++;
+    }
+    return h & (TOPO_HASHSIZE - 1);
+}
+
+/*****************************************************************************/
+/* 1.Function Name: topo_lookup                                              */
+/* 2.Description  : snapshot  key  port index ˻                     */
+/* 3.Parameters   : TOPO_INDEX *t - topology snapshot                        */
+/*                  int kind      - TOPO_KEY_xx                              */
+/*                  char *key     - ˻                                   */
+/* 4.Return Value : port index,  -1                                    */
+/*****************************************************************************/
+int topo_lookup(TOPO_INDEX *t, int kind, char *key)
+{
+    int i;
+    char *val;
+
+    for(i = t->head[kind][topo_hash(key)]; i >= 0; i = t->port[i].next[kind]){
+        if(kind == TOPO_KEY_ID)        val = t->port[i].irtID;
+        else if(kind == TOPO_KEY_NAME) val = t->port[i].irtName;
+        else                           val = t->port[i].bcrIP;
+        if(strcmp(val, key) == 0) return i;
+    }
+    return -1;
+}
+
+/*****************************************************************************/
+/* 1.Function Name: topo_link                                                */
+/* 2.Description  : port  key hash chain   ( key  ù row ) */
+/* 3.Parameters   : TOPO_INDEX *t -  snapshot                        */
+/*                  int kind      - TOPO_KEY_xx                              */
+/*                  int idx       - port index                               */
+/*                  char *key     - key                                    */
+/* 4.Return Value : None                                                     */
+/*****************************************************************************/
+void topo_link(TOPO_INDEX *t, int kind, int idx, char *key)
+{
+    unsigned int h;
+
+    if(key[0] == 0x00 || topo_lookup(t, kind, key) >= 0) return;
+    h = topo_hash(key);
+    t->port[idx].next[kind] = t->head[kind][h];
+    t->head[kind][h] = idx;
+}
+
+/*****************************************************************************/
+/* 1.Function Name: topo_colCpy                                              */
+/* 2.Description  : column    field   (NULL  "")         */
+/* 3.Parameters   : DB_ROW *row - db_fetchRow                            */
+/*                  int idx     - column index                               */
+/*                  char *out   -  field                               */
+/*                  int size    - field ũ                                 */
+/* 4.Return Value : None                                                     */
+/*****************************************************************************/
+void topo_colCpy(DB_ROW *row, int idx, char *out, int size)
+{
+    int len = 0;
+
+    if(!DB_ISNULL(row, idx)){
+        len = (row->col[idx].len < size) ? row->col[idx].len : size - 1;
+        memcpy(out, row->col[idx].val, len);
+    }
+    out[len] = 0x00;
+}
+
+/*****************************************************************************/
+/* 1.Function Name: topo_load                                                */
+/* 2.Description  : LTSSTKPORTINFO ü о  snapshot   ü    */
+/*                   snapshot  write lock  reader   Ȯ */
+/*                   Ѵ                                              */
+/* 3.Parameters   : char *errmsg - error message                             */
+/* 4.Return Value : true  -                                              */
+/*                  false -  ( snapshot )                        */
+/*****************************************************************************/
+int topo_load(char *errmsg)
+{
+    TOPO_INDEX *t, *old;
+    TOPO_PORT *p;
+    DB_SESSION *dbs;
+    DB_ROW row;
+    char lastName[30] = " ";
+    char *pos;
+    int  cap = 256;
+    int  ret_i, n, nsel = 0, trunc = 0, done = 0;
+    struct timeval tv1, tv2;
+
+    gettimeofday(&tv1, NULL);
+    if((t = (TOPO_INDEX *)calloc(1, sizeof(TOPO_INDEX))) == NULL ||
+       (t->port = (TOPO_PORT *)calloc(cap, sizeof(TOPO_PORT))) == NULL){
+        sprintf(errmsg, "ERROR: port topology index alloc fail");
+        free(t);
+        return false;
+    }
+    memset(t->head, 0xff, sizeof(t->head));
+
+    /* PORT_ID  TOPO_BATCH row  SELECT. result_str   ߸
+     * row    SELECT    PORT_ID ں д´ */
+    while(done == 0){
+        dbs = db_lease();
+        strcpy( dbs->bindframe.bind_str[0], lastName );
+        sprintf( dbs->bindframe.bind_str[1], "%d", TOPO_BATCH );
+        ret_i = db_exec( dbs, STMT_TOPO_PORT, TOPO_BATCH );
+        pos = NULL;
+        for(n = 0; ret_i > 0 && db_fetchNext(dbs, &pos, &row) >= 6; n++){
+            if(t->nport == TOPO_MAXPORT){
+                trunc = 1;
+                break;
+            }
+            if(t->nport == cap){
+                p = (TOPO_PORT *)realloc(t->port, cap * 2 * sizeof(TOPO_PORT));
+                if(p == NULL){
+                    db_release(dbs);
+                    sprintf(errmsg, "ERROR: port topology index realloc fail PORT[%d]", cap * 2);
+                    free(t->port);
+                    free(t);
+                    return false;
+                }
+                memset(p + cap, 0x00, cap * sizeof(TOPO_PORT));
+                t->port = p;
+                cap *= 2;
+            }
+            /* 0:PORT_ID 1:IRT_ID 2:PORT_TYPE 3:SCANNER_ID 4:STK_ID 5:IP_ADDR */
+            p = &t->port[t->nport];
+            topo_colCpy(&row, 0, p->irtName, sizeof(p->irtName));
+            topo_colCpy(&row, 1, p->irtID, sizeof(p->irtID));
+            topo_colCpy(&row, 2, p->portType, sizeof(p->portType));
+            topo_colCpy(&row, 3, p->bcrName, sizeof(p->bcrName));
+            topo_colCpy(&row, 4, p->stkName, sizeof(p->stkName));
+            topo_colCpy(&row, 5, p->bcrIP, sizeof(p->bcrIP));
+            if(p->irtName[0] == 0x00){
+                memset(p, 0x00, sizeof(TOPO_PORT));
+                continue;
+            }
+            strcpy(lastName, p->irtName);
+            p->next[TOPO_KEY_ID] = p->next[TOPO_KEY_NAME] = p->next[TOPO_KEY_IP] = -1;
+            topo_link(t, TOPO_KEY_ID,   t->nport, p->irtID);
+            topo_link(t, TOPO_KEY_NAME, t->nport, p->irtName);
+            topo_link(t, TOPO_KEY_IP,   t->nport, p->bcrIP);
+            t->nport++;
+        }
+        db_release(dbs);
+        nsel++;
+        if(n == 0 || trunc) done = 1;
+    }
+    if(trunc){
+        sprintf(errmsg, "ERROR: port topology index truncated at TOPO_MAXPORT[%d] LAST PORT[%s]",
+                TOPO_MAXPORT, lastName);
+        logMessage(ERROR, errmsg);
+    }
+    if(t->nport == 0){
+        sprintf(errmsg, "ERROR: port topology index load fail (no port)");
+        free(t->port);
+        free(t);
+        return false;
+    }
+    t->loadTime = time(NULL);
+
+    /* snapshot ü */
+    pthread_rwlock_wrlock(&gTopoLock);
+    old = gTopo;
+    gTopo = t;
+    pthread_rwlock_unlock(&gTopoLock);
+    if(old != NULL){
+        free(old->port);
+        free(old);
+    }
+
+    gettimeofday(&tv2, NULL);
+    sprintf(errmsg, "INFO : port topology index loaded PORT[%d] select[%d] elapsed[%ldms] hit[%ld] miss[%ld] neg[%ld]",
+            t->nport, nsel, (tv2.tv_sec - tv1.tv_sec) * 1000L + (tv2.tv_usec - tv1.tv_usec) / 1000L,
+            gTopoHit, gTopoMiss, gTopoNegHit);
+    logMessage(INFO, errmsg);
+    return true;
+}
+
+/*****************************************************************************/
+/* 1.Function Name: topo_refreshThread                                       */
+/* 2.Description  : STKinf.topo.refresh ֱ Ǵ topo_request  index  */
+/* 3.Parameters   : None                                                     */
+/* 4.Return Value : None                                                     */
+/*****************************************************************************/
+void * topo_refreshThread(void *arg)
+{
+    char errmsg[BUFSIZ];
+    struct timespec ts;
+
+    pthread_detach(pthread_self());
+    while(1){
+        /*  û ͵ TOPO_MINGAP  ̻θ reload */
+        sleep(TOPO_MINGAP);
+
+        pthread_mutex_lock(&gTopoMtx);
+        ts.tv_sec  = time(NULL) + gTopoRefresh - TOPO_MINGAP;
+        ts.tv_nsec = 0;
+        while(gTopoReq == 0){
+            if(pthread_cond_timedwait(&gTopoCond, &gTopoMtx, &ts) == ETIMEDOUT) break;
+        }
+        gTopoReq = 0;
+        pthread_mutex_unlock(&gTopoMtx);
+
+        if(topo_load(errmsg) == false){
+            logMessage(ERROR, errmsg);
+        }
+    }
+    return NULL;
+}
+
+/*****************************************************************************/
+/* 1.Function Name: topo_request                                             */
+/* 2.Description  : index   key ȸ refresh thread  reload û   */
+/* 3.Parameters   : None                                                     */
+/* 4.Return Value : None                                                     */
+/*****************************************************************************/
+void topo_request()
+{
+    pthread_mutex_lock(&gTopoMtx);
+    gTopoReq = 1;
+    pthread_cond_signal(&gTopoCond);
+    pthread_mutex_unlock(&gTopoMtx);
+}
+
+/*****************************************************************************/
+/* 1.Function Name: topo_negCheck                                            */
+/* 2.Description  : index   key  refresh ֱ ȿ ̹ reload     */
+/*                  ûߴ Ȯϰ, ƴϸ û ð Ѵ         */
+/* 3.Parameters   : int kind  - TOPO_KEY_xx                                  */
+/*                  char *key - ˻                                       */
+/* 4.Return Value : true - ֱ û (reload ʿ), false - û ʿ    */
+/*****************************************************************************/
+int topo_negCheck(int kind, char *key)
+{
+    TOPO_NEG *n;
+    time_t now;
+    int ret = false;
+
+    if(strlen(key) >= sizeof(n->key)) return false;
+
+    now = time(NULL);
+    n = &gTopoNeg[(topo_hash(key) + kind) & (TOPO_NEGSIZE - 1)];
+    pthread_mutex_lock(&gTopoMtx);
+    if(n->kind == kind && strcmp(n->key, key) == 0 && now - n->time < gTopoRefresh){
+        ++gTopoNegHit;
+        ret = true;
+    } else {
+        n->kind = kind;
+        strcpy(n->key, key);
+        n->time = now;
+    }
+    pthread_mutex_unlock(&gTopoMtx);
+    return ret;
+}
+
+/*****************************************************************************/
+/* 1.Function Name: topo_find                                                */
+/* 2.Description  :  snapshot  port  ã out  Ѵ          */
+/*                   false  ָ ȣ  DB ȸ ó    */
+/*                  reload  key  refresh ֱ ȿ ѹ ûѴ     */
+/* 3.Parameters   : int kind       - TOPO_KEY_xx                             */
+/*                  char *key      - ˻                                  */
+/*                  TOPO_PORT *out - ã port 纻                        */
+/* 4.Return Value : true - ã, false -                                 */
+/*****************************************************************************/
+int topo_find(int kind, char *key, TOPO_PORT *out)
+{
+    TOPO_INDEX *t;
+    int i = -1;
 
+    pthread_rwlock_rdlock(&gTopoLock);
+    if((t = gTopo) != NULL && (i = topo_lookup(t, kind, key)) >= 0){
+        memcpy(out, &t->port[i], sizeof(TOPO_PORT));
+    }
+    pthread_rwlock_unlock(&gTopoLock);
 
+    if(t == NULL) return false;
+    if(i < 0){
+        __sync_fetch_and_add(&gTopoMiss, 1);
+        if(topo_negCheck(kind, key) == false) topo_request();
+        return false;
+    }
+    __sync_fetch_and_add(&gTopoHit, 1);
+    return true;
+}
 
 /*****************************************************************************/
 /* 1. Function Name: getCstName                                              */
@@ -220,248 +1791,29 @@ int  gReticleParallelMaint = 1;		/* 
 int getCstName(char *bcrID, char *cstName, char *errmsg)
 {
     int ret_i;
-    int l_length = -1;
-    char tmp_str[MAX_ITEMS]={0,};
-    char resultSet[BUFSIZ]={0,};
+    DB_SESSION *dbs;
+    DB_ROW row;
     
-    pthread_mutex_lock(&msg_mtx);	
-    memset( &ga_sqlframe_stt, NULL, sizeof(SQLFRAME) );
-    memset( &ga_bindframe_stt, NULL, sizeof(BINDFRAME) );
-    
-    sprintf(ga_sqlframe_stt.sqlstat_str,
-        "SELECT RTRIM(CST_ID) CST_ID, RTRIM(CST_NAME) CST_NAME FROM LTSCST WHERE CST_ID=:v1");
-
-    strcpy( ga_bindframe_stt.bind_str[0], bcrID );
-    ret_i = eDB_query( SQL_COMMAND, (char *)0, 1 );
-    memcpy(resultSet, ga_sqlframe_stt.result_str, strlen(ga_sqlframe_stt.result_str));
-	pthread_mutex_unlock(&msg_mtx);
+    dbs = db_lease();	
+    strcpy( dbs->bindframe.bind_str[0], bcrID );
+    ret_i = db_exec( dbs, STMT_CST_NAME, 1 );
    
     if( ret_i > 0 ){
-        if(getSubstr(resultSet, "^CST_NAME=", "^", tmp_str) == SUCCESS ){
-            if(tmp_str[0] != '-') {
-                strcpy(cstName, tmp_str);   
-            } else {
-                sprintf(errmsg, "ERROR: CSTID[%s] CST_NAME is null",bcrID);
-                cstName[0] = NULL;
-                return true;
-            }
+        db_fetchRow(dbs, &row);
+        /* 0:CST_ID 1:CST_NAME */
+        if(db_colStr(&row, 1, cstName) == DB_COL_NULL){
+            sprintf(errmsg, "ERROR: CSTID[%s] CST_NAME is null",bcrID);
+            cstName[0] = NULL;
 		}
 	} else {
-        sprintf(errmsg, "ERROR: GetCstName CSTID[%s]::%s", bcrID, resultSet);
+        sprintf(errmsg, "ERROR: GetCstName CSTID[%s]::%s", bcrID, dbs->sqlframe.result_str);
+        db_release(dbs);
         return false;
     }
+    db_release(dbs);
      return true;
 }
 
-int getRecipe (char *lotID, char *recipeID )
-{
-
-  char resultSet[BUFSIZ];
-  char tmp_str[MAX_ITEMS];
-  char Next_EQ[10];
-  char Next_STK[10];
-  char tmp_RCP[20];
-   char errmsg[BUFSIZ]={0,};
-
-  int ret;
-
-  memset(resultSet,0x00, BUFSIZ);
-  memset(tmp_str, 0x00, MAX_ITEMS);
-  memset(Next_EQ, 0x00, 10);
-  memset(Next_STK, 0x00, 10);
-  memset(tmp_RCP, 0x00,20);
-
-  /*Next STK ȸ */
-        pthread_mutex_lock(&msg_mtx);
-        memset( &ga_sqlframe_stt, NULL, sizeof(SQLFRAME) );
-        memset( &ga_bindframe_stt, NULL, sizeof(BINDFRAME) );
-        memset( resultSet, 0x00, sizeof(resultSet) );
-
-        sprintf(ga_sqlframe_stt.sqlstat_str,
-           "SELECT SUBSTR(A.EQ_ID,1,6) AS NEXT_EQ  \
-            FROM \
-            LSUSER.LS_EQ_LOT_SEQ_NEW A, MWIPLOTSTS B \
-            WHERE A.FACILITY = 'AFB1' \
-            AND B.LOT_id = :v1 \
-            AND A.LOT_NO = B.LOT_ID \
-            AND A.ROUTE = B.FLOW \
-            AND A.OPER = B.OPER");
-        
-           
-        strcpy( ga_bindframe_stt.bind_str[0], lotID );
-        ret = eDB_query( SQL_COMMAND, (char *)0, 1 );
-        memcpy(resultSet, ga_sqlframe_stt.result_str, strlen(ga_sqlframe_stt.result_str));
-        pthread_mutex_unlock(&msg_mtx);
-
-        if( ret > 0 ){
-            if( getSubstr(resultSet, "^NEXT_EQ=", "^", tmp_str) == SUCCESS ){
-                if(tmp_str[0] != '-')
-            	    strcpy(Next_EQ, tmp_str);
-                 else
-            	    Next_EQ[0] = NULL;
-            }
-         } else {
-                Next_EQ[0] = NULL;
-                Next_STK[0] = NULL;
-         }
-
-        pthread_mutex_lock(&msg_mtx);
-        memset( &ga_sqlframe_stt, NULL, sizeof(SQLFRAME) );
-        memset( &ga_bindframe_stt, NULL, sizeof(BINDFRAME) );
-        memset( resultSet, 0x00, sizeof(resultSet) );
-
-        sprintf(ga_sqlframe_stt.sqlstat_str,
-          "SELECT RTRIM(RES_CMF_25) AS NEXT_STK \
-           FROM \
-           MRASRESDEF \
-           WHERE \
-           FACTORY = 'AFB1' \
-           AND RES_ID = :v1 ");
-           
-        strcpy( ga_bindframe_stt.bind_str[0], Next_EQ );
-        ret = eDB_query( SQL_COMMAND, (char *)0, 1 );
-        memcpy(resultSet, ga_sqlframe_stt.result_str, strlen(ga_sqlframe_stt.result_str));
-        pthread_mutex_unlock(&msg_mtx);
-
-        if( ret > 0 ){
-            if( getSubstr(resultSet, "^NEXT_STK=", "^", tmp_str) == SUCCESS ){
-                if(tmp_str[0] != '-')
-            	    strcpy(Next_STK, tmp_str);
-                 else
-            	    Next_STK[0] = NULL;
-            }
-         } else {
-                Next_STK[0] = NULL;
-         }
-
-        sprintf(errmsg, "DEBUG: LOT[%s] Next EQ[%s] Next STK[%s]", lotID, Next_EQ, Next_STK);
-        logMessage(DEBUG, errmsg);
-
-
-      /*Next STK ȸ */
-      
-      
-      
-        /*Update Recipe   Ѵٸ Update Recipe Return */
-        pthread_mutex_lock(&msg_mtx);
-        memset( &ga_sqlframe_stt, NULL, sizeof(SQLFRAME) );
-        memset( &ga_bindframe_stt, NULL, sizeof(BINDFRAME) );
-        memset( resultSet, 0x00, sizeof(resultSet) );
-
-        sprintf(ga_sqlframe_stt.sqlstat_str,
-           "SELECT RECIPE FROM MRCPLOTRCP WHERE LOT_ID = :v1");
-           
-        strcpy( ga_bindframe_stt.bind_str[0], lotID );
-        ret = eDB_query( SQL_COMMAND, (char *)0, 1 );
-        memcpy(resultSet, ga_sqlframe_stt.result_str, strlen(ga_sqlframe_stt.result_str));
-        pthread_mutex_unlock(&msg_mtx);
-
-        if( ret > 0 ){
-            if( getSubstr(resultSet, "^RECIPE=", "^", tmp_str) == SUCCESS ){
-                if(tmp_str[0] != '-')
-            	    strcpy(tmp_RCP, tmp_str);
-                 else
-            	    tmp_RCP[0] = NULL;
-            }
-         } else {
-                tmp_RCP[0] = NULL;
-         }
-
-         if(tmp_RCP[0] != NULL){
-            /*Update Recipe   Ѵٸ Update Recipe Return */     
-                if (Next_STK[0] != NULL ){
-                     sprintf (recipeID,"%.20s-%.6s",tmp_RCP, Next_STK);
-                } else {
-                     sprintf (recipeID,"%.20s",tmp_RCP);
-                }
-                 return 1;
-         } 
-        	
-        /* Recipe   Ѵٸ  Recipe Return */
-        pthread_mutex_lock(&msg_mtx);
-        memset( &ga_sqlframe_stt, NULL, sizeof(SQLFRAME) );
-        memset( &ga_bindframe_stt, NULL, sizeof(BINDFRAME) );
-        memset( resultSet, 0x00, sizeof(resultSet) );
-
-        sprintf(ga_sqlframe_stt.sqlstat_str,
-                "SELECT B.RECIPE RECIPE FROM MWIPLOTSTS A, MRCPMFODEF B \
-                 WHERE A.LOT_ID = :v1 \
-                 AND A.FACTORY =B.FACTORY \
-                 AND B.OPT_LEVEL = '1' \
-                 AND A.MAT_ID = B.MAT_ID \
-                 AND A.FLOW = B.FLOW \
-                 AND A.OPER = B.OPER");
-           
-        strcpy( ga_bindframe_stt.bind_str[0], lotID );
-        ret = eDB_query( SQL_COMMAND, (char *)0, 1 );
-        memcpy(resultSet, ga_sqlframe_stt.result_str, strlen(ga_sqlframe_stt.result_str));
-        pthread_mutex_unlock(&msg_mtx);
-
-        if( ret > 0 ){
-            if( getSubstr(resultSet, "^RECIPE=", "^", tmp_str) == SUCCESS ){
-                if(tmp_str[0] != '-')
-            	    strcpy(tmp_RCP, tmp_str);
-                 else
-            	    tmp_RCP[0] = NULL;
-            }
-         } else {
-                tmp_RCP[0] = NULL;
-         }
-
-         if(tmp_RCP[0] != NULL){
-            /* Recipe   Ѵٸ  Recipe Return */     
-                if (Next_STK[0] != NULL ){
-                     sprintf (recipeID,"%.20s-%.6s",tmp_RCP, Next_STK);
-                } else {
-                     sprintf (recipeID,"%.20s",tmp_RCP);
-                }
-                 return 2;
-         } 
-
-        /* Recipe   Ѵٸ  Recipe Return */
-        pthread_mutex_lock(&msg_mtx);
-        memset( &ga_sqlframe_stt, NULL, sizeof(SQLFRAME) );
-        memset( &ga_bindframe_stt, NULL, sizeof(BINDFRAME) );
-        memset( resultSet, 0x00, sizeof(resultSet) );
-
-        sprintf(ga_sqlframe_stt.sqlstat_str,
-                "SELECT B.RECIPE RECIPE FROM MWIPLOTSTS A, MRCPMFODEF B \
-                 WHERE A.LOT_ID = :v1 \
-                 AND A.FACTORY =B.FACTORY \
-                 AND B.OPT_LEVEL = '2' \
-                 AND B.MAT_ID = ' ' \
-                 AND A.FLOW = B.FLOW \
-                 AND A.OPER = B.OPER");
-
-        strcpy( ga_bindframe_stt.bind_str[0], lotID );
-        ret = eDB_query( SQL_COMMAND, (char *)0, 1 );
-        memcpy(resultSet, ga_sqlframe_stt.result_str, strlen(ga_sqlframe_stt.result_str));
-        pthread_mutex_unlock(&msg_mtx);
-
-        if( ret > 0 ){
-            if( getSubstr(resultSet, "^RECIPE=", "^", tmp_str) == SUCCESS ){
-                if(tmp_str[0] != '-')
-            	    strcpy(tmp_RCP, tmp_str);
-                 else
-            	    tmp_RCP[0] = NULL;
-            }
-         } else {
-                tmp_RCP[0] = NULL;
-         }
-
-         if(tmp_RCP[0] != NULL){
-            /*Update Recipe   Ѵٸ  Recipe Return */     
-                if (Next_STK[0] != NULL ){
-                     sprintf (recipeID,"%.20s-%.6s",tmp_RCP, Next_STK);
-                } else {
-                     sprintf (recipeID,"%.20s",tmp_RCP);
-                }
-                 return 3;
-         } 
-         
-         return 0;
-}
-
 /*****************************************************************************/
 /* 1.Function Name: main                                                     */
 /* 2.Description  : HHTinf's main function                                   */
@@ -474,6 +1826,7 @@ void main()
 	int serv_smq;				/* ť ũ    */
 	int ltssvr_smq;				/* LTSsvrť ũ  */
 	int logsvr_smq;				/* LOGsvrť ũ  */
+	int bcr_smq = -1;			/* BCR listen socket (reactor) */
 	int s_port = 0;				/*   Ʈ       */
 	int l_queue = 0;			/*   ť   */
 	int t_max = 0;			    /*  ִ      */
@@ -505,19 +1858,43 @@ void main()
     
     signal(SIGPIPE, SIG_IGN);
 	signal(SIGTERM, signalHandler);
+
+	/*  template  */
+	if ( tpl_init(svr_msg) == false ) {
+		logMessage(ERROR, svr_msg);
+		exit(1);
+	}
+
+	/* û óð histogram ʱȭ */
+	if ( stat_init(svr_msg) == false ) {
+		logMessage(ERROR, svr_msg);
+		exit(1);
+	}
 	
 	/*   ʱȭ */
 	if ( (serv_smq = initSocket_inet(s_port, l_queue, svr_msg) ) == false ) {
 		logMessage(ERROR, svr_msg);
 		exit(1);
 	}
-    /* Health check thread create for L4 */
-    if(createHealthThread(&attr, s_port+5, l_queue, svr_msg) != 0)
+    /* Health check thread create for L4 (+ /metrics) */
+    if(gStatMetrics == 1){
+        if(stat_healthStart(&attr, s_port+5, l_queue, svr_msg) != 0)
+        {
+        	logMessage(ERROR, svr_msg);
+            exit(1);
+        }
+    } else if(createHealthThread(&attr, s_port+5, l_queue, svr_msg) != 0)
     {
     	logMessage(ERROR, svr_msg);
         exit(1);
     }
-    if(createBcrWaitThread(&attr, s_port+3, l_queue, svr_msg) != 0){
+    if(gIoMode == IOMODE_REACTOR){
+        /* reactor mode : BCR listener is owned by the I/O threads */
+        if ( (bcr_smq = initSocket_inet(s_port+3, l_queue, svr_msg) ) == false ) {
+            logMessage(ERROR, svr_msg);
+            exit(1);
+        }
+    } else if(createBcrWaitThread(&attr, s_port+3, l_queue, svr_msg) != 0){
         logMessage(ERROR, svr_msg);
         exit(1);
     }
@@ -527,11 +1904,51 @@ void main()
     	logMessage(ERROR, svr_msg);
         exit(1);
     }
-	sprintf(svr_msg, "INFO : %s μ ⵿Ͽϴ", SERVER_NAME);
-	logMessage(ERROR, svr_msg);
-    
-	/* Ŭ̾ û ó */
-	waitConnection(&attr, serv_smq, lts_file, msg_file, t_max, svr_msg);
+    /* LOGsvr shipping thread create */
+    if(logq_start(&attr, svr_msg) != 0)
+    {
+    	logMessage(ERROR, svr_msg);
+        exit(1);
+    }
+    /* LTSsvr connection pool thread create */
+    if(lts_poolStart(&attr, svr_msg) != 0)
+    {
+    	logMessage(ERROR, svr_msg);
+        exit(1);
+    }
+    /* Ridian connection pool health check thread create */
+    if(rid_poolStart(&attr, svr_msg) != 0)
+    {
+    	logMessage(ERROR, svr_msg);
+        exit(1);
+    }
+    /* port topology index load & refresh thread create */
+    if(topo_start(&attr, svr_msg) != 0)
+    {
+    	logMessage(ERROR, svr_msg);
+        exit(1);
+    }
+    /* barcode read thread pool create (rListUnitAtIrt  BCR/Ridian  ) */
+    if(bcr_readPoolStart(&attr, svr_msg) != 0)
+    {
+    	logMessage(ERROR, svr_msg);
+        exit(1);
+    }
+    /* BCR connection manager thread create (topology  reader  warm-up) */
+    if(bcrc_start(&attr, svr_msg) != 0)
+    {
+    	logMessage(ERROR, svr_msg);
+        exit(1);
+    }
+	sprintf(svr_msg, "INFO : %s μ ⵿Ͽϴ", SERVER_NAME);
+	logMessage(ERROR, svr_msg);
+    
+	/* Ŭ̾ û ó */
+	if(gIoMode == IOMODE_REACTOR){
+	    reactor_run(&attr, serv_smq, bcr_smq, svr_msg);
+	} else {
+	    waitConnection(&attr, serv_smq, lts_file, msg_file, t_max, svr_msg);
+	}
 	logMessage(ERROR, svr_msg);
     
     eDB_disconnect();    		
@@ -694,7 +2111,123 @@ int readConfig(int *sport, int *lqueue, int *tmax,
     		if(gLogLevel < 0){
     		    gLogLevel = 9;
     		}
-    	} 
+    	}
+    	else if (strcmp("STKinf.io.mode", token) == 0) {
+    		gIoMode = (int)strtol(&tmp[strlen(token) + 1], &tail, 0);
+    		if(gIoMode == IOMODE_THREAD){
+    		    printf("INFO : thread per connection mode STKinf start\n");
+    		} else if(gIoMode == IOMODE_REACTOR){
+    		    printf("INFO : reactor mode STKinf start\n");
+    		} else {
+    		    sprintf(msg, "ERROR: STKinf.io.mode [%d] value is invalid", gIoMode);
+    		    return false;
+    		}
+    	}
+    	else if (strcmp("STKinf.io.threads", token) == 0) {
+    		gIoThreads = (int)strtol(&tmp[strlen(token) + 1], &tail, 0);
+    		if(gIoThreads < 1 || gIoThreads > REACTOR_MAXIO){
+    		    sprintf(msg, "ERROR: STKinf.io.threads [%d] value is invalid (1~%d)", gIoThreads, REACTOR_MAXIO);
+    		    return false;
+    		}
+    	}
+    	else if (strcmp("STKinf.handler.threads", token) == 0) {
+    		gHandlerThreads = (int)strtol(&tmp[strlen(token) + 1], &tail, 0);
+    		if(gHandlerThreads < 1 || gHandlerThreads > EXEC_MAXWORKER){
+    		    sprintf(msg, "ERROR: STKinf.handler.threads [%d] value is invalid (1~%d)", gHandlerThreads, EXEC_MAXWORKER);
+    		    return false;
+    		}
+    	}
+    	else if (strcmp("STKinf.handler.queue", token) == 0) {
+    		gHandlerQueue = (int)strtol(&tmp[strlen(token) + 1], &tail, 0);
+    		if(gHandlerQueue < 1){
+    		    sprintf(msg, "ERROR: STKinf.handler.queue [%d] value is invalid", gHandlerQueue);
+    		    return false;
+    		}
+    	}
+    	else if (strcmp("STKinf.lot.prefetch", token) == 0) {
+    		gLotPrefetch = (int)strtol(&tmp[strlen(token) + 1], &tail, 0);
+    		if(gLotPrefetch != 0 && gLotPrefetch != 1){
+    		    sprintf(msg, "ERROR: STKinf.lot.prefetch [%d] value is invalid (0 or 1)", gLotPrefetch);
+    		    return false;
+    		}
+    	}
+    	else if (strcmp("STKinf.lot.cache.size", token) == 0) {
+    		gLotcSize = (int)strtol(&tmp[strlen(token) + 1], &tail, 0);
+    		if(gLotcSize < 0 || gLotcSize > LOTC_MAXSIZE){
+    		    sprintf(msg, "ERROR: STKinf.lot.cache.size [%d] value is invalid (0~%d)", gLotcSize, LOTC_MAXSIZE);
+    		    return false;
+    		}
+    	}
+    	else if (strcmp("STKinf.lot.cache.ttl", token) == 0) {
+    		gLotcTTL = (int)strtol(&tmp[strlen(token) + 1], &tail, 0);
+    		if(gLotcTTL < 1){
+    		    sprintf(msg, "ERROR: STKinf.lot.cache.ttl [%d] value is invalid", gLotcTTL);
+    		    return false;
+    		}
+    	}
+    	else if (strcmp("STKinf.log.queue", token) == 0) {
+    		gLogqSize = (int)strtol(&tmp[strlen(token) + 1], &tail, 0);
+    		if(gLogqSize < 0 || gLogqSize > LOGQ_MAXSIZE){
+    		    sprintf(msg, "ERROR: STKinf.log.queue [%d] value is invalid (0~%d)", gLogqSize, LOGQ_MAXSIZE);
+    		    return false;
+    		}
+    	}
+    	else if (strcmp("STKinf.lts.pool", token) == 0) {
+    		gLtsPoolSize = (int)strtol(&tmp[strlen(token) + 1], &tail, 0);
+    		if(gLtsPoolSize < 0 || gLtsPoolSize > LTS_MAXCONN){
+    		    sprintf(msg, "ERROR: STKinf.lts.pool [%d] value is invalid (0~%d)", gLtsPoolSize, LTS_MAXCONN);
+    		    return false;
+    		}
+    	}
+    	else if (strcmp("STKinf.bcr.pool", token) == 0) {
+    		gBcrcOn = (int)strtol(&tmp[strlen(token) + 1], &tail, 0);
+    		if(gBcrcOn != 0 && gBcrcOn != 1){
+    		    sprintf(msg, "ERROR: STKinf.bcr.pool [%d] value is invalid (0 or 1)", gBcrcOn);
+    		    return false;
+    		}
+    	}
+    	else if (strcmp("STKinf.bcr.concurrent", token) == 0) {
+    		gBcrConcurrent = (int)strtol(&tmp[strlen(token) + 1], &tail, 0);
+    		if(gBcrConcurrent != 0 && gBcrConcurrent != 1){
+    		    sprintf(msg, "ERROR: STKinf.bcr.concurrent [%d] value is invalid (0 or 1)", gBcrConcurrent);
+    		    return false;
+    		}
+    	}
+    	else if (strcmp("STKinf.rid.pool.size", token) == 0) {
+    		gRidPoolSize = (int)strtol(&tmp[strlen(token) + 1], &tail, 0);
+    		if(gRidPoolSize < 1 || gRidPoolSize > RID_MAXPOOL){
+    		    sprintf(msg, "ERROR: STKinf.rid.pool.size [%d] value is invalid (1~%d)", gRidPoolSize, RID_MAXPOOL);
+    		    return false;
+    		}
+    	}
+    	else if (strcmp("STKinf.rid.pipeline", token) == 0) {
+    		gRidPipeline = (int)strtol(&tmp[strlen(token) + 1], &tail, 0);
+    		if(gRidPipeline < 1 || gRidPipeline > RID_MAXPIPE){
+    		    sprintf(msg, "ERROR: STKinf.rid.pipeline [%d] value is invalid (1~%d)", gRidPipeline, RID_MAXPIPE);
+    		    return false;
+    		}
+    	}
+    	else if (strcmp("STKinf.stat.metrics", token) == 0) {
+    		gStatMetrics = (int)strtol(&tmp[strlen(token) + 1], &tail, 0);
+    		if(gStatMetrics != 0 && gStatMetrics != 1){
+    		    sprintf(msg, "ERROR: STKinf.stat.metrics [%d] value is invalid (0 or 1)", gStatMetrics);
+    		    return false;
+    		}
+    	}
+    	else if (strcmp("STKinf.trace.slow", token) == 0) {
+    		gTraceSlow = (int)strtol(&tmp[strlen(token) + 1], &tail, 0);
+    		if(gTraceSlow < 0){
+    		    sprintf(msg, "ERROR: STKinf.trace.slow [%d] value is invalid (>= 0)", gTraceSlow);
+    		    return false;
+    		}
+    	}
+    	else if (strcmp("STKinf.topo.refresh", token) == 0) {
+    		gTopoRefresh = (int)strtol(&tmp[strlen(token) + 1], &tail, 0);
+    		if(gTopoRefresh != 0 && gTopoRefresh < TOPO_MINGAP){
+    		    sprintf(msg, "ERROR: STKinf.topo.refresh [%d] value is invalid (0 or >= %d)", gTopoRefresh, TOPO_MINGAP);
+    		    return false;
+    		}
+    	}
 		else {
 			sprintf(msg, "ERROR:  ʴ ȯ溯 [%s] Ǿϴ", token);
 			return false;
@@ -704,6 +2237,15 @@ int readConfig(int *sport, int *lqueue, int *tmax,
 	/* ȯ ݱ */
 	fclose(fp);
 
+	/* DB SQL text table ʱȭ */
+	if(db_init(msg) == false){
+	    return false;
+	}
+	/* LOT page cache  */
+	if(lotc_init(gLotcSize, msg) == false){
+	    return false;
+	}
+
 	/* ó ȯ */
 	return true;
 }
@@ -767,19 +2309,16 @@ void waitConnection(pthread_attr_t *attr, int sockfd,
         logMessage(INFO, msg);
         
 		/* û ó   */
-		while (thread_cnt >= tmax) usleep(10000);
+		/* slot  ȯ       */
+		stk_admit(tmax, stkIP);
 		if ( pthread_create(&tinfo->msg_tid, attr, stkMsgThread, (void *)tinfo) != 0 ) {
 			sprintf(msg, "ERROR: STKIP[%s] new thread create fail",stkIP);
 			logMessage(ERROR, msg);
 			close(tinfo->clnt_sockfd);
 			free(tinfo);
+			stk_leave();
 			continue;
 		}
-
-		/*    */
-		pthread_mutex_lock(&cnt_mtx);
-		++thread_cnt;
-		pthread_mutex_unlock(&cnt_mtx);
 	}
 }
 
@@ -909,81 +2448,40 @@ void * bcrMsgThread(void * arg)
     MSG_THREAD_INFO *tinfo = (MSG_THREAD_INFO *)arg;
     
     int n_bcrRecv;
-    int ret,ltsresult;
-    int stkType;
+    int ret;
+    STK_PROFILE prof;
     char errmsg[BUFSIZ]={0,};
     char cstID[12]={0,};
-    char ltsSendBuf[BUFSIZ]={0,};
-    char ltsRecvBuf[BUFSIZ]={0,};
     char *bcrIP = NULL;
     char stkName[24]={0,};
     char bcrName[24]={0,};
     char portName[24]={0,};
-    char logicalID[24]={0,};
-    char tmpPortName[24]={0,};
-    char portType[2]={0,};
-    char location[24]={0,};
     
     struct timeval waittime;
     fd_set r_set;
     
     sleep(1);
-    waittime.tv_sec =  10;
+    waittime.tv_sec =  BCR_RECV_TIMEOUT;
     waittime.tv_usec = 0;
     
     pthread_cleanup_push(freeThreadInfo, tinfo);
     bcrIP = inet_ntoa(((struct sockaddr_in*)(&tinfo->clnt_addr))->sin_addr);
     
-    if(GetBcrInfoByBcrIP(bcrIP, stkName, bcrName, portName, portType, errmsg) == false){
-        logMessage(ERROR, errmsg);
-    } else {
-        if(portType[0] != 'O'){
-            sprintf(errmsg, "ERROR: STK[%s] PORT[%s] BCR[%s] IP[%s] port type is not output",stkName, portName, bcrName, bcrIP);
+    if(bcr_getOutputPort(bcrIP, stkName, bcrName, portName, &prof, errmsg) == true){
+        FD_ZERO(&r_set);
+        FD_SET(tinfo->clnt_sockfd,&r_set);
+        ret = select(tinfo->clnt_sockfd + 1, &r_set, NULL, NULL, &waittime);
+        
+        if(ret == -1){
+            sprintf(errmsg,"ERROR: STK[%s] PORT[%s] BCR[%s] IP[%s] select func error",stkName, portName, bcrName, bcrIP);
+            logMessage(ERROR, errmsg);
+        } else if( ret == 0){
+            sprintf(errmsg,"ERROR: STK[%s] PORT[%s] BCR[%s] IP[%s] recv timeout", stkName, portName, bcrName, bcrIP);
             logMessage(ERROR, errmsg);
         } else {
-            stkType = GetStkTypeByStkName(stkName, errmsg);
-            if(stkType == false){
-                logMessage(ERROR, errmsg);
-            } else {
-                FD_ZERO(&r_set);
-                FD_SET(tinfo->clnt_sockfd,&r_set);
-                ret = select(tinfo->clnt_sockfd + 1, &r_set, NULL, NULL, &waittime);
-                
-                if(ret == -1){
-                    sprintf(errmsg,"ERROR: STK[%s] PORT[%s] BCR[%s] IP[%s] select func error",stkName, portName, bcrName, bcrIP);
-                    logMessage(ERROR, errmsg);
-                } else if( ret == 0){
-                    sprintf(errmsg,"ERROR: STK[%s] PORT[%s] BCR[%s] IP[%s] recv timeout", stkName, portName, bcrName, bcrIP);
-                    logMessage(ERROR, errmsg);
-                } else {
-                    if(FD_ISSET(tinfo->clnt_sockfd, &r_set)) {
-                        n_bcrRecv = read(tinfo->clnt_sockfd, cstID, sizeof(cstID));
-                        if(n_bcrRecv == 7 && strlen(cstID) == 6){
-                            if(GetLogicalIDByBcrID(cstID, logicalID, errmsg) == false){
-                            } else {
-                                if(logicalID[0] == NULL){
-                                    sprintf(errmsg, "ERROR: STK[%s] PORT[%s] BCR[%s] IP[%s] CST[%s] empty cstID can't output",
-                                                        stkName, portName, bcrName, bcrIP, cstID);
-                                    logMessage(ERROR, errmsg);                                                    
-                                } else {
-                                    if(GetLocationByBcrID(cstID, location, tmpPortName, errmsg) == true){
-                                        if(location[0] == NULL){
-                                            logMessage(ERROR, errmsg);
-                                        } else {
-                                            if(lts_outputRequest(stkType, stkName, cstID, logicalID, portName, errmsg) == false){
-                                                logMessage(ERROR, errmsg);
-                                            }
-                                        }
-                                    }
-                                }
-                            }
-                        } else {
-                            sprintf(errmsg, "ERROR: STK[%s] PORT[%s] BCR[%s] IP[%s] RECV[%s] wrong data recv",
-                                                stkName, portName, bcrName, bcrIP, cstID);
-                            logMessage(ERROR, errmsg);                                            
-                        }
-                    }
-                }
+            if(FD_ISSET(tinfo->clnt_sockfd, &r_set)) {
+                n_bcrRecv = read(tinfo->clnt_sockfd, cstID, sizeof(cstID));
+                bcr_outputRequest(bcrIP, stkName, bcrName, portName, &prof, cstID, n_bcrRecv, errmsg);
             }
         }
     }
@@ -994,6 +2492,85 @@ void * bcrMsgThread(void * arg)
 	pthread_cleanup_pop(1);
 }
 
+/*****************************************************************************/
+/* 1.Function Name: bcr_getOutputPort                                        */
+/* 2.Description  : BCR IP  output port  STK type ȸ                   */
+/* 3.Parameters   : char *bcrIP    - BCR IP                                  */
+/*                  STK_PROFILE *prof - STK profile                          */
+/*                  char *bcrName  - BCR name                                */
+/*                  char *portName - port name                               */
+/*                  char *errmsg   - Error Message                           */
+/* 4.Return Value : int                                                      */
+/*****************************************************************************/
+int bcr_getOutputPort(char *bcrIP, char *stkName, char *bcrName, char *portName, STK_PROFILE *prof, char *errmsg)
+{
+    char portType[2]={0,};
+    
+    if(GetBcrInfoByBcrIP(bcrIP, stkName, bcrName, portName, portType, errmsg) == false){
+        logMessage(ERROR, errmsg);
+        return false;
+    }
+    if(portType[0] != 'O'){
+        sprintf(errmsg, "ERROR: STK[%s] PORT[%s] BCR[%s] IP[%s] port type is not output",stkName, portName, bcrName, bcrIP);
+        logMessage(ERROR, errmsg);
+        return false;
+    }
+    if(stk_buildProfile(stkName, prof, errmsg) == false){
+        logMessage(ERROR, errmsg);
+        return false;
+    }
+    return true;
+}
+
+/*****************************************************************************/
+/* 1.Function Name: bcr_outputRequest                                        */
+/* 2.Description  : output port BCR   cassette  output ó          */
+/* 3.Parameters   : char *bcrIP    - BCR IP                                  */
+/*                  char *stkName  - STK name                                */
+/*                  char *bcrName  - BCR name                                */
+/*                  char *portName - port name                               */
+/*                  STK_PROFILE *prof - STK profile                          */
+/*                  char *cstID    - BCR  data                           */
+/*                  int  n_bcrRecv - BCR                             */
+/*                  char *errmsg   - Error Message                           */
+/* 4.Return Value : int                                                      */
+/*****************************************************************************/
+int bcr_outputRequest(char *bcrIP, char *stkName, char *bcrName, char *portName, STK_PROFILE *prof,
+                      char *cstID, int n_bcrRecv, char *errmsg)
+{
+    char logicalID[24]={0,};
+    char tmpPortName[24]={0,};
+    char location[24]={0,};
+    
+    if(n_bcrRecv != BCRLEN || strlen(cstID) != BCRLEN - 1){
+        sprintf(errmsg, "ERROR: STK[%s] PORT[%s] BCR[%s] IP[%s] RECV[%s] wrong data recv",
+                            stkName, portName, bcrName, bcrIP, cstID);
+        logMessage(ERROR, errmsg);
+        return false;
+    }
+    if(GetLogicalIDByBcrID(cstID, logicalID, errmsg) == false){
+        return false;
+    }
+    if(logicalID[0] == NULL){
+        sprintf(errmsg, "ERROR: STK[%s] PORT[%s] BCR[%s] IP[%s] CST[%s] empty cstID can't output",
+                            stkName, portName, bcrName, bcrIP, cstID);
+        logMessage(ERROR, errmsg);
+        return false;
+    }
+    if(GetLocationByBcrID(cstID, location, tmpPortName, errmsg) == true){
+        if(location[0] == NULL){
+            logMessage(ERROR, errmsg);
+            return false;
+        }
+        if(lts_outputRequest(prof, cstID, logicalID, portName, errmsg) == false){
+            logMessage(ERROR, errmsg);
+            return false;
+        }
+        return true;
+    }
+    return false;
+}
+
 /*****************************************************************************/
 /* 1.Function Name: stkMsgThread                                            */
 /* 2.Description  : Client Message Handling                                  */
@@ -1003,533 +2580,1261 @@ void * bcrMsgThread(void * arg)
 void * stkMsgThread(void * arg)
 {
     MSG_THREAD_INFO *tinfo = (MSG_THREAD_INFO *)arg;
+    STK_SESSION sess;
+    FRAME_RD rd;
     
-    int  stkType;
     int  n_stkrecv;
     char recvBuf[BUFSIZ]={0,};
     char errmsg[BUFSIZ]={0,};
-    char lotInfo[32*6]={0,};
-    char useTag;
-    char *stkIP;
-    char stkName[15]={0,};
-    int  endFlag = 0;
-    int  ridsock = -1;
            
     pthread_cleanup_push(freeThreadInfo, tinfo);
     
     sleep(1);
-    stkIP = inet_ntoa(((struct sockaddr_in*)(&tinfo->clnt_addr))->sin_addr);
+    stk_initSession(&sess, IOKIND_STK, tinfo->clnt_sockfd,
+                    inet_ntoa(((struct sockaddr_in*)(&tinfo->clnt_addr))->sin_addr));
+    frm_init(&rd, tinfo->clnt_sockfd, 1, 0, sizeof(sess.rbuf), sess.rbuf, sizeof(sess.rbuf), sess.stkName);
     
-    memset(stkName, 0x00, sizeof(stkName));
     memset(errmsg,  0x00, BUFSIZ);
     
     while(1){
-        if(endFlag == 1){
-            sprintf(errmsg,"INFO : STK[%s] is close request", stkName);
+        if(sess.endFlag == 1){
+            sprintf(errmsg,"INFO : STK[%s] is close request", sess.stkName);
             logMessage(INFO, errmsg);
             break;
         }
-        if (tinfo->clnt_sockfd < 0 || endFlag == 1) {
-            sprintf(errmsg,"ERROR: STK[%s] is disconnect",stkName);
+        if (tinfo->clnt_sockfd < 0 || sess.endFlag == 1) {
+            sprintf(errmsg,"ERROR: STK[%s] is disconnect",sess.stkName);
             logMessage(ERROR, errmsg);
             break;
         }
         memset(recvBuf, 0x00, BUFSIZ);
-        n_stkrecv = stk_recv(tinfo->clnt_sockfd, recvBuf, stkName, errmsg);
+        n_stkrecv = stk_recv(&rd, recvBuf, sess.stkName, errmsg);
         if( n_stkrecv < 0 ){
-            sprintf(errmsg,"ERROR: STK[%s] is recv error", stkName);
+            sprintf(errmsg,"ERROR: STK[%s] is recv error", sess.stkName);
             logMessage(ERROR, errmsg);
-            endFlag = 1;
+            sess.endFlag = 1;
             break;
     	} else if(n_stkrecv == 0){
-    		sprintf(errmsg,"ERROR: STK[%s] is recv time out",stkName);
+    		sprintf(errmsg,"ERROR: STK[%s] is recv time out",sess.stkName);
             logMessage(ERROR, errmsg);
-    		endFlag = 1;
+    		sess.endFlag = 1;
     		break;
     	} else {
-        	switch(recvBuf[TYPEBYTE]){
-            	case msgTypeConnectRequest :
-                {
-                    if(stk_rConnect(tinfo->clnt_sockfd, recvBuf, stkName, errmsg) == false){
-                        sprintf(errmsg, "ERROR: STK[%s] stk_rConnect error",stkName);
-                        logMessage(ERROR, errmsg);
-                        endFlag = 1;
-                        break;
-                    } else {
-                        stkType = GetStkTypeByStkName(stkName, errmsg);
-                        if(stkType == false){
-                            logMessage(ERROR, errmsg);
-                            endFlag = 1;
-                            break;
-                        } else {
-                            if(stkType == LOTPODTYPE && gLotParallelMaint == 1){
-                                if(ridsock > -1){
-                                    close(ridsock);
-                                }
-                                ridsock = rid_connect(stkName);
-                                if(ridsock == false){
-                                    ridsock = rid_connect(stkName);
-                                    if(ridsock == false){
-                                        sprintf(errmsg, "ERROR: STK[%s] ridian reconnect fail errno[%d]",stkName,errno);
-                                        logMessage(INFO, errmsg);
-                                        ridsock = -1;
-                                        endFlag = 1;
-                                        break;
-                                    } else {
-                                        sprintf(errmsg, "INFO : STK[%s] ridian reconnect success sock[%d]",stkName,ridsock);
-                                        logMessage(INFO, errmsg);
-                                        break;
-                                    }
-                                }
-                                break;
-                            } else if(stkType != LOTPODTYPE && gReticleParallelMaint == 1){
-                                if(ridsock > -1){
-                                    close(ridsock);
-                                }
-                                ridsock = rid_connect(stkName);
-                                if(ridsock == false){
-                                    ridsock = rid_connect(stkName);
-                                    if(ridsock == false){
-                                        sprintf(errmsg, "ERROR: STK[%s] ridian reconnect fail errno[%d]",stkName,errno);
-                                        logMessage(INFO, errmsg);
-                                        ridsock = -1;
-                                        endFlag = 1;
-                                        break;
-                                    } else {
-                                        sprintf(errmsg, "INFO : STK[%s] ridian reconnect success sock[%d]",stkName,ridsock);
-                                        logMessage(INFO, errmsg);
-                                        break;
-                                    }
-                                }
-                                break;
-                            }                            
-                        }
-                    }
-                    break;
-                }
-                case msgTypeCloseRequest :
-                {
-                    if(stk_rClose(tinfo->clnt_sockfd, recvBuf, stkName, errmsg) == false){
-                        sprintf(errmsg, "ERROR: STK[%s] stk_rClose error",stkName);
-                        logMessage(ERROR, errmsg);
-                        endFlag = 1;
-                        break;
-                    }else {
-                        sprintf(errmsg,"INFO : STK[%s] is normal disconnect ok...",stkName);
-                        logMessage(ERROR, errmsg);
-                        endFlag = 1;
-                        break;
-                    }
-                    if(stkType == LOTPODTYPE && gLotParallelMaint == 1){
-                        close(ridsock);
-                        ridsock = -1;
-                        sprintf(errmsg, "DEBUG: STK[%s] ridian socket close success", stkName);
-                        logMessage(DEBUG, errmsg);
-                        break;
-                    } else if(stkType != LOTPODTYPE && gReticleParallelMaint == 1){
-                        close(ridsock);
-                        ridsock = -1;
-                        sprintf(errmsg, "DEBUG: STK[%s] ridian socket close success", stkName);
-                        logMessage(DEBUG, errmsg);
-                        break;
-                    }
-                    break;
-                }
-                case msgTypePTLSensor :
-                {
-                    if(stk_rPhysicalToLogicalSensor(tinfo->clnt_sockfd, recvBuf, stkName, errmsg) == false){
-                        sprintf(errmsg, "ERROR: STK[%s] stk_rPhysicalToLogicalSensor error",stkName);
-                        logMessage(ERROR, errmsg);
-                        endFlag = 1;
-                    } 
-                    break;
-                }            
-                case msgTypeQuerySensorLoc :
-                {    
-                    if(stk_rListUnitAtIrt(tinfo->clnt_sockfd, &ridsock, recvBuf, stkName, stkType, errmsg) == false) {
-                        sprintf(errmsg, "ERROR: STK[%s] stk_rListUnitAtIrt ridian socket fail",stkName);
-                        logMessage(ERROR, errmsg);
-                        if(stkType == LOTPODTYPE && gLotParallelMaint == 1){
-                            if(ridsock > -1){
-                                close(ridsock); 
-                                ridsock = -1;   
-                                sprintf(errmsg, "DEBUG: STK[%s] ridian socket close success", stkName);
-                                logMessage(DEBUG, errmsg);                              
-                            }
-                        } else if(stkType != LOTPODTYPE && gReticleParallelMaint == 1){
-                            if(ridsock > -1){
-                                close(ridsock);
-                                ridsock = -1; 
-                                sprintf(errmsg, "DEBUG: STK[%s] ridian socket close success", stkName);
-                                logMessage(DEBUG, errmsg);                                
-                            }
-                        }
-                        endFlag = 1;
-                    }
-                    break;
-                }
-                case msgTypeReadMemory :
-                {
-                    if(stk_rReadMemory(tinfo->clnt_sockfd, recvBuf, stkName, stkType, lotInfo, errmsg) == false){
-                        sprintf(errmsg, "ERROR: STK[%s] stk_rReadMemory error",stkName);
-                        logMessage(ERROR, errmsg);
-                        endFlag = 1;
-                    }
-                    break;
-                }
-                
-                case msgTypeAssociateUnit :
-                {            
-                    if(stk_rAssociateUnit(tinfo->clnt_sockfd, &ridsock, recvBuf, stkName, stkType, errmsg) == false){
-                        sprintf(errmsg, "ERROR: STK[%s] stk_rAssociateUnit ridian socket fail",stkName);
-                        logMessage(ERROR, errmsg);
-                        if(stkType == LOTPODTYPE && gLotParallelMaint == 1){
-                            if(ridsock != -1){
-                                close(ridsock);
-                                ridsock = -1;   
-                                sprintf(errmsg, "DEBUG: STK[%s] ridian socket close success", stkName);
-                                logMessage(DEBUG, errmsg);                                
-                            }
-                        } else if(stkType != LOTPODTYPE && gReticleParallelMaint == 1){
-                            if(ridsock != -1){
-                                close(ridsock);
-                                ridsock = -1;  
-                                sprintf(errmsg, "DEBUG: STK[%s] ridian socket close success", stkName);
-                                logMessage(DEBUG, errmsg);                                 
-                            }
-                        }
-                        endFlag = 1;
-                    }
-                    break;
-                }
-                case msgTypeDisassociateUnit :
-                {
-                    if(stk_rDisassociateUnit(tinfo->clnt_sockfd, &ridsock, recvBuf, stkName, stkType, errmsg) == false){
-                        sprintf(errmsg, "ERROR: STK[%s] stk_rDisassociateUnit ridian socket fail",stkName);
-                        logMessage(ERROR, errmsg);
-                        if(stkType == LOTPODTYPE && gLotParallelMaint == 1){
-                            if(ridsock != -1){
-                                close(ridsock); 
-                                ridsock = -1;  
-                                sprintf(errmsg, "DEBUG: STK[%s] ridian socket close success", stkName);
-                                logMessage(DEBUG, errmsg);                                
-                            }
-                        } else if(stkType != LOTPODTYPE && gReticleParallelMaint == 1){
-                            if(ridsock != -1){
-                                close(ridsock);  
-                                ridsock = -1; 
-                                sprintf(errmsg, "DEBUG: STK[%s] ridian socket close success", stkName);
-                                logMessage(DEBUG, errmsg);                                
-                            }
-                        }
-                        endFlag = 1;
-                    }
-                    break;
-                }
-    
-                case msgTypeDisplayMsg :
-                {
-                    if(stk_rDisplayMsg(tinfo->clnt_sockfd, &ridsock, recvBuf, stkName, stkType, errmsg) == false){
-                        sprintf(errmsg, "ERROR: STK[%s] stk_rDisplayMsg ridian socket fail",stkName);
-                        logMessage(ERROR, errmsg);
-                        if(stkType == LOTPODTYPE && gLotParallelMaint == 1){
-                            if(ridsock != -1){
-                                close(ridsock);  
-                                ridsock = -1;   
-                                sprintf(errmsg, "DEBUG: STK[%s] ridian socket close success", stkName);
-                                logMessage(DEBUG, errmsg);                              
-                            }
-                        } else if(stkType != LOTPODTYPE && gReticleParallelMaint == 1){
-                            if(ridsock != -1){
-                                close(ridsock); 
-                                sprintf(errmsg, "DEBUG: STK[%s] ridian socket close success", stkName);
-                                logMessage(DEBUG, errmsg); 
-                                ridsock = -1;                                 
-                            }
-                        }
-                        endFlag = 1;
-                    }
-                    break;
-                }
-                
-                default :
-                {
-                    endFlag = 1;
-                    sprintf(errmsg, "ERROR: STK[%s] unknwon message recv type[%d]", stkIP, recvBuf[TYPEBYTE]);
-                    logMessage(ERROR, errmsg);
-                    break;
-                }
-            }
+    	    stk_dispatchMsg(&sess, recvBuf, errmsg);
         }
     }
-    if(ridsock != -1){
-        close(ridsock);
-        sprintf(errmsg, "DEBUG: STK[%s] ridian socket close success and thread destroy", stkName);
-        logMessage(DEBUG, errmsg);
-    }
-    
-    pthread_mutex_lock(&cnt_mtx);
-	--thread_cnt;
-	pthread_mutex_unlock(&cnt_mtx);
-	sprintf(errmsg, "DEBUG: STK[%s] thread destroy thread cnt[%d] decrease", stkName, thread_cnt);
+    stk_leave();
+	sprintf(errmsg, "DEBUG: STK[%s] thread destroy thread cnt[%d] decrease", sess.stkName, thread_cnt);
     logMessage(DEBUG, errmsg);
 	/* ڿ  ڵ鷯 ߺ   */
 	pthread_setcanceltype(PTHREAD_CANCEL_DEFERRED, NULL);
-    sprintf(errmsg, "DEBUG: STK[%s] ڿ  ڵ鷯 ߺ  ", stkName);
+    sprintf(errmsg, "DEBUG: STK[%s] ڿ  ڵ鷯 ߺ  ", sess.stkName);
     logMessage(DEBUG, errmsg);
 	/* ڿ  ڵ鷯  */
 	pthread_cleanup_pop(1);
     
-	sprintf(errmsg, "DEBUG: STK[%s] all socket close success and thread destroy", stkName);
+	sprintf(errmsg, "DEBUG: STK[%s] all socket close success and thread destroy", sess.stkName);
     logMessage(DEBUG, errmsg);
 }
 
 /*****************************************************************************/
-/* 1. Function Name: stk_rConnect                                            */
-/* 2. Description  : STK connect û ó                                   */
-/* 3. Parameters   : int   csock     - Client  ũ                */
-/*                   char* recvBuf   - recv  ޼                        */
-/*                   char* stkName   - STK name                              */
-/*                   char* errMsg    - Error Message                         */
-/* 4. Return Value : int                                                     */
+/* 1.Function Name: stk_initSession                                          */
+/* 2.Description  : STK session initialize                                   */
+/* 3.Parameters   : STK_SESSION *sess - session                              */
+/*                  int kind          - IOKIND_xxx                           */
+/*                  int sock          - client socket                        */
+/*                  char *ip          - client IP                            */
+/* 4.Return Value : None                                                     */
 /*****************************************************************************/
-int stk_rConnect(int csock, char *recvBuf, char *stkName, char *errmsg) 
+void stk_initSession(STK_SESSION *sess, int kind, int sock, char *ip)
 {
-    rConnectRequest treq, *req;
-    req = &treq;
-    memset(req, 0x00, sizeof(rConnectRequest));
-    memcpy(req, recvBuf, sizeof(rConnectRequest));
-    
-    memcpy(stkName, req->name,1);
-    memcpy(&stkName[1], &req->name[2], 5);
+    memset(sess, 0x00, sizeof(STK_SESSION));
+    sess->kind     = kind;
+    sess->csock    = sock;
+    sess->lastRecv = time(NULL);
+    if(ip != NULL){
+        strncpy(sess->stkIP, ip, sizeof(sess->stkIP) - 1);
+    }
+}
 
-    sprintf(errmsg,"INFO : STK[%s] rConnect start ", stkName);
-    logMessage(INFO, errmsg);
-    
-    stk_rConnect_hton(req);
-    if(stk_RecvLogSvr((void*)req ,req->msgType, stkName, errmsg, true) == -1){
-        sprintf(errmsg,"ERROR: STK[%s] rConnect recv log transfer fail", stkName);
-        logMessage(ERROR, errmsg);
-    }
-    
-    rConnectReply trep, *rep;
-    rep = &trep;
-    memset(rep,0x00,sizeof(rConnectReply));
-    rep->msgLen	    = sizeof(rConnectReply);
-    rep->msgLen     = bigToLitts(rep->msgLen);
-	rep->msgType	= msgTypeConnectRequest;
-	rep->result	    = bigToLitts(0);
-	rep->major	    = bigToLitts(2);
-	rep->minor	    = bigToLitts(5);
-	rep->byteOrder  = req->byteOrder;
-	rep->bitOrder	= req->bitOrder;
-	rep->point	    = bigToLitts(0);
-	
-	if(write(csock,(void*)rep, sizeof(rConnectReply)) <= 0){
-	    sprintf(errmsg,"ERROR: STK[%s] disconnet network...",stkName);
-	    logMessage(ERROR, errmsg);
-	    return false;
-	}
-	stk_rConnect_ntoh(rep);
-	if(stk_SendLogSvr((void*)rep ,rep->msgType, stkName, errmsg, true) == -1){
-	    sprintf(errmsg,"ERROR: STK[%s] rConnect send log transfer fail",stkName);
+/*****************************************************************************/
+/* 1.Function Name: stk_dispatchMsg                                          */
+/* 2.Description  : STK recv message dispatch (thread/reactor )          */
+/* 3.Parameters   : STK_SESSION *sess - session                              */
+/*                  char *recvBuf     - recv  ޼                       */
+/*                  char *errmsg      - Error Message                        */
+/* 4.Return Value : int - session endFlag                                    */
+/*****************************************************************************/
+int stk_dispatchMsg(STK_SESSION *sess, char *recvBuf, char *errmsg)
+{
+    STK_VIEW view, *v = &view;
+    struct timespec t0;
+
+    if(view_open(v, recvBuf, errmsg) == false){
+        sprintf(errmsg, "ERROR: STK[%s] invalid message LEN[%d] TYPE[%d]", sess->stkIP, v->len, recvBuf[TYPEBYTE]);
         logMessage(ERROR, errmsg);
+        sess->endFlag = 1;
+        return sess->endFlag;
+    }
+    clock_gettime(CLOCK_MONOTONIC, &t0);
+    tlReplyResult = -1;
+    trace_begin(&t0);
+    switch(v->type){
+    	case msgTypeConnectRequest :
+        {
+            if(stk_rConnect(sess->csock, v, sess->stkName, errmsg) == false){
+                sprintf(errmsg, "ERROR: STK[%s] stk_rConnect error",sess->stkName);
+                logMessage(ERROR, errmsg);
+                sess->endFlag = 1;
+                break;
+            } else {
+                if(stk_buildProfile(sess->stkName, &sess->prof, errmsg) == false){
+                    logMessage(ERROR, errmsg);
+                    sess->endFlag = 1;
+                    break;
+                } else {
+                    /* Ridian  process  pool  ,   θ Ȯ */
+                    if(sess->prof.parallel == 1 && rid_check(sess->stkName) == false){
+                        sprintf(errmsg, "ERROR: STK[%s] ridian connect fail errno[%d]",sess->stkName,errno);
+                        logMessage(INFO, errmsg);
+                        sess->endFlag = 1;
+                        break;
+                    }
+                }
+            }
+            break;
+        }
+        case msgTypeCloseRequest :
+        {
+            if(stk_rClose(sess->csock, v, sess->stkName, errmsg) == false){
+                sprintf(errmsg, "ERROR: STK[%s] stk_rClose error",sess->stkName);
+                logMessage(ERROR, errmsg);
+                sess->endFlag = 1;
+                break;
+            }else {
+                sprintf(errmsg,"INFO : STK[%s] is normal disconnect ok...",sess->stkName);
+                logMessage(ERROR, errmsg);
+                sess->endFlag = 1;
+                break;
+            }
+            break;
+        }
+        case msgTypePTLSensor :
+        {
+            if(stk_rPhysicalToLogicalSensor(sess->csock, v, sess->stkName, errmsg) == false){
+                sprintf(errmsg, "ERROR: STK[%s] stk_rPhysicalToLogicalSensor error",sess->stkName);
+                logMessage(ERROR, errmsg);
+                sess->endFlag = 1;
+            } 
+            break;
+        }            
+        case msgTypeQuerySensorLoc :
+        {    
+            if(stk_rListUnitAtIrt(sess->csock, v, &sess->prof, errmsg) == false) {
+                sprintf(errmsg, "ERROR: STK[%s] stk_rListUnitAtIrt ridian socket fail",sess->stkName);
+                logMessage(ERROR, errmsg);
+                sess->endFlag = 1;
+            }
+            break;
+        }
+        case msgTypeReadMemory :
+        {
+            if(stk_rReadMemory(sess->csock, v, &sess->prof, sess->lotInfo, errmsg) == false){
+                sprintf(errmsg, "ERROR: STK[%s] stk_rReadMemory error",sess->stkName);
+                logMessage(ERROR, errmsg);
+                sess->endFlag = 1;
+            }
+            break;
+        }
+        
+        case msgTypeAssociateUnit :
+        {            
+            if(stk_rAssociateUnit(sess->csock, v, &sess->prof, errmsg) == false){
+                sprintf(errmsg, "ERROR: STK[%s] stk_rAssociateUnit ridian socket fail",sess->stkName);
+                logMessage(ERROR, errmsg);
+                sess->endFlag = 1;
+            }
+            break;
+        }
+        case msgTypeDisassociateUnit :
+        {
+            if(stk_rDisassociateUnit(sess->csock, v, &sess->prof, errmsg) == false){
+                sprintf(errmsg, "ERROR: STK[%s] stk_rDisassociateUnit ridian socket fail",sess->stkName);
+                logMessage(ERROR, errmsg);
+                sess->endFlag = 1;
+            }
+            break;
+        }
+    
+        case msgTypeDisplayMsg :
+        {
+            if(stk_rDisplayMsg(sess->csock, v, &sess->prof, errmsg) == false){
+                sprintf(errmsg, "ERROR: STK[%s] stk_rDisplayMsg ridian socket fail",sess->stkName);
+                logMessage(ERROR, errmsg);
+                sess->endFlag = 1;
+            }
+            break;
+        }
+        
+        default :
+        {
+            sess->endFlag = 1;
+            sprintf(errmsg, "ERROR: STK[%s] unknwon message recv type[%d]", sess->stkIP, recvBuf[TYPEBYTE]);
+            logMessage(ERROR, errmsg);
+            break;
+        }
     }
-    sprintf(errmsg,"INFO : STK[%s] rConnect end  RESULT[%d]", 
-                                                    stkName, rep->result);                                                    
-    logMessage(INFO, errmsg);
-    return true;
+    stat_record(v->type, tlReplyResult, &t0);
+    trace_end(sess->stkName, v->type, tlReplyResult);
+    return sess->endFlag;
 }
 
 /*****************************************************************************/
-/* 1. Function Name: stk_rPhysicalToLogicalSensor                            */
-/* 2. Description  : STK IRT name û ó                                  */
-/* 3. Parameters   : int   csock     - Client  ũ                */
-/*                   char* recvBuf   - recv  ޼                        */
-/*                   char* stkName   - STK name                              */
-/*                   char* errMsg    - Error Message                         */
-/* 4. Return Value : int                                                     */
+/* 1.Function Name: reactor_run                                              */
+/* 2.Description  : reactor mode main loop. I/O thread  listen, STK,     */
+/*                  BCR socket  epoll  ϰ ϼ frame           */
+/*                  handler thread  task  ѱ                         */
+/* 3.Parameters   : pthread_attr_t *attr -  Ӽ                       */
+/*                  int stk_sock         - STK listen socket                 */
+/*                  int bcr_sock         - BCR listen socket                 */
+/*                  char *msg            - error message                     */
+/* 4.Return Value : None                                                     */
 /*****************************************************************************/
-int stk_rPhysicalToLogicalSensor(int csock, char *recvBuf, char *stkName, char *errmsg)
+void reactor_run(pthread_attr_t *attr, int stk_sock, int bcr_sock, char *msg)
 {
-    char irtName[30]={0,};
-    rGenRequest treq, *req;
-    req = &treq;
-    memset(req, 0x00, sizeof(rGenRequest));
-    memcpy(req, recvBuf, sizeof(rGenRequest));
+    struct epoll_event ev;
+    int i;
     
-    rGenReply trep, *rep;
-    rep = &trep;
-    memset(rep,0x00,sizeof(rGenReply));
+    for(i = 0; i < gIoThreads; i++){
+        memset(&gIoThread[i], 0x00, sizeof(STK_IOTHREAD));
+        gIoThread[i].idx = i;
+        pthread_mutex_init(&gIoThread[i].mtx, NULL);
+        if((gIoThread[i].epfd = epoll_create(REACTOR_MAXEVENTS)) < 0){
+            sprintf(msg, "ERROR: reactor IO[%d] epoll create fail errno[%d]", i, errno);
+            return;
+        }
+    }
     
-    sprintf(errmsg,"INFO : STK[%s] rPhysicalToLogicalSensor start  IRTID[%s]", 
-                                                    stkName, req->physicalID);
-    logMessage(INFO, errmsg);
+    /* listen socket  0 I/O thread   */
+    stk_initSession(&gStkListen, IOKIND_STKLISTEN, stk_sock, NULL);
+    stk_initSession(&gBcrListen, IOKIND_BCRLISTEN, bcr_sock, NULL);
+    setNonblockSocket(stk_sock);
+    setNonblockSocket(bcr_sock);
     
-    stk_rPhysicalToLogicalSensor_hton(req);
-    if(stk_RecvLogSvr((void*)req ,req->msgType, stkName, errmsg, true) == -1){
-        sprintf(errmsg, "ERROR: STK[%s] rPhysicalToLogicalSensor recv log transfer fail", stkName);
-        logMessage(INFO, errmsg);
+    memset(&ev, 0x00, sizeof(ev));
+    ev.events = EPOLLIN;
+    ev.data.ptr = &gStkListen;
+    if(epoll_ctl(gIoThread[0].epfd, EPOLL_CTL_ADD, stk_sock, &ev) < 0){
+        sprintf(msg, "ERROR: reactor STK listen socket epoll add fail errno[%d]", errno);
+        return;
+    }
+    ev.data.ptr = &gBcrListen;
+    if(epoll_ctl(gIoThread[0].epfd, EPOLL_CTL_ADD, bcr_sock, &ev) < 0){
+        sprintf(msg, "ERROR: reactor BCR listen socket epoll add fail errno[%d]", errno);
+        return;
     }
     
-    if(GetIrtNameByIrt(req->physicalID, irtName, errmsg) < 0){
-        logMessage(ERROR, errmsg);
-        rep->msgLen	    = bigToLitts(sizeof(rGenReply));
-    	rep->msgType	= msgTypePTLSensor;
-    	rep->result	    = bigToLittl(11);
-    	strcpy(rep->physicalID,req->physicalID);
-    	strcpy(rep->logicalName,"");
-        
-        if(write(csock, rep, sizeof(rGenReply)) <= 0){
-            sprintf(errmsg,"ERROR: STK[%s] disconnet network",stkName);
-    	    logMessage(ERROR, errmsg);
-    	    return false;
-    	}
-    	stk_rPhysicalToLogicalSensor_ntoh(rep);
-    	if(stk_SendLogSvr((void*)rep ,rep->msgType, stkName, errmsg, true) == -1){
-            sprintf(errmsg, "ERROR: STK[%s] rPhysicalToLogicalSensor send log transfer fail", stkName);
-            logMessage(ERROR, errmsg);
+    if(exec_start(attr, msg) == false){
+        return;
+    }
+    for(i = 1; i < gIoThreads; i++){
+        if(pthread_create(&gIoThread[i].tid, attr, reactor_ioThread, (void *)&gIoThread[i]) != 0){
+            sprintf(msg, "ERROR: reactor IO[%d] thread create fail errno[%d]", i, errno);
+            return;
         }
-        
-        sprintf(errmsg,"INFO : STK[%s] rPhysicalToLogicalSensor end  RESULT[%d], IRTID[%s], PORTID[%s]", 
-                                                        stkName, rep->result, rep->physicalID, rep->logicalName);
-        logMessage(INFO, errmsg);
-        return false;
     }
+    sprintf(msg, "INFO : reactor start IO thread[%d] handler thread[%d]", gIoThreads, gHandlerThreads);
+    logMessage(INFO, msg);
     
-    rep->msgLen	    = bigToLitts(sizeof(rGenReply));
-	rep->msgType	= msgTypePTLSensor;
-	rep->result	    = bigToLittl(0);
-	strcpy(rep->physicalID,req->physicalID);
-	strcpy(rep->logicalName,irtName);
+    gIoThread[0].tid = pthread_self();
+    reactor_ioLoop(&gIoThread[0]);
     
-    if(write(csock, rep, sizeof(rGenReply)) <= 0){
-        sprintf(errmsg,"ERROR: STK[%s] disconnet network",stkName);
-	    logMessage(ERROR, errmsg);
-	    return false;
-	}
-	stk_rPhysicalToLogicalSensor_ntoh(rep);
-	if(stk_SendLogSvr((void*)rep ,rep->msgType, stkName, errmsg, true) == -1){
-        sprintf(errmsg, "ERROR: STK[%s] rPhysicalToLogicalSensor send log transfer fail", stkName);
-        logMessage(ERROR, errmsg);
-    }
+    sprintf(msg, "ERROR: reactor IO[0] loop exit");
+}
+
+/*****************************************************************************/
+/* 1.Function Name: reactor_ioThread                                         */
+/* 2.Description  : reactor I/O thread                                       */
+/* 3.Parameters   : STK_IOTHREAD *io - I/O thread                        */
+/* 4.Return Value : None                                                     */
+/*****************************************************************************/
+void * reactor_ioThread(void *arg)
+{
+    reactor_ioLoop((STK_IOTHREAD *)arg);
+    return NULL;
+}
+
+/*****************************************************************************/
+/* 1.Function Name: reactor_ioLoop                                           */
+/* 2.Description  : epoll event loop                                         */
+/* 3.Parameters   : STK_IOTHREAD *io - I/O thread                        */
+/* 4.Return Value : None                                                     */
+/*****************************************************************************/
+void reactor_ioLoop(STK_IOTHREAD *io)
+{
+    struct epoll_event evs[REACTOR_MAXEVENTS];
+    STK_SESSION *sess;
+    time_t lastSweep = time(NULL);
+    int n, i;
+    char msg[BUFSIZ];
     
-    sprintf(errmsg,"INFO : STK[%s] rPhysicalToLogicalSensor end  RESULT[%d], IRTID[%s], PORTID[%s]", 
-                                            stkName, rep->result, rep->physicalID, rep->logicalName);
-    logMessage(INFO, errmsg);
-    return true;
-} 
+    while(1){
+        n = epoll_wait(io->epfd, evs, REACTOR_MAXEVENTS, io->deferred ? REACTOR_RETRY_MS : 1000);
+        if(n < 0){
+            if(errno == EINTR) continue;
+            sprintf(msg, "ERROR: reactor IO[%d] epoll_wait fail errno[%d]", io->idx, errno);
+            logMessage(ERROR, msg);
+            sleep(1);
+            continue;
+        }
+        for(i = 0; i < n; i++){
+            sess = (STK_SESSION *)evs[i].data.ptr;
+            switch(sess->kind){
+                case IOKIND_STKLISTEN :
+                case IOKIND_BCRLISTEN :
+                    reactor_accept(sess);
+                    break;
+                case IOKIND_STK :
+                    reactor_readStk(io, sess);
+                    break;
+                case IOKIND_BCR :
+                    reactor_readBcr(io, sess);
+                    break;
+            }
+        }
+        if(io->deferred){
+            reactor_retryDeferred(io);
+        }
+        if(time(NULL) != lastSweep){
+            lastSweep = time(NULL);
+            reactor_sweep(io);
+        }
+    }
+}
 
 /*****************************************************************************/
-/* 1. Function Name: stk_rLogicalToPhysicalSensor                            */
-/* 2. Description  : STK IRT name û ó                                  */
-/* 3. Parameters   : int   ridsock   - Ridian  ũ                */
-/*                   char* portName  - STK portName                          */
-/*                   char* stkName   - STK name                              */
-/*                   char* errMsg    - Error Message                         */
-/* 4. Return Value : int                                                     */
+/* 1.Function Name: reactor_accept                                           */
+/* 2.Description  : listen socket accept, session  I/O thread        */
+/* 3.Parameters   : STK_SESSION *lsn - listen session                        */
+/* 4.Return Value : None                                                     */
 /*****************************************************************************/
-int stk_rLogicalToPhysicalSensor(int *ridsock, char *portName, char *stkName, char *errmsg)
+void reactor_accept(STK_SESSION *lsn)
 {
-    int reqLen;
-    rGenRequest treq, *req;
-    req = &treq;
-    memset(req, 0x00, sizeof(rGenRequest));
+    STK_SESSION *sess;
+    STK_IOTHREAD *io;
+    struct sockaddr_in addr;
+    socklen_t addrLen;
+    struct epoll_event ev;
+    int sock;
+    int ret;
+    char msg[BUFSIZ];
     
-    reqLen = sizeof(rGenRequest);
-    req->msgLen = sizeof(rGenRequest);
-    req->msgType = msgTypeLTPSensor;
-    memcpy(req->logicalName, portName, strlen(portName));
+    while(1){
+        addrLen = sizeof(addr);
+        if((sock = accept(lsn->csock, (struct sockaddr *)&addr, &addrLen)) < 0){
+            if(errno == EINTR) continue;
+            if(errno != EAGAIN && errno != EWOULDBLOCK){
+                sprintf(msg, "ERROR: Ŭ̾Ʈκ û   ϴ INFO:%s",strerror(errno));
+                logMessage(ERROR, msg);
+            }
+            return;
+        }
+        setNonblockSocket(sock);
         
-    rGenReply trep, *rep;
-    rep = &trep;
-    memset(rep,0x00,sizeof(rGenReply));
-    
-    sprintf(errmsg,"INFO : STK[%s] stk_rLogicalToPhysicalSensor start  PORTID[%s]", 
-                                                            stkName, req->logicalName);
-    logMessage(INFO, errmsg);
-    
-    if(rid_SendRecv(ridsock, (char*)req, reqLen, (char*)rep, sizeof(rGenReply), stkName)=='K'){
-        if(rep->result == 0){
+        if((sess = calloc(1, sizeof(STK_SESSION))) == NULL){
+            sprintf(msg, "ERROR: reactor session   ޸ Ҵ翡 Ͽϴ");
+            logMessage(ERROR, msg);
+            close(sock);
+            continue;
+        }
+        stk_initSession(sess, (lsn->kind == IOKIND_STKLISTEN) ? IOKIND_STK : IOKIND_BCR,
+                        sock, inet_ntoa(addr.sin_addr));
+        if(sess->kind == IOKIND_STK){
+            sprintf(msg, "INFO : STKIP[%s] client connect request", sess->stkIP);
         } else {
-            sprintf(errmsg, "ERROR: STK[%s] stk_rLogicalToPhysicalSensor PORTID[%s] is not existe", stkName, req->logicalName);
-            return 1;
+            sprintf(msg, "INFO : BCRIP[%s] client connect request", sess->stkIP);
+        }
+        logMessage(INFO, msg);
+        
+        /* listen socket  0 I/O thread  óϹǷ gIoNext  lock ʿ */
+        sess->ioIdx = gIoNext;
+        gIoNext = (gIoNext + 1) % gIoThreads;
+        io = &gIoThread[sess->ioIdx];
+        
+        memset(&ev, 0x00, sizeof(ev));
+        ev.events = EPOLLIN | EPOLLONESHOT;
+        ev.data.ptr = sess;
+        
+        pthread_mutex_lock(&io->mtx);
+        sess->next = io->head;
+        if(io->head != NULL) io->head->prev = sess;
+        io->head = sess;
+        ret = epoll_ctl(io->epfd, EPOLL_CTL_ADD, sock, &ev);
+        pthread_mutex_unlock(&io->mtx);
+        
+        if(sess->kind == IOKIND_STK){
+            pthread_mutex_lock(&cnt_mtx);
+            ++gSessionCnt;
+            pthread_mutex_unlock(&cnt_mtx);
+            if(gSessionCnt > gHandlerThreads){
+                sprintf(msg, "INFO : STK session cnt[%d] > handler thread[%d], check STKinf.handler.threads",
+                        gSessionCnt, gHandlerThreads);
+                logMessage(INFO, msg);
+            }
+        }
+        if(ret < 0){
+            sprintf(msg, "ERROR: IP[%s] reactor epoll add fail errno[%d]", sess->stkIP, errno);
+            logMessage(ERROR, msg);
+            reactor_closeSession(sess);
         }
-    } else {
-        memset(rep,0x00,sizeof(rGenReply));
-        sprintf(errmsg, "ERROR: STK[%s] stk_rLogicalToPhysicalSensor ridian send and recv fail.", stkName);
-        return false;
     }
-    
-    sprintf(errmsg,"INFO : STK[%s] rPhysicalToLogicalSensor end  RESULT[%d], IRTID[%s], PORTID[%s]", 
-                                            stkName, rep->result, rep->physicalID, rep->logicalName);
-    logMessage(INFO, errmsg);
-    return true;
-} 
+}
 
 /*****************************************************************************/
-/* 1. Function Name: stk_rLogicalToPhysicalUnit                              */
-/* 2. Description  : tag ID û                                             */
-/* 3. Parameters   : int   csock     - Client  ũ                */
-/*                   int   ridsock   - ridian  ũ                */
-/*                   char* tagID     - Teltag ID                             */ 
-/*                   char* logicalID - Logical ID                            */
-/*                   char* stkName   - STK name                              */
-/*                   char* errMsg    - Error Message                         */
-/* 4. Return Value : int                                                     */
+/* 1.Function Name: reactor_readStk                                          */
+/* 2.Description  : STK socket read, ϼ frame   task  ѱ   */
+/* 3.Parameters   : STK_IOTHREAD *io  - I/O thread                       */
+/*                  STK_SESSION *sess - STK session                          */
+/* 4.Return Value : None                                                     */
 /*****************************************************************************/
-int stk_rLogicalToPhysicalUnit(int csock, int *ridsock, char *tagID, char *logicalID, char *stkName, char *errmsg)
+void reactor_readStk(STK_IOTHREAD *io, STK_SESSION *sess)
 {
-    rGenRequest treq, *req;
-    req = &treq;
-    memset(req, 0x00, sizeof(rGenRequest));
-    unsigned short int reqLen;
+    char errmsg[BUFSIZ];
+    int n, len;
     
-    rGenReply trep, *rep;
-    rep = &trep;
-    memset(rep,0x00,sizeof(rGenReply));
-    
-    sprintf(errmsg,"INFO : STK[%s] rLogicalToPhysicalUnit start  LOGICALID[%s]", 
-                                                    stkName, logicalID);
-    logMessage(INFO, errmsg);
-    
-    req->msgLen = sizeof(rGenRequest);
-    req->msgType = msgTypeLTPUnit;
-    req->itemType = 0;
-    memcpy(req->logicalName, logicalID, strlen(logicalID));
-    reqLen = sizeof(rGenRequest);
-    
-    if(rid_SendRecv(ridsock, (char*)req, reqLen, (char*)rep, sizeof(rGenReply), stkName)=='K'){
-        if(rep->result == 0){
-            memcpy(tagID, rep->physicalID, strlen(rep->physicalID));
-        } else {
-            tagID[0] == NULL;
+    while(sess->rlen < (int)sizeof(sess->rbuf)){
+        n = read(sess->csock, &sess->rbuf[sess->rlen], sizeof(sess->rbuf) - sess->rlen);
+        if(n > 0){
+            sess->rlen += n;
+            continue;
         }
-    } else {
-        sprintf(errmsg, "ERROR: STK[%s] rLogicalToPhysicalUnit ridian send and recv fail.", stkName);
-        return false;
+        if(n < 0 && errno == EINTR) continue;
+        if(n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) break;
+        sess->eof = 1;
+        break;
     }
+    sess->lastRecv = time(NULL);
     
-    sprintf(errmsg,"INFO : STK[%s] rLogicalToPhysicalUnit end  RESULT[%d], TAGID[%s], LOGICALID[%s]", 
-                                            stkName, rep->result, rep->physicalID, rep->logicalName);
-    logMessage(INFO, errmsg);
-    return true;
+    if((len = reactor_frameLen(sess, errmsg)) < 0){
+        reactor_closeSession(sess);
+        return;
+    }
+    if(len > 0){
+        pthread_mutex_lock(&io->mtx);
+        sess->busy = 1;
+        pthread_mutex_unlock(&io->mtx);
+        if(exec_trySubmit(reactor_stkTask, (void *)sess) == false){
+            reactor_defer(io, sess, reactor_stkTask);
+        }
+        return;
+    }
+    if(sess->eof){
+        sprintf(errmsg, "ERROR: STK[%s] disconnect", sess->stkName);
+        logMessage(ERROR, errmsg);
+        reactor_closeSession(sess);
+        return;
+    }
+    reactor_rearm(sess);
 }
 
 /*****************************************************************************/
-/* 1. Function Name: stk_rListUnitAtIrt                                      */
-/* 2. Description  : STK Teltag read û ó                               */
+/* 1.Function Name: reactor_readBcr                                          */
+/* 2.Description  : output port BCR socket read                              */
+/* 3.Parameters   : STK_IOTHREAD *io  - I/O thread                       */
+/*                  STK_SESSION *sess - BCR session                          */
+/* 4.Return Value : None                                                     */
+/*****************************************************************************/
+void reactor_readBcr(STK_IOTHREAD *io, STK_SESSION *sess)
+{
+    char errmsg[BUFSIZ];
+    int n;
+    
+    /* bcrMsgThread  ϰ ִ 12 byte  д´ */
+    while(sess->rlen < 12){
+        n = read(sess->csock, &sess->rbuf[sess->rlen], 12 - sess->rlen);
+        if(n > 0){
+            sess->rlen += n;
+            continue;
+        }
+        if(n < 0 && errno == EINTR) continue;
+        if(n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) break;
+        sess->eof = 1;
+        break;
+    }
+    
+    if(sess->rlen >= BCRLEN || (sess->eof && sess->rlen > 0)){
+        pthread_mutex_lock(&io->mtx);
+        sess->busy = 1;
+        pthread_mutex_unlock(&io->mtx);
+        if(exec_trySubmit(reactor_bcrTask, (void *)sess) == false){
+            reactor_defer(io, sess, reactor_bcrTask);
+        }
+        return;
+    }
+    if(sess->eof){
+        sprintf(errmsg, "ERROR: BCRIP[%s] disconnect", sess->stkIP);
+        logMessage(ERROR, errmsg);
+        reactor_closeSession(sess);
+        return;
+    }
+    reactor_rearm(sess);
+}
+
+/*****************************************************************************/
+/* 1.Function Name: reactor_frameLen                                         */
+/* 2.Description  : session buffer  ϼ STK frame  Ȯ             */
+/* 3.Parameters   : STK_SESSION *sess - STK session                          */
+/*                  char *msg         - Error Message                        */
+/* 4.Return Value : int  0 - frame ̿ϼ                                    */
+/*                      >0 - frame                                       */
+/*                      -1 - frame                                       */
+/*****************************************************************************/
+int reactor_frameLen(STK_SESSION *sess, char *msg)
+{
+    unsigned short int msgLen;
+    
+    if(sess->rlen < HEADERSIZE){
+        return 0;
+    }
+    if(msgVerify((char)sess->rbuf[TYPEBYTE]) == false){
+        sprintf(msg, "ERROR: STK[%s] unknown message type[%d]", sess->stkName, sess->rbuf[TYPEBYTE]);
+        logMessage(ERROR, msg);
+        return -1;
+    }
+    memcpy(&msgLen, sess->rbuf, LENGTHSIZE);
+    msgLen = bigToLitts(msgLen);
+    if(msgLen < HEADERSIZE || msgLen > sizeof(sess->rbuf)){
+        sprintf(msg, "ERROR: STK[%s] wrong message length[%d]", sess->stkName, msgLen);
+        logMessage(ERROR, msg);
+        return -1;
+    }
+    if(sess->rlen < msgLen){
+        return 0;
+    }
+    return msgLen;
+}
+
+/*****************************************************************************/
+/* 1.Function Name: reactor_stkTask                                          */
+/* 2.Description  : STK frame handler task. EPOLLONESHOT   session     */
+/*                   frame  ѹ ϳ task  óȴ           */
+/* 3.Parameters   : STK_SESSION *sess - STK session                          */
+/* 4.Return Value : None                                                     */
+/*****************************************************************************/
+void reactor_stkTask(void *arg)
+{
+    STK_SESSION *sess = (STK_SESSION *)arg;
+    char recvBuf[BUFSIZ];
+    char errmsg[BUFSIZ];
+    int len = 0;
+    
+    while(sess->endFlag == 0 && (len = reactor_frameLen(sess, errmsg)) > 0){
+        memset(recvBuf, 0x00, BUFSIZ);
+        memcpy(recvBuf, sess->rbuf, len);
+        sess->rlen -= len;
+        memmove(sess->rbuf, &sess->rbuf[len], sess->rlen);
+        stk_dispatchMsg(sess, recvBuf, errmsg);
+    }
+    if(sess->endFlag == 1){
+        sprintf(errmsg,"INFO : STK[%s] is close request", sess->stkName);
+        logMessage(INFO, errmsg);
+        reactor_closeSession(sess);
+        return;
+    }
+    if(len < 0){
+        reactor_closeSession(sess);
+        return;
+    }
+    if(sess->eof){
+        sprintf(errmsg, "ERROR: STK[%s] disconnect", sess->stkName);
+        logMessage(ERROR, errmsg);
+        reactor_closeSession(sess);
+        return;
+    }
+    reactor_rearm(sess);
+}
+
+/*****************************************************************************/
+/* 1.Function Name: reactor_bcrTask                                          */
+/* 2.Description  : output port BCR cassette ó task (bcrMsgThread ü)   */
+/* 3.Parameters   : STK_SESSION *sess - BCR session                          */
+/* 4.Return Value : None                                                     */
+/*****************************************************************************/
+void reactor_bcrTask(void *arg)
+{
+    STK_SESSION *sess = (STK_SESSION *)arg;
+    STK_PROFILE prof;
+    char errmsg[BUFSIZ]={0,};
+    char cstID[12+1]={0,};
+    char stkName[24]={0,};
+    char bcrName[24]={0,};
+    char portName[24]={0,};
+    
+    memcpy(cstID, sess->rbuf, sess->rlen);
+    if(bcr_getOutputPort(sess->stkIP, stkName, bcrName, portName, &prof, errmsg) == true){
+        bcr_outputRequest(sess->stkIP, stkName, bcrName, portName, &prof, cstID, sess->rlen, errmsg);
+    }
+    sprintf(errmsg, "DEBUG: STK[%s] PORT[%s] BCR[%s] BCRIP[%s] destroy session", stkName, portName, bcrName, sess->stkIP);
+    logMessage(DEBUG, errmsg);
+    reactor_closeSession(sess);
+}
+
+/*****************************************************************************/
+/* 1.Function Name: reactor_rearm                                            */
+/* 2.Description  : handler ó Ϸ  session  ٽ epoll         */
+/* 3.Parameters   : STK_SESSION *sess - session                              */
+/* 4.Return Value : None                                                     */
+/*****************************************************************************/
+void reactor_rearm(STK_SESSION *sess)
+{
+    STK_IOTHREAD *io = &gIoThread[sess->ioIdx];
+    struct epoll_event ev;
+    char msg[BUFSIZ];
+    int ret;
+    
+    memset(&ev, 0x00, sizeof(ev));
+    ev.events = EPOLLIN | EPOLLONESHOT;
+    ev.data.ptr = sess;
+    
+    pthread_mutex_lock(&io->mtx);
+    sess->busy = 0;
+    ret = epoll_ctl(io->epfd, EPOLL_CTL_MOD, sess->csock, &ev);
+    pthread_mutex_unlock(&io->mtx);
+    
+    if(ret < 0){
+        sprintf(msg, "ERROR: IP[%s] STK[%s] reactor re-arm fail errno[%d]", sess->stkIP, sess->stkName, errno);
+        logMessage(ERROR, msg);
+        reactor_closeSession(sess);
+    }
+}
+
+/*****************************************************************************/
+/* 1.Function Name: reactor_closeSession                                     */
+/* 2.Description  : session  epoll  ϰ ڿ                  */
+/* 3.Parameters   : STK_SESSION *sess - session                              */
+/* 4.Return Value : None                                                     */
+/*****************************************************************************/
+void reactor_closeSession(STK_SESSION *sess)
+{
+    STK_IOTHREAD *io = &gIoThread[sess->ioIdx];
+    struct epoll_event ev;
+    char msg[BUFSIZ];
+    
+    memset(&ev, 0x00, sizeof(ev));
+    pthread_mutex_lock(&io->mtx);
+    epoll_ctl(io->epfd, EPOLL_CTL_DEL, sess->csock, &ev);
+    if(sess->prev != NULL) sess->prev->next = sess->next;
+    else                   io->head = sess->next;
+    if(sess->next != NULL) sess->next->prev = sess->prev;
+    pthread_mutex_unlock(&io->mtx);
+    
+    if(sess->kind == IOKIND_STK){
+        pthread_mutex_lock(&cnt_mtx);
+        --gSessionCnt;
+        pthread_mutex_unlock(&cnt_mtx);
+        sprintf(msg, "DEBUG: STK[%s] session close session cnt[%d]", sess->stkName, gSessionCnt);
+    } else {
+        sprintf(msg, "DEBUG: BCRIP[%s] session close", sess->stkIP);
+    }
+    logMessage(DEBUG, msg);
+    
+    close(sess->csock);
+    free(sess);
+}
+
+/*****************************************************************************/
+/* 1.Function Name: reactor_sweep                                            */
+/* 2.Description  : idle session timeout ˻ (stk_recv, bcrMsgThread      */
+/*                   timeout ). stk_recv  select  ٿ     */
+/*                  waittime  缳 ʾ ù timeout  õ     */
+/*                   Ƿ   STK_IDLE_TIMEOUT  ̴     */
+/* 3.Parameters   : STK_IOTHREAD *io - I/O thread                        */
+/* 4.Return Value : None                                                     */
+/*****************************************************************************/
+void reactor_sweep(STK_IOTHREAD *io)
+{
+    STK_SESSION *sess;
+    time_t now;
+    char msg[BUFSIZ];
+    
+    while(1){
+        now = time(NULL);
+        pthread_mutex_lock(&io->mtx);
+        for(sess = io->head; sess != NULL; sess = sess->next){
+            if(sess->busy) continue;
+            if(sess->kind == IOKIND_STK && now - sess->lastRecv > STK_IDLE_TIMEOUT) break;
+            if(sess->kind == IOKIND_BCR && now - sess->lastRecv > BCR_RECV_TIMEOUT) break;
+        }
+        if(sess != NULL){
+            sess->busy = 1;
+        }
+        pthread_mutex_unlock(&io->mtx);
+        
+        if(sess == NULL){
+            return;
+        }
+        if(sess->kind == IOKIND_STK){
+            sprintf(msg,"ERROR: STK[%s] recv timeout retry count over", sess->stkName);
+        } else {
+            sprintf(msg,"ERROR: BCRIP[%s] recv timeout", sess->stkIP);
+        }
+        logMessage(ERROR, msg);
+        reactor_closeSession(sess);
+    }
+}
+
+/*****************************************************************************/
+/* 1.Function Name: reactor_defer                                            */
+/* 2.Description  : executor queue     I/O thread        */
+/*                  ʵ task  session  ɾ ΰ loop  õ     */
+/*                  Ѵ. session  busy ·  sweep  ƴϴ    */
+/* 3.Parameters   : STK_IOTHREAD *io     - I/O thread                    */
+/*                  STK_SESSION *sess    - session                           */
+/*                  void (*func)(void *) - task function                     */
+/* 4.Return Value : None                                                     */
+/*****************************************************************************/
+void reactor_defer(STK_IOTHREAD *io, STK_SESSION *sess, void (*func)(void *))
+{
+    char msg[BUFSIZ];
+    
+    pthread_mutex_lock(&io->mtx);
+    sess->deferred = func;
+    ++io->deferred;
+    pthread_mutex_unlock(&io->mtx);
+    
+    sprintf(msg, "INFO : IP[%s] executor queue full[%d], task submit deferred", sess->stkIP, gExecQueued);
+    logMessage(INFO, msg);
+}
+
+/*****************************************************************************/
+/* 1.Function Name: reactor_retryDeferred                                    */
+/* 2.Description  : reactor_defer  ɾ  task  executor  ٽ    */
+/* 3.Parameters   : STK_IOTHREAD *io - I/O thread                        */
+/* 4.Return Value : None                                                     */
+/*****************************************************************************/
+void reactor_retryDeferred(STK_IOTHREAD *io)
+{
+    STK_SESSION *sess, *next;
+    void (*func)(void *);
+    
+    /* ϵ task   session   io->mtx  ʿϹǷ, lock 
+     *  ȿ session  free  ʴ´ */
+    pthread_mutex_lock(&io->mtx);
+    for(sess = io->head; sess != NULL && io->deferred > 0; sess = next){
+        next = sess->next;
+        if(sess->deferred == NULL) continue;
+        func = sess->deferred;
+        sess->deferred = NULL;
+        if(exec_trySubmit(func, (void *)sess) == false){
+            sess->deferred = func;
+            break;
+        }
+        --io->deferred;
+    }
+    pthread_mutex_unlock(&io->mtx);
+}
+
+/*****************************************************************************/
+/* 1.Function Name: exec_start                                               */
+/* 2.Description  : work-stealing executor ⵿. worker  ڱ queue    */
+/*                  , ڱ queue   ٸ worker  task  ´ */
+/* 3.Parameters   : pthread_attr_t *attr -  Ӽ                       */
+/*                  char *msg            - error message                     */
+/* 4.Return Value : int                                                      */
+/*****************************************************************************/
+int exec_start(pthread_attr_t *attr, char *msg)
+{
+    int i;
+    
+    for(i = 0; i < gHandlerThreads; i++){
+        memset(&gWorker[i], 0x00, sizeof(STK_WORKER));
+        gWorker[i].idx = i;
+        pthread_mutex_init(&gWorker[i].mtx, NULL);
+    }
+    for(i = 0; i < gHandlerThreads; i++){
+        if(pthread_create(&gWorker[i].tid, attr, exec_workerThread, (void *)&gWorker[i]) != 0){
+            sprintf(msg, "ERROR: executor worker[%d] thread create fail errno[%d]", i, errno);
+            return false;
+        }
+    }
+    sprintf(msg, "INFO : executor start worker[%d] queue max[%d]", gHandlerThreads, gHandlerQueue);
+    logMessage(INFO, msg);
+    return true;
+}
+
+/*****************************************************************************/
+/* 1.Function Name: exec_submit                                              */
+/* 2.Description  : executor  task .  task  STKinf.handler.queue */
+/*                  ̸̻ ڸ   Ѵ (backpressure)        */
+/* 3.Parameters   : void (*func)(void *) - task function                     */
+/*                  void *arg            - task argument                     */
+/* 4.Return Value : int                                                      */
+/*****************************************************************************/
+int exec_submit(void (*func)(void *), void *arg)
+{
+    return exec_enqueue(func, arg, 1);
+}
+
+/*****************************************************************************/
+/* 1.Function Name: exec_trySubmit                                           */
+/* 2.Description  : queue     ʰ false (ΰ ۾)     */
+/* 3.Parameters   : void (*func)(void *) - task function                     */
+/*                  void *arg            - task argument                     */
+/* 4.Return Value : int                                                      */
+/*****************************************************************************/
+int exec_trySubmit(void (*func)(void *), void *arg)
+{
+    return exec_enqueue(func, arg, 0);
+}
+
+/*****************************************************************************/
+/* 1.Function Name: exec_enqueue                                             */
+/* 2.Description  : worker queue  task ߰                                */
+/* 3.Parameters   : void (*func)(void *) - task function                     */
+/*                  void *arg            - task argument                     */
+/*                  int wait             - queue full              */
+/* 4.Return Value : int                                                      */
+/*****************************************************************************/
+int exec_enqueue(void (*func)(void *), void *arg, int wait)
+{
+    STK_TASK *task;
+    STK_WORKER *w;
+    int idx;
+    
+    if(wait == 0 && gExecQueued >= gHandlerQueue){
+        return false;
+    }
+    if((task = calloc(1, sizeof(STK_TASK))) == NULL){
+        logMessage(ERROR, "ERROR: executor task   ޸ Ҵ翡 Ͽϴ");
+        return false;
+    }
+    task->func = func;
+    task->arg  = arg;
+    
+    pthread_mutex_lock(&gExecMtx);
+    if(wait == 0 && gExecQueued >= gHandlerQueue){
+        pthread_mutex_unlock(&gExecMtx);
+        free(task);
+        return false;
+    }
+    while(gExecQueued >= gHandlerQueue){
+        ++gExecBlocked;
+        pthread_cond_wait(&gExecSpace, &gExecMtx);
+    }
+    /* ˻  lock ȿ ڸ  ξ  thread  ÿ
+     * ص gHandlerQueue   ʴ´ */
+    ++gExecQueued;
+    if(gExecQueued > gExecHigh) gExecHigh = gExecQueued;
+    /* worker  ϴ task  ڱ queue ,  ܴ round robin */
+    if(tlWorkerIdx >= 0){
+        idx = tlWorkerIdx;
+    } else {
+        idx = (int)(gExecNext++ % (unsigned int)gHandlerThreads);
+    }
+    pthread_mutex_unlock(&gExecMtx);
+    
+    w = &gWorker[idx];
+    pthread_mutex_lock(&w->mtx);
+    if(w->tail != NULL) w->tail->next = task;
+    else                w->head = task;
+    w->tail = task;
+    ++w->cnt;
+    pthread_mutex_unlock(&w->mtx);
+    
+    pthread_mutex_lock(&gExecMtx);
+    if(gExecIdle > 0) pthread_cond_signal(&gExecCond);
+    pthread_mutex_unlock(&gExecMtx);
+    
+    return true;
+}
+
+/*****************************************************************************/
+/* 1.Function Name: exec_take                                                */
+/* 2.Description  : ڱ queue  task  ,  ٸ worker     */
+/*                  queue  ´ (steal)                              */
+/* 3.Parameters   : int idx - worker index                                   */
+/* 4.Return Value : STK_TASK *                                               */
+/*****************************************************************************/
+STK_TASK * exec_take(int idx)
+{
+    STK_WORKER *w;
+    STK_TASK *task;
+    int i;
+    
+    for(i = 0; i < gHandlerThreads; i++){
+        w = &gWorker[(idx + i) % gHandlerThreads];
+        if(w->cnt == 0) continue;
+        
+        pthread_mutex_lock(&w->mtx);
+        if((task = w->head) != NULL){
+            w->head = task->next;
+            if(w->head == NULL) w->tail = NULL;
+            --w->cnt;
+        }
+        pthread_mutex_unlock(&w->mtx);
+        
+        if(task != NULL){
+            if(i > 0) __sync_fetch_and_add(&gExecSteal, 1);
+            task->next = NULL;
+            return task;
+        }
+    }
+    return NULL;
+}
+
+/*****************************************************************************/
+/* 1.Function Name: exec_workerThread                                        */
+/* 2.Description  : executor worker thread                                   */
+/* 3.Parameters   : STK_WORKER *w - worker                               */
+/* 4.Return Value : None                                                     */
+/*****************************************************************************/
+void * exec_workerThread(void *arg)
+{
+    STK_WORKER *w = (STK_WORKER *)arg;
+    STK_TASK *task;
+    
+    tlWorkerIdx = w->idx;
+    while(1){
+        if((task = exec_take(w->idx)) == NULL){
+            pthread_mutex_lock(&gExecMtx);
+            while(gExecQueued <= 0){
+                ++gExecIdle;
+                pthread_cond_wait(&gExecCond, &gExecMtx);
+                --gExecIdle;
+            }
+            pthread_mutex_unlock(&gExecMtx);
+            continue;
+        }
+        pthread_mutex_lock(&gExecMtx);
+        --gExecQueued;
+        pthread_cond_signal(&gExecSpace);
+        pthread_mutex_unlock(&gExecMtx);
+        
+        task->func(task->arg);
+        free(task);
+        __sync_fetch_and_add(&gExecDone, 1);
+    }
+    return NULL;
+}
+
+/*****************************************************************************/
+/* 1.Function Name: stk_admit                                                */
+/* 2.Description  : thread   . STKinf.thread.max  ϸ     */
+/*                  slot  ȯ  ϸ,   ű       */
+/*                  listen backlog  δ                                 */
+/* 3.Parameters   : int tmax     -  ִ                           */
+/*                  char *stkIP  - STK IP                                    */
+/* 4.Return Value : None                                                     */
+/*****************************************************************************/
+void stk_admit(int tmax, char *stkIP)
+{
+    char msg[BUFSIZ];
+    int  cnt;
+    
+    pthread_mutex_lock(&cnt_mtx);
+    cnt = thread_cnt;
+    pthread_mutex_unlock(&cnt_mtx);
+    if(cnt >= tmax){
+        sprintf(msg, "INFO : STKIP[%s] admission wait thread cnt[%d] max[%d]", stkIP, cnt, tmax);
+        logMessage(INFO, msg);
+    }
+    
+    pthread_mutex_lock(&cnt_mtx);
+    while(thread_cnt >= tmax){
+        pthread_cond_wait(&gAdmitCond, &cnt_mtx);
+    }
+    ++thread_cnt;
+    pthread_mutex_unlock(&cnt_mtx);
+}
+
+/*****************************************************************************/
+/* 1.Function Name: stk_leave                                                */
+/* 2.Description  : thread  slot ȯ                                    */
+/* 3.Parameters   : None                                                     */
+/* 4.Return Value : None                                                     */
+/*****************************************************************************/
+void stk_leave()
+{
+    pthread_mutex_lock(&cnt_mtx);
+    --thread_cnt;
+    pthread_cond_signal(&gAdmitCond);
+    pthread_mutex_unlock(&cnt_mtx);
+}
+
+/*****************************************************************************/
+/* 1. Function Name: stk_buildProfile                                        */
+/* 2. Description  : STK type  stocker  ó å 1ȸ ȸϿ     */
+/*                   (rid_SendRecv  handler  ȸ ʴ´)        */
+/* 3. Parameters   : char* stkName   - STK name                              */
+/*                   STK_PROFILE *prof - STK profile                         */
+/*                   char* errMsg    - Error Message                         */
+/* 4. Return Value : int                                                     */
+/*****************************************************************************/
+int stk_buildProfile(char *stkName, STK_PROFILE *prof, char *errmsg)
+{
+    memset(prof, 0x00, sizeof(STK_PROFILE));
+    strncpy(prof->stkName, stkName, sizeof(prof->stkName) - 1);
+    
+    prof->stkType = GetStkTypeByStkName(stkName, errmsg);
+    if(prof->stkType == false){
+        return false;
+    }
+    if(prof->stkType == LOTPODTYPE){
+        prof->parallel = gLotParallelMaint;
+    } else {
+        prof->parallel = gReticleParallelMaint;
+    }
+    /* ASML Reticle Pod interlock  CRST   */
+    if(memcmp(stkName, "CRST", 4) == 0){
+        prof->asmlCheck = 1;
+    }
+    /* 2017.07.20 CPST ġ  Update  EAP ó, 2019.07.29 Pod ID ȯ */
+    if(memcmp(stkName, "CPST", 4) == 0){
+        prof->ltsSkip  = 1;
+        prof->podTrans = 1;
+        prof->emptyLot = 1;
+    }
+    
+    sprintf(errmsg, "INFO : STK[%s] profile TYPE[%d] PARALLEL[%d] ASML[%d] LTSSKIP[%d] PODTRANS[%d]",
+                     prof->stkName, prof->stkType, prof->parallel, prof->asmlCheck, prof->ltsSkip, prof->podTrans);
+    logMessage(INFO, errmsg);
+    return true;
+}
+
+/*****************************************************************************/
+/* 1. Function Name: stk_rConnect                                            */
+/* 2. Description  : STK connect û ó                                   */
+/* 3. Parameters   : int   csock     - Client  ũ                */
+/*                   STK_VIEW *v     - recv  ޼ view                   */
+/*                   char* stkName   - STK name                              */
+/*                   char* errMsg    - Error Message                         */
+/* 4. Return Value : int                                                     */
+/*****************************************************************************/
+int stk_rConnect(int csock, STK_VIEW *v, char *stkName, char *errmsg) 
+{
+    rConnectRequest *req = (rConnectRequest *)v->buf;
+    
+    memcpy(stkName, req->name,1);
+    memcpy(&stkName[1], &req->name[2], 5);
+
+    sprintf(errmsg,"INFO : STK[%s] rConnect start ", stkName);
+    logMessage(INFO, errmsg);
+    
+    if(stk_RecvLogSvr((void*)v->buf ,v->type, stkName, errmsg, true) == -1){
+        sprintf(errmsg,"ERROR: STK[%s] rConnect recv log transfer fail", stkName);
+        logMessage(ERROR, errmsg);
+    }
+    
+    rConnectReply trep, *rep;
+    rep = &trep;
+    memset(rep,0x00,sizeof(rConnectReply));
+    rep->msgLen	    = sizeof(rConnectReply);
+	rep->msgType	= msgTypeConnectRequest;
+	rep->result	    = 0;
+	rep->major	    = 2;
+	rep->minor	    = 5;
+	rep->byteOrder  = req->byteOrder;
+	rep->bitOrder	= req->bitOrder;
+	rep->point	    = 0;
+	
+	if(stk_writeReply(csock, rep, sizeof(rConnectReply)) == false){
+	    sprintf(errmsg,"ERROR: STK[%s] disconnet network...",stkName);
+	    logMessage(ERROR, errmsg);
+	    return false;
+	}
+	if(stk_SendLogSvr((void*)rep ,rep->msgType, stkName, errmsg, true) == -1){
+	    sprintf(errmsg,"ERROR: STK[%s] rConnect send log transfer fail",stkName);
+        logMessage(ERROR, errmsg);
+    }
+    sprintf(errmsg,"INFO : STK[%s] rConnect end  RESULT[%d]", 
+                                                    stkName, rep->result);                                                    
+    logMessage(INFO, errmsg);
+    return true;
+}
+
+/*****************************************************************************/
+/* 1. Function Name: stk_rPhysicalToLogicalSensor                            */
+/* 2. Description  : STK IRT name û ó                                  */
 /* 3. Parameters   : int   csock     - Client  ũ                */
-/*                   int   ridsock   - ridian server  ũ         */
-/*                   char* recvBuf   - recv  ޼                        */
+/*                   STK_VIEW *v     - recv  ޼ view                   */
 /*                   char* stkName   - STK name                              */
-/*                   int stkType     - STK type                              */
+/*                   char* errMsg    - Error Message                         */
+/* 4. Return Value : int                                                     */
+/*****************************************************************************/
+int stk_rPhysicalToLogicalSensor(int csock, STK_VIEW *v, char *stkName, char *errmsg)
+{
+    char irtName[30]={0,};
+    rGenRequest *req = (rGenRequest *)v->buf;
+    
+    rGenReply trep, *rep;
+    rep = &trep;
+    memset(rep,0x00,sizeof(rGenReply));
+    
+    sprintf(errmsg,"INFO : STK[%s] rPhysicalToLogicalSensor start  IRTID[%s]", 
+                                                    stkName, req->physicalID);
+    logMessage(INFO, errmsg);
+    
+    if(stk_RecvLogSvr((void*)v->buf ,v->type, stkName, errmsg, true) == -1){
+        sprintf(errmsg, "ERROR: STK[%s] rPhysicalToLogicalSensor recv log transfer fail", stkName);
+        logMessage(INFO, errmsg);
+    }
+    
+    if(GetIrtNameByIrt(req->physicalID, irtName, errmsg) < 0){
+        logMessage(ERROR, errmsg);
+        rep->msgLen	    = sizeof(rGenReply);
+    	rep->msgType	= msgTypePTLSensor;
+    	rep->result	    = 11;
+    	strcpy(rep->physicalID,req->physicalID);
+    	strcpy(rep->logicalName,"");
+        
+        if(stk_writeReply(csock, rep, sizeof(rGenReply)) == false){
+            sprintf(errmsg,"ERROR: STK[%s] disconnet network",stkName);
+    	    logMessage(ERROR, errmsg);
+    	    return false;
+    	}
+    	if(stk_SendLogSvr((void*)rep ,rep->msgType, stkName, errmsg, true) == -1){
+            sprintf(errmsg, "ERROR: STK[%s] rPhysicalToLogicalSensor send log transfer fail", stkName);
+            logMessage(ERROR, errmsg);
+        }
+        
+        sprintf(errmsg,"INFO : STK[%s] rPhysicalToLogicalSensor end  RESULT[%d], IRTID[%s], PORTID[%s]", 
+                                                        stkName, rep->result, rep->physicalID, rep->logicalName);
+        logMessage(INFO, errmsg);
+        return false;
+    }
+    
+    rep->msgLen	    = sizeof(rGenReply);
+	rep->msgType	= msgTypePTLSensor;
+	rep->result	    = 0;
+	strcpy(rep->physicalID,req->physicalID);
+	strcpy(rep->logicalName,irtName);
+    
+    if(stk_writeReply(csock, rep, sizeof(rGenReply)) == false){
+        sprintf(errmsg,"ERROR: STK[%s] disconnet network",stkName);
+	    logMessage(ERROR, errmsg);
+	    return false;
+	}
+	if(stk_SendLogSvr((void*)rep ,rep->msgType, stkName, errmsg, true) == -1){
+        sprintf(errmsg, "ERROR: STK[%s] rPhysicalToLogicalSensor send log transfer fail", stkName);
+        logMessage(ERROR, errmsg);
+    }
+    
+    sprintf(errmsg,"INFO : STK[%s] rPhysicalToLogicalSensor end  RESULT[%d], IRTID[%s], PORTID[%s]", 
+                                            stkName, rep->result, rep->physicalID, rep->logicalName);
+    logMessage(INFO, errmsg);
+    return true;
+} 
+
+/*****************************************************************************/
+/* 1. Function Name: stk_rLogicalToPhysicalSensor                            */
+/* 2. Description  : STK IRT name û ó                                  */
+/* 3. Parameters   : char* portName  - STK portName                          */
+/*                   STK_PROFILE *prof - STK profile                         */
+/*                   char* errMsg    - Error Message                         */
+/* 4. Return Value : int                                                     */
+/*****************************************************************************/
+int stk_rLogicalToPhysicalSensor(char *portName, STK_PROFILE *prof, char *errmsg)
+{
+    char *stkName = prof->stkName;      /* profile  STK name */
+    int reqLen;
+    rGenRequest treq, *req;
+    req = &treq;
+    memset(req, 0x00, sizeof(rGenRequest));
+    
+    reqLen = sizeof(rGenRequest);
+    req->msgLen = sizeof(rGenRequest);
+    req->msgType = msgTypeLTPSensor;
+    memcpy(req->logicalName, portName, strlen(portName));
+        
+    rGenReply trep, *rep;
+    rep = &trep;
+    memset(rep,0x00,sizeof(rGenReply));
+    
+    sprintf(errmsg,"INFO : STK[%s] stk_rLogicalToPhysicalSensor start  PORTID[%s]", 
+                                                            stkName, req->logicalName);
+    logMessage(INFO, errmsg);
+    
+    if(rid_SendRecv((char*)req, reqLen, (char*)rep, sizeof(rGenReply), prof)=='K'){
+        if(rep->result == 0){
+        } else {
+            sprintf(errmsg, "ERROR: STK[%s] stk_rLogicalToPhysicalSensor PORTID[%s] is not existe", stkName, req->logicalName);
+            return 1;
+        }
+    } else {
+        memset(rep,0x00,sizeof(rGenReply));
+        sprintf(errmsg, "ERROR: STK[%s] stk_rLogicalToPhysicalSensor ridian send and recv fail.", stkName);
+        return false;
+    }
+    
+    sprintf(errmsg,"INFO : STK[%s] rPhysicalToLogicalSensor end  RESULT[%d], IRTID[%s], PORTID[%s]", 
+                                            stkName, rep->result, rep->physicalID, rep->logicalName);
+    logMessage(INFO, errmsg);
+    return true;
+} 
+
+/*****************************************************************************/
+/* 1. Function Name: stk_rLogicalToPhysicalUnit                              */
+/* 2. Description  : tag ID û                                             */
+/* 3. Parameters   : int   csock     - Client  ũ                */
+/*                   char* tagID     - Teltag ID                             */ 
+/*                   char* logicalID - Logical ID                            */
+/*                   STK_PROFILE *prof - STK profile                         */
+/*                   char* errMsg    - Error Message                         */
+/* 4. Return Value : int                                                     */
+/*****************************************************************************/
+int stk_rLogicalToPhysicalUnit(int csock, char *tagID, char *logicalID, STK_PROFILE *prof, char *errmsg)
+{
+    char *stkName = prof->stkName;      /* profile  STK name */
+    rGenRequest treq, *req;
+    req = &treq;
+    memset(req, 0x00, sizeof(rGenRequest));
+    unsigned short int reqLen;
+    
+    rGenReply trep, *rep;
+    rep = &trep;
+    memset(rep,0x00,sizeof(rGenReply));
+    
+    sprintf(errmsg,"INFO : STK[%s] rLogicalToPhysicalUnit start  LOGICALID[%s]", 
+                                                    stkName, logicalID);
+    logMessage(INFO, errmsg);
+    
+    req->msgLen = sizeof(rGenRequest);
+    req->msgType = msgTypeLTPUnit;
+    req->itemType = 0;
+    memcpy(req->logicalName, logicalID, strlen(logicalID));
+    reqLen = sizeof(rGenRequest);
+    
+    if(rid_SendRecv((char*)req, reqLen, (char*)rep, sizeof(rGenReply), prof)=='K'){
+        if(rep->result == 0){
+            memcpy(tagID, rep->physicalID, strlen(rep->physicalID));
+        } else {
+            tagID[0] = '\0';
+        }
+    } else {
+        sprintf(errmsg, "ERROR: STK[%s] rLogicalToPhysicalUnit ridian send and recv fail.", stkName);
+        return false;
+    }
+    
+    sprintf(errmsg,"INFO : STK[%s] rLogicalToPhysicalUnit end  RESULT[%d], TAGID[%s], LOGICALID[%s]", 
+                                            stkName, rep->result, rep->physicalID, rep->logicalName);
+    logMessage(INFO, errmsg);
+    return true;
+}
+
+/*****************************************************************************/
+/* 1. Function Name: stk_rListUnitAtIrt                                      */
+/* 2. Description  : STK Teltag read û ó                               */
+/* 3. Parameters   : int   csock     - Client  ũ                */
+/*                   STK_VIEW *v     - recv  ޼ view                   */
+/*                   STK_PROFILE *prof - STK profile                         */
 /*                   PortTable *pt   - STK PORT                          */
 /*                   char* errMsg    - Error Message                         */
 /* 4. Return Value : int                                                     */
 /*****************************************************************************/
-int stk_rListUnitAtIrt(int csock, int *ridsock, char *recvBuf, char *stkName, int stkType, char *errmsg)
+int stk_rListUnitAtIrt(int csock, STK_VIEW *v, STK_PROFILE *prof, char *errmsg)
 {
+    char *stkName = prof->stkName;      /* profile  STK name */
+    int  stkType = prof->stkType;       /* profile  STK type */
     char tag, bcr, useTag;                  /* TelTag, Barcode پִ Ȯϴ flag */
     int  bcrResult,ridResult;               /*  BCR    */
     char bcrIP[20]={0,};                    /*  BCR IP   */
@@ -1541,6 +3846,8 @@ int stk_rListUnitAtIrt(int csock, int *ridsock, char *recvBuf, char *stkName, in
     char portType[2]={0,};                  /* Port Type   */
     char tmpTagID[12]={0,};                 /* Temp Tag ID */
 	char cstName[31]={0,};                    /* LOT ID   */
+    BCR_READ br;                            /* Ridian ȸ   barcode read */
+    struct timespec ts;                     /* stage trace  ð */
 
 	int i_Ret = 0;
 
@@ -1548,14 +3855,12 @@ int stk_rListUnitAtIrt(int csock, int *ridsock, char *recvBuf, char *stkName, in
 
     tag = 'N';                              /* TelTag Ⱦٰ ʱȭŲ. */
     
-    rQuerySensorRequest treq, *req;
+    rQuerySensorRequest *req = (rQuerySensorRequest *)v->buf;
+    rQuerySensorRequest fwd;                /* Ridian   host order û */
     rQuerySensorReply trep, *rep;
     rep = &trep;
-    req = & treq;
     
-    memset(req, 0x00, sizeof(rQuerySensorRequest));
     memset(rep, 0x00, sizeof(rQuerySensorReply));
-    memcpy(req, recvBuf, sizeof(rQuerySensorRequest));
         
     reqLen = sizeof(rQuerySensorRequest);
     repLen = sizeof(rQuerySensorReply);  
@@ -1563,50 +3868,46 @@ int stk_rListUnitAtIrt(int csock, int *ridsock, char *recvBuf, char *stkName, in
     sprintf(errmsg,"INFO : STK[%s] rListUnitAtIrt start  PORTID[%s]", stkName, req->nameList.name);
     logMessage(INFO, errmsg);
     
-    stk_rListUnitAtIrt_hton(req);
-    if(stk_RecvLogSvr((void*)req ,req->msgType, stkName, errmsg, true) == -1){
+    if(stk_RecvLogSvr((void*)v->buf ,v->type, stkName, errmsg, true) == -1){
         sprintf(errmsg, "ERROR: STK[%s] rListUnitAtIrt recv log transfer fail", stkName);
         logMessage(ERROR, errmsg);
     }
 
     strcpy(irtName,req->nameList.name);
+    trace_ctx(irtName, NULL);
 
-    if(GetBcrIPByIrt(irtName, irtID, portType, bcrIP, errmsg) < 0){
+    trace_now(&ts);
+    i_Ret = GetBcrIPByIrt(irtName, irtID, portType, bcrIP, errmsg);
+    trace_span("GetBcrIPByIrt", &ts);
+    if(i_Ret < 0){
         logMessage(ERROR, errmsg);
-        stk_rListUnitAtIrtErrReply(csock, recvBuf, stkName, stkType, errmsg);
+        stk_rListUnitAtIrtErrReply(csock, v->buf, stkName, stkType, errmsg);
         return true;
     }
-    if(stkType == LOTPODTYPE){
-        if(gLotParallelMaint == 1){
-            ridResult = stk_rLogicalToPhysicalSensor(ridsock, irtName, stkName, errmsg);
-            if(ridResult == false){
-                logMessage(ERROR, errmsg);
-                stk_rListUnitAtIrtErrReply(csock, recvBuf, stkName, stkType, errmsg);
-                return false;
-            } else if(ridResult == 1){
-                logMessage(ERROR, errmsg);
-                return stk_rListUnitAtIrtErrReply(csock, recvBuf, stkName, stkType, errmsg);
-            }
-        }
-    } else {
-        if(gReticleParallelMaint == 1){
-            ridResult = stk_rLogicalToPhysicalSensor(ridsock, irtName, stkName, errmsg);
-            if(ridResult == false){
-                logMessage(ERROR, errmsg);
-                stk_rListUnitAtIrtErrReply(csock, recvBuf, stkName, stkType, errmsg);
-                return false;
-            } else if(ridResult == 1){
-                logMessage(ERROR, errmsg);
-                return stk_rListUnitAtIrtErrReply(csock, recvBuf, stkName, stkType, errmsg);
-            }
+    /* ڵ  õ : BCR   LogicalToPhysicalSensor ȸ͸
+     * ÿ Ѵ. QuerySensorLoc    BCR read  ASML
+     * ˻簡  ڿ  */
+    bcr_readStart(&br, bcrIP, prof);
+
+    if(prof->parallel == 1){
+        ridResult = stk_rLogicalToPhysicalSensor(irtName, prof, errmsg);
+        if(ridResult == false){
+            bcr_readJoin(&br);
+            logMessage(ERROR, errmsg);
+            stk_rListUnitAtIrtErrReply(csock, v->buf, stkName, stkType, errmsg);
+            return false;
+        } else if(ridResult == 1){
+            bcr_readJoin(&br);
+            logMessage(ERROR, errmsg);
+            return stk_rListUnitAtIrtErrReply(csock, v->buf, stkName, stkType, errmsg);
         }
     }
-    
-    /* ڵ  õ */
-    bcrResult = bcr_SendRecv(bcrIP, barcodeID, stkName, errmsg);
+    bcr_readJoin(&br);
+    bcrResult = br.result;
+    memcpy(barcodeID, br.barcodeID, sizeof(barcodeID));
 
 	/*ASML  Type Pod   Reticle ID  ݴ  */
-	if ( 0 == memcmp (stkName, "CRST", 4) &&  barcodeID[0] == 'R' )
+	if ( prof->asmlCheck == 1 &&  barcodeID[0] == 'R' )
 	{
 		i_Ret = getCstName (barcodeID, cstName, errmsg);
 
@@ -1619,7 +3920,7 @@ int stk_rListUnitAtIrt(int csock, int *ridsock, char *recvBuf, char *stkName, in
 		{
             sprintf(errmsg, "ASML INTERLOCK STK[%s] CST_ID[%s] CST_NAME[%s]", stkName, barcodeID, cstName);
             logMessage(ERROR, errmsg);
-            stk_rListUnitAtIrtErrReply(csock, recvBuf, stkName, stkType, errmsg);
+            stk_rListUnitAtIrtErrReply(csock, v->buf, stkName, stkType, errmsg);
             return true;
 		}
 	}
@@ -1627,46 +3928,45 @@ int stk_rListUnitAtIrt(int csock, int *ridsock, char *recvBuf, char *stkName, in
     if(bcrResult == 0){
         bcr = 'Y';
 
-        if ( 0 == memcmp (stkName, "CPST", 4))
+        if ( prof->emptyLot == 1 )
         {
             if(GetLogicalIDByBcrIDEmpty(barcodeID, lotID, errmsg) == false){
                 logMessage(ERROR, errmsg);
-                return stk_rListUnitAtIrtErrReply(csock, recvBuf, stkName, stkType, errmsg);
+                return stk_rListUnitAtIrtErrReply(csock, v->buf, stkName, stkType, errmsg);
             }
         }
         else
         {
             if(GetLogicalIDByBcrID(barcodeID, lotID, errmsg) == false){
                 logMessage(ERROR, errmsg);
-                return stk_rListUnitAtIrtErrReply(csock, recvBuf, stkName, stkType, errmsg);
+                return stk_rListUnitAtIrtErrReply(csock, v->buf, stkName, stkType, errmsg);
             }
         }
     } else {
         if(stkType == LOTPODTYPE){
-            if(gLotParallelMaint == 0){
+            if(prof->parallel == 0){
                 sprintf(errmsg, "ERROR: STK[%s] BCRIP[%s] read fail", stkName, bcrIP);
                 logMessage(ERROR, errmsg);
-                stk_rListUnitAtIrtErrReply(csock, recvBuf, stkName, stkType, errmsg);
+                stk_rListUnitAtIrtErrReply(csock, v->buf, stkName, stkType, errmsg);
                 return true;
             }
         } else {
             sprintf(errmsg, "ERROR: STK[%s] BCRIP[%s] read fail", stkName, bcrIP);
             logMessage(ERROR, errmsg);
-            return stk_rListUnitAtIrtErrReply(csock, recvBuf, stkName, stkType, errmsg);
+            return stk_rListUnitAtIrtErrReply(csock, v->buf, stkName, stkType, errmsg);
         }
         bcr = 'N';
     }
-    ridResult = rid_SendRecv(ridsock, (char*)req, reqLen, (char*)rep, repLen, stkName);
+    view_decode(v, &fwd, reqLen);
+    ridResult = rid_SendRecv((char*)&fwd, reqLen, (char*)rep, repLen, prof);
     if(ridResult == 'K'){
         if(rep->result != 0){
-            stk_rListUnitAtIrt_ntoh(rep);
-            if(write(csock, rep, sizeof(rQuerySensorReply)) <= 0){
+            if(stk_writeReply(csock, rep, sizeof(rQuerySensorReply)) == false){
                 sprintf(errmsg,"ERROR: STK[%s] disconnet network",stkName);
         	    logMessage(ERROR, errmsg);
         	    return false;
         	}
 
-        	stk_rListUnitAtIrt_ntoh(rep);
         	if(stk_SendLogSvr((void*)rep ,rep->msgType, stkName, errmsg, true) == -1){
                 sprintf(errmsg,"ERROR: STK[%s] rListUnitAtIrt send log transfer fail", stkName);
                 logMessage(ERROR, errmsg);
@@ -1684,19 +3984,13 @@ int stk_rListUnitAtIrt(int csock, int *ridsock, char *recvBuf, char *stkName, in
             } else {
                 sprintf(errmsg,"ERROR: STK[%s] ridian TAGID reading fail unknown tagID", stkName);
                 logMessage(ERROR, errmsg);
-                return stk_rListUnitAtIrtErrReply(csock, recvBuf, stkName, stkType, errmsg);
+                return stk_rListUnitAtIrtErrReply(csock, v->buf, stkName, stkType, errmsg);
             }
-            if(gReticleParallelMaint == 1 && stkType != LOTPODTYPE){
+            if(prof->parallel == 1){
                 if(strlen(rep->responseMsg.unitID) == 0 || rep->responseMsg.unitID[0]==' '){
                     sprintf(errmsg,"ERROR: STK[%s] ridian TAGID reading fail", stkName);
                     logMessage(ERROR, errmsg);
-                    return stk_rListUnitAtIrtErrReply(csock, recvBuf, stkName, stkType, errmsg);
-                }
-            } else if(gLotParallelMaint == 1 && stkType == LOTPODTYPE){
-                if(strlen(rep->responseMsg.unitID) == 0 || rep->responseMsg.unitID[0]==' '){
-                    sprintf(errmsg,"ERROR: STK[%s] ridian TAGID reading fail", stkName);
-                    logMessage(ERROR, errmsg);
-                    return stk_rListUnitAtIrtErrReply(csock, recvBuf, stkName, stkType, errmsg);
+                    return stk_rListUnitAtIrtErrReply(csock, v->buf, stkName, stkType, errmsg);
                 }
             }
         }
@@ -1709,44 +4003,44 @@ int stk_rListUnitAtIrt(int csock, int *ridsock, char *recvBuf, char *stkName, in
             memcpy(teltag, rep->responseMsg.unitID, strlen(rep->responseMsg.unitID));
             /* ڵ尡   */
             if(bcr == 'Y'){
-                if(gReticleParallelMaint == 1 && stkType != LOTPODTYPE){
+                if(prof->parallel == 1 && stkType != LOTPODTYPE){
                     if(GetTagIDByBcrID(barcodeID, tmpTagID, errmsg) == false){
                         if(InsertBcrTagMapping(barcodeID, teltag, stkName, errmsg) == false){
                             logMessage(ERROR, errmsg);
-                            return stk_rListUnitAtIrtErrReply(csock, recvBuf, stkName, stkType, errmsg);
+                            return stk_rListUnitAtIrtErrReply(csock, v->buf, stkName, stkType, errmsg);
                         }
                     } else {
                         if(strcmp(teltag, tmpTagID) != 0){
                             sprintf(errmsg, "ERROR: STK[%s] LTSBCRTAG table wrong info CSTID[%s] DBTAG[%s] READTAG[%s]",
                                                                         stkName, barcodeID, tmpTagID,teltag);
                             logMessage(ERROR, errmsg);
-                            return stk_rListUnitAtIrtErrReply(csock, recvBuf, stkName, stkType, errmsg);
+                            return stk_rListUnitAtIrtErrReply(csock, v->buf, stkName, stkType, errmsg);
                         }
                     }
                 }
                 if(strlen(rep->responseMsg.unitName) == 0 && strlen(lotID) > 0){
                     /*  Teltag bcr  Ʋ ƾ */
-                    if(lts_rDisassociateUnit(stkType,stkName,barcodeID,lotID,irtName,errmsg) == false){
+                    if(lts_rDisassociateUnit(prof,barcodeID,lotID,irtName,errmsg) == false){
                         logMessage(ERROR, errmsg);
-                        return stk_rListUnitAtIrtErrReply(csock, recvBuf, stkName, stkType, errmsg);
+                        return stk_rListUnitAtIrtErrReply(csock, v->buf, stkName, stkType, errmsg);
                     }
                     memset(lotID, 0x00, sizeof(lotID));
                 } else if(strlen(rep->responseMsg.unitName) > 0 && strlen(lotID) == 0){
-                    if(lts_rAssociateUnit(stkType,stkName,barcodeID,rep->responseMsg.unitName,irtName,errmsg) == false){
+                    if(lts_rAssociateUnit(prof,barcodeID,rep->responseMsg.unitName,irtName,errmsg) == false){
                         logMessage(ERROR, errmsg);
-                        return stk_rListUnitAtIrtErrReply(csock, recvBuf, stkName, stkType, errmsg);
+                        return stk_rListUnitAtIrtErrReply(csock, v->buf, stkName, stkType, errmsg);
                     }
                     memset(lotID, 0x00, sizeof(lotID));
                     memcpy(lotID, rep->responseMsg.unitName, strlen(rep->responseMsg.unitName));
                 } else if(strlen(rep->responseMsg.unitName) > 0 && strlen(lotID) > 0){
                     if(memcmp(lotID,rep->responseMsg.unitName,strlen(lotID)) != 0){
-                        if(lts_rDisassociateUnit(stkType,stkName,barcodeID,lotID,irtName,errmsg) == false){
+                        if(lts_rDisassociateUnit(prof,barcodeID,lotID,irtName,errmsg) == false){
                             logMessage(ERROR, errmsg);
-                            return stk_rListUnitAtIrtErrReply(csock, recvBuf, stkName, stkType, errmsg);
+                            return stk_rListUnitAtIrtErrReply(csock, v->buf, stkName, stkType, errmsg);
                         }                     
-                        if(lts_rAssociateUnit(stkType,stkName,barcodeID,rep->responseMsg.unitName,irtName,errmsg) == false){
+                        if(lts_rAssociateUnit(prof,barcodeID,rep->responseMsg.unitName,irtName,errmsg) == false){
                             logMessage(ERROR, errmsg);
-                            return stk_rListUnitAtIrtErrReply(csock, recvBuf, stkName, stkType, errmsg);
+                            return stk_rListUnitAtIrtErrReply(csock, v->buf, stkName, stkType, errmsg);
                         }
                         memset(lotID, 0x00, sizeof(lotID));
                         memcpy(lotID, rep->responseMsg.unitName, strlen(rep->responseMsg.unitName));
@@ -1762,7 +4056,7 @@ int stk_rListUnitAtIrt(int csock, int *ridsock, char *recvBuf, char *stkName, in
 	    memset(rep, 0x00, sizeof(rQuerySensorReply));
 	    sprintf(errmsg,"ERROR: STK[%s] ridian msg send and recv fail",stkName);
 	    logMessage(ERROR, errmsg);
-	    stk_rListUnitAtIrtErrReply(csock, recvBuf, stkName, stkType, errmsg);
+	    stk_rListUnitAtIrtErrReply(csock, v->buf, stkName, stkType, errmsg);
 	    return false;
 	}
     
@@ -1775,7 +4069,7 @@ int stk_rListUnitAtIrt(int csock, int *ridsock, char *recvBuf, char *stkName, in
     } else {
         sprintf(errmsg,"ERROR: STK[%s] must use teltag or barcode",stkName);
     	logMessage(ERROR, errmsg);
-        return stk_rListUnitAtIrtErrReply(csock, recvBuf, stkName, stkType, errmsg);
+        return stk_rListUnitAtIrtErrReply(csock, v->buf, stkName, stkType, errmsg);
     }
     
     sprintf(errmsg,"INFO : STK[%s] PORTID[%s], USETAG[%c], TAGID[%s], CSTID[%s], LOGICALID[%s], PORTTYPE[%s]", 
@@ -1814,13 +4108,13 @@ int stk_rListUnitAtIrt(int csock, int *ridsock, char *recvBuf, char *stkName, in
             if(strlen(lotID) == 0 || lotID[0] == NULL || lotID[0] == ' '){
                 sprintf(errmsg,"ERROR: STK[%s] must logicalID connected CSTID[%s]",stkName, barcodeID);
             	logMessage(ERROR, errmsg);
-                return stk_rListUnitAtIrtErrReply(csock, recvBuf, stkName, stkType, errmsg);
+                return stk_rListUnitAtIrtErrReply(csock, v->buf, stkName, stkType, errmsg);
             }
             sprintf(errmsg, "INFO : STK[%s] podtype LOGICALID[%s] input start", stkName, lotID);
             logMessage(INFO, errmsg);
-            if(lts_inputRequest(stkType, stkName, barcodeID, lotID, irtName, errmsg) == false){
+            if(lts_inputRequest(prof, barcodeID, lotID, irtName, errmsg) == false){
                 if(useTag == 'B'){
-                    return stk_rListUnitAtIrtErrReply(csock, recvBuf, stkName, stkType, errmsg);
+                    return stk_rListUnitAtIrtErrReply(csock, v->buf, stkName, stkType, errmsg);
                 }
             }
             sprintf(errmsg, "INFO : STK[%s] podtype LOGICALID[%s] input end", stkName, lotID);
@@ -1829,13 +4123,13 @@ int stk_rListUnitAtIrt(int csock, int *ridsock, char *recvBuf, char *stkName, in
             if(strlen(lotID) == 0 || lotID[0] == NULL || lotID[0] == ' '){
                 sprintf(errmsg,"ERROR: STK[%s] must logicalID connected CSTID[%s]",stkName, barcodeID);
             	logMessage(ERROR, errmsg);
-                return stk_rListUnitAtIrtErrReply(csock, recvBuf, stkName, stkType, errmsg);
+                return stk_rListUnitAtIrtErrReply(csock, v->buf, stkName, stkType, errmsg);
             }
             sprintf(errmsg, "INFO : STK[%s] podtype LOGICALID[%s] output start", stkName, lotID);
             logMessage(INFO, errmsg);  
-            if(lts_outputRequest(stkType, stkName, barcodeID, lotID, irtName, errmsg) == false){
+            if(lts_outputRequest(prof, barcodeID, lotID, irtName, errmsg) == false){
                 if(useTag=='B'){
-                    return stk_rListUnitAtIrtErrReply(csock, recvBuf, stkName, stkType, errmsg);
+                    return stk_rListUnitAtIrtErrReply(csock, v->buf, stkName, stkType, errmsg);
                 }
             }
             sprintf(errmsg, "INFO : STK[%s] podtype LOGICALID[%s], output end", stkName, lotID);
@@ -1843,14 +4137,18 @@ int stk_rListUnitAtIrt(int csock, int *ridsock, char *recvBuf, char *stkName, in
         }
     }
     
-    stk_rListUnitAtIrt_ntoh(rep);
-    if(write(csock, rep, sizeof(rQuerySensorReply)) <= 0){
+    trace_ctx(NULL, lotID);
+    /* ̾  rReadMemory(0x400~)   LOT  ̸ ȸ */
+    if(stkType == LOTPODTYPE && lotID[0] != NULL && lotID[0] != ' '){
+        lot_prefetch(lotID);
+    }
+    
+    if(stk_writeReply(csock, rep, sizeof(rQuerySensorReply)) == false){
         sprintf(errmsg,"ERROR: STK[%s] disconnet network",stkName);
 	    logMessage(ERROR, errmsg);
 	    return false;
 	}
 	
-	stk_rListUnitAtIrt_ntoh(rep);
 	if(stk_SendLogSvr((void*)rep ,rep->msgType, stkName, errmsg, true) == -1){
 	    sprintf(errmsg, "ERROR: STK[%s] rListUnitAtIrt send log transfer fail", stkName);
         logMessage(ERROR, errmsg);
@@ -1875,35 +4173,17 @@ int stk_rListUnitAtIrt(int csock, int *ridsock, char *recvBuf, char *stkName, in
 /*****************************************************************************/
 int stk_rListUnitAtIrtErrReply(int csock, char *recvBuf, char *stkName, int stkType, char *errmsg)
 {
-    rQuerySensorReply trep, *rep;
-    rep = &trep;
-    memset(rep, 0x00, sizeof(rQuerySensorReply));
+    REPLY_TPL *t = tpl_find(msgTypeQuerySensorLoc, TPL_ERR);
+    rQuerySensorReply *rep = (rQuerySensorReply *)t->host;
     sprintf(errmsg,"ERROR: STK[%s] rListUnitAtIrt error reply start ", stkName);
     logMessage(ERROR, errmsg);
-    time_t ctime    = time(&ctime);
-    memset(rep,0x00,sizeof(rQuerySensorReply));
-    rep->msgLen     = sizeof(rQuerySensorReply);
-    rep->msgType	= msgTypeQuerySensorLoc;
-    rep->lastFlag   = 1;
-    rep->result	    = 11;
-    rep->totalNum	= 0;
-    rep->numItems	= 0; 
-	rep->responseMsg.unittype		= 1;
-	rep->responseMsg.updateTime	    = ctime;
-	rep->responseMsg.moveTime		= ctime;
-	rep->responseMsg.motionTime	    = ctime;
-	rep->responseMsg.unitCategory	= 1;
-	rep->responseMsg.sensorCategory = 1;
-	rep->responseMsg.unitTransit	= 0;
 	
-	stk_rListUnitAtIrt_ntoh(rep);
-    if(write(csock, rep, sizeof(rQuerySensorReply)) <= 0){
+    if(tpl_send(csock, t) == false){
         sprintf(errmsg,"ERROR: STK[%s] disconnet network...",stkName);
 	    logMessage(ERROR, errmsg);
 	    return false;
 	}
 	
-	stk_rListUnitAtIrt_ntoh(rep);
 	if(stk_SendLogSvr((void*)rep ,rep->msgType, stkName, errmsg, true) == -1){
 	    sprintf(errmsg,"ERROR: STK[%s] rListUnitAtIrt send log transfer fail", stkName);
         logMessage(ERROR, errmsg);
@@ -1919,31 +4199,29 @@ int stk_rListUnitAtIrtErrReply(int csock, char *recvBuf, char *stkName, int stkT
 /* 1. Function Name: stk_rReadMemory                                         */
 /* 2. Description  : STK Logical info û                                   */
 /* 3. Parameters   : int   csock     - Client  ũ                */
-/*                   char* recvBuf   - recv  ޼                        */
-/*                   char* stkName   - STK name                              */
-/*                   int stkType     - STK type                              */
+/*                   STK_VIEW *v     - recv  ޼ view                   */
+/*                   STK_PROFILE *prof - STK profile                         */
 /*                   char* lotInfo   - LOT                           */
 /*                   PortTable *pt   - STK PORT                          */
 /*                   char* errMsg    - Error Message                         */
 /* 4. Return Value : int                                                     */
 /*****************************************************************************/
-int stk_rReadMemory(int csock, char *recvBuf, char *stkName, int stkType, char *lotInfo, char *errmsg)
+int stk_rReadMemory(int csock, STK_VIEW *v, STK_PROFILE *prof, char *lotInfo, char *errmsg)
 {
+    char *stkName = prof->stkName;      /* profile  STK name */
+    int  stkType = prof->stkType;       /* profile  STK type */
     unsigned int address=0x00;
+    int  ret, gen;
     char readData[17]={0,};
-    rReadRAMRequest treq, *req;
-    req = &treq;
-    memset(req, 0x00, sizeof(rReadRAMRequest));
-    memcpy(req, recvBuf, sizeof(rReadRAMRequest));              
-    address = bigToLittl(req->addr);
+    rReadRAMRequest *req = (rReadRAMRequest *)v->buf;
+    address = VIEW_U32(v, rReadRAMRequest, addr);
+    trace_ctx(NULL, req->unitName);
     
     sprintf(errmsg,"INFO : STK[%s] rReadMemory start LOGICALID[%s], ADDR=[0x%X]",
                                             stkName, req->unitName, address);
     logMessage(INFO, errmsg);
     
-    stk_rReadMemory_hton(req);
-    
-    if(stk_RecvLogSvr((void*)req ,req->msgType, stkName, errmsg, true) == -1){
+    if(stk_RecvLogSvr((void*)v->buf ,v->type, stkName, errmsg, true) == -1){
         sprintf(errmsg, "ERROR: STK[%s] rReadMemory recv log transfer fail", stkName);
         logMessage(ERROR, errmsg);
     }
@@ -1951,18 +4229,31 @@ int stk_rReadMemory(int csock, char *recvBuf, char *stkName, int stkType, char *
     rReadRAMReply trep, *rep;
     rep = &trep;
     memset(rep,0x00,sizeof(rReadRAMReply));
-    rep->msgLen     = bigToLitts(sizeof(rReadRAMReply));
+    rep->msgLen     = sizeof(rReadRAMReply);
 	rep->msgType    = msgTypeReadMemory;
-	rep->result	    = bigToLitts(0);
+	rep->result	    = 0;
 	
 	if(stkType == LOTPODTYPE){
     	if(address == 0x400){
     	    memset(lotInfo, 0x00, 32*6);
-	        if(GetLotInfo(req->unitName, lotInfo, errmsg) == false){
-	            rep->result = bigToLitts(11);
+    	    /* prefetch  >  cache > DB ȸ  */
+    	    ret = lot_prefetchTake(req->unitName, lotInfo, errmsg);
+    	    if(ret < 0 && lotc_read(req->unitName, 0, LOTINFO_SIZE, lotInfo) == true){
+    	        ret = true;
+    	    }
+    	    if(ret < 0){
+    	        gen = lotc_gen(req->unitName);
+    	        ret = GetLotInfo(req->unitName, lotInfo, errmsg);
+    	        if(ret == true){
+    	            lotc_put(req->unitName, lotInfo, gen);
+    	        }
+    	    }
+	        if(ret == false){
+	            rep->result = 11;
 	        }                    	    
 	    }
     	if(address <= 0x490){
+    	    /* 0x400~0x490   0x400  session 纻 д´ */
     	    memcpy(rep->data,&lotInfo[address-0x400], READLEN);
     	    if(address == 0x490){
     	        memset(lotInfo, 0x00, 32*6);
@@ -1978,14 +4269,13 @@ int stk_rReadMemory(int csock, char *recvBuf, char *stkName, int stkType, char *
 	        memcpy(rep->data,"                ", READLEN);
 	    }
 	}
-	rep->addr = bigToLittl(address);
+	rep->addr = address;
 	
-	if(write(csock, rep, sizeof(rReadRAMReply)) <= 0){
+	if(stk_writeReply(csock, rep, sizeof(rReadRAMReply)) == false){
 	    sprintf(errmsg,"ERROR: STK[%s] disconnet network...",stkName);
 	    logMessage(ERROR, errmsg);
         return false;
 	}
-	stk_rReadMemory_ntoh(rep);
 	if(stk_SendLogSvr((void*)rep ,rep->msgType, stkName, errmsg, true) == -1){
         sprintf(errmsg, "ERROR: STK[%s] rReadMemory send log transfer fail", stkName);
         logMessage(ERROR, errmsg);
@@ -2013,19 +4303,14 @@ int stk_rReadMemoryErrReply(int csock, char *recvBuf, char *stkName, int stkType
     sprintf(errmsg,"ERROR: STK[%s] rReadMemory error reply start ", stkName);
     logMessage(ERROR, errmsg);
     
-    rReadRAMReply trep, *rep;
-    rep = &trep;
-    memset(rep,0x00,sizeof(rReadRAMReply));
-    rep->msgLen     = bigToLitts(sizeof(rReadRAMReply));
-	rep->msgType    = msgTypeReadMemory;
-	rep->result	    = bigToLitts(11);
+    REPLY_TPL *t = tpl_find(msgTypeReadMemory, TPL_ERR);
+    rReadRAMReply *rep = (rReadRAMReply *)t->host;
 		
-	if(write(csock, rep, sizeof(rReadRAMReply)) <= 0){
+	if(tpl_send(csock, t) == false){
 	    sprintf(errmsg,"ERROR: STK[%s] disconnet network...",stkName);
 	    logMessage(ERROR, errmsg);
         return false;
 	}
-	stk_rReadMemory_ntoh(rep);
 	if(stk_SendLogSvr((void*)rep ,rep->msgType, stkName, errmsg, true) == -1){
 	    sprintf(errmsg,"ERROR: STK[%s] rReadMemory send log transfer fail", stkName);
         logMessage(ERROR, errmsg);
@@ -2040,16 +4325,16 @@ int stk_rReadMemoryErrReply(int csock, char *recvBuf, char *stkName, int stkType
 /* 1. Function Name: stk_rAssociateUnit                                      */
 /* 2. Description  : STK Logical connect û ó                           */
 /* 3. Parameters   : int   csock     - Client  ũ                */
-/*                   int  *ridsock   - ridian server  ũ         */
-/*                   char* recvBuf   - recv  ޼                        */
-/*                   char* stkName   - STK name                              */
-/*                   int stkType     - STK type                              */
+/*                   STK_VIEW *v     - recv  ޼ view                   */
+/*                   STK_PROFILE *prof - STK profile                         */
 /*                   PortTable *pt   - STK PORT                          */
 /*                   char* errMsg    - Error Message                         */
 /* 4. Return Value : int                                                     */
 /*****************************************************************************/                                         
-int stk_rAssociateUnit(int csock, int *ridsock, char *recvBuf, char *stkName, int stkType, char *errmsg)
+int stk_rAssociateUnit(int csock, STK_VIEW *v, STK_PROFILE *prof, char *errmsg)
 {
+    char *stkName = prof->stkName;      /* profile  STK name */
+    int  stkType = prof->stkType;       /* profile  STK type */
     char bcrID[12]={0,};
     char tagID[12]={0,};
     unsigned short int reqLen;
@@ -2059,11 +4344,11 @@ int stk_rAssociateUnit(int csock, int *ridsock, char *recvBuf, char *stkName, in
     char receiver[200]={0,};
     char tmpLogicalID[24]={0,};
     
+    /* physicalID  TAG  ٲ Ridian  Ƿ host order 纻  */
     rGenRequest treq, *req;
     req = &treq;
-    memset(req, 0x00, sizeof(rGenRequest));
-    memcpy(req, recvBuf, sizeof(rGenRequest));
     reqLen = sizeof(rGenRequest);
+    view_decode(v, req, reqLen);
     
     rGenReply trep, *rep;
     rep = &trep;
@@ -2072,13 +4357,12 @@ int stk_rAssociateUnit(int csock, int *ridsock, char *recvBuf, char *stkName, in
     sprintf(errmsg,"INFO : STK[%s] rAssociateUnit start CSTID[%s], LOGICALID[%s]", stkName, req->physicalID, req->logicalName);
     logMessage(INFO, errmsg);
     
-    stk_rAssociateUnit_hton(req);
-    if(stk_RecvLogSvr((void*)req ,req->msgType, stkName, errmsg, true) == -1){
+    if(stk_RecvLogSvr((void*)v->buf ,v->type, stkName, errmsg, true) == -1){
         sprintf(errmsg, "ERROR: STK[%s] rAssociateUnit recv log transfer fail", stkName);
         logMessage(ERROR, errmsg);
     }
     
-    if(gReticleParallelMaint == 1 && stkType == RETICLEBARETYPE){
+    if(prof->parallel == 1 && stkType == RETICLEBARETYPE){
         if(GetTagIDByBcrID(req->physicalID, tagID, errmsg) == false){
             logMessage(ERROR, errmsg);
             sprintf(msg, "Connect error^BCR TAG not mapping^STK[%s]^BCR[%s]^RET[%s]", 
@@ -2086,7 +4370,7 @@ int stk_rAssociateUnit(int csock, int *ridsock, char *recvBuf, char *stkName, in
             if(hht_sendErrMsg(stkName, msg, errmsg) == false){
                 logMessage(ERROR, errmsg);
             }
-            return stk_rAssociateUnitErrReply(csock, recvBuf, stkName, stkType, errmsg);
+            return stk_rAssociateUnitErrReply(csock, v->buf, stkName, stkType, errmsg);
         }
         
         memcpy(bcrID, req->physicalID, strlen(req->physicalID));
@@ -2105,7 +4389,7 @@ int stk_rAssociateUnit(int csock, int *ridsock, char *recvBuf, char *stkName, in
                 logMessage(ERROR, errmsg);
                 sprintf(errmsg,"ERROR: STK[%s] vision system fail connect sequence end(error) CSTID[%s]",stkName, bcrID);
                 logMessage(ERROR, errmsg);
-                return stk_rAssociateUnitErrReply(csock, recvBuf, stkName, stkType, errmsg);
+                return stk_rAssociateUnitErrReply(csock, v->buf, stkName, stkType, errmsg);
             } else {
                 if(strlen(tmpLogicalID) != 0 && tmpLogicalID[0] != NULL){
                     memset(req->logicalName, 0x00, sizeof(req->logicalName));
@@ -2116,37 +4400,36 @@ int stk_rAssociateUnit(int csock, int *ridsock, char *recvBuf, char *stkName, in
                     logMessage(ERROR, errmsg);
                     sprintf(errmsg,"ERROR: STK[%s] vision system fail connect sequence end(error) CSTID[%s]",stkName, bcrID);
                     logMessage(ERROR, errmsg);
-                    return stk_rAssociateUnitErrReply(csock, recvBuf, stkName, stkType, errmsg);
+                    return stk_rAssociateUnitErrReply(csock, v->buf, stkName, stkType, errmsg);
                 }
             }
         */
         }
     }
     
-    if(lts_rAssociateUnit(stkType,stkName,bcrID,req->logicalName,stkName,errmsg) == false){
+    if(lts_rAssociateUnit(prof,bcrID,req->logicalName,stkName,errmsg) == false){
         logMessage(ERROR, errmsg);
         sprintf(msg, "Connect error^STK[%s]^BCR[%s]^RET[%s]", 
                                     stkName, req->physicalID, req->logicalName);
         if(hht_sendErrMsg(stkName, msg, errmsg) == false){
             logMessage(ERROR, errmsg);
         }
-        return stk_rAssociateUnitErrReply(csock, recvBuf, stkName, stkType, errmsg);
+        return stk_rAssociateUnitErrReply(csock, v->buf, stkName, stkType, errmsg);
     }
     
-    if(rid_SendRecv(ridsock, (char*)req, reqLen, (char*)rep, sizeof(rGenReply), stkName)=='K'){
+    if(rid_SendRecv((char*)req, reqLen, (char*)rep, sizeof(rGenReply), prof)=='K'){
         /* Ridian  errorϰ ó */
         if(rep->result != 0){
-            if(lts_rDisassociateUnit(stkType,stkName,bcrID,req->logicalName,stkName,errmsg) == false){
+            if(lts_rDisassociateUnit(prof,bcrID,req->logicalName,stkName,errmsg) == false){
                 logMessage(ERROR, errmsg);
                 sprintf(msg, "Connect error^STK[%s]^BCR[%s]^RET[%s]", 
                                     stkName, req->physicalID, req->logicalName);
                 if(hht_sendErrMsg(stkName, msg, errmsg) == false){
                     logMessage(ERROR, errmsg);
                 }
-                return stk_rAssociateUnitErrReply(csock, recvBuf, stkName, stkType, errmsg);
+                return stk_rAssociateUnitErrReply(csock, v->buf, stkName, stkType, errmsg);
             }
-            stk_rAssociateUnit_ntoh(rep);
-            if(write(csock, rep, sizeof(rGenReply)) <= 0){
+            if(stk_writeReply(csock, rep, sizeof(rGenReply)) == false){
                 sprintf(errmsg,"ERROR: STK[%s] disconnet network",stkName);
         	    logMessage(ERROR, errmsg);
         	    sprintf(msg, "Network error^STK[%s]",stkName);
@@ -2162,7 +4445,6 @@ int stk_rAssociateUnit(int csock, int *ridsock, char *recvBuf, char *stkName, in
                 logMessage(ERROR, errmsg);
             }
                 
-        	stk_rAssociateUnit_ntoh(rep);
         	if(stk_SendLogSvr((void*)rep ,rep->msgType, stkName, errmsg, true) == -1){
                 sprintf(errmsg, "ERROR: STK[%s] rAssociateUnit send log transfer fail", stkName);
                 logMessage(ERROR, errmsg);
@@ -2176,14 +4458,14 @@ int stk_rAssociateUnit(int csock, int *ridsock, char *recvBuf, char *stkName, in
 	} else {
     /* ridian ſ ߻ ó */
         memset(rep,0x00,sizeof(rGenReply));
-        if(lts_rDisassociateUnit(stkType,stkName,bcrID,req->logicalName,stkName,errmsg) == false){
+        if(lts_rDisassociateUnit(prof,bcrID,req->logicalName,stkName,errmsg) == false){
             logMessage(ERROR, errmsg);
             sprintf(msg, "Disconnect error^STK[%s]^BCR[%s]^RET[%s]",
                                         stkName, bcrID, req->logicalName);
             if(hht_sendErrMsg(stkName, msg, errmsg) == false){
                 logMessage(ERROR, errmsg);
             }
-            stk_rAssociateUnitErrReply(csock, recvBuf, stkName, stkType, errmsg);
+            stk_rAssociateUnitErrReply(csock, v->buf, stkName, stkType, errmsg);
             return false;
         }
 	    sprintf(errmsg,"ERROR: STK[%s] ridian rAssociateUnit send and recv fail",stkName);
@@ -2193,31 +4475,29 @@ int stk_rAssociateUnit(int csock, int *ridsock, char *recvBuf, char *stkName, in
         if(hht_sendErrMsg(stkName, msg, errmsg) == false){
             logMessage(ERROR, errmsg);
         }
-	    stk_rAssociateUnitErrReply(csock, recvBuf, stkName, stkType, errmsg);
+	    stk_rAssociateUnitErrReply(csock, v->buf, stkName, stkType, errmsg);
         return false;
 	}
     
-    stk_rAssociateUnit_ntoh(rep);
-    if(write(csock, rep, sizeof(rGenReply)) <= 0){
+    if(stk_writeReply(csock, rep, sizeof(rGenReply)) == false){
         sprintf(errmsg,"ERROR: STK[%s] disconnet network",stkName);
 	    logMessage(ERROR, errmsg);
 	    sprintf(msg, "Network error^STK[%s]",stkName);
         if(hht_sendErrMsg(stkName, msg, errmsg) == false){
             logMessage(ERROR, errmsg);
         }
-	    if(lts_rDisassociateUnit(stkType,stkName,bcrID,req->logicalName,stkName,errmsg) == false){
+	    if(lts_rDisassociateUnit(prof,bcrID,req->logicalName,stkName,errmsg) == false){
             logMessage(ERROR, errmsg);
             return false;
         }
 	    return false;
 	}
     
-	stk_rAssociateUnit_ntoh(rep);
 	if(stk_SendLogSvr((void*)rep ,rep->msgType, stkName, errmsg, true) == -1){
         sprintf(errmsg, "ERROR: STK[%s] rAssociateUnit send log transfer fail", stkName);
         logMessage(ERROR, errmsg);
     }
-    if(lts_outputRequest(stkType,stkName,bcrID,req->logicalName,stkName, errmsg) == false){
+    if(lts_outputRequest(prof,bcrID,req->logicalName,stkName, errmsg) == false){
 	    logMessage(ERROR, errmsg);
 	    return true;
     }
@@ -2243,22 +4523,15 @@ int stk_rAssociateUnitErrReply(int csock, char *recvBuf, char *stkName, int stkT
     sprintf(errmsg,"ERROR: STK[%s] rAssociateUnit error reply start ", stkName);
     logMessage(ERROR, errmsg);
     
-    rGenReply trep, *rep;
-    rep = &trep;
-    memset(rep,0x00,sizeof(rGenReply));
-    
-    rep->msgLen	    = sizeof(rGenReply);
-	rep->msgType	= msgTypeAssociateUnit;
-	rep->result	    = 11;
+    REPLY_TPL *t = tpl_find(msgTypeAssociateUnit, TPL_ERR);
+    rGenReply *rep = (rGenReply *)t->host;
 	
-	stk_rAssociateUnit_ntoh(rep);
-    if(write(csock, rep, sizeof(rGenReply)) <= 0){
+    if(tpl_send(csock, t) == false){
         sprintf(errmsg,"ERROR: STK[%s] disconnet network",stkName);
 	    logMessage(ERROR, errmsg);
 	    return false;
 	}
     
-	stk_rAssociateUnit_ntoh(rep);
 	if(stk_SendLogSvr((void*)rep ,rep->msgType, stkName, errmsg, true) == -1){
         sprintf(errmsg, "ERROR: STK[%s] rAssociateUnit send log transfer fail", stkName);
         logMessage(ERROR, errmsg);
@@ -2273,26 +4546,24 @@ int stk_rAssociateUnitErrReply(int csock, char *recvBuf, char *stkName, int stkT
 /* 1. Function Name: stk_rDisassociateUnit                                   */
 /* 2. Description  : STK Logical disconnect û ó                        */
 /* 3. Parameters   : int   csock     - Client  ũ                */
-/*                   int   ridsock   - ridian server  ũ         */
-/*                   char* recvBuf   - recv  ޼                        */
-/*                   char* stkName   - STK name                              */
-/*                   int stkType     - STK type                              */
+/*                   STK_VIEW *v     - recv  ޼ view                   */
+/*                   STK_PROFILE *prof - STK profile                         */
 /*                   PortTable *pt   - STK PORT                          */
 /*                   char* errMsg    - Error Message                         */
 /* 4. Return Value : int                                                     */
 /*****************************************************************************/ 
-int stk_rDisassociateUnit(int csock, int *ridsock, char *recvBuf, char *stkName, int stkType, char *errmsg)
+int stk_rDisassociateUnit(int csock, STK_VIEW *v, STK_PROFILE *prof, char *errmsg)
 {
+    char *stkName = prof->stkName;      /* profile  STK name */
+    int  stkType = prof->stkType;       /* profile  STK type */
     char bcrID[12]={0,};
     char tagID[12]={0,};
     unsigned short int reqLen;
     char msg[100]={0,};
     int status = false;
     
-    rGenRequest treq, *req;
-    req = &treq;
-    memset(req, 0x00, sizeof(rGenRequest));
-    memcpy(req, recvBuf, sizeof(rGenRequest));
+    rGenRequest *req = (rGenRequest *)v->buf;
+    rGenRequest fwd;                        /* Ridian   host order û */
     reqLen = sizeof(rGenRequest);
     
     rGenReply trep, *rep;
@@ -2303,21 +4574,20 @@ int stk_rDisassociateUnit(int csock, int *ridsock, char *recvBuf, char *stkName,
                                                     stkName, req->logicalName);
     logMessage(INFO, errmsg);
     
-    stk_rDisassociateUnit_hton(req);
-    if(stk_RecvLogSvr((void*)req ,req->msgType, stkName, errmsg, true) == -1){
+    if(stk_RecvLogSvr((void*)v->buf ,v->type, stkName, errmsg, true) == -1){
         sprintf(errmsg, "ERROR: STK[%s] rDisassociateUnit recv log transfer fail", stkName);
         logMessage(ERROR, errmsg);
     }
 
     if(GetBcrIDByLogicalID(req->logicalName, bcrID, errmsg) == false){
-        if(gReticleParallelMaint == 1 && stkType == RETICLEBARETYPE){
-            if(stk_rLogicalToPhysicalUnit(csock, ridsock, tagID, req->logicalName, stkName, errmsg) == false){
+        if(prof->parallel == 1 && stkType == RETICLEBARETYPE){
+            if(stk_rLogicalToPhysicalUnit(csock, tagID, req->logicalName, prof, errmsg) == false){
                 logMessage(ERROR, errmsg);
                 sprintf(msg, "Disconnect error^STK[%s]^RET[%s]",stkName, req->logicalName);
                 if(hht_sendErrMsg(stkName, msg, errmsg) == false){
                     logMessage(ERROR, errmsg);
                 }
-                return stk_rDisassociateUnitErrReply(csock,recvBuf,stkName,stkType,errmsg);
+                return stk_rDisassociateUnitErrReply(csock,v->buf,stkName,stkType,errmsg);
             }
             if(GetBcrIDByTagID(tagID, bcrID, errmsg) == false){
                 logMessage(ERROR, errmsg);
@@ -2325,7 +4595,7 @@ int stk_rDisassociateUnit(int csock, int *ridsock, char *recvBuf, char *stkName,
                 if(hht_sendErrMsg(stkName, msg, errmsg) == false){
                     logMessage(ERROR, errmsg);
                 }
-                return stk_rDisassociateUnitErrReply(csock,recvBuf,stkName,stkType,errmsg);
+                return stk_rDisassociateUnitErrReply(csock,v->buf,stkName,stkType,errmsg);
             }
         } else {
             if(memcmp(req->logicalName, "EMPTY" ,5) != 0){
@@ -2334,12 +4604,12 @@ int stk_rDisassociateUnit(int csock, int *ridsock, char *recvBuf, char *stkName,
                 if(hht_sendErrMsg(stkName, msg, errmsg) == false){
                     logMessage(ERROR, errmsg);
                 }
-                return stk_rDisassociateUnitErrReply(csock,recvBuf,stkName,stkType,errmsg);
+                return stk_rDisassociateUnitErrReply(csock,v->buf,stkName,stkType,errmsg);
             }
         }
     } else {
         if(bcrID[0] != NULL){
-            if(gReticleParallelMaint == 1 && stkType == RETICLEBARETYPE){
+            if(prof->parallel == 1 && stkType == RETICLEBARETYPE){
                 if(GetTagIDByBcrID(bcrID, tagID, errmsg) == false){
                     logMessage(ERROR, errmsg);
                     sprintf(msg, "Disconnect error^BCR TAG not mapping^STK[%s]^BCR[%s]^RET[%s]",
@@ -2347,36 +4617,36 @@ int stk_rDisassociateUnit(int csock, int *ridsock, char *recvBuf, char *stkName,
                     if(hht_sendErrMsg(stkName, msg, errmsg) == false){
                         logMessage(ERROR, errmsg);
                     }
-            	    return stk_rDisassociateUnitErrReply(csock,recvBuf,stkName,stkType,errmsg);
+            	    return stk_rDisassociateUnitErrReply(csock,v->buf,stkName,stkType,errmsg);
                 }
             }
     
-            if(lts_rDisassociateUnit(stkType,stkName,bcrID,req->logicalName,stkName,errmsg) == false){
+            if(lts_rDisassociateUnit(prof,bcrID,req->logicalName,stkName,errmsg) == false){
                 logMessage(ERROR, errmsg);
                 sprintf(msg, "Disconnect error^STK[%s]^BCR[%s]^RET[%s]",
                                             stkName, bcrID, req->logicalName);
                 if(hht_sendErrMsg(stkName, msg, errmsg) == false){
                     logMessage(ERROR, errmsg);
                 }
-            	return stk_rDisassociateUnitErrReply(csock,recvBuf,stkName,stkType,errmsg);
+            	return stk_rDisassociateUnitErrReply(csock,v->buf,stkName,stkType,errmsg);
             }
             status = true;
         }
     }
     
-    if(rid_SendRecv(ridsock, (char*)req, reqLen, (char*)rep, sizeof(rGenReply), stkName)=='K'){
+    view_decode(v, &fwd, reqLen);
+    if(rid_SendRecv((char*)&fwd, reqLen, (char*)rep, sizeof(rGenReply), prof)=='K'){
         if(rep->result != 0){
-            if(lts_rAssociateUnit(stkType,stkName,bcrID,req->logicalName,stkName,errmsg) == false){
+            if(lts_rAssociateUnit(prof,bcrID,req->logicalName,stkName,errmsg) == false){
                 logMessage(ERROR, errmsg);
                 sprintf(msg, "Disconnect error^STK[%s]^BCR[%s]^RET[%s]",
                                             stkName, bcrID, req->logicalName);
                 if(hht_sendErrMsg(stkName, msg, errmsg) == false){
                     logMessage(ERROR, errmsg);
                 }
-                return stk_rDisassociateUnitErrReply(csock, recvBuf, stkName, stkType, errmsg);
+                return stk_rDisassociateUnitErrReply(csock, v->buf, stkName, stkType, errmsg);
             }
-            stk_rDisassociateUnit_ntoh(rep);
-            if(write(csock, rep, sizeof(rGenReply)) <= 0){
+            if(stk_writeReply(csock, rep, sizeof(rGenReply)) == false){
                 sprintf(errmsg,"ERROR: STK[%s] disconnet network...",stkName);
         	    logMessage(ERROR, errmsg);
         	    sprintf(msg, "Network error^STK[%s]",stkName);
@@ -2390,7 +4660,6 @@ int stk_rDisassociateUnit(int csock, int *ridsock, char *recvBuf, char *stkName,
             if(hht_sendErrMsg(stkName, msg, errmsg) == false){
                 logMessage(ERROR, errmsg);
             }
-        	stk_rDisassociateUnit_ntoh(rep);
         	if(stk_SendLogSvr((void*)rep ,rep->msgType, stkName, errmsg, true) == -1){
                 sprintf(errmsg, "ERROR: STK[%s] rDisassociateUnit send log transfer fail", stkName);
                 logMessage(ERROR, errmsg);
@@ -2403,14 +4672,14 @@ int stk_rDisassociateUnit(int csock, int *ridsock, char *recvBuf, char *stkName,
         }
 	} else {
 	    memset(rep,0x00,sizeof(rGenReply));
-	    if(lts_rAssociateUnit(stkType,stkName,bcrID,req->logicalName,stkName,errmsg) == false){
+	    if(lts_rAssociateUnit(prof,bcrID,req->logicalName,stkName,errmsg) == false){
             logMessage(ERROR, errmsg);
             sprintf(msg, "Disconnect error^STK[%s]^BCR[%s]^RET[%s]",
                                                     stkName, bcrID, req->logicalName);
             if(hht_sendErrMsg(stkName, msg, errmsg) == false){
                 logMessage(ERROR, errmsg);
             }
-            stk_rDisassociateUnitErrReply(csock, recvBuf, stkName, stkType, errmsg);
+            stk_rDisassociateUnitErrReply(csock, v->buf, stkName, stkType, errmsg);
             return false;
         }
 	    sprintf(errmsg, "ERROR: STK[%s] ridian rDisassociateUnit send and recv fail", stkName);
@@ -2419,12 +4688,11 @@ int stk_rDisassociateUnit(int csock, int *ridsock, char *recvBuf, char *stkName,
         if(hht_sendErrMsg(stkName, msg, errmsg) == false){
             logMessage(ERROR, errmsg);
         }
-        stk_rDisassociateUnitErrReply(csock,recvBuf,stkName,stkType,errmsg);
+        stk_rDisassociateUnitErrReply(csock,v->buf,stkName,stkType,errmsg);
 	    return false;
     }
     
-    stk_rDisassociateUnit_ntoh(rep);
-    if(write(csock, rep, sizeof(rGenReply)) <= 0){
+    if(stk_writeReply(csock, rep, sizeof(rGenReply)) == false){
         sprintf(errmsg,"ERROR: STK[%s] disconnet network",stkName);
 	    logMessage(ERROR, errmsg);
 	    sprintf(msg, "Network error^STK[%s]",stkName);
@@ -2434,13 +4702,12 @@ int stk_rDisassociateUnit(int csock, int *ridsock, char *recvBuf, char *stkName,
 	    return false;
 	}
 	
-	stk_rDisassociateUnit_ntoh(rep);
 	if(stk_SendLogSvr((void*)rep ,rep->msgType, stkName, errmsg, true) == -1){
         sprintf(errmsg, "ERROR: STK[%s] rDisassociateUnit send log transfer fail", stkName);
         logMessage(ERROR, errmsg);
     }
     if(memcmp(req->logicalName, "EMPTY", 5) != 0 && status == true){
-        if(lts_inputRequest(stkType, stkName, bcrID, req->logicalName, stkName, errmsg) == false){
+        if(lts_inputRequest(prof, bcrID, req->logicalName, stkName, errmsg) == false){
             logMessage(ERROR, errmsg);
             return true;
         }
@@ -2468,22 +4735,15 @@ int stk_rDisassociateUnitErrReply(int csock, char *recvBuf, char *stkName, int s
     sprintf(errmsg,"ERROR: STK[%s] stocker rDisassociateUnit error reply start ", stkName);
     logMessage(ERROR, errmsg);
     
-    rGenReply trep, *rep;
-    rep = &trep;
-    memset(rep,0x00,sizeof(rGenReply));
-    
-    rep->msgLen	    = sizeof(rGenReply);
-	rep->msgType	= msgTypeDisassociateUnit;
-	rep->result	    = 11;
+    REPLY_TPL *t = tpl_find(msgTypeDisassociateUnit, TPL_ERR);
+    rGenReply *rep = (rGenReply *)t->host;
 	
-	stk_rDisassociateUnit_ntoh(rep);
-    if(write(csock, rep, sizeof(rGenReply)) <= 0){
+    if(tpl_send(csock, t) == false){
         sprintf(errmsg,"INFO : STK[%s] disconnet network...",stkName);
 	    logMessage(INFO, errmsg);
 	    return false;
 	}
 	
-	stk_rDisassociateUnit_ntoh(rep);
 	if(stk_SendLogSvr((void*)rep ,rep->msgType, stkName, errmsg, true) == -1){
         sprintf(errmsg, "ERROR: STK[%s] rDisassociateUnit send log transfer fail", stkName);
         logMessage(ERROR, errmsg);
@@ -2498,25 +4758,23 @@ int stk_rDisassociateUnitErrReply(int csock, char *recvBuf, char *stkName, int s
 /* 1. Function Name: stk_rDisplayMsg                                         */
 /* 2. Description  : STK Tag write û ó                                 */
 /* 3. Parameters   : int   csock     - Client  ũ                */
-/*                   int   ridsock   - ridian server  ũ         */
-/*                   char* recvBuf   - recv  ޼                        */
-/*                   char* stkName   - STK name                              */
-/*                   int stkType     - STK type                              */
+/*                   STK_VIEW *v     - recv  ޼ view                   */
+/*                   STK_PROFILE *prof - STK profile                         */
 /*                   PortTable *pt   - STK PORT                          */
 /*                   char* errMsg    - Error Message                         */
 /* 4. Return Value : int                                                     */
 /*****************************************************************************/ 
-int stk_rDisplayMsg(int csock, int *ridsock, char *recvBuf, char *stkName, int stkType, char *errmsg)
+int stk_rDisplayMsg(int csock, STK_VIEW *v, STK_PROFILE *prof, char *errmsg)
 {
+    char *stkName = prof->stkName;      /* profile  STK name */
+    int  stkType = prof->stkType;       /* profile  STK type */
     unsigned short int reqLen;
     char location[24]={0,};
     char tagID[12]={0,};
     char bcrID[12]={0,};
     
-    rPostLineRequest treq, *req;
-    req = &treq;
-    memset(req, 0x00, sizeof(rPostLineRequest));
-    memcpy(req, recvBuf, sizeof(rPostLineRequest));
+    rPostLineRequest *req = (rPostLineRequest *)v->buf;
+    rPostLineRequest fwd;                   /* Ridian   host order û */
     reqLen = sizeof(rPostLineRequest);
     
     rSimpleReply trep, *rep;
@@ -2526,16 +4784,15 @@ int stk_rDisplayMsg(int csock, int *ridsock, char *recvBuf, char *stkName, int s
     sprintf(errmsg,"INFO : STK[%s] rDisplayMsg start LOGICALID[%s], MSG[%s]", stkName, req->unitName, req->msg);
     logMessage(INFO, errmsg);
     
-    stk_rDisplayMsg_hton(req);
-    if(stk_RecvLogSvr((void*)req ,req->msgType, stkName, errmsg, true) == -1){
+    if(stk_RecvLogSvr((void*)v->buf ,v->type, stkName, errmsg, true) == -1){
         sprintf(errmsg, "ERROR: STK[%s] rDisplayMsg recv log transfer fail", stkName);
         logMessage(ERROR, errmsg);
     }
     
-    if(gReticleParallelMaint == 1 && stkType == RETICLEBARETYPE) {
-        if(stk_rLogicalToPhysicalUnit(csock, ridsock, tagID, req->unitName, stkName, errmsg) == false){
+    if(prof->parallel == 1 && stkType == RETICLEBARETYPE) {
+        if(stk_rLogicalToPhysicalUnit(csock, tagID, req->unitName, prof, errmsg) == false){
             logMessage(ERROR, errmsg);
-	        stk_rDisplayMsgErrReply(csock, recvBuf, stkName, stkType, errmsg);
+	        stk_rDisplayMsgErrReply(csock, v->buf, stkName, stkType, errmsg);
 	        return false;
         } else {
             if(strlen(tagID) == 0 || tagID[0] == NULL){
@@ -2544,12 +4801,13 @@ int stk_rDisplayMsg(int csock, int *ridsock, char *recvBuf, char *stkName, int s
             	rep->numItems	= 1;
             	rep->result	    = 0;
             } else {
-                if(rid_SendRecv(ridsock, (char*)req, reqLen, (char*)rep, sizeof(rSimpleReply), stkName)=='K'){
+                view_decode(v, &fwd, reqLen);
+                if(rid_SendRecv((char*)&fwd, reqLen, (char*)rep, sizeof(rSimpleReply), prof)=='K'){
             	} else {
             	    memset(rep,0x00,sizeof(rSimpleReply));
             	    sprintf(errmsg,"ERROR: STK[%s] ridian rDisplayMsg send and recv fail",stkName);
             	    logMessage(ERROR, errmsg);
-            	    stk_rDisplayMsgErrReply(csock, recvBuf, stkName, stkType, errmsg);
+            	    stk_rDisplayMsgErrReply(csock, v->buf, stkName, stkType, errmsg);
             	    return false;
             	}
             }
@@ -2561,14 +4819,12 @@ int stk_rDisplayMsg(int csock, int *ridsock, char *recvBuf, char *stkName, int s
     	rep->result	    = 0;
     }
 
-	stk_rDisplayMsg_ntoh(rep);
-	if(write(csock, rep, sizeof(rSimpleReply)) <= 0){
+	if(stk_writeReply(csock, rep, sizeof(rSimpleReply)) == false){
 	    sprintf(errmsg,"INFO : STK[%s] disconnet network",stkName);
 	    logMessage(INFO, errmsg);
 	    return false;
 	} 
 	
-	stk_rDisplayMsg_ntoh(rep);
 	if(stk_SendLogSvr((void*)rep ,rep->msgType, stkName, errmsg, true) == -1){
 	    sprintf(errmsg, "ERROR: STK[%s] rDisplayMsg send log transfer fail", stkName);
         logMessage(ERROR, errmsg);
@@ -2593,23 +4849,15 @@ int stk_rDisplayMsg(int csock, int *ridsock, char *recvBuf, char *stkName, int s
 /*****************************************************************************/ 
 int stk_rDisplayMsgErrReply(int csock, char *recvBuf, char *stkName, int stkType, char *errmsg)
 {
-    rSimpleReply trep, *rep;
-    rep = &trep;
-    memset(rep,0x00,sizeof(rSimpleReply));
-    
-    rep->msgLen	    = sizeof(rSimpleReply);
-	rep->msgType	= msgTypeDisplayMsg;
-	rep->numItems	= 1;
-	rep->result	    = 11;
+    REPLY_TPL *t = tpl_find(msgTypeDisplayMsg, TPL_ERR);
+    rSimpleReply *rep = (rSimpleReply *)t->host;
 	
-    stk_rDisplayMsg_ntoh(rep);
-	if(write(csock, rep, sizeof(rSimpleReply)) <= 0){
+	if(tpl_send(csock, t) == false){
 	    sprintf(errmsg,"INFO : STK[%s] disconnet network...",stkName);
 	    logMessage(INFO, errmsg);
 	    return false;
 	} 
 	
-	stk_rDisplayMsg_ntoh(rep);
 	if(stk_SendLogSvr((void*)rep ,rep->msgType, stkName, errmsg, true) == -1){
         sprintf(errmsg, "ERROR: STK[%s] rDisplayMsg send log transfer fail", stkName);
         logMessage(ERROR, errmsg);
@@ -2627,23 +4875,17 @@ int stk_rDisplayMsgErrReply(int csock, char *recvBuf, char *stkName, int stkType
 /* 1. Function Name: stk_rClose                                              */
 /* 2. Description  : STK connection close û ó                          */
 /* 3. Parameters   : int   csock     - Client  ũ                */
-/*                   char* recvBuf   - recv  ޼                        */
+/*                   STK_VIEW *v     - recv  ޼ view                   */
 /*                   char* stkName   - STK name                              */
 /*                   char* errMsg    - Error Message                         */
 /* 4. Return Value : int                                                     */
 /*****************************************************************************/ 
-int stk_rClose(int csock, char *recvBuf, char *stkName, char *errmsg)
+int stk_rClose(int csock, STK_VIEW *v, char *stkName, char *errmsg)
 {
-    rSimpleRequest treq, *req;
-    req = &treq;
-    
-    memset(req, 0x00, sizeof(rSimpleRequest));
-    memcpy(req, recvBuf, sizeof(rSimpleRequest));
     sprintf(errmsg,"INFO : STK[%s] rClose start",stkName);
     logMessage(INFO, errmsg);
     
-    stk_rClose_hton(req);
-    if(stk_RecvLogSvr((void*)req ,req->msgType, stkName, errmsg, true) == -1){
+    if(stk_RecvLogSvr((void*)v->buf ,v->type, stkName, errmsg, true) == -1){
         sprintf(errmsg, "ERROR: STK[%s] rClose recv log transfer fail", stkName);
         logMessage(ERROR, errmsg);
     }
@@ -2651,16 +4893,15 @@ int stk_rClose(int csock, char *recvBuf, char *stkName, char *errmsg)
     rSimpleReply trep, *rep; 
     rep = &trep;
     memset(rep,0x00,sizeof(rSimpleReply));
-    rep->msgLen	    = bigToLitts(sizeof(rSimpleReply));
+    rep->msgLen	    = sizeof(rSimpleReply);
 	rep->msgType	= msgTypeCloseRequest;
-	rep->result	    = bigToLitts(0);
+	rep->result	    = 0;
 	rep->numItems	= 0;
-	if(write(csock,(void*)rep, sizeof(rSimpleReply)) <= 0){
+	if(stk_writeReply(csock, rep, sizeof(rSimpleReply)) == false){
 	    sprintf(errmsg,"ERROR: STK[%s] disconnet network",stkName);
 	    logMessage(ERROR, errmsg);
         return false;
 	}
-	stk_rClose_ntoh(rep);
 	if(stk_SendLogSvr((void*)rep ,rep->msgType, stkName, errmsg, true) == -1){
         sprintf(errmsg, "ERROR: STK[%s] rClose send log transfer fail", stkName);
         logMessage(ERROR, errmsg);
@@ -2674,55 +4915,76 @@ int stk_rClose(int csock, char *recvBuf, char *stkName, char *errmsg)
 /*****************************************************************************/
 /* 1. Function Name: rid_SendRecv                                            */
 /* 2. Description  : ridian server                                   */
-/* 3. Parameters   : int   ridsock   - ridian server  ũ         */
+/*                   process  pool   lease Ͽ ۼѴ     */
+/*                   STKinf.rid.pipeline > 1 ̸ pipeline  ۼ     */
+/* 3. Parameters   : char* s_buff    - ridian send  ޼                 */
+/*                   int   s_buffLen - ridian send  ޼ size            */
+/*                   char* r_buff    - ridian recv  ޼                 */
+/*                   STK_PROFILE *prof - STK profile                         */
+/* 4. Return Value : int                                                     */
+/*****************************************************************************/ 
+char rid_SendRecv(char* s_buff, unsigned short int s_buffLen, char* r_buff, unsigned short int r_size, STK_PROFILE *prof)
+{
+    char msg[1024]={0,};
+    char result;
+    int slot;
+    struct timespec ts;
+
+    /*   ƴϸ ridian  ü   */
+    if(prof->parallel == 0){
+        if(stk_MakeSendMsg((void *)s_buff, (void *)r_buff, (char)s_buff[TYPEBYTE], msg) == false){
+            logMessage(ERROR, msg);
+        }
+        return 'K';
+    }
+    trace_now(&ts);
+    if(gRidPipeline > 1){
+        result = rid_pipeSendRecv(s_buff, s_buffLen, r_buff, r_size, prof);
+        trace_span("ridian", &ts);
+        return result;
+    }
+
+    if((slot = rid_lease(prof->stkName)) < 0){
+        trace_span("ridian.lease", &ts);
+        sprintf(msg, "ERROR: STK[%s] ridian pool lease timeout", prof->stkName);
+        logMessage(ERROR, msg);
+        return 'F';
+    }
+    result = rid_exchange(&gRidPool[slot], s_buff, s_buffLen, r_buff, r_size, prof);
+    /*   ƴϸ stream ¸   Ƿ  ݴ´ */
+    rid_release(slot, result == 'K');
+    trace_span("ridian", &ts);
+    return result;
+}
+
+/*****************************************************************************/
+/* 1. Function Name: rid_exchange                                            */
+/* 2. Description  : lease  ridian  1ȸ ۼ                       */
+/*                    ϸ conn->sock    ٲ۴        */
+/* 3. Parameters   : RID_CONN *conn  - lease  pool                     */
 /*                   char* s_buff    - ridian send  ޼                 */
 /*                   int   s_buffLen - ridian send  ޼ size            */
 /*                   char* r_buff    - ridian recv  ޼                 */
-/*                   char* stkName   - STK name                              */
+/*                   STK_PROFILE *prof - STK profile                         */
 /* 4. Return Value : int                                                     */
 /*****************************************************************************/ 
-char rid_SendRecv(int *ridiansock, char* s_buff, unsigned short int s_buffLen, char* r_buff, unsigned short int r_size, char *stkName)
+char rid_exchange(RID_CONN *conn, char* s_buff, unsigned short int s_buffLen, char* r_buff, unsigned short int r_size, STK_PROFILE *prof)
 {
+    int *ridiansock = &conn->sock;
+    char *stkName = prof->stkName;      /* profile  STK name */
+    char *frame;
     int         s_buflen = -1;
     char        msgType = 0;
     char        msg[1024]={0,};
-    char        tmpBuff[1024]={0,};
     struct      sockaddr_in ridAddr_in;
     struct      timeval waittime;
-    fd_set      r_set;
     fd_set      s_set;
-    fd_set      tmp_set;
     int         ret;
     int         retryCount = 0;
-    int         stkType = -1;
     unsigned short int r_buffLen;
-    int         tmpLen = -1;
-    int         totTmpLen = 0;
-    int ridsock;
-    
-    ridsock = *ridiansock;
-    
-    stkType = GetStkTypeByStkName(stkName, msg);
-    if(stkType == false) {
-        logMessage(ERROR, msg);
-        return 'F';
-    }
-    
-    if(stkType == LOTPODTYPE){
-        if(gLotParallelMaint == 0){
-            if(stk_MakeSendMsg((void *)s_buff, (void *)r_buff, (char)s_buff[TYPEBYTE], msg) == false){
-                logMessage(ERROR, msg);
-            }
-            return 'K';
-        }
-    } else {
-        if(gReticleParallelMaint == 0){
-            if(stk_MakeSendMsg((void *)s_buff, (void *)r_buff, (char)s_buff[TYPEBYTE], msg) == false){
-                logMessage(ERROR, msg);
-            }
-            return 'K';
-        }
-    }
+    int ridsock;
+    
+    ridsock = *ridiansock;
     
     if(msgVerify((char)s_buff[TYPEBYTE]) == false){
         sprintf(msg, "ERROR: STK[%s] ridian send message type[%d]", stkName,(char)s_buff[TYPEBYTE]);
@@ -2738,6 +5000,7 @@ char rid_SendRecv(int *ridiansock, char* s_buff, unsigned short int s_buffLen, c
             return 'F';
         }
         *ridiansock = ridsock;
+        __sync_fetch_and_add(&gRidConn, 1);
     }
 
     while(1){
@@ -2760,11 +5023,13 @@ char rid_SendRecv(int *ridiansock, char* s_buff, unsigned short int s_buffLen, c
             ridsock = -1;
             ridsock = rid_connect(stkName);
             if(ridsock == false){
+                *ridiansock = -1;
                 sprintf(msg, "ERROR: STK[%s] ridian server reconnect fail", stkName);
                 logMessage(ERROR, msg);
                 return 'F';
             }
             *ridiansock = ridsock;
+            __sync_fetch_and_add(&gRidConn, 1);
             sprintf(msg,"DEBUG: STK[%s] ridian reconnect socket num[%d]",stkName, ridsock);
             logMessage(DEBUG, msg);
             retryCount++;
@@ -2783,322 +5048,1016 @@ char rid_SendRecv(int *ridiansock, char* s_buff, unsigned short int s_buffLen, c
             retryCount = 0;
             break;
         }
-    }
-    
-    while(1){
-        if(FD_ISSET(ridsock, &s_set)) {
-            s_buflen = write(ridsock, s_buff, s_buffLen);
-            if(s_buflen == -1){
-                if(retryCount == RETRY){
-                    sprintf(msg, "ERROR: STK[%s] ridian server network disconnect..retry count over", stkName);
-                    logMessage(ERROR, msg);
-                    return 'F';
-                } else {
-                    close(ridsock);
-                    sprintf(msg, "ERROR: STK[%s] ridian server network disconnect", stkName);
-                    logMessage(ERROR, msg);
-                    ridsock = rid_connect(stkName);
-                    if(ridsock == false){
-                        sprintf(msg, "ERROR: STK[%s] ridian server reconnect fail", stkName);
-                        logMessage(ERROR, msg);
-                        return 'F';
-                    }
-                    *ridiansock = ridsock;
-                    sprintf(msg,"DEBUG: STK[%s] ridian reconnect socket num[%d]",stkName, ridsock);
-                    logMessage(DEBUG, msg);
-                    retryCount++;
-                    continue;
-                }
-            } else if(s_buflen != s_buffLen){
-                sprintf(msg,"ERROR: STK[%s] ridian send MSGTYPE[%d]  SENDSIZE[%d]  STRUCTSIZE[%d]",
-                                                        stkName,s_buff[TYPEBYTE],s_buflen,s_buffLen);
-                logMessage(ERROR, msg);
-                return 'S';
+    }
+    
+    while(1){
+        if(FD_ISSET(ridsock, &s_set)) {
+            s_buflen = write(ridsock, s_buff, s_buffLen);
+            if(s_buflen == -1){
+                if(retryCount == RETRY){
+                    sprintf(msg, "ERROR: STK[%s] ridian server network disconnect..retry count over", stkName);
+                    logMessage(ERROR, msg);
+                    return 'F';
+                } else {
+                    close(ridsock);
+                    sprintf(msg, "ERROR: STK[%s] ridian server network disconnect", stkName);
+                    logMessage(ERROR, msg);
+                    ridsock = rid_connect(stkName);
+                    if(ridsock == false){
+                        *ridiansock = -1;
+                        sprintf(msg, "ERROR: STK[%s] ridian server reconnect fail", stkName);
+                        logMessage(ERROR, msg);
+                        return 'F';
+                    }
+                    *ridiansock = ridsock;
+                    __sync_fetch_and_add(&gRidConn, 1);
+                    sprintf(msg,"DEBUG: STK[%s] ridian reconnect socket num[%d]",stkName, ridsock);
+                    logMessage(DEBUG, msg);
+                    retryCount++;
+                    continue;
+                }
+            } else if(s_buflen != s_buffLen){
+                sprintf(msg,"ERROR: STK[%s] ridian send MSGTYPE[%d]  SENDSIZE[%d]  STRUCTSIZE[%d]",
+                                                        stkName,s_buff[TYPEBYTE],s_buflen,s_buffLen);
+                logMessage(ERROR, msg);
+                return 'S';
+            } else {
+                retryCount = 0;
+                break;
+            }
+        }
+    }
+    
+    if(stk_RecvLogSvr((void*)s_buff ,s_buff[TYPEBYTE], stkName, msg, false) == -1){
+        sprintf(msg, "ERROR: STK[%s] ridian send log transfer fail", stkName);
+        logMessage(ERROR, msg);
+    }
+    
+    /*  ȯ  byte    ޴´ */
+    frm_init(&conn->rd, ridsock, 0, 1, RID_FRAMEBUF - 1, conn->rbuf, RID_FRAMEBUF, stkName);
+    while(1){
+        ret = frm_read(&conn->rd, &frame, 10, msg);
+        if(ret < 0){
+            /* ۽ request  ҾǷ  ʰ  ó (release  ݴ´) */
+            sprintf(msg,"ERROR: STK[%s] ridian recv disconnect errorno[%d]::%s",stkName,errno,strerror(errno));
+            logMessage(ERROR, msg);
+            return 'F';
+        } else if( ret == 0){
+            if(retryCount == RETRY){
+                sprintf(msg,"ERROR: STK[%s] ridian recv time out error retry count over",stkName);
+                logMessage(ERROR, msg);
+                return 'F';
+            } else {
+                sprintf(msg,"ERROR: STK[%s] ridian recv time out error",stkName);
+                logMessage(ERROR, msg);
+                retryCount++;
+                continue;
+            }
+        } else {
+            retryCount=0;
+            break;
+        }
+    }
+    r_buffLen = ret;
+    if(r_buffLen != r_size) {
+        sprintf(msg,"DEBUG: STK[%s] stocker garbage recv size[%d] end",stkName,r_buffLen);
+        logMessage(DEBUG, msg);
+        if(stk_MakeSendMsg((void *)s_buff, (void *)r_buff, (char)s_buff[TYPEBYTE], msg) == false){
+            logMessage(ERROR, msg);
+        }
+    } else if(s_buff[TYPEBYTE] != frame[TYPEBYTE]){
+        sprintf(msg,"ERROR: STK[%s] ridian SEND MSGTYPE[%d] RECV MSGTYPE[%d] headertype is different",
+                                                   stkName, s_buff[TYPEBYTE],frame[TYPEBYTE]);
+        logMessage(ERROR, msg);
+        return 'F';
+    } else {
+        memcpy(r_buff, frame, r_buffLen);
+    }
+    
+    if(stk_SendLogSvr((void*)r_buff ,r_buff[TYPEBYTE], stkName, msg, false) == -1){
+        sprintf(msg, "ERROR: STK[%s] ridian recv log transfer fail", stkName);
+        logMessage(ERROR, msg);
+    }
+    return 'K';
+}
+
+/*****************************************************************************/
+/* 1. Function Name: rid_connect                                             */
+/* 2. Description  : ridian server                                   */
+/* 3. Parameters   : char *stkName    - stocker name                         */
+/* 4. Return Value : int                                                     */
+/*****************************************************************************/ 
+int rid_connect(char *stkName)
+{
+    int ridiansock;
+    int retry = 0;
+    struct sockaddr_in ridAddr_in;
+    char msg[200]={0,};
+
+    memset(&ridAddr_in,0x00,sizeof(ridAddr_in));
+    ridAddr_in.sin_family = AF_INET;
+    ridAddr_in.sin_port = htons(RIDSERVER_PORT);
+    ridAddr_in.sin_addr.s_addr = inet_addr(RIDSERVER_IP);
+    
+    while(1){
+        retry = 0;
+        if((ridiansock = socket(AF_INET,SOCK_STREAM,0)) < 0){
+            sprintf(msg, "ERROR: STK[%s] ridian socket create fail..retry[%d]",stkName,retry);
+            logMessage(ERROR, msg);
+            if(retry >= RETRY){
+                ridiansock = -1;
+                return false;
+            } else {
+                retry++;
+                continue;
+            }
+        }
+        retry = 0;
+        if(connect(ridiansock, (struct sockaddr *)&ridAddr_in, sizeof(struct sockaddr)) == -1){
+            sprintf(msg, "ERROR: STK[%s] ridian connect fail..retry[%d]",stkName,retry);
+            logMessage(ERROR, msg);
+            if(retry >= RETRY){
+                close(ridiansock);
+                return false;
+            } else {
+                retry++;
+                close(ridiansock);
+                continue;
+            }
+        } else {
+            sprintf(msg, "INFO : STK[%s] ridian socket create success socket num[%d]",stkName, ridiansock);
+            logMessage(INFO, msg);
+            return ridiansock;
+        }
+    }
+}
+
+/*****************************************************************************/
+/* 1. Function Name: rid_close                                               */
+/* 2. Description  : ridian server                                   */
+/*                   pool  ϳ close û    ݴ´   */
+/* 3. Parameters   : STK_PROFILE *prof - STK profile                         */
+/* 4. Return Value : int                                                     */
+/*****************************************************************************/ 
+int rid_close(STK_PROFILE *prof)
+{
+    int slot;
+    char result;
+
+    rSimpleRequest treq, *req;
+    req = &treq;
+    memset(req, 0x00, sizeof(rSimpleRequest));    
+    
+    req->msgLen = sizeof(rSimpleRequest);
+    req->msgType = msgTypeCloseRequest;
+    
+    rSimpleReply trep, *rep;
+    rep = &trep;
+    memset(rep,0x00,sizeof(rSimpleReply));
+    
+    if(gRidPipeline > 1){
+        /*  ̹Ƿ Ridian    thread  Ѵ */
+        result = rid_pipeSendRecv((char*)req, sizeof(rSimpleRequest), (char*)rep, sizeof(rSimpleReply), prof);
+        return (result == 'K') ? true : false;
+    }
+    if((slot = rid_lease(prof->stkName)) < 0){
+        return false;
+    }
+    result = rid_exchange(&gRidPool[slot], (char*)req, sizeof(rSimpleRequest), (char*)rep, sizeof(rSimpleReply), prof);
+    rid_release(slot, false);
+    if(result == 'K'){
+        return true;
+    } else {
+        return false;
+    }
+}
+
+/*****************************************************************************/
+/* 1. Function Name: rid_poolStart                                           */
+/* 2. Description  : Ridian connection pool ʱȭ  health check thread    */
+/*                   .  lease Ǵ health check  δ´          */
+/*                   pipeline  Ằ  thread   δ´     */
+/* 3. Parameters   : pthread_attr_t *attr -  Ӽ                      */
+/*                   char *msg            - error message                    */
+/* 4. Return Value : 0 - , -1 -                                      */
+/*****************************************************************************/
+int rid_poolStart(pthread_attr_t *attr, char *msg)
+{
+    pthread_t tid;
+    int i, j;
+
+    for(i = 0; i < RID_MAXPOOL; i++){
+        gRidPool[i].idx  = i;
+        gRidPool[i].sock = -1;
+        gRidPool[i].busy = 0;
+        pthread_mutex_init(&gRidPool[i].wmtx, NULL);
+        for(j = 0; j < RID_MAXPIPE; j++){
+            pthread_cond_init(&gRidPool[i].pend[j].cond, NULL);
+        }
+    }
+    /*   stocker   Ridian   ʴ´ */
+    if(gLotParallelMaint == 0 && gReticleParallelMaint == 0){
+        return 0;
+    }
+    for(i = 0; i < gRidPoolSize; i++){
+        if((gRidPool[i].rbuf = (char *)malloc(RID_FRAMEBUF)) == NULL){
+            sprintf(msg, "ERROR: Ridian frame buffer alloc fail errno[%d]", errno);
+            return -1;
+        }
+    }
+    if(gRidPipeline > 1){
+        for(i = 0; i < gRidPoolSize; i++){
+            if(pthread_create(&tid, attr, rid_pipeThread, &gRidPool[i]) != 0){
+                sprintf(msg, "ERROR: Ridian pipeline thread[%d] create fail errno[%d]", i, errno);
+                return -1;
+            }
+        }
+        return 0;
+    }
+    if(pthread_create(&tid, attr, rid_poolThread, NULL) != 0){
+        sprintf(msg, "ERROR: Ridian pool thread create fail errno[%d]", errno);
+        return -1;
+    }
+    return 0;
+}
+
+/*****************************************************************************/
+/* 1. Function Name: rid_lease                                               */
+/* 2. Description  : Ridian pool  lease (  켱)                 */
+/*                    ̸ RID_LEASE_WAIT ʱ               */
+/* 3. Parameters   : char *stkName   - STK client name                       */
+/* 4. Return Value : slot index, -1 - timeout                                */
+/*****************************************************************************/
+int rid_lease(char *stkName)
+{
+    struct timespec ts;
+    int i, slot, waited = 0;
+
+    pthread_mutex_lock(&gRidMtx);
+    while(1){
+        for(i = 0, slot = -1; i < gRidPoolSize; i++){
+            if(gRidPool[i].busy) continue;
+            if(slot < 0 || (gRidPool[slot].sock < 0 && gRidPool[i].sock >= 0)) slot = i;
+            if(gRidPool[slot].sock >= 0) break;
+        }
+        if(slot >= 0) break;
+        if(waited == 0){
+            waited = 1;
+            ++gRidWaited;
+            ts.tv_sec  = time(NULL) + RID_LEASE_WAIT;
+            ts.tv_nsec = 0;
+        }
+        if(pthread_cond_timedwait(&gRidCond, &gRidMtx, &ts) == ETIMEDOUT){
+            ++gRidTimeout;
+            pthread_mutex_unlock(&gRidMtx);
+            return -1;
+        }
+    }
+    gRidPool[slot].busy = 1;
+    ++gRidLease;
+    pthread_mutex_unlock(&gRidMtx);
+    return slot;
+}
+
+/*****************************************************************************/
+/* 1. Function Name: rid_release                                             */
+/* 2. Description  : Ridian pool  ȯ. ok  ƴϸ  ݰ     */
+/*                   lease Ǵ health check  ٽ Ѵ              */
+/* 3. Parameters   : int slot        - rid_lease  slot                     */
+/*                   int ok          - true :                        */
+/* 4. Return Value : None                                                    */
+/*****************************************************************************/
+void rid_release(int slot, int ok)
+{
+    pthread_mutex_lock(&gRidMtx);
+    if(ok == false && gRidPool[slot].sock >= 0){
+        close(gRidPool[slot].sock);
+        gRidPool[slot].sock = -1;
+        ++gRidDead;
+    }
+    gRidPool[slot].busy = 0;
+    pthread_cond_signal(&gRidCond);
+    pthread_mutex_unlock(&gRidMtx);
+}
+
+/*****************************************************************************/
+/* 1. Function Name: rid_alive                                               */
+/* 2. Description  : idle Ridian  liveness check. idle ῡ  data  */
+/*                    timeout  ȯ  ̹Ƿ  ʰ  */
+/*                   üϰ false  ش                              */
+/* 3. Parameters   : int sock        - Ridian socket                         */
+/* 4. Return Value : true -  , false -  Ǵ ܿ      */
+/*****************************************************************************/
+int rid_alive(int sock)
+{
+    char c;
+    int n;
+
+    while((n = recv(sock, &c, 1, MSG_PEEK | MSG_DONTWAIT)) < 0 && errno == EINTR);
+    if(n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) return true;
+    return false;
+}
+
+/*****************************************************************************/
+/* 1. Function Name: rid_poolThread                                          */
+/* 2. Description  : RID_CHECK ֱ idle  liveness check  ̿     */
+/*                   slot . Ridian ⵿ connect а   ֱ*/
+/*                    slot   ֱ ̷   ʴ´  */
+/* 3. Parameters   : None                                                    */
+/* 4. Return Value : None                                                    */
+/*****************************************************************************/
+void * rid_poolThread(void *arg)
+{
+    char errmsg[BUFSIZ];
+    int i, sock, up, busy, connFail;
+    time_t now, statTime = time(NULL);
+
+    pthread_detach(pthread_self());
+    while(1){
+        sleep(RID_CHECK);
+
+        connFail = 0;
+        for(i = 0; i < gRidPoolSize; i++){
+            pthread_mutex_lock(&gRidMtx);
+            if(gRidPool[i].busy || (gRidPool[i].sock < 0 && connFail)){
+                pthread_mutex_unlock(&gRidMtx);
+                continue;
+            }
+            gRidPool[i].busy = 1;
+            sock = gRidPool[i].sock;
+            pthread_mutex_unlock(&gRidMtx);
+
+            if(sock >= 0 && rid_alive(sock) == false){
+                close(sock);
+                sock = -1;
+                __sync_fetch_and_add(&gRidDead, 1);
+                sprintf(errmsg, "ERROR: Ridian pool connection[%d] closed by server or stale reply", i);
+                logMessage(ERROR, errmsg);
+            }
+            if(sock < 0){
+                if((sock = rid_connect(SERVER_NAME)) == false){
+                    sock = -1;
+                    connFail = 1;
+                } else {
+                    __sync_fetch_and_add(&gRidConn, 1);
+                }
+            }
+            pthread_mutex_lock(&gRidMtx);
+            gRidPool[i].sock = sock;
+            gRidPool[i].busy = 0;
+            pthread_cond_signal(&gRidCond);
+            pthread_mutex_unlock(&gRidMtx);
+        }
+
+        now = time(NULL);
+        if(now - statTime < DB_STAT_INTERVAL) continue;
+        statTime = now;
+        pthread_mutex_lock(&gRidMtx);
+        for(i = 0, up = 0, busy = 0; i < gRidPoolSize; i++){
+            if(gRidPool[i].sock >= 0) up++;
+            if(gRidPool[i].busy) busy++;
+        }
+        sprintf(errmsg, "INFO : Ridian pool size[%d] up[%d] busy[%d] lease[%ld] waited[%ld] timeout[%ld] connect[%ld] dead[%ld]",
+                gRidPoolSize, up, busy, gRidLease, gRidWaited, gRidTimeout, gRidConn, gRidDead);
+        pthread_mutex_unlock(&gRidMtx);
+        logMessage(INFO, errmsg);
+    }
+    return NULL;
+}
+
+/*****************************************************************************/
+/* 1. Function Name: rid_check                                               */
+/* 2. Description  : rConnect  Ridian    Ȯ                  */
+/*                   lease   ξ, pipeline      */
+/*                   pool    RID_LEASE_WAIT  Ѵ      */
+/* 3. Parameters   : char *stkName   - STK client name                       */
+/* 4. Return Value : true -  , false - Ұ                          */
+/*****************************************************************************/
+int rid_check(char *stkName)
+{
+    struct timespec ts;
+    int i, up = 0;
+
+    if(gRidPipeline > 1){
+        ts.tv_sec  = time(NULL) + RID_LEASE_WAIT;
+        ts.tv_nsec = 0;
+        pthread_mutex_lock(&gRidMtx);
+        while(1){
+            for(i = 0; i < gRidPoolSize; i++){
+                if(gRidPool[i].sock >= 0) up = 1;
+            }
+            if(up) break;
+            if(pthread_cond_timedwait(&gRidCond, &gRidMtx, &ts) == ETIMEDOUT) break;
+        }
+        pthread_mutex_unlock(&gRidMtx);
+        return up ? true : false;
+    }
+
+    if((i = rid_lease(stkName)) < 0){
+        return false;
+    }
+    if(gRidPool[i].sock < 0){
+        if((gRidPool[i].sock = rid_connect(stkName)) == false){
+            gRidPool[i].sock = -1;
+        } else {
+            __sync_fetch_and_add(&gRidConn, 1);
+        }
+    }
+    up = (gRidPool[i].sock >= 0);
+    rid_release(i, up);
+    return up ? true : false;
+}
+
+/*****************************************************************************/
+/* 1. Function Name: rid_pipeThread                                          */
+/* 2. Description  : pipeline  Ridian  ϳ /  thread  */
+/*                    ۽  fifo  ù request  ѱ, type */
+/*                    ٸų  ų timeout  request      */
+/*                     request    ó  Ѵ   */
+/* 3. Parameters   : void *arg       - RID_CONN *                            */
+/* 4. Return Value : None                                                    */
+/*****************************************************************************/
+void * rid_pipeThread(void *arg)
+{
+    RID_CONN *conn = (RID_CONN *)arg;
+    RID_PEND *pend;
+    char errmsg[BUFSIZ];
+    char rdName[32];
+    char *r_buff;
+    int r_buffLen;
+    int sock, i, want, connFail = 0;
+
+    pthread_detach(pthread_self());
+    sprintf(rdName, "Ridian pipeline connection[%d]", conn->idx);
+    while(1){
+        if((sock = rid_connect(SERVER_NAME)) == false){
+            if(connFail++ == 0){
+                sprintf(errmsg, "ERROR: Ridian pipeline connection[%d] connect fail", conn->idx);
+                logMessage(ERROR, errmsg);
+            }
+            sleep(RID_RETRY);
+            continue;
+        }
+        connFail = 0;
+        pthread_mutex_lock(&conn->wmtx);
+        pthread_mutex_lock(&gRidMtx);
+        conn->sock = sock;
+        conn->head = 0;
+        conn->cnt  = 0;
+        conn->reset = 0;
+        frm_init(&conn->rd, sock, 0, 1, RID_FRAMEBUF - 1, conn->rbuf, RID_FRAMEBUF, rdName);
+        ++gRidConn;
+        pthread_cond_broadcast(&gRidCond);
+        pthread_mutex_unlock(&gRidMtx);
+        pthread_mutex_unlock(&conn->wmtx);
+
+        while(1){
+            if((r_buffLen = frm_read(&conn->rd, &r_buff, -1, errmsg)) <= 0) break;
+
+            pthread_mutex_lock(&gRidMtx);
+            if(conn->reset){
+                /* shutdown  ޾  䵵 ¦   Ƿ  */
+                pthread_mutex_unlock(&gRidMtx);
+                break;
+            }
+            pend = (conn->cnt > 0) ? &conn->pend[conn->fifo[conn->head]] : NULL;
+            want = (pend != NULL && r_buffLen == pend->r_size);
+            if(pend == NULL){
+                ++gRidOrphan;
+                pthread_mutex_unlock(&gRidMtx);
+                continue;
+            }
+            if(want && pend->type != r_buff[TYPEBYTE]){
+                ++gRidDesync;
+                sprintf(errmsg,"ERROR: Ridian pipeline connection[%d] SEND MSGTYPE[%d] RECV MSGTYPE[%d] headertype is different",
+                                                           conn->idx, pend->type, r_buff[TYPEBYTE]);
+                pthread_mutex_unlock(&gRidMtx);
+                logMessage(ERROR, errmsg);
+                break;
+            }
+            conn->head = (conn->head + 1) % RID_MAXPIPE;
+            conn->cnt--;
+            if(want == 0){
+                ++gRidGarbage;
+                pend->state = RIDP_GARBAGE;
+                pthread_cond_signal(&pend->cond);
+            } else if(msgVerify((char)r_buff[TYPEBYTE]) == false){
+                pend->state = RIDP_FAIL;
+                pthread_cond_signal(&pend->cond);
+            } else {
+                memcpy(pend->r_buff, r_buff, r_buffLen);
+                pend->state = RIDP_DONE;
+                pthread_cond_signal(&pend->cond);
+            }
+            pthread_mutex_unlock(&gRidMtx);
+        }
+
+        sprintf(errmsg, "ERROR: Ridian pipeline connection[%d] closed [%s]", conn->idx, strerror(errno));
+        logMessage(ERROR, errmsg);
+        pthread_mutex_lock(&conn->wmtx);
+        pthread_mutex_lock(&gRidMtx);
+        conn->sock = -1;
+        close(sock);
+        ++gRidDead;
+        for(i = 0; i < conn->cnt; i++){
+            pend = &conn->pend[conn->fifo[(conn->head + i) % RID_MAXPIPE]];
+            if(pend->state == RIDP_ABANDON){
+                pend->state = RIDP_FREE;
+                conn->inflight--;
             } else {
-                retryCount = 0;
-                break;
+                pend->state = RIDP_FAIL;
+                pthread_cond_signal(&pend->cond);
             }
         }
+        conn->head = 0;
+        conn->cnt  = 0;
+        pthread_cond_broadcast(&gRidCond);
+        pthread_mutex_unlock(&gRidMtx);
+        pthread_mutex_unlock(&conn->wmtx);
     }
-    
-    if(stk_RecvLogSvr((void*)s_buff ,s_buff[TYPEBYTE], stkName, msg, false) == -1){
-        sprintf(msg, "ERROR: STK[%s] ridian send log transfer fail", stkName);
+    return NULL;
+}
+
+/*****************************************************************************/
+/* 1. Function Name: rid_pipeSendRecv                                        */
+/* 2. Description  :  Ⱑ   pipeline      */
+/*                    STKinf.rid.pipeline   ٸ ʰ  */
+/*                    ۽Ѵ                                           */
+/* 3. Parameters   : char* s_buff    - ridian send  ޼                 */
+/*                   int   s_buffLen - ridian send  ޼ size            */
+/*                   char* r_buff    - ridian recv  ޼                 */
+/*                   STK_PROFILE *prof - STK profile                         */
+/* 4. Return Value : 'K' - , 'F' -                                   */
+/*****************************************************************************/
+char rid_pipeSendRecv(char* s_buff, unsigned short int s_buffLen, char* r_buff, unsigned short int r_size, STK_PROFILE *prof)
+{
+    char *stkName = prof->stkName;
+    RID_CONN *conn;
+    RID_PEND *pend;
+    struct timespec ts;
+    char msg[1024]={0,};
+    char statmsg[BUFSIZ];
+    char result;
+    int i, k, sock, n, sent, state, lost = 0, logFlag = 0;
+    time_t now;
+
+    if(msgVerify((char)s_buff[TYPEBYTE]) == false){
+        sprintf(msg, "ERROR: STK[%s] ridian send message type[%d]", stkName,(char)s_buff[TYPEBYTE]);
         logMessage(ERROR, msg);
+        return 'F';
     }
-    
+
+    ts.tv_sec  = time(NULL) + RID_LEASE_WAIT;
+    ts.tv_nsec = 0;
+    pthread_mutex_lock(&gRidMtx);
     while(1){
-        waittime.tv_sec =  10;
-        waittime.tv_usec = 0;
-        
-        FD_ZERO(&r_set);
-        FD_SET(ridsock,&r_set);
-        
-        sprintf(msg,"DEBUG: STK[%s] ridian recv select socket num[%d]",stkName,ridsock);
-        logMessage(DEBUG, msg);
-        
-        ret = select(ridsock+1, &r_set, NULL, NULL, &waittime); 
-        if(ret == -1){
-            if(retryCount == RETRY){
-                sprintf(msg,"ERROR: STK[%s] stocker recv select func error retry count over",stkName);
-                logMessage(ERROR, msg);
-                return 'F';
-            }
-            sprintf(msg,"ERROR: STK[%s] stocker recv select func RET[%d] errorno[%d]::%s",stkName,ret,errno,strerror(errno));
+        for(i = 0, conn = NULL; i < gRidPoolSize; i++){
+            if(gRidPool[i].sock < 0 || gRidPool[i].reset || gRidPool[i].inflight >= gRidPipeline) continue;
+            if(conn == NULL || gRidPool[i].inflight < conn->inflight) conn = &gRidPool[i];
+        }
+        if(conn != NULL) break;
+        ++gRidWaited;
+        if(pthread_cond_timedwait(&gRidCond, &gRidMtx, &ts) == ETIMEDOUT){
+            ++gRidTimeout;
+            pthread_mutex_unlock(&gRidMtx);
+            sprintf(msg, "ERROR: STK[%s] ridian pipeline wait timeout", stkName);
             logMessage(ERROR, msg);
-            close(ridsock);
-            ridsock = rid_connect(stkName);
-            if(ridsock == false){
-                sprintf(msg,"ERROR: STK[%s] ridian reconnect fail",stkName);
-                logMessage(ERROR, msg);
-                return 'F';
-            }
-            *ridiansock = ridsock;
-            sprintf(msg,"DEBUG: STK[%s] ridian reconnect socket num[%d]",stkName, ridsock);
-            logMessage(DEBUG, msg);
-            retryCount++;
+            return 'F';
+        }
+    }
+    for(k = 0; conn->pend[k].state != RIDP_FREE; k++);
+    pend = &conn->pend[k];
+    pend->state  = RIDP_WAIT;
+    pend->type   = s_buff[TYPEBYTE];
+    pend->r_size = r_size;
+    pend->r_buff = r_buff;
+    if(++conn->inflight > gRidPipeHigh) gRidPipeHigh = conn->inflight;
+    ++gRidPipeReq;
+    now = time(NULL);
+    if(now - gRidStatTime >= DB_STAT_INTERVAL){
+        gRidStatTime = now;
+        for(i = 0, n = 0; i < gRidPoolSize; i++){
+            if(gRidPool[i].sock >= 0) n++;
+        }
+        sprintf(statmsg, "INFO : Ridian pipeline size[%d] up[%d] depth[%d] high[%d] req[%ld] waited[%ld] timeout[%ld] fail[%ld] reset[%ld] garbage[%ld] orphan[%ld] desync[%ld] connect[%ld]",
+                gRidPoolSize, n, gRidPipeline, gRidPipeHigh, gRidPipeReq, gRidWaited, gRidTimeout,
+                gRidPipeFail, gRidReset, gRidGarbage, gRidOrphan, gRidDesync, gRidConn);
+        logFlag = 1;
+    }
+    pthread_mutex_unlock(&gRidMtx);
+    if(logFlag) logMessage(INFO, statmsg);
+
+    /* fifo ϰ ۽ wmtx ȿ Ͽ ۽  =   ǰ Ѵ */
+    pthread_mutex_lock(&conn->wmtx);
+    pthread_mutex_lock(&gRidMtx);
+    if((sock = conn->sock) >= 0 && conn->reset == 0){
+        conn->fifo[(conn->head + conn->cnt) % RID_MAXPIPE] = k;
+        conn->cnt++;
+    } else {
+        sock = -1;
+    }
+    pthread_mutex_unlock(&gRidMtx);
+    sent = (sock >= 0);
+    for(i = 0; sent && i < s_buffLen; i += n){
+        n = write(sock, s_buff + i, s_buffLen - i);
+        if(n < 0 && errno == EINTR){
+            n = 0;
             continue;
-        } else if( ret == 0){
-            if(retryCount == RETRY){
-                sprintf(msg,"ERROR: STK[%s] ridian recv time out error retry count over",stkName);
-                logMessage(ERROR, msg);
-                return 'F';
-            } else {
-                sprintf(msg,"ERROR: STK[%s] ridian recv time out error",stkName);
-                logMessage(ERROR, msg);
-                retryCount++;
-                continue;
-            }
-        } else {
-            retryCount=0;
+        }
+        if(n <= 0){
+            /*  thread    request   ϰ Ѵ */
+            shutdown(sock, SHUT_RDWR);
             break;
         }
     }
-    if(FD_ISSET(ridsock, &r_set)) {
-        s_buflen = read(ridsock, r_buff,HEADERSIZE);
-        memcpy(&r_buffLen,r_buff,LENGTHSIZE);
-        if(r_buffLen != r_size) {
-            while(1){
-                waittime.tv_sec =  1;
-                waittime.tv_usec = 0;
-                
-                FD_ZERO(&tmp_set);
-                FD_SET(ridsock,&tmp_set);
-                ret = select(ridsock+1, &tmp_set, NULL, NULL, &waittime); 
-                if(ret < 0){
-                    sprintf(msg,"ERROR: STK[%s] stocker garbage recv select func error",stkName);
-                    logMessage(ERROR, msg);
-                    return 'F';
-                } else if(ret == 0){
-                    sprintf(msg,"ERROR: STK[%s] stocker garbage recv select time out",stkName);
-                    logMessage(ERROR, msg);
-                    continue;
-                }
-                if((r_buffLen-totTmpLen-HEADERSIZE) > 1024){
-                    tmpLen = read(ridsock, tmpBuff, 1024);
-                } else if((r_buffLen-totTmpLen-HEADERSIZE) <= 1024){
-                    tmpLen = read(ridsock, tmpBuff, r_buffLen-totTmpLen-HEADERSIZE);
-                }
-                totTmpLen +=tmpLen;
-                sprintf(msg,"DEBUG: STK[%s] stocker garbage recv size[%d]",stkName,totTmpLen+HEADERSIZE);
-                logMessage(DEBUG, msg);
-                if(totTmpLen >= r_buffLen-HEADERSIZE){
-                    sprintf(msg,"DEBUG: STK[%s] stocker garbage recv size[%d] end",stkName,totTmpLen+HEADERSIZE);
-                    logMessage(DEBUG, msg);
-                    if(stk_MakeSendMsg((void *)s_buff, (void *)r_buff, (char)s_buff[TYPEBYTE], msg) == false){
-                        logMessage(ERROR, msg);
-                    }
-                    break;
-                }
-            }
-        } else {
-            if(msgVerify((char)r_buff[TYPEBYTE]) == false){
-                sprintf(msg, "ERROR: STK[%s] ridian recv message type[%d]", stkName,(char)r_buff[TYPEBYTE]);
-                logMessage(ERROR, msg);
-                return 'F';
-            } else {
-                if(s_buflen != HEADERSIZE){
-                    sprintf(msg,"ERROR: STK[%s] ridian recv MSGTYPE[%d] headersize is different",stkName, r_buff[TYPEBYTE]);
-                    logMessage(ERROR, msg);
-                    return 'F';
-                } else if(s_buff[TYPEBYTE] != r_buff[TYPEBYTE]){
-                    sprintf(msg,"ERROR: STK[%s] ridian SEND MSGTYPE[%d] RECV MSGTYPE[%d] headertype is different",
-                                                               stkName, s_buff[TYPEBYTE],r_buff[TYPEBYTE]);
-                    logMessage(ERROR, msg);
-                    return 'F';
-                }
-                s_buflen = read(ridsock, r_buff+HEADERSIZE,r_buffLen-HEADERSIZE);
-                if(s_buflen != r_buffLen-HEADERSIZE){
-                    sprintf(msg,"ERROR: STK[%s] ridian RECV MSGTYPE[%d] BODYSIZE[%d] READING SIZE[%d] is different",
-                                                               stkName, r_buff[TYPEBYTE],r_buffLen,s_buflen);
-                    logMessage(ERROR, msg);
-                    return 'F';
-                }
-            }
+    pthread_mutex_unlock(&conn->wmtx);
+
+    if(sent && stk_RecvLogSvr((void*)s_buff ,s_buff[TYPEBYTE], stkName, msg, false) == -1){
+        sprintf(msg, "ERROR: STK[%s] ridian send log transfer fail", stkName);
+        logMessage(ERROR, msg);
+    }
+
+    pthread_mutex_lock(&gRidMtx);
+    if(sent == 0){
+        pend->state = RIDP_FAIL;
+    }
+    ts.tv_sec  = time(NULL) + RID_TIMEOUT;
+    ts.tv_nsec = 0;
+    while(pend->state == RIDP_WAIT){
+        if(pthread_cond_timedwait(&pend->cond, &gRidMtx, &ts) == ETIMEDOUT) break;
+    }
+    state = pend->state;
+    if(state == RIDP_WAIT){
+        /* correlation ID       FIFO ¦ 
+         * и.  ݾ  request   нŰ, pend 
+         *  thread  ϸ鼭 ݳѴ */
+        pend->state = RIDP_ABANDON;
+        if(conn->reset == 0 && conn->sock >= 0){
+            conn->reset = 1;
+            shutdown(conn->sock, SHUT_RDWR);
+            ++gRidReset;
+            lost = 1;
+        }
+        ++gRidPipeFail;
+    } else {
+        if(state == RIDP_FAIL) ++gRidPipeFail;
+        pend->state = RIDP_FREE;
+        conn->inflight--;
+        pthread_cond_broadcast(&gRidCond);
+    }
+    pthread_mutex_unlock(&gRidMtx);
+    if(lost){
+        sprintf(msg, "ERROR: Ridian pipeline connection[%d] reply timeout, reconnect", conn->idx);
+        logMessage(ERROR, msg);
+    }
+
+    switch(state){
+    case RIDP_DONE:
+        result = 'K';
+        break;
+    case RIDP_GARBAGE:
+        /* rid_exchange   ̰ ٸ   ü   */
+        result = 'K';
+        sprintf(msg,"DEBUG: STK[%s] ridian MSGTYPE[%d] garbage reply dropped",stkName, s_buff[TYPEBYTE]);
+        logMessage(DEBUG, msg);
+        if(stk_MakeSendMsg((void *)s_buff, (void *)r_buff, (char)s_buff[TYPEBYTE], msg) == false){
+            logMessage(ERROR, msg);
         }
+        break;
+    case RIDP_WAIT:
+        result = 'F';
+        sprintf(msg, "ERROR: STK[%s] ridian MSGTYPE[%d] recv time out", stkName, s_buff[TYPEBYTE]);
+        logMessage(ERROR, msg);
+        break;
+    default:
+        result = 'F';
+        sprintf(msg, "ERROR: STK[%s] ridian MSGTYPE[%d] send/recv fail", stkName, s_buff[TYPEBYTE]);
+        logMessage(ERROR, msg);
+        break;
     }
-    
-    if(stk_SendLogSvr((void*)r_buff ,r_buff[TYPEBYTE], stkName, msg, false) == -1){
+    if(result == 'K' && stk_SendLogSvr((void*)r_buff ,r_buff[TYPEBYTE], stkName, msg, false) == -1){
         sprintf(msg, "ERROR: STK[%s] ridian recv log transfer fail", stkName);
         logMessage(ERROR, msg);
     }
-    return 'K';
+    return result;
 }
 
 /*****************************************************************************/
-/* 1. Function Name: rid_connect                                             */
-/* 2. Description  : ridian server                                   */
-/* 3. Parameters   : char *stkName    - stocker name                         */
+/* 1. Function Name: stk_recv                                                */
+/* 2. Description  : STK client recv                                     */
+/* 3. Parameters   : FRAME_RD *rd    - STK client socket frame reader        */
+/*                   char *r_buf     - STK client recv  buffer             */
+/*                   char *stkName   - STK client name                       */
+/*                   char *msg       - Error Message                         */
 /* 4. Return Value : int                                                     */
 /*****************************************************************************/ 
-int rid_connect(char *stkName)
+int stk_recv(FRAME_RD *rd, char* r_buf, char* stkName, char* msg)
 {
-    int ridiansock;
-    int retry = 0;
-    struct sockaddr_in ridAddr_in;
-    char msg[200]={0,};
-
-    memset(&ridAddr_in,0x00,sizeof(ridAddr_in));
-    ridAddr_in.sin_family = AF_INET;
-    ridAddr_in.sin_port = htons(RIDSERVER_PORT);
-    ridAddr_in.sin_addr.s_addr = inet_addr(RIDSERVER_IP);
+    char *frame;
+    int len;
+    int count =0;
     
     while(1){
-        retry = 0;
-        if((ridiansock = socket(AF_INET,SOCK_STREAM,0)) < 0){
-            sprintf(msg, "ERROR: STK[%s] ridian socket create fail..retry[%d]",stkName,retry);
+        len = frm_read(rd, &frame, 60*60, msg);
+        if(len < 0){
+            sprintf(msg, "ERROR: STK[%s] disconnect", stkName);
             logMessage(ERROR, msg);
-            if(retry >= RETRY){
-                ridiansock = -1;
-                return false;
-            } else {
-                retry++;
-                continue;
+            return -1;
+        } else if(len == 0){
+            if(count > RETRY){
+                sprintf(msg,"ERROR: STK[%s] recv timeout retry count over",stkName);
+                logMessage(ERROR, msg);
+                return 0;
             }
+            sprintf(msg,"INFO : STK[%s] recv timeout",stkName);
+            logMessage(INFO, msg);
+            count++;
+        } else {
+            memcpy(r_buf, frame, len);
+            return len;
         }
-        retry = 0;
-        if(connect(ridiansock, (struct sockaddr *)&ridAddr_in, sizeof(struct sockaddr)) == -1){
-            sprintf(msg, "ERROR: STK[%s] ridian connect fail..retry[%d]",stkName,retry);
-            logMessage(ERROR, msg);
-            if(retry >= RETRY){
-                close(ridiansock);
-                return false;
-            } else {
-                retry++;
-                close(ridiansock);
+    }
+}
+
+/*****************************************************************************/
+/* 1. Function Name: frm_init                                                */
+/* 2. Description  : length prefix frame reader ʱȭ                       */
+/*                      ٽ ȣϿ  byte      */
+/* 3. Parameters   : FRAME_RD *f     - frame reader                          */
+/*                   int sock        - socket                                */
+/*                   int bigEndian   - 1 : length  big-endian              */
+/*                   int resyncOn    - 1 : ߸ header  ǳʶڴ         */
+/*                                     0 : ߸ header  -1 ()        */
+/*                   int maxLen      - ִ frame  (cap )            */
+/*                   char *buf       -  buffer                           */
+/*                   int cap         -  buffer ũ                      */
+/*                   char *name      - log   ̸                      */
+/* 4. Return Value : None                                                    */
+/*****************************************************************************/
+void frm_init(FRAME_RD *f, int sock, int bigEndian, int resyncOn, int maxLen, char *buf, int cap, char *name)
+{
+    f->sock      = sock;
+    f->bigEndian = bigEndian;
+    f->resyncOn  = resyncOn;
+    f->maxLen    = (maxLen > cap) ? cap : maxLen;
+    f->cap       = cap;
+    f->head      = 0;
+    f->tail      = 0;
+    f->resync    = 0;
+    f->name      = name;
+    f->buf       = buf;
+}
+
+/*****************************************************************************/
+/* 1. Function Name: frm_read                                                */
+/* 2. Description  : ϼ frame ϳ . buffer  frame       */
+/*                    recv ϸ ѹ   ִ ŭ ޴´          */
+/*                   length  type  ߸ header  resyncOn ̸ 1 byte */
+/*                       header  ã (Ridian), ƴϸ     */
+/*                    stk_recv   -1    ´ (STK).   */
+/*                   STK  reactor_frameLen   Ƿ  I/O   */
+/*                                                               */
+/* 3. Parameters   : FRAME_RD *f     - frame reader                          */
+/*                   char **frame    - frame  ( ȣ  ȿ)    */
+/*                   int timeout     -  (), -1 :           */
+/*                   char *msg       - Error Message                         */
+/* 4. Return Value : >0 - frame , 0 - timeout, -1 -  Ǵ        */
+/*****************************************************************************/
+int frm_read(FRAME_RD *f, char **frame, int timeout, char *msg)
+{
+    unsigned short int msgLen;
+    struct timeval waittime;
+    fd_set r_set;
+    int avail, n, skipped = 0;
+
+    while(1){
+        while((avail = f->tail - f->head) >= HEADERSIZE){
+            memcpy(&msgLen, &f->buf[f->head], LENGTHSIZE);
+            if(f->bigEndian) msgLen = bigToLitts(msgLen);
+            if(msgLen < HEADERSIZE || msgLen > f->maxLen || msgVerify((char)f->buf[f->head + TYPEBYTE]) == false){
+                if(f->resyncOn == 0){
+                    sprintf(msg, "ERROR: %s unknown message type[%d] length[%d]", f->name,
+                            f->buf[f->head + TYPEBYTE], msgLen);
+                    logMessage(ERROR, msg);
+                    return -1;
+                }
+                f->head++;
+                skipped++;
                 continue;
             }
-        } else {
-            sprintf(msg, "INFO : STK[%s] ridian socket create success socket num[%d]",stkName, ridiansock);
-            logMessage(INFO, msg);
-            return ridiansock;
+            if(skipped > 0){
+                f->resync += skipped;
+                sprintf(msg, "ERROR: %s frame resync, skip[%d] total[%ld] byte", f->name, skipped, f->resync);
+                logMessage(ERROR, msg);
+                skipped = 0;
+            }
+            if(avail < msgLen) break;
+            *frame = &f->buf[f->head];
+            f->head += msgLen;
+            return msgLen;
+        }
+        /* ̿ϼ frame    maxLen   ڸ  */
+        if(f->head > 0){
+            memmove(f->buf, &f->buf[f->head], avail);
+            f->head = 0;
+            f->tail = avail;
+        }
+
+        n = recv(f->sock, &f->buf[f->tail], f->cap - f->tail, MSG_DONTWAIT);
+        if(n > 0){
+            f->tail += n;
+            continue;
+        }
+        if(n == 0) return -1;
+        if(errno == EINTR) continue;
+        if(errno != EAGAIN && errno != EWOULDBLOCK) return -1;
+
+        FD_ZERO(&r_set);
+        FD_SET(f->sock, &r_set);
+        waittime.tv_sec  = timeout;
+        waittime.tv_usec = 0;
+        n = select(f->sock+1, &r_set, NULL, NULL, (timeout < 0) ? NULL : &waittime);
+        if(n == 0) return 0;
+        if(n < 0 && errno != EINTR) return -1;
+    }
+}
+
+/*****************************************************************************/
+/* 1. Function Name: view_open                                               */
+/* 2. Description  : recv buffer  STK û frame   view    */
+/*                   糪 byte order ȯ  ʴ´                    */
+/* 3. Parameters   : STK_VIEW *v     - û view                             */
+/*                   char *recvBuf   - frame  ִ recv buffer         */
+/*                   char *msg       - Error Message                         */
+/* 4. Return Value : true -  frame, false - length Ǵ type         */
+/*****************************************************************************/
+int view_open(STK_VIEW *v, char *recvBuf, char *msg)
+{
+    unsigned short int msgLen;
+
+    memcpy(&msgLen, recvBuf, LENGTHSIZE);
+    v->buf  = recvBuf;
+    v->len  = bigToLitts(msgLen);
+    v->type = recvBuf[TYPEBYTE];
+    if(v->len < HEADERSIZE || v->len > BUFSIZ || msgVerify(v->type) == false){
+        return false;
+    }
+    return true;
+}
+
+/*****************************************************************************/
+/* 1. Function Name: view_u32                                                */
+/* 2. Description  : view  4 byte field  host order  д´            */
+/* 3. Parameters   : STK_VIEW *v     - û view                             */
+/*                   int off         - field offset                          */
+/* 4. Return Value : unsigned int - field                                  */
+/*****************************************************************************/
+unsigned int view_u32(STK_VIEW *v, int off)
+{
+    unsigned int val;
+
+    if(off + (int)sizeof(val) > v->len) return 0;
+    memcpy(&val, v->buf + off, sizeof(val));
+    return bigToLittl(val);
+}
+
+/*****************************************************************************/
+/* 1. Function Name: view_decode                                             */
+/* 2. Description  : Ridian   û host order ü ѹ ȯ   */
+/* 3. Parameters   : STK_VIEW *v     - û view                             */
+/*                   void *req       - host order û ü                */
+/*                   int size        - û ü ũ                      */
+/* 4. Return Value : true - , false - ȯ   type                */
+/*****************************************************************************/
+int view_decode(STK_VIEW *v, void *req, int size)
+{
+    WIRE_MSG *w = wire_find(v->type);
+
+    if(w == NULL) return false;
+    memcpy(req, v->buf, size);
+    wire_swap(w->req, req, size);
+    return true;
+}
+
+/*****************************************************************************/
+/* 1. Function Name: stk_writeReply                                          */
+/* 2. Description  : host order  network order 纻  write   */
+/*                   Ѵ. rep  ٲ Ƿ ״ log           */
+/* 3. Parameters   : int csock       - Client  ũ                */
+/*                   void *rep       - host order  ü                */
+/*                   int size        -  ü ũ                      */
+/* 4. Return Value : true - , false -                                */
+/*****************************************************************************/
+int stk_writeReply(int csock, void *rep, int size)
+{
+    long wire[BUFSIZ / sizeof(long)];
+    WIRE_MSG *w = wire_find(((char *)rep)[TYPEBYTE]);
+
+    if(w == NULL || size > (int)sizeof(wire)) return false;
+    memcpy(wire, rep, size);
+    wire_swap(w->rep, wire, size);
+    if(stk_writeAll(csock, wire, size) == false){
+        return false;
+    }
+    tlReplyResult = wire_result(w, rep);
+    return true;
+}
+
+/*****************************************************************************/
+/* 1. Function Name: stk_writeAll                                            */
+/* 2. Description  : non-blocking STK socket  size byte   write Ѵ */
+/*                   socket buffer   STK_WRITE_TIMEOUT  ٸ   */
+/* 3. Parameters   : int csock       - Client  ũ                */
+/*                   void *buf       -  buffer                           */
+/*                   int size        -  ũ                             */
+/* 4. Return Value : true - , false -                                */
+/*****************************************************************************/
+int stk_writeAll(int csock, void *buf, int size)
+{
+    struct pollfd pfd;
+    char *p = (char *)buf;
+    int n, off = 0;
+
+    while(off < size){
+        if((n = write(csock, p + off, size - off)) > 0){
+            off += n;
+            continue;
         }
+        if(n < 0 && errno == EINTR) continue;
+        if(n == 0 || (errno != EAGAIN && errno != EWOULDBLOCK)) return false;
+
+        pfd.fd      = csock;
+        pfd.events  = POLLOUT;
+        pfd.revents = 0;
+        if((n = poll(&pfd, 1, STK_WRITE_TIMEOUT * 1000)) < 0 && errno == EINTR) continue;
+        if(n <= 0 || (pfd.revents & (POLLERR | POLLHUP | POLLNVAL))) return false;
     }
+    return true;
 }
 
 /*****************************************************************************/
-/* 1. Function Name: rid_close                                               */
-/* 2. Description  : ridian server                                   */
-/* 3. Parameters   : int  ridsock     - ridian socket                        */
-/*                   char *stkName    - stocker name                         */
-/* 4. Return Value : int                                                     */
-/*****************************************************************************/ 
-int rid_close(int ridsock, char *stkName)
+/* 1. Function Name: wire_find                                               */
+/* 2. Description  : msgType  wire descriptor  ã´                    */
+/* 3. Parameters   : char msgType    - message type                          */
+/* 4. Return Value : WIRE_MSG * - descriptor, NULL -  ʴ type      */
+/*****************************************************************************/
+WIRE_MSG * wire_find(char msgType)
 {
-    rSimpleRequest treq, *req;
-    req = &treq;
-    memset(req, 0x00, sizeof(rSimpleRequest));    
-    
-    req->msgLen = sizeof(rSimpleRequest);
-    req->msgType = msgTypeCloseRequest;
-    
-    rSimpleReply trep, *rep;
-    rep = &trep;
-    memset(rep,0x00,sizeof(rSimpleReply));
-    
-    if(rid_SendRecv(ridsock, (char*)req, sizeof(rSimpleRequest), (char*)rep, sizeof(rSimpleReply), stkName) == 'K'){
-        close(ridsock);
-        return true;
-    } else {
-        close(ridsock);
-        return false;
-    }
+    unsigned char t = (unsigned char)msgType;
+
+    if(t >= WIRE_MAXTYPE || gWireTab[t].name == NULL) return NULL;
+    return &gWireTab[t];
 }
 
 /*****************************************************************************/
-/* 1. Function Name: stk_recv                                                */
-/* 2. Description  : STK client recv                                     */
-/* 3. Parameters   : int   sock      - STK client socket ũ          */
-/*                   char *r_buf     - STK client recv  buffer             */
-/*                   char *stkName   - STK client name                       */
-/*                   char *msg       - Error Message                         */
-/* 4. Return Value : int                                                     */
-/*****************************************************************************/ 
-int stk_recv(int sock, char* r_buf, char* stkName, char* msg)
+/* 1. Function Name: wire_swap                                               */
+/* 2. Description  : descriptor   field  byte order  ٲ۴      */
+/*                    ȯ ̹Ƿ encode/decode  Ѵ    */
+/*                   len  Ѵ field  ǵ帮 ʴ´                    */
+/*                   WIRE_LEGACY field   bigToLittl   Ѵ   */
+/* 3. Parameters   : WIRE_FIELD *f   - field descriptor                  */
+/*                   void *buf       - ȯ ü                         */
+/*                   int len         - buf  ȿ                       */
+/* 4. Return Value : void                                                    */
+/*****************************************************************************/
+void wire_swap(WIRE_FIELD *f, void *buf, int len)
 {
-    unsigned short int msgLen;
-    int n_rBuf;
-    int n_rBuf_tot=0;
-    int ret;
-    int count =0;
-    
-    struct timeval waittime;
-    fd_set r_set;
-    
-    waittime.tv_sec =  60*60;
-    waittime.tv_usec = 0;
-    
-    while(1){
-        FD_ZERO(&r_set);
-        FD_SET(sock,&r_set);
-        ret = select(sock+1, &r_set, NULL, NULL, &waittime);
-        
-        if(ret == -1){
-            sprintf(msg,"ERROR: STK[%s] select func error",stkName);
-            logMessage(ERROR, msg);
-            return -1;
-        } else if( ret == 0){
-            if(count > RETRY){
-                sprintf(msg,"ERROR: STK[%s] recv timeout retry count over",stkName);
-                logMessage(ERROR, msg);
-                return 0;
-            }
-            sprintf(msg,"INFO : STK[%s] recv timeout",stkName);
-            logMessage(INFO, msg);
-            count++;
-        } else if(ret > 0){
-            break;
-        }
-    }
-    if(FD_ISSET(sock, &r_set)) {
-        n_rBuf = read(sock,r_buf,HEADERSIZE);
-        if(n_rBuf != HEADERSIZE && n_rBuf > 0){
-            sprintf(msg,"ERROR: STK[%s] recv msg header read fail",stkName);
-            logMessage(ERROR, msg);
-            return -1;
-        } else if(n_rBuf <= 0){
-            sprintf(msg, "ERROR: STK[%s] disconnect", stkName);
-            logMessage(ERROR, msg);
-            return -1;
-        }
-        if(msgVerify((char)r_buf[TYPEBYTE]) == false){
-            sprintf(msg, "ERROR: STK[%s] unknown message type[%d]", stkName,r_buf[TYPEBYTE]); 
-            logMessage(ERROR, msg);
-            return -1;
-        }
-        memcpy(&msgLen, r_buf, LENGTHSIZE);
-        msgLen = bigToLitts(msgLen);
-        while(1){
-            n_rBuf_tot += n_rBuf;
-            if(msgLen > n_rBuf_tot){
-                n_rBuf = read(sock,&r_buf[n_rBuf_tot], msgLen - n_rBuf_tot);
-                if(n_rBuf <= 0){
-                    sprintf(msg,"ERROR: STK[%s] disconnect",stkName);
-                    logMessage(ERROR, msg);
-                    return -1;
-                }
-            } else {
-                return n_rBuf_tot;
-            }
+    char *p;
+    unsigned short v16;
+    unsigned int   v32;
+    unsigned long  v64;
+
+    for(; f->width != 0 && f->off + WIRE_WIDTH(f) <= len; f++){
+        p = (char *)buf + f->off;
+        switch(f->width){
+            case 2 :
+                memcpy(&v16, p, 2);
+                v16 = __builtin_bswap16(v16);
+                memcpy(p, &v16, 2);
+                break;
+            case 4 :
+            case 4 | WIRE_LEGACY :
+                memcpy(&v32, p, 4);
+                v32 = __builtin_bswap32(v32);
+                memcpy(p, &v32, 4);
+                break;
+            case 8 :
+                memcpy(&v64, p, 8);
+                v64 = __builtin_bswap64(v64);
+                memcpy(p, &v64, 8);
+                break;
+            case 2 | WIRE_LEGACY :
+                /* short  int   bigToLittl   16 bit   */
+                memcpy(&v16, p, 2);
+                v16 = (unsigned short)bigToLittl((unsigned int)(int)(short)v16);
+                memcpy(p, &v16, 2);
+                break;
+            case 8 | WIRE_LEGACY :
+                /*  4 byte  ٲٰ  4 byte  0 */
+                memcpy(&v64, p, 8);
+                v64 = (unsigned long)bigToLittl((unsigned int)v64);
+                memcpy(p, &v64, 8);
+                break;
         }
     }
 }
@@ -3134,14 +6093,18 @@ int bcr_connect(char* bcrIP)
 /* 2. Description  : STK client  BCR                           */
 /* 3. Parameters   : char *bcrIP     - STK client  BCR IP              */
 /*                   char *cstID     -  BCR  BCR ID            */
-/*                   char *stkName   - STK client name                       */
+/*                   STK_PROFILE *prof - STK profile                         */
 /*                   char *msg       - Error Message                         */
 /* 4. Return Value : int                                                     */
 /*****************************************************************************/
-int bcr_SendRecv(char* bcrIP, char* cstID, char* stkName, char* msg)
+int bcr_SendRecv(char* bcrIP, char* cstID, STK_PROFILE *prof, char* msg)
 {
+    char *stkName = prof->stkName;      /* profile  STK name */
     int retry = 0;
     int bcrsock = -1;
+    int slot = -1;                      /* bcrc_lease  reader      */
+    long readUs = 0;
+    struct timeval tv1, tv2;
     int n_rBuf;
     char s_buf[1];
     int ret;
@@ -3156,8 +6119,14 @@ int bcr_SendRecv(char* bcrIP, char* cstID, char* stkName, char* msg)
     waittime.tv_usec = 0;
 
     while(1){
-        bcrsock = bcr_connect(bcrIP);
-        if(bcrsock == -1){
+        bcrsock = bcrc_lease(bcrIP, &slot, msg);
+        if(bcrsock == -3){
+            /*  з backoff  reader  õ ʰ ٷ  */
+            logMessage(ERROR, msg);
+            sprintf(msg,"ERROR: STK[%s] BCRIP[%s] connect fail reader is down",stkName,bcrIP);
+            logMessage(ERROR, msg);
+            return -2;
+        } else if(bcrsock == -1){
             retry++;
             if(retry == RETRY){
                 sprintf(msg,"ERROR: STK[%s] BCRIP[%s] connect fail retry count over",stkName,bcrIP);
@@ -3181,6 +6150,7 @@ int bcr_SendRecv(char* bcrIP, char* cstID, char* stkName, char* msg)
     }
     retry = 0;
     s_buf[0] = 0x05;
+    gettimeofday(&tv1, NULL);
 
     while(1){
         FD_ZERO(&s_set);
@@ -3190,19 +6160,19 @@ int bcr_SendRecv(char* bcrIP, char* cstID, char* stkName, char* msg)
         if(ret == -1){
             sprintf(msg,"ERROR: STK[%s] BCRIP[%s] send func error",stkName,bcrIP);
             logMessage(ERROR, msg);
-            close(bcrsock);
+            bcrc_release(slot, bcrsock, false, readUs);
             return -1;
         } else if( ret == 0){
             sprintf(msg,"ERROR: STK[%s] BCRIP[%s] send time out",stkName,bcrIP);
             logMessage(ERROR, msg);
-            close(bcrsock);
+            bcrc_release(slot, bcrsock, false, readUs);
             return -1;
         } else if(ret > 0){
             if(FD_ISSET(bcrsock, &s_set)){
                 if(write(bcrsock, s_buf, sizeof(s_buf)) <= 0){
                     sprintf(msg,"ERROR: STK[%s] bcr reading command send fail",stkName);
                     logMessage(ERROR, msg);
-                    close(bcrsock);
+                    bcrc_release(slot, bcrsock, false, readUs);
                     return -1;
                 }
             }
@@ -3215,12 +6185,12 @@ int bcr_SendRecv(char* bcrIP, char* cstID, char* stkName, char* msg)
         if(ret == -1){
             sprintf(msg,"ERROR: STK[%s] BCRIP[%s] recv func error",stkName,bcrIP);
             logMessage(ERROR, msg);
-            close(bcrsock);
+            bcrc_release(slot, bcrsock, false, readUs);
             return -1;
         } else if( ret == 0){
             sprintf(msg,"ERROR: STK[%s] BCRIP[%s] recv time out",stkName,bcrIP);
             logMessage(ERROR, msg);
-            close(bcrsock);
+            bcrc_release(slot, bcrsock, false, readUs);
             return -1;
         } else if(ret > 0){
             if(FD_ISSET(bcrsock, &r_set)){
@@ -3228,9 +6198,11 @@ int bcr_SendRecv(char* bcrIP, char* cstID, char* stkName, char* msg)
                 if(n_rBuf <= 0){
                     sprintf(msg,"ERROR: STK[%s] BCRIP[%s] disconnect bcr",stkName,bcrIP);
                     logMessage(ERROR, msg);
-                    close(bcrsock);
+                    bcrc_release(slot, bcrsock, false, 0);
                     return -1;
                 }
+                gettimeofday(&tv2, NULL);
+                readUs = (tv2.tv_sec - tv1.tv_sec) * 1000000L + (tv2.tv_usec - tv1.tv_usec);
             }
 
 			//2016.01.13 ī޶ Type Bar Code Reaader ⿡ Data  7 ڸ ߻Ͽ Data ȯ ǽ
@@ -3245,7 +6217,7 @@ int bcr_SendRecv(char* bcrIP, char* cstID, char* stkName, char* msg)
             sprintf(msg,"INFO : BCR_ID_TRANS2 STK[%s] BCRIP[%s] read CSTID[%s]",stkName,bcrIP,cstID);
             logMessage(INFO, msg);
 
-			if ( 0 == memcmp (stkName, "CPST", 4) && cstID[0] == 'S' )
+			if ( prof->podTrans == 1 && cstID[0] == 'S' )
 			{
 				//2019.07.29 Pod ID -> Cst ID  ȯ, ӽ Test   CPST27  
 				memcpy (temp_pod_id, cstID, 6);
@@ -3290,25 +6262,25 @@ int bcr_SendRecv(char* bcrIP, char* cstID, char* stkName, char* msg)
                     if(ret == -1){
                         sprintf(msg,"ERROR: STK[%s] BCRIP[%s] send timeout command func error",stkName,bcrIP);
                         logMessage(ERROR, msg);
-                        close(bcrsock);
+                        bcrc_release(slot, bcrsock, false, readUs);
                         return -1;
                     } else if( ret == 0){
                         sprintf(msg,"ERROR: STK[%s] BCRIP[%s] send timeout command time out",stkName,bcrIP);
                         logMessage(ERROR, msg);
-                        close(bcrsock);
+                        bcrc_release(slot, bcrsock, false, readUs);
                         return -1;
                     } else if(ret > 0){
                         if(FD_ISSET(bcrsock, &s_set)){
                             if(write(bcrsock, s_buf, sizeof(s_buf)) <= 0){
                                 sprintf(msg,"ERROR: STK[%s] bcr reading timeout command send fail",stkName);
                                 logMessage(ERROR, msg);
-                                close(bcrsock);
+                                bcrc_release(slot, bcrsock, false, readUs);
                                 return -1;
                             }
                         }
                     }
                     memset(cstID, 0x00, 12);
-                    close(bcrsock);
+                    bcrc_release(slot, bcrsock, false, readUs);
                     return -1;
                 }
             } else {
@@ -3323,33 +6295,482 @@ int bcr_SendRecv(char* bcrIP, char* cstID, char* stkName, char* msg)
                 if(ret == -1){
                     sprintf(msg,"ERROR: STK[%s] BCRIP[%s] send timeout command func error",stkName,bcrIP);
                     logMessage(ERROR, msg);
-                    close(bcrsock);
+                    bcrc_release(slot, bcrsock, false, readUs);
                     return true;
                 } else if( ret == 0){
                     sprintf(msg,"ERROR: STK[%s] BCRIP[%s] send timeout command time out",stkName,bcrIP);
                     logMessage(ERROR, msg);
-                    close(bcrsock);
+                    bcrc_release(slot, bcrsock, false, readUs);
                     return true;
                 } else if(ret > 0){
                     if(FD_ISSET(bcrsock, &s_set)){
                         if(write(bcrsock, s_buf, sizeof(s_buf)) <= 0){
                             sprintf(msg,"ERROR: STK[%s] bcr reading timeout command send fail",stkName);
                             logMessage(ERROR, msg);
-                            close(bcrsock);
+                            bcrc_release(slot, bcrsock, false, readUs);
                             return true;
                         }
                     }
                 }
                 sprintf(msg,"DEBUG: STK[%s] BCRIP[%s] send timeout command success", stkName, bcrIP);
-                close(bcrsock);
+                bcrc_release(slot, bcrsock, true, readUs);
                 return 0;
             }
         }
     }
-    close(bcrsock);
+    bcrc_release(slot, bcrsock, true, readUs);
     return 0;
 } 
 
+/*****************************************************************************/
+/* 1. Function Name: bcrc_start                                              */
+/* 2. Description  : BCR connection manager thread                       */
+/* 3. Parameters   : pthread_attr_t *attr -  Ӽ                      */
+/*                   char *msg            - error message                    */
+/* 4. Return Value : 0 - , -1 -                                      */
+/*****************************************************************************/
+int bcrc_start(pthread_attr_t *attr, char *msg)
+{
+    pthread_t tid;
+
+    if(gBcrcOn == 0){
+        sprintf(msg, "INFO : BCR connection manager disabled");
+        logMessage(INFO, msg);
+        return 0;
+    }
+    if(pthread_create(&tid, attr, bcrc_thread, NULL) != 0){
+        sprintf(msg, "ERROR: BCR connection manager thread create fail errno[%d]", errno);
+        return -1;
+    }
+    return 0;
+}
+
+/*****************************************************************************/
+/* 1. Function Name: bcrc_find                                               */
+/* 2. Description  : reader IP   slot ˻,   (gBcrcMtx ʿ)*/
+/* 3. Parameters   : char *bcrIP     -  BCR IP                         */
+/* 4. Return Value : slot index, -1 - table full                             */
+/*****************************************************************************/
+int bcrc_find(char *bcrIP)
+{
+    int i;
+
+    for(i = 0; i < gBcrcCnt; i++){
+        if(strcmp(gBcrc[i].ip, bcrIP) == 0) return i;
+    }
+    if(gBcrcCnt >= BCRC_MAX || strlen(bcrIP) >= sizeof(gBcrc[0].ip)) return -1;
+    memset(&gBcrc[i], 0x00, sizeof(BCR_CONN));
+    strcpy(gBcrc[i].ip, bcrIP);
+    gBcrc[i].sock  = -1;
+    gBcrc[i].state = BCRC_IDLE;
+    gBcrcCnt++;
+    return i;
+}
+
+/*****************************************************************************/
+/* 1. Function Name: bcrc_connect                                            */
+/* 2. Description  : BCRC_CONN_TIMEOUT  ΰ  BCR              */
+/*                     reader  OS timeout  ٸ ʴ´     */
+/* 3. Parameters   : char *bcrIP     -  BCR IP                         */
+/*                   long *connUs    - connect ҿð(usec)                */
+/* 4. Return Value : socket, -1 -  , -2 - socket             */
+/*****************************************************************************/
+int bcrc_connect(char *bcrIP, long *connUs)
+{
+    int bcrsock, flags, err = 0;
+    socklen_t len = sizeof(err);
+    struct sockaddr_in bcrAddr_in;
+    struct timeval tv, tv1, tv2;
+    fd_set w_set;
+
+    memset(&bcrAddr_in,0x00,sizeof(bcrAddr_in));
+    bcrAddr_in.sin_family = AF_INET;
+    bcrAddr_in.sin_port = htons(MOD_PORT);
+    bcrAddr_in.sin_addr.s_addr = inet_addr(bcrIP);
+
+    if((bcrsock = socket(AF_INET,SOCK_STREAM,0)) < 0){
+        return -2;
+    }
+    gettimeofday(&tv1, NULL);
+    flags = fcntl(bcrsock, F_GETFL, 0);
+    fcntl(bcrsock, F_SETFL, flags | O_NONBLOCK);
+    if(connect(bcrsock, (struct sockaddr *)&bcrAddr_in, sizeof(struct sockaddr)) == -1){
+        if(errno != EINPROGRESS){
+            close(bcrsock);
+            return -1;
+        }
+        FD_ZERO(&w_set);
+        FD_SET(bcrsock, &w_set);
+        tv.tv_sec  = BCRC_CONN_TIMEOUT;
+        tv.tv_usec = 0;
+        if(select(bcrsock+1, NULL, &w_set, NULL, &tv) <= 0 ||
+           getsockopt(bcrsock, SOL_SOCKET, SO_ERROR, &err, &len) < 0 || err != 0){
+            close(bcrsock);
+            return -1;
+        }
+    }
+    fcntl(bcrsock, F_SETFL, flags);
+    gettimeofday(&tv2, NULL);
+    *connUs = (tv2.tv_sec - tv1.tv_sec) * 1000000L + (tv2.tv_usec - tv1.tv_usec);
+    return bcrsock;
+}
+
+/*****************************************************************************/
+/* 1. Function Name: bcrc_alive                                              */
+/* 2. Description  : idle  liveness check. reader   false,     */
+/*                   ִ ( read  ܿ data)           */
+/* 3. Parameters   : int sock        - BCR socket                            */
+/* 4. Return Value : true -  , false -                         */
+/*****************************************************************************/
+int bcrc_alive(int sock)
+{
+    char buf[64];
+    int n;
+
+    while(1){
+        n = recv(sock, buf, sizeof(buf), MSG_DONTWAIT);
+        if(n > 0) continue;
+        if(n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) return true;
+        return false;
+    }
+}
+
+/*****************************************************************************/
+/* 1. Function Name: bcrc_lease                                              */
+/* 2. Description  : reader  warm  lease.   ٷ ,   */
+/*                     reader  retry ð ٷ  ó   */
+/*                    reader  ٸ thread    bcrc_connect  */
+/*                      (slot  )                           */
+/* 3. Parameters   : char *bcrIP     -  BCR IP                         */
+/*                   int *slot       - lease  slot (bcrc_release  )  */
+/*                   char *msg       - Error Message                         */
+/* 4. Return Value : socket, -1 -  , -2 - socket  ,          */
+/*                  -3 -   reader (retry ð )                */
+/*****************************************************************************/
+int bcrc_lease(char *bcrIP, int *slot, char *msg)
+{
+    BCR_CONN *bc;
+    int i, sock;
+    long connUs = 0;
+    time_t now;
+
+    *slot = -1;
+    if(gBcrcOn == 0){
+        return bcr_connect(bcrIP);
+    }
+    now = time(NULL);
+    pthread_mutex_lock(&gBcrcMtx);
+    if((i = bcrc_find(bcrIP)) < 0){
+        ++gBcrcFull;
+        pthread_mutex_unlock(&gBcrcMtx);
+        return bcrc_connect(bcrIP, &connUs);
+    }
+    bc = &gBcrc[i];
+    if(bc->state == BCRC_BUSY){
+        /*  ᵵ BCRC_CONN_TIMEOUT ȿ ٸ */
+        pthread_mutex_unlock(&gBcrcMtx);
+        return bcrc_connect(bcrIP, &connUs);
+    }
+    if(bc->sock < 0 && now < bc->retryAt){
+        pthread_mutex_unlock(&gBcrcMtx);
+        sprintf(msg, "ERROR: BCRIP[%s] reader is down, next connect after %ld sec", bcrIP, (long)(bc->retryAt - now));
+        return -3;
+    }
+    bc->state = BCRC_BUSY;
+    sock = bc->sock;
+    pthread_mutex_unlock(&gBcrcMtx);
+
+    if(sock >= 0 && bcrc_alive(sock) == false){
+        close(sock);
+        sock = -1;
+        __sync_fetch_and_add(&bc->dead, 1);
+    }
+    if(sock >= 0){
+        __sync_fetch_and_add(&bc->reuse, 1);
+        *slot = i;
+        return sock;
+    }
+
+    sock = bcrc_connect(bcrIP, &connUs);
+    pthread_mutex_lock(&gBcrcMtx);
+    if(sock >= 0){
+        bc->sock    = sock;
+        bc->backoff = 0;
+        bc->conn++;
+        bc->connUs += connUs;
+        if(connUs > bc->connMax) bc->connMax = connUs;
+        *slot = i;
+    } else {
+        bc->sock  = -1;
+        bc->state = BCRC_IDLE;
+        bc->connFail++;
+        bc->backoff = (bc->backoff == 0) ? 1 : bc->backoff * 2;
+        if(bc->backoff > BCRC_BACKOFF_MAX) bc->backoff = BCRC_BACKOFF_MAX;
+        bc->retryAt = time(NULL) + bc->backoff;
+    }
+    pthread_mutex_unlock(&gBcrcMtx);
+    return sock;
+}
+
+/*****************************************************************************/
+/* 1. Function Name: bcrc_release                                            */
+/* 2. Description  : lease   ȯ.   read  warm      */
+/*                       ݴ´                          */
+/* 3. Parameters   : int slot        - bcrc_lease  slot (-1 :  )   */
+/*                   int sock        - BCR socket                            */
+/*                   int keep        - true :                        */
+/*                   long readUs     - 0x05 ~   ð (0 : )      */
+/* 4. Return Value : None                                                    */
+/*****************************************************************************/
+void bcrc_release(int slot, int sock, int keep, long readUs)
+{
+    BCR_CONN *bc;
+
+    if(slot < 0){
+        close(sock);
+        return;
+    }
+    bc = &gBcrc[slot];
+    pthread_mutex_lock(&gBcrcMtx);
+    if(readUs > 0){
+        bc->read++;
+        bc->readUs += readUs;
+        if(readUs > bc->readMax) bc->readMax = readUs;
+    }
+    if(keep == false){
+        close(sock);
+        bc->sock = -1;
+    }
+    bc->state = BCRC_IDLE;
+    pthread_mutex_unlock(&gBcrcMtx);
+}
+
+/*****************************************************************************/
+/* 1. Function Name: bcrc_thread                                             */
+/* 2. Description  : BCRC_CHECK ֱ topology  reader  ϰ, idle  */
+/*                    liveness check  ̿ reader warm-up        */
+/*                   DB_STAT_INTERVAL  reader  latency  log        */
+/* 3. Parameters   : None                                                    */
+/* 4. Return Value : None                                                    */
+/*****************************************************************************/
+void * bcrc_thread(void *arg)
+{
+    TOPO_INDEX *t;
+    BCR_CONN *bc, st;
+    char errmsg[BUFSIZ];
+    char ip[20];
+    int i, sock, cnt;
+    long connUs;
+    time_t now, statTime = time(NULL);
+
+    pthread_detach(pthread_self());
+    while(1){
+        sleep(BCRC_CHECK);
+
+        pthread_mutex_lock(&gBcrcMtx);
+        pthread_rwlock_rdlock(&gTopoLock);
+        if((t = gTopo) != NULL){
+            for(i = 0; i < t->nport; i++){
+                if(t->port[i].bcrIP[0] != 0x00) bcrc_find(t->port[i].bcrIP);
+            }
+        }
+        pthread_rwlock_unlock(&gTopoLock);
+        /* slot  ߰ ǹǷ cnt  slot   ȿϴ */
+        cnt = gBcrcCnt;
+        pthread_mutex_unlock(&gBcrcMtx);
+
+        for(i = 0; i < cnt; i++){
+            bc  = &gBcrc[i];
+            now = time(NULL);
+            pthread_mutex_lock(&gBcrcMtx);
+            if(bc->state == BCRC_BUSY || (bc->sock < 0 && now < bc->retryAt)){
+                pthread_mutex_unlock(&gBcrcMtx);
+                continue;
+            }
+            bc->state = BCRC_BUSY;
+            sock = bc->sock;
+            strcpy(ip, bc->ip);
+            pthread_mutex_unlock(&gBcrcMtx);
+
+            if(sock >= 0){
+                if(bcrc_alive(sock) == false){
+                    close(sock);
+                    sock = -1;
+                    __sync_fetch_and_add(&bc->dead, 1);
+                    sprintf(errmsg, "ERROR: BCRIP[%s] warm connection closed by reader", ip);
+                    logMessage(ERROR, errmsg);
+                }
+                pthread_mutex_lock(&gBcrcMtx);
+                bc->sock  = sock;
+                bc->state = BCRC_IDLE;
+                pthread_mutex_unlock(&gBcrcMtx);
+                continue;
+            }
+
+            sock = bcrc_connect(ip, &connUs);
+            pthread_mutex_lock(&gBcrcMtx);
+            bc->sock  = sock < 0 ? -1 : sock;
+            bc->state = BCRC_IDLE;
+            if(sock >= 0){
+                bc->backoff = 0;
+                bc->conn++;
+                bc->connUs += connUs;
+                if(connUs > bc->connMax) bc->connMax = connUs;
+            } else {
+                bc->connFail++;
+                bc->backoff = (bc->backoff == 0) ? BCRC_CHECK : bc->backoff * 2;
+                if(bc->backoff > BCRC_BACKOFF_MAX) bc->backoff = BCRC_BACKOFF_MAX;
+                bc->retryAt = time(NULL) + bc->backoff;
+            }
+            pthread_mutex_unlock(&gBcrcMtx);
+        }
+
+        now = time(NULL);
+        if(now - statTime < DB_STAT_INTERVAL) continue;
+        statTime = now;
+        for(i = 0; i < cnt; i++){
+            bc = &gBcrc[i];
+            /*  lock ȿ   log Ѵ */
+            pthread_mutex_lock(&gBcrcMtx);
+            if(bc->read == bc->logged && bc->sock >= 0){
+                pthread_mutex_unlock(&gBcrcMtx);
+                continue;
+            }
+            bc->logged = bc->read;
+            memcpy(&st, bc, sizeof(BCR_CONN));
+            st.reuse = __sync_fetch_and_add(&bc->reuse, 0);
+            st.dead  = __sync_fetch_and_add(&bc->dead, 0);
+            pthread_mutex_unlock(&gBcrcMtx);
+            sprintf(errmsg, "INFO : BCRIP[%s] %s conn[%ld] connFail[%ld] connAvg[%ldus] connMax[%ldus] read[%ld] readAvg[%ldus] readMax[%ldus] reuse[%ld] dead[%ld]",
+                    st.ip, st.sock >= 0 ? "UP" : "DOWN", st.conn, st.connFail,
+                    st.conn > 0 ? st.connUs / st.conn : 0L, st.connMax,
+                    st.read, st.read > 0 ? st.readUs / st.read : 0L, st.readMax, st.reuse, st.dead);
+            logMessage(INFO, errmsg);
+        }
+        if(gBcrcFull > 0){
+            sprintf(errmsg, "INFO : BCR connection manager table full lease[%ld]", gBcrcFull);
+            logMessage(INFO, errmsg);
+        }
+    }
+    return NULL;
+}
+
+/*****************************************************************************/
+/* 1. Function Name: bcr_readPoolStart                                       */
+/* 2. Description  : barcode read thread pool                            */
+/*                   STKinf.bcr.concurrent=0 ̸  ʴ´              */
+/* 3. Parameters   : pthread_attr_t *attr -  Ӽ                      */
+/*                   char *msg            - error message                    */
+/* 4. Return Value : 0 - , -1 -                                      */
+/*****************************************************************************/
+int bcr_readPoolStart(pthread_attr_t *attr, char *msg)
+{
+    pthread_t tid;
+    int i;
+
+    if(gBcrConcurrent == 0){
+        return 0;
+    }
+    for(i = 0; i < BCR_READERS; i++){
+        if(pthread_create(&tid, attr, bcr_readThread, NULL) != 0){
+            sprintf(msg, "ERROR: BCR read thread create fail errno[%d]", errno);
+            return -1;
+        }
+    }
+    return 0;
+}
+
+/*****************************************************************************/
+/* 1. Function Name: bcr_readStart                                           */
+/* 2. Description  : barcode read  read pool  ñ                     */
+/*                    read thread  ų STKinf.bcr.concurrent=0 ̸ */
+/*                   ٷ а ƿ´ (bcr_readJoin  ϰ ȣ)      */
+/* 3. Parameters   : BCR_READ *br      - read  (join   )     */
+/*                   char *bcrIP       - STK client  BCR IP            */
+/*                   STK_PROFILE *prof - STK profile                         */
+/* 4. Return Value : None                                                    */
+/*****************************************************************************/
+void bcr_readStart(BCR_READ *br, char *bcrIP, STK_PROFILE *prof)
+{
+    memset(br, 0x00, sizeof(BCR_READ));
+    br->bcrIP = bcrIP;
+    br->prof  = prof;
+    br->result = -1;
+    clock_gettime(CLOCK_MONOTONIC, &br->t0);
+
+    if(gBcrConcurrent == 1){
+        pthread_mutex_lock(&gBcrrMtx);
+        /*  list   thread   ʰ Ͽ read  ټ ʰ Ѵ */
+        if(gBcrrIdle > 0){
+            --gBcrrIdle;
+            if(gBcrrTail != NULL) gBcrrTail->next = br;
+            else                  gBcrrHead = br;
+            gBcrrTail = br;
+            br->started = 1;
+            pthread_cond_signal(&gBcrrCond);
+        }
+        pthread_mutex_unlock(&gBcrrMtx);
+        if(br->started == 1) return;
+    }
+    br->result = bcr_SendRecv(br->bcrIP, br->barcodeID, br->prof, br->errmsg);
+    clock_gettime(CLOCK_MONOTONIC, &br->t1);
+}
+
+/*****************************************************************************/
+/* 1. Function Name: bcr_readThread                                          */
+/* 2. Description  : read pool thread.  list  barcode read  ó     */
+/* 3. Parameters   : void *arg       - ̻                                */
+/* 4. Return Value : None                                                    */
+/*****************************************************************************/
+void * bcr_readThread(void *arg)
+{
+    BCR_READ *br;
+
+    pthread_detach(pthread_self());
+    pthread_mutex_lock(&gBcrrMtx);
+    ++gBcrrIdle;
+    while(1){
+        while(gBcrrHead == NULL){
+            pthread_cond_wait(&gBcrrCond, &gBcrrMtx);
+        }
+        br = gBcrrHead;
+        if((gBcrrHead = br->next) == NULL) gBcrrTail = NULL;
+        pthread_mutex_unlock(&gBcrrMtx);
+
+        br->result = bcr_SendRecv(br->bcrIP, br->barcodeID, br->prof, br->errmsg);
+        clock_gettime(CLOCK_MONOTONIC, &br->t1);
+
+        pthread_mutex_lock(&gBcrrMtx);
+        br->done = 1;
+        ++gBcrrIdle;
+        pthread_cond_broadcast(&gBcrrDone);
+    }
+    return NULL;
+}
+
+/*****************************************************************************/
+/* 1. Function Name: bcr_readJoin                                            */
+/* 2. Description  : barcode read Ϸ                                   */
+/* 3. Parameters   : BCR_READ *br    - bcr_readStart  read             */
+/* 4. Return Value : None                                                    */
+/*****************************************************************************/
+void bcr_readJoin(BCR_READ *br)
+{
+    struct timespec ts;
+
+    if(br->started == 1){
+        trace_now(&ts);
+        pthread_mutex_lock(&gBcrrMtx);
+        while(br->done == 0){
+            pthread_cond_wait(&gBcrrDone, &gBcrrMtx);
+        }
+        pthread_mutex_unlock(&gBcrrMtx);
+        trace_span("bcr.join", &ts);
+        br->started = 0;
+    }
+    trace_add("bcr", &br->t0, &br->t1);
+}
+
 /*****************************************************************************/
 /* 1. Function Name: hht_sendErrMsg                                          */
 /* 2. Description  : Error send HHTinf                                       */
@@ -3470,12 +6891,6 @@ int hht_SendRecv(char* stkName, char *receiver, char *msg, char *errmsg)
     char recvMsgName[7]={0,};
     char tm[100]={0,};
     
-    int logsock;
-    if ( (logsock = connSocket_unix(logFile, errmsg) ) == false ) {
-		logMessage(ERROR, errmsg);
-		logsock = -1;
-    }
-    
     hhtsock = hht_connect();
     if(hhtsock == -1){
         sprintf(errmsg, "ERROR: STK[%s] is HHTinf connect fail", stkName);
@@ -3493,16 +6908,11 @@ int hht_SendRecv(char* stkName, char *receiver, char *msg, char *errmsg)
     if(hhtresult < 0){
         sprintf(errmsg,"ERROR: HHTinf MSG[%-6s] send fail network error[%s]",sendMsgName, strerror(errno));
         close(hhtsock);
-        if(logsock > 0){
-            close(logsock);
-        }
         return false;
     } 
     
-    if(logsock > 0){
-        logresult = sendLogMessage(logsock, SERVER_NAME, "->HHTinf", sendMsgName, sendBuf, errmsg);
-    }
-    if(logresult < 0){
+    logresult = logq_ship("->HHTinf", sendMsgName, sendBuf, errmsg);
+    if(logresult == false){
         sprintf(errmsg,"ERROR: MSG[%-6s] [%s->HHTinf] log send fail MSGBODY:%s",sendMsgName,SERVER_NAME,sendBuf);
         logMessage(ERROR, errmsg);
     }  
@@ -3511,21 +6921,13 @@ int hht_SendRecv(char* stkName, char *receiver, char *msg, char *errmsg)
     if(hhtresult < 0){
         sprintf(errmsg,"ERROR: HHTinf MSG[%-6s] recv fail network error[%s]", recvMsgName, strerror(errno));
         close(hhtsock);
-        if(logsock > 0){
-            close(logsock);
-        }
         return false;
     }
-    if(logsock > 0){
-        logresult = sendLogMessage(logsock, SERVER_NAME, "<-HHTinf", recvMsgName, recvBuf, errmsg);
-    }
-    if(logresult < 0){
+    logresult = logq_ship("<-HHTinf", recvMsgName, recvBuf, errmsg);
+    if(logresult == false){
         sprintf(errmsg,"ERROR: MSG[%-6s] [%s<-HHTinf] log recv fail MSGBODY:%s",recvMsgName,SERVER_NAME,recvBuf);
         logMessage(ERROR, errmsg);
     }
-    if(logsock > 0){
-        close(logsock);
-    }
     close(hhtsock);
     return true;
 }
@@ -3542,16 +6944,10 @@ int hht_SendRecv(char* stkName, char *receiver, char *msg, char *errmsg)
 /*****************************************************************************/
 int stk_RecvLogSvr(void* s_buf ,char msgType, char* stkName, char* msg, int flag)
 {
-    int s_len = -1;
     char buff[BUFSIZ/2]={0,};
     unsigned short int msgLen;
     char name[30]={0,};
     char dest[10]={0,};
-    int logsock;
-    if ( (logsock = connSocket_unix(logFile, msg) ) == false ) {
-		logMessage(ERROR, msg);
-		return -1;
-    }
     switch(msgType){
         case msgTypeConnectRequest :
         {
@@ -3590,7 +6986,8 @@ int stk_RecvLogSvr(void* s_buf ,char msgType, char* stkName, char* msg, int flag
         case msgTypeReadMemory :
         {
             rReadRAMRequest *req = (rReadRAMRequest *)s_buf;
-            sprintf(buff,"STK_ID=%s|LOT_ID=%s|ADDR=0x%X",stkName,req->unitName,req->addr);
+            sprintf(buff,"STK_ID=%s|LOT_ID=%s|ADDR=0x%X",stkName,req->unitName,
+                    (flag == true) ? bigToLittl(req->addr) : req->addr);
             strcpy(name,"rReadMemory");
             break;
         }
@@ -3611,7 +7008,8 @@ int stk_RecvLogSvr(void* s_buf ,char msgType, char* stkName, char* msg, int flag
         case msgTypeDisplayMsg :
         {
             rPostLineRequest *req = (rPostLineRequest *)s_buf;
-            sprintf(buff,"STK_ID=%s|LOT_ID=%s|LINE=%d|MSG=%s",stkName,req->unitName,req->line, req->msg);
+            sprintf(buff,"STK_ID=%s|LOT_ID=%s|LINE=%d|MSG=%s",stkName,req->unitName,
+                    (flag == true) ? bigToLittl(req->line) : req->line, req->msg);
             strcpy(name,"rDisplayMsg");
             break;
         }
@@ -3626,7 +7024,6 @@ int stk_RecvLogSvr(void* s_buf ,char msgType, char* stkName, char* msg, int flag
         {
             sprintf(msg, "ERROR: STK[%s] unknown message type[%d]",stkName, msgType);
 		    logMessage(ERROR, msg);    
-		    close(logsock);
             return -1;
         }
     }
@@ -3635,12 +7032,10 @@ int stk_RecvLogSvr(void* s_buf ,char msgType, char* stkName, char* msg, int flag
     } else {
         sprintf(dest, "->RIDsvr");
     }
-    if(s_len = sendLogMessage(logsock, SERVER_NAME, dest, name, buff, msg) == -1){
+    if(logq_ship(dest, name, buff, msg) == false){
         logMessage(ERROR, msg);
-        close(logsock);
         return -1;
     }
-    close(logsock);
     return 0;
 }
 
@@ -3656,16 +7051,10 @@ int stk_RecvLogSvr(void* s_buf ,char msgType, char* stkName, char* msg, int flag
 /*****************************************************************************/
 int stk_SendLogSvr(void* s_buf ,char msgType, char* stkName, char* msg, int flag)
 {
-    int s_len = -1;
     char buff[BUFSIZ]={0,};
     unsigned short int msgLen;
     char name[30]={0,};
     char dest[10]={0,};
-    int logsock;
-    if ( (logsock = connSocket_unix(logFile, msg) ) == false ) {
-		logMessage(ERROR, msg);
-		return -1;
-    }
     switch(msgType){  
         case msgTypeConnectRequest :
         {
@@ -3744,7 +7133,6 @@ int stk_SendLogSvr(void* s_buf ,char msgType, char* stkName, char* msg, int flag
         {
             sprintf(msg, "ERROR: STK[%s] unknown message type[%d]", stkName, msgType);
 		    logMessage(ERROR, msg);
-		    close(logsock);
             return -1;
         }
     }
@@ -3753,12 +7141,10 @@ int stk_SendLogSvr(void* s_buf ,char msgType, char* stkName, char* msg, int flag
     } else {
         sprintf(dest, "<-RIDsvr");
     }
-    if(s_len = sendLogMessage(logsock, SERVER_NAME, dest, name, buff, msg) == -1){
+    if(logq_ship(dest, name, buff, msg) == false){
         logMessage(ERROR, msg);
-        close(logsock);
         return -1;
     }
-    close(logsock);
     return 0;
 }
 
@@ -3773,118 +7159,648 @@ int stk_SendLogSvr(void* s_buf ,char msgType, char* stkName, char* msg, int flag
 /*****************************************************************************/
 int stk_MakeSendMsg(void* r_buf, void* s_buf ,char msgType, char* errmsg)
 {
-    switch(msgType){  
+    REPLY_TPL *t = tpl_find(msgType, 0);
+
+    if(t == NULL){
+        sprintf(errmsg, "ERROR: unknown message type[%d]", msgType);
+        return false;
+    }
+    memcpy(s_buf, t->host, t->size);
+    tpl_stamp(t, s_buf, false);
+    if(msgType == msgTypeReadMemory){
+        rReadRAMRequest *req = (rReadRAMRequest *)r_buf;
+        rReadRAMReply *rep = (rReadRAMReply *)s_buf;
+        rep->addr = bigToLittl(req->addr);
+    }
+    return true;
+}
+
+/*****************************************************************************/
+/* 1. Function Name: tpl_init                                                */
+/* 2. Description  :  template table . gWireTab   type       */
+/*                    , ErrReply  ִ type  error   */
+/* 3. Parameters   : char *msg       - Error Message                         */
+/* 4. Return Value : true - , false -                                */
+/*****************************************************************************/
+int tpl_init(char *msg)
+{
+    char errType[] = { msgTypeQuerySensorLoc, msgTypeReadMemory, msgTypeAssociateUnit,
+                       msgTypeDisassociateUnit, msgTypeDisplayMsg };
+    int i;
+
+    for(i = 0; i < WIRE_MAXTYPE; i++){
+        if(gWireTab[i].name == NULL) continue;
+        if((gReplyTpl[i][0] = tpl_build((char)i, 0)) == NULL){
+            sprintf(msg, "ERROR: reply template build fail TYPE[%d]", i);
+            return false;
+        }
+    }
+    for(i = 0; i < (int)sizeof(errType); i++){
+        if((gReplyTpl[(int)errType[i]][1] = tpl_build(errType[i], TPL_ERR)) == NULL){
+            sprintf(msg, "ERROR: reply template build fail TYPE[%d] RESULT[%d]", errType[i], TPL_ERR);
+            return false;
+        }
+    }
+    return true;
+}
+
+/*****************************************************************************/
+/* 1. Function Name: tpl_build                                               */
+/* 2. Description  : msgType/result  ⺻   network order      */
+/*                   纻 ̸ ȯ д                                 */
+/* 3. Parameters   : char msgType    - message type                          */
+/*                   int result      -  result                           */
+/* 4. Return Value : REPLY_TPL * - template, NULL -                      */
+/*****************************************************************************/
+REPLY_TPL * tpl_build(char msgType, int result)
+{
+    WIRE_MSG *w = wire_find(msgType);
+    REPLY_TPL *t;
+    rGenReply *hdr;
+    short r16 = result;
+    int   r32 = result;
+
+    if(w == NULL || w->repSize > TPL_MAXBUF) return NULL;
+    if((t = (REPLY_TPL *)malloc(sizeof(REPLY_TPL))) == NULL) return NULL;
+    memset(t, 0x00, sizeof(REPLY_TPL));
+    t->type   = msgType;
+    t->result = result;
+    t->size   = w->repSize;
+
+    hdr = (rGenReply *)t->host;
+    hdr->msgLen  = w->repSize;
+    hdr->msgType = msgType;
+    if(w->result.width == sizeof(r16)){
+        memcpy((char *)t->host + w->result.off, &r16, sizeof(r16));
+    } else {
+        memcpy((char *)t->host + w->result.off, &r32, sizeof(r32));
+    }
+
+    switch(msgType){
         case msgTypeConnectRequest :
         {
-            rConnectReply *rep = (rConnectReply *)s_buf;
-            rep->msgLen	    = sizeof(rConnectReply);
-        	rep->msgType	= msgTypeConnectRequest;
-        	rep->result	    = 0;
+            rConnectReply *rep = (rConnectReply *)t->host;
         	rep->major	    = 2;
         	rep->minor	    = 5;
         	rep->byteOrder  = LITTLE_ENDIAN;
-        	rep->bitOrder	= 0;
-        	rep->point	    = 0;
-            break;
-        }
-        case msgTypeCloseRequest :
-        {
-            rSimpleReply *rep = (rSimpleReply *)s_buf;
-            rep->msgLen	    = sizeof(rSimpleReply);
-        	rep->msgType	= msgTypeCloseRequest;
-        	rep->result	    = 0;
-        	rep->numItems	= 0;
-            break;
-        }
-        case msgTypePTLSensor :
-        {
-            rGenReply *rep   = (rGenReply *)s_buf;
-            rep->msgLen = sizeof(rGenReply);
-            rep->msgType = msgTypePTLSensor;
-            rep->result = 0;
-            break;
-        }
-        case msgTypeLTPSensor :
-        {
-            rGenReply *rep = (rGenReply *)s_buf;
-            rep->msgLen = sizeof(rGenReply);
-            rep->msgType = msgTypeLTPSensor;
-            rep->result = 0;
             break;
         }
         case msgTypeQuerySensorLoc :
         {    
-            rQuerySensorReply *rep = (rQuerySensorReply *)s_buf;
-            time_t ctime    = time(&ctime);
-            rep->msgLen     = sizeof(rQuerySensorReply);
-            rep->msgType	= msgTypeQuerySensorLoc;
+            rQuerySensorReply *rep = (rQuerySensorReply *)t->host;
             rep->lastFlag   = 1;
-            rep->result	    = 0;
-            rep->totalNum	= 1;
-            rep->numItems	= 1; 
-            memcpy(rep->responseMsg.unitID,0x00,sizeof(rep->responseMsg.unitID));
-        	memcpy(rep->responseMsg.unitName,0x00,sizeof(rep->responseMsg.unitName));
-        	memcpy(rep->responseMsg.sensorID,0x00,sizeof(rep->responseMsg.sensorID));
-        	memcpy(rep->responseMsg.sensorName,0x00,sizeof(rep->responseMsg.sensorName));
+            if(result == 0){
+                rep->totalNum	= 1;
+                rep->numItems	= 1; 
+            }
         	rep->responseMsg.unittype		= 1;
-        	rep->responseMsg.updateTime	    = ctime;
-        	rep->responseMsg.moveTime		= ctime;
-        	rep->responseMsg.motionTime	    = ctime;
         	rep->responseMsg.unitCategory	= 1;
         	rep->responseMsg.sensorCategory = 1;
-        	rep->responseMsg.unitTransit	= 0;
             break;
         }
-        case msgTypeReadMemory :
+        case msgTypeDisplayMsg :
         {
-            rReadRAMRequest *req = (rReadRAMRequest *)r_buf;
-            rReadRAMReply *rep = (rReadRAMReply *)s_buf;
-            rep->msgLen     = sizeof(rReadRAMReply);
-        	rep->msgType    = msgTypeReadMemory;
-        	rep->result	    = 0;
-        	rep->addr       = bigToLittl(req->addr);
-            break;
-        }
-        case msgTypeAssociateUnit :
-        {            
-            rGenReply *rep = (rGenReply *)s_buf;
-            rep->msgLen = sizeof(rGenReply);
-            rep->msgType = msgTypeAssociateUnit;
-            rep->result = 0;
+            rSimpleReply *rep = (rSimpleReply *)t->host;
+            if(result != 0){
+                rep->numItems = 1;
+            }
             break;
         }
-        case msgTypeDisassociateUnit :
-        {
-            rGenReply *rep = (rGenReply *)s_buf;
-            rep->msgLen = sizeof(rGenReply);
-            rep->msgType = msgTypeDisassociateUnit;
-            rep->result = 0;
-            break;
+    }
+    memcpy(t->wire, t->host, t->size);
+    wire_swap(w->rep, t->wire, t->size);
+    return t;
+}
+
+/*****************************************************************************/
+/* 1. Function Name: tpl_find                                                */
+/* 2. Description  : msgType/result   template  ã´               */
+/* 3. Parameters   : char msgType    - message type                          */
+/*                   int result      -  result                           */
+/* 4. Return Value : REPLY_TPL * - template, NULL -                      */
+/*****************************************************************************/
+REPLY_TPL * tpl_find(char msgType, int result)
+{
+    unsigned char t = (unsigned char)msgType;
+    REPLY_TPL *tpl;
+
+    if(t >= WIRE_MAXTYPE) return NULL;
+    tpl = gReplyTpl[t][(result == 0) ? 0 : 1];
+    if(tpl == NULL || tpl->result != result) return NULL;
+    return tpl;
+}
+
+/*****************************************************************************/
+/* 1. Function Name: tpl_stamp                                               */
+/* 2. Description  : template 纻 ð field   ð ٲ۴      */
+/* 3. Parameters   : REPLY_TPL *t    - template                              */
+/*                   void *buf       - template  host/wire 纻            */
+/*                   int wire        - true : buf  network order           */
+/* 4. Return Value : void                                                    */
+/*****************************************************************************/
+void tpl_stamp(REPLY_TPL *t, void *buf, int wire)
+{
+    rQuerySensorReply *rep = (rQuerySensorReply *)buf;
+    osLong now;
+
+    if(t->type != msgTypeQuerySensorLoc) return;
+    now = (osLong)time(NULL);
+    if(wire == true){
+        /* gWireTab  WL field    bigToLittl ȯ */
+        now = (osLong)bigToLittl((unsigned int)now);
+    }
+	rep->responseMsg.updateTime	    = now;
+	rep->responseMsg.moveTime		= now;
+	rep->responseMsg.motionTime	    = now;
+}
+
+/*****************************************************************************/
+/* 1. Function Name: tpl_send                                                */
+/* 2. Description  : network order template  ״ write Ѵ             */
+/*                   ð field  ִ type  纻  ģ         */
+/* 3. Parameters   : int csock       - Client  ũ                */
+/*                   REPLY_TPL *t    - template                              */
+/* 4. Return Value : true - , false -                                */
+/*****************************************************************************/
+int tpl_send(int csock, REPLY_TPL *t)
+{
+    long buf[TPL_MAXBUF / sizeof(long)];
+    void *out = t->wire;
+
+    if(t->type == msgTypeQuerySensorLoc){
+        memcpy(buf, t->wire, t->size);
+        tpl_stamp(t, buf, true);
+        out = buf;
+    }
+    if(stk_writeAll(csock, out, t->size) == false){
+        return false;
+    }
+    tlReplyResult = t->result;
+    return true;
+}
+
+/*****************************************************************************/
+/* 1. Function Name: wire_result                                             */
+/* 2. Description  : host order  result field  д´                */
+/* 3. Parameters   : WIRE_MSG *w     -  type  descriptor               */
+/*                   void *rep       - host order                        */
+/* 4. Return Value : int - result                                            */
+/*****************************************************************************/
+int wire_result(WIRE_MSG *w, void *rep)
+{
+    short r16;
+    int   r32;
+
+    if(w->result.width == sizeof(r16)){
+        memcpy(&r16, (char *)rep + w->result.off, sizeof(r16));
+        return r16;
+    }
+    memcpy(&r32, (char *)rep + w->result.off, sizeof(r32));
+    return r32;
+}
+
+/*****************************************************************************/
+/* 1. Function Name: stat_init                                               */
+/* 2. Description  : gWireTab  type  histogram slot  ϰ        */
+/*                   thread  shard  ݳ key               */
+/* 3. Parameters   : char *msg       - Error Message                         */
+/* 4. Return Value : true - , false -                                */
+/*****************************************************************************/
+int stat_init(char *msg)
+{
+    int i;
+
+    memset(gStatSlot, -1, sizeof(gStatSlot));
+    for(i = 0; i < WIRE_MAXTYPE; i++){
+        if(gWireTab[i].name == NULL) continue;
+        if(gStatTypes >= STAT_MAXTYPE){
+            sprintf(msg, "ERROR: stat slot overflow TYPE[%d] (max %d)", i, STAT_MAXTYPE);
+            return false;
         }
-        case msgTypeDisplayMsg :
-        {
-            rSimpleReply *rep = (rSimpleReply *)s_buf;
-            rep->msgLen	    = sizeof(rSimpleReply);
-        	rep->msgType	= msgTypeDisplayMsg;
-        	rep->result	    = 0;
-        	rep->numItems	= 0;
-            break;
+        gStatName[gStatTypes] = gWireTab[i].name;
+        gStatSlot[i] = gStatTypes++;
+    }
+    if(pthread_key_create(&gStatKey, stat_release) != 0){
+        sprintf(msg, "ERROR: stat thread key create fail errno[%d]", errno);
+        return false;
+    }
+    return true;
+}
+
+/*****************************************************************************/
+/* 1. Function Name: stat_shard                                              */
+/* 2. Description  :  thread  shard. ó θ ݳ shard        */
+/*                   ,    Ͽ δ              */
+/* 3. Parameters   : None                                                    */
+/* 4. Return Value : STAT_SHARD * - shard, NULL - ޸                 */
+/*****************************************************************************/
+STAT_SHARD * stat_shard()
+{
+    STAT_SHARD *sh;
+
+    if(tlStat != NULL) return tlStat;
+    for(sh = __atomic_load_n(&gStatHead, __ATOMIC_ACQUIRE); sh != NULL; sh = sh->next){
+        if(__sync_bool_compare_and_swap(&sh->owner, 0, 1)) break;
+    }
+    if(sh == NULL){
+        if((sh = (STAT_SHARD *)calloc(1, sizeof(STAT_SHARD))) == NULL) return NULL;
+        sh->owner = 1;
+        do {
+            sh->next = gStatHead;
+        } while(!__sync_bool_compare_and_swap(&gStatHead, sh->next, sh));
+    }
+    tlStat = sh;
+    pthread_setspecific(gStatKey, sh);
+    return sh;
+}
+
+/*****************************************************************************/
+/* 1. Function Name: stat_release                                            */
+/* 2. Description  : thread  shard  ݳѴ ( )           */
+/* 3. Parameters   : void *arg       - STAT_SHARD                            */
+/* 4. Return Value : void                                                    */
+/*****************************************************************************/
+void stat_release(void *arg)
+{
+    STAT_SHARD *sh = (STAT_SHARD *)arg;
+
+    __atomic_store_n(&sh->owner, 0, __ATOMIC_RELEASE);
+}
+
+/*****************************************************************************/
+/* 1. Function Name: stat_bucket                                             */
+/* 2. Description  : usec  log-linear bucket index                       */
+/* 3. Parameters   : unsigned long us - óð(usec)                       */
+/* 4. Return Value : int - bucket index                                      */
+/*****************************************************************************/
+int stat_bucket(unsigned long us)
+{
+    int e, idx;
+
+    if(us < STAT_SUB) return (int)us;
+    e = 63 - __builtin_clzl(us);
+    idx = (e - STAT_SUBBITS + 1) * STAT_SUB + (int)((us >> (e - STAT_SUBBITS)) & (STAT_SUB - 1));
+    return (idx < STAT_NBUCKET) ? idx : STAT_NBUCKET - 1;
+}
+
+/*****************************************************************************/
+/* 1. Function Name: stat_upper                                              */
+/* 2. Description  : bucket  (usec, )                            */
+/* 3. Parameters   : int idx         - bucket index                          */
+/* 4. Return Value : unsigned long -                                     */
+/*****************************************************************************/
+unsigned long stat_upper(int idx)
+{
+    int g = idx / STAT_SUB;
+
+    if(g == 0) return (unsigned long)idx + 1;
+    return (unsigned long)(STAT_SUB + idx % STAT_SUB + 1) << (g - 1);
+}
+
+/*****************************************************************************/
+/* 1. Function Name: stat_record                                             */
+/* 2. Description  : ó ϳ ð  thread  shard           */
+/* 3. Parameters   : char msgType    - message type                          */
+/*                   int result      -  result (-1 :  )          */
+/*                   struct timespec *t0 - ó  ð (MONOTONIC)        */
+/* 4. Return Value : void                                                    */
+/*****************************************************************************/
+void stat_record(char msgType, int result, struct timespec *t0)
+{
+    struct timespec t1;
+    STAT_SHARD *sh;
+    STAT_HIST *h;
+    unsigned long us;
+    unsigned char t = (unsigned char)msgType;
+    int r;
+
+    if(t >= WIRE_MAXTYPE || gStatSlot[t] < 0) return;
+    if((sh = stat_shard()) == NULL) return;
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+    us = (unsigned long)(t1.tv_sec - t0->tv_sec) * 1000000
+       + (t1.tv_nsec - t0->tv_nsec) / 1000;
+
+    if(result == -1)          r = STAT_RES_NONE;
+    else if(result == 0)      r = STAT_RES_OK;
+    else if(result == TPL_ERR) r = STAT_RES_ERR;
+    else                      r = STAT_RES_OTHER;
+
+    h = &sh->h[(int)gStatSlot[t]][r];
+    STAT_INC(h->bucket[stat_bucket(us)], 1);
+    STAT_INC(h->sum, us);
+    STAT_INC(h->cnt, 1);
+}
+
+/*****************************************************************************/
+/* 1. Function Name: stat_merge                                              */
+/* 2. Description  :  shard  ģ. writer   Ƿ bucket    */
+/*                   հ cnt    ٸ  ִ                */
+/* 3. Parameters   : STAT_HIST *out  - [STAT_MAXTYPE][STAT_NRESULT]      */
+/* 4. Return Value : void                                                    */
+/*****************************************************************************/
+void stat_merge(STAT_HIST *out)
+{
+    STAT_SHARD *sh;
+    STAT_HIST *h, *o;
+    int i, k;
+
+    memset(out, 0x00, sizeof(STAT_HIST) * STAT_MAXTYPE * STAT_NRESULT);
+    for(sh = __atomic_load_n(&gStatHead, __ATOMIC_ACQUIRE); sh != NULL; sh = sh->next){
+        for(i = 0; i < STAT_MAXTYPE * STAT_NRESULT; i++){
+            h = &sh->h[0][0] + i;
+            o = out + i;
+            o->cnt += __atomic_load_n(&h->cnt, __ATOMIC_RELAXED);
+            o->sum += __atomic_load_n(&h->sum, __ATOMIC_RELAXED);
+            for(k = 0; k < STAT_NBUCKET; k++){
+                o->bucket[k] += __atomic_load_n(&h->bucket[k], __ATOMIC_RELAXED);
+            }
         }
-        case msgTypeLTPUnit :
-        {
-            rGenReply *rep = (rGenReply *)s_buf;
-            rep->msgLen = sizeof(rGenReply);
-            rep->msgType = msgTypeLTPUnit;
-            rep->result = 0;
-            break;
+    }
+}
+
+/*****************************************************************************/
+/* 1. Function Name: stat_format                                             */
+/* 2. Description  : ģ histogram  Prometheus text format      */
+/*                   le  STAT_EXPORT_FROM  bucket ()           */
+/* 3. Parameters   : STAT_HIST *m    - stat_merge                        */
+/*                   char *buf       -  buffer                           */
+/*                   int cap         - buf ũ                              */
+/* 4. Return Value : int -                                           */
+/*****************************************************************************/
+int stat_format(STAT_HIST *m, char *buf, int cap)
+{
+    static const char *resName[STAT_NRESULT] = { "0", "11", "other", "none" };
+    STAT_HIST *h;
+    unsigned long cum;
+    int i, r, k, len = 0;
+
+#define STAT_OUT(...) do { if(len < cap) len += snprintf(buf + len, cap - len, __VA_ARGS__); } while(0)
+    STAT_OUT("# HELP stkinf_request_duration_seconds STK request handling time by message and result\n");
+    STAT_OUT("# TYPE stkinf_request_duration_seconds histogram\n");
+    for(i = 0; i < gStatTypes; i++){
+        for(r = 0; r < STAT_NRESULT; r++){
+            h = &m[i * STAT_NRESULT + r];
+            if(h->cnt == 0) continue;
+            cum = 0;
+            for(k = 0; k < STAT_EXPORT_FROM; k++) cum += h->bucket[k];
+            for(k = STAT_EXPORT_FROM; k < STAT_NBUCKET - 1; k++){
+                cum += h->bucket[k];
+                STAT_OUT("stkinf_request_duration_seconds_bucket{msg=\"%s\",result=\"%s\",le=\"%.6f\"} %lu\n",
+                         gStatName[i], resName[r], stat_upper(k) / 1e6, cum);
+            }
+            STAT_OUT("stkinf_request_duration_seconds_bucket{msg=\"%s\",result=\"%s\",le=\"+Inf\"} %lu\n",
+                     gStatName[i], resName[r], h->cnt);
+            STAT_OUT("stkinf_request_duration_seconds_sum{msg=\"%s\",result=\"%s\"} %.6f\n",
+                     gStatName[i], resName[r], h->sum / 1e6);
+            STAT_OUT("stkinf_request_duration_seconds_count{msg=\"%s\",result=\"%s\"} %lu\n",
+                     gStatName[i], resName[r], h->cnt);
         }
-        default:
-        {
-            sprintf(errmsg, "ERROR: unknown message type[%d]", msgType);
-		    return false;
+    }
+#undef STAT_OUT
+    return (len < cap) ? len : cap - 1;
+}
+
+/*****************************************************************************/
+/* 1. Function Name: stat_healthStart                                        */
+/* 2. Description  : L4 health check port  listener    thread    */
+/*                   .  port  GET /metrics  Ѵ             */
+/* 3. Parameters   : pthread_attr_t *attr -  Ӽ                      */
+/*                   unsigned int sport   - health check port                */
+/*                   int l_queue          - listen queue ũ                */
+/*                   char *msg            - Error Message                    */
+/* 4. Return Value : 0 - , -1 -                                      */
+/*****************************************************************************/
+int stat_healthStart(pthread_attr_t *attr, unsigned int sport, int l_queue, char *msg)
+{
+    pthread_t tid;
+
+    if((gStatSock = initSocket_inet(sport, l_queue, msg)) == false){
+        return -1;
+    }
+    if(pthread_create(&tid, attr, stat_healthThread, NULL) != 0){
+        sprintf(msg, "ERROR: health/metrics thread create fail");
+        return -1;
+    }
+    pthread_detach(tid);
+    return 0;
+}
+
+/*****************************************************************************/
+/* 1. Function Name: stat_healthThread                                       */
+/* 2. Description  : health check  ϳ ޾ óѴ                */
+/* 3. Parameters   : void *arg       - ̻                                */
+/* 4. Return Value : None                                                    */
+/*****************************************************************************/
+void * stat_healthThread(void *arg)
+{
+    STAT_HIST *m;
+    char *out;
+    char msg[BUFSIZ]={0,};
+    int csock, cap;
+
+    /* series  export bucket + (+Inf, sum, count) , ׸ HELP/TYPE.
+     * gStatTypes  stat_init  ٲ ʴ´ */
+    cap = (gStatTypes * STAT_NRESULT * (STAT_NBUCKET - STAT_EXPORT_FROM + 2) + 2) * STAT_LINEMAX;
+    m   = (STAT_HIST *)malloc(sizeof(STAT_HIST) * STAT_MAXTYPE * STAT_NRESULT);
+    out = (char *)malloc(cap);
+    if(m == NULL || out == NULL){
+        sprintf(msg, "FATAL: health/metrics buffer alloc fail");
+        logMessage(ERROR, msg);
+        exit(1);
+    }
+    while(1){
+        if((csock = accept(gStatSock, NULL, NULL)) < 0){
+            if(errno != EINTR){
+                sprintf(msg, "ERROR: health check accept fail ERRMSG:%s", strerror(errno));
+                logMessage(ERROR, msg);
+                sleep(1);
+            }
+            continue;
         }
+        stat_serve(csock, m, out, cap);
+        close(csock);
     }
-    return true;
+    return NULL;
+}
+
+/*****************************************************************************/
+/* 1. Function Name: stat_serve                                              */
+/* 2. Description  : health check  ϳ ó. û   L4 check  */
+/*                   ״ ݰ, GET /metrics  histogram, ׿ GET  OK  */
+/* 3. Parameters   : int csock       - health check                      */
+/*                   STAT_HIST *m    - stat_merge ۾ buffer                */
+/*                   char *out       -  buffer                           */
+/*                   int cap         - out ũ                              */
+/* 4. Return Value : void                                                    */
+/*****************************************************************************/
+void stat_serve(int csock, STAT_HIST *m, char *out, int cap)
+{
+    char req[1024]={0,};
+    char hdr[256]={0,};
+    struct timeval tv;
+    fd_set rfds;
+    int n, len;
+
+    FD_ZERO(&rfds);
+    FD_SET(csock, &rfds);
+    tv.tv_sec  = 0;
+    tv.tv_usec = STAT_HTTP_WAIT * 1000;
+    if(select(csock + 1, &rfds, NULL, NULL, &tv) <= 0) return;
+    if((n = recv(csock, req, sizeof(req) - 1, 0)) <= 0) return;
+
+    if(strncmp(req, "GET /metrics", 12) == 0){
+        stat_merge(m);
+        if((len = stat_format(m, out, cap)) >= cap - 1){
+            sprintf(req, "ERROR: /metrics output truncated [%d] byte", len);
+            logMessage(ERROR, req);
+        }
+        n = sprintf(hdr, "HTTP/1.0 200 OK\r\nContent-Type: text/plain; version=0.0.4\r\n"
+                         "Content-Length: %d\r\n\r\n", len);
+    } else {
+        len = sprintf(out, "OK\n");
+        n = sprintf(hdr, "HTTP/1.0 200 OK\r\nContent-Length: %d\r\n\r\n", len);
+    }
+    if(stk_writeAll(csock, hdr, n) == true){
+        stk_writeAll(csock, out, len);
+    }
+}
+
+/*****************************************************************************/
+/* 1. Function Name: trace_begin                                             */
+/* 2. Description  :  thread  û trace                           */
+/* 3. Parameters   : struct timespec *t0 - û  ð (MONOTONIC)        */
+/* 4. Return Value : void                                                    */
+/*****************************************************************************/
+void trace_begin(struct timespec *t0)
+{
+    TRACE *tr = &tlTrace;
+
+    tr->on = (gTraceSlow > 0) ? 1 : 0;
+    tr->n = 0;
+    tr->drop = 0;
+    tr->t0 = *t0;
+    tr->port[0] = 0x00;
+    tr->lot[0] = 0x00;
+}
+
+/*****************************************************************************/
+/* 1. Function Name: trace_now                                               */
+/* 2. Description  : stage  ð.  ƴϸ clock   ʴ´   */
+/* 3. Parameters   : struct timespec *ts - stage  ð                   */
+/* 4. Return Value : void                                                    */
+/*****************************************************************************/
+void trace_now(struct timespec *ts)
+{
+    if(tlTrace.on == 0){
+        ts->tv_sec = 0;
+        ts->tv_nsec = 0;
+        return;
+    }
+    clock_gettime(CLOCK_MONOTONIC, ts);
+}
+
+/*****************************************************************************/
+/* 1. Function Name: trace_span                                              */
+/* 2. Description  : trace_now  ݱ stage                   */
+/* 3. Parameters   : const char *name - stage ̸ (ڿ )             */
+/*                   struct timespec *ts - trace_now ð                    */
+/* 4. Return Value : void                                                    */
+/*****************************************************************************/
+void trace_span(const char *name, struct timespec *ts)
+{
+    struct timespec now;
+
+    if(tlTrace.on == 0 || ts->tv_sec == 0) return;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    trace_add(name, ts, &now);
+}
+
+/*****************************************************************************/
+/* 1. Function Name: trace_add                                               */
+/* 2. Description  : / ð  stage                     */
+/*                   (ٸ thread   BCR read )                       */
+/* 3. Parameters   : const char *name - stage ̸ (ڿ )             */
+/*                   struct timespec *a -  ð                          */
+/*                   struct timespec *b -  ð                          */
+/* 4. Return Value : void                                                    */
+/*****************************************************************************/
+void trace_add(const char *name, struct timespec *a, struct timespec *b)
+{
+    TRACE *tr = &tlTrace;
+    TRACE_SPAN *sp;
+    long start, dur;
+
+    if(tr->on == 0 || a->tv_sec == 0 || b->tv_sec == 0) return;
+    if(tr->n >= TRACE_MAXSPAN){
+        tr->drop++;
+        return;
+    }
+    start = (a->tv_sec - tr->t0.tv_sec) * 1000000 + (a->tv_nsec - tr->t0.tv_nsec) / 1000;
+    dur   = (b->tv_sec - a->tv_sec) * 1000000 + (b->tv_nsec - a->tv_nsec) / 1000;
+    sp = &tr->span[tr->n++];
+    sp->name  = name;
+    sp->start = (start > 0) ? (unsigned int)start : 0;
+    sp->dur   = (dur > 0) ? (unsigned int)dur : 0;
+}
+
+/*****************************************************************************/
+/* 1. Function Name: trace_ctx                                               */
+/* 2. Description  : slow record   port/lot  (NULL  )        */
+/* 3. Parameters   : char *port      - STK port (IRT name)                   */
+/*                   char *lot       - LOT/Reticle ID                        */
+/* 4. Return Value : void                                                    */
+/*****************************************************************************/
+void trace_ctx(char *port, char *lot)
+{
+    TRACE *tr = &tlTrace;
+
+    if(tr->on == 0) return;
+    if(port != NULL){
+        strncpy(tr->port, port, sizeof(tr->port) - 1);
+        tr->port[sizeof(tr->port) - 1] = 0x00;
+    }
+    if(lot != NULL){
+        strncpy(tr->lot, lot, sizeof(tr->lot) - 1);
+        tr->lot[sizeof(tr->lot) - 1] = 0x00;
+    }
+}
+
+/*****************************************************************************/
+/* 1. Function Name: trace_end                                               */
+/* 2. Description  : û trace . STKinf.trace.slow(ms) ̻ ɸ û */
+/*                   stage  ð   record                    */
+/*                    : stage=us+ҿus                              */
+/* 3. Parameters   : char *stkName   - STK name                              */
+/*                   char msgType    - message type                          */
+/*                   int result      -  result (-1 :  )          */
+/* 4. Return Value : void                                                    */
+/*****************************************************************************/
+void trace_end(char *stkName, char msgType, int result)
+{
+    TRACE *tr = &tlTrace;
+    WIRE_MSG *w;
+    struct timespec now;
+    char rec[BUFSIZ];
+    long total;
+    int i, len;
+
+    if(tr->on == 0) return;
+    tr->on = 0;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    total = (now.tv_sec - tr->t0.tv_sec) * 1000000 + (now.tv_nsec - tr->t0.tv_nsec) / 1000;
+    if(total < (long)gTraceSlow * 1000) return;
+
+    w = wire_find(msgType);
+    len = snprintf(rec, sizeof(rec), "SLOW : STK_ID=%s|MSG=%s|RESULT=%d|TOTAL_US=%ld|PORT=%s|LOT=%s|STAGES=",
+                   stkName, (w != NULL) ? w->name : "?", result, total, tr->port, tr->lot);
+    for(i = 0; i < tr->n && len < (int)sizeof(rec); i++){
+        len += snprintf(rec + len, sizeof(rec) - len, "%s%s=%u+%u", (i > 0) ? "," : "",
+                        tr->span[i].name, tr->span[i].start, tr->span[i].dur);
+    }
+    if(tr->drop > 0 && len < (int)sizeof(rec)){
+        snprintf(rec + len, sizeof(rec) - len, "|DROPPED=%d", tr->drop);
+    }
+    logMessage(ERROR, rec);
 }
 
 /*****************************************************************************/
@@ -3898,60 +7814,38 @@ int stk_MakeSendMsg(void* r_buf, void* s_buf ,char msgType, char* errmsg)
 int GetLogicalIDByBcrID(char *bcrID, char *logicalID, char *errmsg)
 {
     int ret_i;
-    char tmp_str[MAX_ITEMS]={0,};
-    char resultSet[BUFSIZ]={0,};
-    int l_length = -1;
-    
-    pthread_mutex_lock(&msg_mtx);	
-    memset( &ga_sqlframe_stt, NULL, sizeof(SQLFRAME) );
-    memset( &ga_bindframe_stt, NULL, sizeof(BINDFRAME) );
+    DB_SESSION *dbs;
+    DB_ROW row;
+    DB_COL *col;
     
-    sprintf(ga_sqlframe_stt.sqlstat_str,
-        "SELECT RTRIM(CST_ID) CST_ID, RTRIM(LOGICAL_ID) LOGICAL_ID, LENGTH(RTRIM(LOGICAL_ID)) L_LENGTH FROM LTSCST WHERE CST_ID=:v1");
+    dbs = db_lease();	
         /*
         "SELECT CST_ID, LOGICAL_ID, LENGTH(LOGICAL_ID) L_LENGTH FROM LTSCST WHERE CST_ID=:v1");
         */
-    strcpy( ga_bindframe_stt.bind_str[0], bcrID );
-    ret_i = eDB_query( SQL_COMMAND, (char *)0, 1 );
-    memcpy(resultSet, ga_sqlframe_stt.result_str, strlen(ga_sqlframe_stt.result_str));
-	pthread_mutex_unlock(&msg_mtx);
+    strcpy( dbs->bindframe.bind_str[0], bcrID );
+    ret_i = db_exec( dbs, STMT_LOGICAL_ID, 1 );
    
     if( ret_i > 0 ){
-        if(getSubstr(resultSet, "^L_LENGTH=", "^", tmp_str) == SUCCESS ){
-            if(tmp_str[0] != '-') {
-                l_length = atoi(tmp_str);   
-            } else {
+        db_fetchRow(dbs, &row);
+        /* 0:CST_ID 1:LOGICAL_ID 2:L_LENGTH */
+        if( row.ncol > 2 && row.col[2].isNull ){
+            logicalID[0] = NULL;
+        } else if( row.ncol > 1 ){
+            col = &row.col[1];
+            if( col->isNull ){
                 logicalID[0] = NULL;
-                return true;
-            }
-        }
-        if( getSubstr(resultSet, "^LOGICAL_ID=", "^", tmp_str) == SUCCESS ){
-            if(tmp_str[0] != '-') {
-            	if (memcmp(bcrID,"R",1) == 0) {
-            	     sprintf (logicalID, "%-14s", tmp_str);
-            	} else {            	
-                    strcpy(logicalID, tmp_str);
-                }
-                /*
-                if((strlen(logicalID) + 1) == l_length){
-                    strcat(logicalID, " ");
-                } else if(strlen(logicalID) == l_length){
-                } else {
-                    logicalID[0] = NULL;
-                    sprintf(errmsg, "ERROR: GetLogicalIDByBcrID Fail CSTID[%s]::LEN[%d] DBLEN[%d]",
-                                                bcrID,strlen(logicalID),l_length);
-                    return false;
-                }
-                */
+            } else if (memcmp(bcrID,"R",1) == 0) {
+                sprintf (logicalID, "%-14.*s", col->len, col->val);
             } else {
-                logicalID[0] = NULL;
-                return true;
+                sprintf (logicalID, "%.*s", col->len, col->val);
             }
         }
     } else {
-        sprintf(errmsg, "ERROR: GetLogicalIDByBcrID Fail CSTID[%s]::%s", bcrID, resultSet);
+        sprintf(errmsg, "ERROR: GetLogicalIDByBcrID Fail CSTID[%s]::%s", bcrID, dbs->sqlframe.result_str);
+        db_release(dbs);
         return false;
     }
+    db_release(dbs);
      return true;
 }
 
@@ -3966,30 +7860,22 @@ int GetLogicalIDByBcrID(char *bcrID, char *logicalID, char *errmsg)
 int GetLogicalIDByBcrIDEmpty(char *bcrID, char *logicalID, char *errmsg)
 {
     int ret_i;
-    char tmp_str[MAX_ITEMS]={0,};
-    char resultSet[BUFSIZ]={0,};
-    int l_length = -1;
+    DB_SESSION *dbs;
+    DB_ROW row;
     
-    pthread_mutex_lock(&msg_mtx);	
-    memset( &ga_sqlframe_stt, NULL, sizeof(SQLFRAME) );
-    memset( &ga_bindframe_stt, NULL, sizeof(BINDFRAME) );
-    
-    sprintf(ga_sqlframe_stt.sqlstat_str,
-        "SELECT DECODE (LOGICAL_ID, ' ', 'ZZEMPTY-' || CST_ID, LOGICAL_ID) LOGICAL_ID FROM LTSCST WHERE CST_ID = :v1");
-
-    strcpy( ga_bindframe_stt.bind_str[0], bcrID );
-    ret_i = eDB_query( SQL_COMMAND, (char *)0, 1 );
-    memcpy(resultSet, ga_sqlframe_stt.result_str, strlen(ga_sqlframe_stt.result_str));
-	pthread_mutex_unlock(&msg_mtx);
+    dbs = db_lease();	
+    strcpy( dbs->bindframe.bind_str[0], bcrID );
+    ret_i = db_exec( dbs, STMT_LOGICAL_EMPTY, 1 );
    
     if( ret_i > 0 ){
-        if( getSubstr(resultSet, "^LOGICAL_ID=", "^", tmp_str) == SUCCESS ){
-            if(tmp_str[0] != '-') strcpy(logicalID, tmp_str );
-        }
+        db_fetchRow(dbs, &row);
+        db_colStr(&row, 0, logicalID);
     } else {
-        sprintf(errmsg, "ERROR: GetLogicalIDByBcrID Emtpy Fail CSTID[%s]::%s", bcrID, resultSet);
+        sprintf(errmsg, "ERROR: GetLogicalIDByBcrID Emtpy Fail CSTID[%s]::%s", bcrID, dbs->sqlframe.result_str);
+        db_release(dbs);
         return false;
     }
+    db_release(dbs);
     return true;
 }
 
@@ -4004,31 +7890,23 @@ int GetLogicalIDByBcrIDEmpty(char *bcrID, char *logicalID, char *errmsg)
 int getPodIDToCstID(char *PodID, char *CstID, char *errmsg)
 {
     int ret_i;
-    char tmp_str[MAX_ITEMS]={0,};
-    
-    char resultSet[BUFSIZ]={0,};
-    pthread_mutex_lock(&msg_mtx);
-    
-    memset( &ga_sqlframe_stt, NULL, sizeof(SQLFRAME) );
-    memset( &ga_bindframe_stt, NULL, sizeof(BINDFRAME) );
+    DB_SESSION *dbs;
+    DB_ROW row;
     
-    sprintf(ga_sqlframe_stt.sqlstat_str, 
-            "SELECT RTRIM(LOGICAL_ID) CST_ID FROM LTSCST WHERE CST_ID =:v1");
-    strcpy( ga_bindframe_stt.bind_str[0], PodID );
+    dbs = db_lease();
+    strcpy( dbs->bindframe.bind_str[0], PodID );
     
-    ret_i = eDB_query( SQL_COMMAND, (char *)0, 1 );
-    
-    memcpy(resultSet, ga_sqlframe_stt.result_str, strlen(ga_sqlframe_stt.result_str));
-	pthread_mutex_unlock(&msg_mtx);
+    ret_i = db_exec( dbs, STMT_POD_CST_ID, 1 );
     
     if( ret_i > 0 ){
-        if( getSubstr(resultSet, "^CST_ID=", "^", tmp_str) == SUCCESS ){
-            if(tmp_str[0] != '-') strcpy(CstID, tmp_str );
-        }
+        db_fetchRow(dbs, &row);
+        db_colStr(&row, 0, CstID);
     } else {
-        sprintf(errmsg, "ERROR: getPodIDToCstID Fail PodID[%s]::%s",PodID, resultSet);
+        sprintf(errmsg, "ERROR: getPodIDToCstID Fail PodID[%s]::%s",PodID, dbs->sqlframe.result_str);
+        db_release(dbs);
         return -1;
     }
+    db_release(dbs);
     return true;
 }
 
@@ -4044,31 +7922,29 @@ int getPodIDToCstID(char *PodID, char *CstID, char *errmsg)
 int GetIrtNameByIrt(char *irtID, char *irtName, char *errmsg)
 {
     int ret_i;
-    char tmp_str[MAX_ITEMS]={0,};
-    
-    char resultSet[BUFSIZ]={0,};
-    pthread_mutex_lock(&msg_mtx);
+    DB_SESSION *dbs;
+    DB_ROW row;
+    TOPO_PORT tp;
     
-    memset( &ga_sqlframe_stt, NULL, sizeof(SQLFRAME) );
-    memset( &ga_bindframe_stt, NULL, sizeof(BINDFRAME) );
-    
-    sprintf(ga_sqlframe_stt.sqlstat_str, 
-            "SELECT PORT_ID FROM ltsstkportinfo WHERE IRT_ID=:v1");
-    strcpy( ga_bindframe_stt.bind_str[0], irtID );
+    if(topo_find(TOPO_KEY_ID, irtID, &tp) == true){
+        strcpy(irtName, tp.irtName);
+        return true;
+    }
     
-    ret_i = eDB_query( SQL_COMMAND, (char *)0, 1 );
+    dbs = db_lease();
+    strcpy( dbs->bindframe.bind_str[0], irtID );
     
-    memcpy(resultSet, ga_sqlframe_stt.result_str, strlen(ga_sqlframe_stt.result_str));
-	pthread_mutex_unlock(&msg_mtx);
+    ret_i = db_exec( dbs, STMT_IRT_NAME, 1 );
     
     if( ret_i > 0 ){
-        if( getSubstr(resultSet, "^PORT_ID=", "^", tmp_str) == SUCCESS ){
-            if(tmp_str[0] != '-') strcpy( irtName, tmp_str );
-        }
+        db_fetchRow(dbs, &row);
+        db_colStr(&row, 0, irtName);
     } else {
-        sprintf(errmsg, "ERROR: GetIrtNameByIrt Fail IRTID[%s]::%s",irtID, resultSet);
+        sprintf(errmsg, "ERROR: GetIrtNameByIrt Fail IRTID[%s]::%s",irtID, dbs->sqlframe.result_str);
+        db_release(dbs);
         return -1;
     }
+    db_release(dbs);
     return true;
 }
 
@@ -4085,52 +7961,63 @@ int GetIrtNameByIrt(char *irtID, char *irtName, char *errmsg)
 int GetBcrIPByIrt(char *irtName, char *irtID, char* portType, char *bcrIP, char *errmsg)
 {
     int ret_i;
-    char tmp_str[MAX_ITEMS]={0,};
-    char resultSet[BUFSIZ]={0,};
+    DB_SESSION *dbs;
+    DB_ROW row;
+    DB_COL *col;
+    TOPO_PORT tp;
+    
+    /* BCR   port   DB ȸ (error) ״  */
+    if(topo_find(TOPO_KEY_NAME, irtName, &tp) == true && tp.bcrIP[0] != 0x00){
+        strcpy(bcrIP, tp.bcrIP);
+        strcpy(irtID, tp.irtID);
+        if(tp.portType[0] == 0x00 || tp.portType[0] == '-'){
+            sprintf(errmsg, "ERROR: PORTID[%s] is not seting port type", irtName);
+            return false;
+        } else if(memcmp(tp.portType, "PT01", 4) == 0){
+            portType[0] = 'I';
+        } else if(memcmp(tp.portType, "PT02", 4) == 0){
+            portType[0] = 'O';
+        } else if(memcmp(tp.portType, "PT03", 4) == 0){
+            portType[0] = 'C';
+        } else {
+            sprintf(errmsg, "ERROR: PORTID[%s] unknown port type[%s]", irtName, tp.portType);
+            return false;
+        }
+        return true;
+    }
     
-    pthread_mutex_lock(&msg_mtx);
-    memset( &ga_sqlframe_stt, NULL, sizeof(SQLFRAME) );
-    memset( &ga_bindframe_stt, NULL, sizeof(BINDFRAME) );
-    
-    sprintf(ga_sqlframe_stt.sqlstat_str,
-        "SELECT A.IRT_ID, B.IP_ADDR, PORT_TYPE FROM LTSSTKPORTINFO A, LTSTERMINAL B \
-         WHERE  A.PORT_ID = :v1 \
-         AND	A.SCANNER_ID = B.SCANNER_ID");
-         
-    strcpy( ga_bindframe_stt.bind_str[0], irtName );         
+    dbs = db_lease();
+    strcpy( dbs->bindframe.bind_str[0], irtName );         
 	
-    ret_i = eDB_query( SQL_COMMAND, (char *)0, 1 );
-    
-    memcpy(resultSet, ga_sqlframe_stt.result_str, strlen(ga_sqlframe_stt.result_str));
-	pthread_mutex_unlock(&msg_mtx);
+    ret_i = db_exec( dbs, STMT_BCR_IP, 1 );
 	
     if( ret_i > 0 ){
-        if( getSubstr(resultSet, "^IP_ADDR=", "^", tmp_str) == SUCCESS ){
-            if(tmp_str[0] != '-') strcpy( bcrIP, tmp_str );
-        }
-        if( getSubstr(resultSet, "^IRT_ID=", "^", tmp_str) == SUCCESS ){
-            if(tmp_str[0] != '-') strcpy( irtID, tmp_str );
-        }
-        if( getSubstr(resultSet, "^PORT_TYPE=", "^", tmp_str) == SUCCESS ){
-            if(tmp_str[0] != '-') {
-                if(memcmp(tmp_str, "PT01", 4) == 0){
-                    portType[0] = 'I';
-                } else if(memcmp(tmp_str, "PT02", 4) == 0){
-                    portType[0] = 'O';
-                } else if(memcmp(tmp_str, "PT03", 4) == 0){
-                    portType[0] = 'C';
-                } else {
-                    sprintf(errmsg, "ERROR: PORTID[%s] unknown port type[%s]", irtName, tmp_str);
-                    return false;
-                }
-            } else {
+        db_fetchRow(dbs, &row);
+        /* 0:IRT_ID 1:IP_ADDR 2:PORT_TYPE */
+        db_colStr(&row, 1, bcrIP);
+        db_colStr(&row, 0, irtID);
+        ret_i = true;
+        if( row.ncol > 2 ){
+            col = &row.col[2];
+            if( col->isNull ){
                 sprintf(errmsg, "ERROR: PORTID[%s] is not seting port type", irtName);
-                return false;
+                ret_i = false;
+            } else if( DB_COLCMP(col, "PT01", 4) ){
+                portType[0] = 'I';
+            } else if( DB_COLCMP(col, "PT02", 4) ){
+                portType[0] = 'O';
+            } else if( DB_COLCMP(col, "PT03", 4) ){
+                portType[0] = 'C';
+            } else {
+                sprintf(errmsg, "ERROR: PORTID[%s] unknown port type[%.*s]", irtName, col->len, col->val);
+                ret_i = false;
             }
         }
-        return true;
+        db_release(dbs);
+        return ret_i;
     } else {
-        sprintf(errmsg, "ERROR: GetBcrIPByIrt Fail PORTID[%s]::%s",irtName, resultSet);
+        sprintf(errmsg, "ERROR: GetBcrIPByIrt Fail PORTID[%s]::%s",irtName, dbs->sqlframe.result_str);
+        db_release(dbs);
         return -1;
     }
     return true;
@@ -4150,49 +8037,52 @@ int GetBcrIPByIrt(char *irtName, char *irtID, char* portType, char *bcrIP, char
 int GetBcrInfoByBcrIP(char *bcrIP, char *stkName, char *bcrName, char *portName, char *portType, char *errmsg)
 {
     int ret_i;
-    char tmp_str[MAX_ITEMS]={0,};
-    
-    char resultSet[BUFSIZ]={0,};
-    pthread_mutex_lock(&msg_mtx);
-    
-    memset( &ga_sqlframe_stt, NULL, sizeof(SQLFRAME) );
-    memset( &ga_bindframe_stt, NULL, sizeof(BINDFRAME) );
-    
-    sprintf(ga_sqlframe_stt.sqlstat_str, 
-            "SELECT PORT_ID, PORT_TYPE,SCANNER_ID,STK_ID FROM LTSSTKPORTINFO \
-             WHERE SCANNER_ID=(SELECT SCANNER_ID FROM LTSTERMINAL WHERE IP_ADDR=:v1)");
-    strcpy( ga_bindframe_stt.bind_str[0], bcrIP );
+    DB_SESSION *dbs;
+    DB_ROW row;
+    DB_COL *col;
+    TOPO_PORT tp;
+    
+    if(topo_find(TOPO_KEY_IP, bcrIP, &tp) == true){
+        strcpy(portName, tp.irtName);
+        strcpy(stkName, tp.stkName);
+        strcpy(bcrName, tp.bcrName);
+        if(strcmp(tp.portType, "PT01") == 0){
+            portType[0] = 'I';
+        } else if(strcmp(tp.portType, "PT02") == 0){
+            portType[0] = 'O';
+        } else if(strcmp(tp.portType, "PT03") == 0){
+            portType[0] = 'C';
+        }
+        return true;
+    }
     
-    ret_i = eDB_query( SQL_COMMAND, (char *)0, 1 );
+    dbs = db_lease();
+    strcpy( dbs->bindframe.bind_str[0], bcrIP );
     
-    memcpy(resultSet, ga_sqlframe_stt.result_str, strlen(ga_sqlframe_stt.result_str));
-	pthread_mutex_unlock(&msg_mtx);
+    ret_i = db_exec( dbs, STMT_BCR_INFO, 1 );
     
     if( ret_i > 0 ){
-        if( getSubstr(resultSet, "^PORT_ID=", "^", tmp_str) == SUCCESS ){
-            if(tmp_str[0] != '-') strcpy( portName, tmp_str );
-        }
-        if( getSubstr(resultSet, "^STK_ID=", "^", tmp_str) == SUCCESS ){
-            if(tmp_str[0] != '-') strcpy( stkName, tmp_str );
-        }
-        if( getSubstr(resultSet, "^PORT_TYPE=", "^", tmp_str) == SUCCESS ){
-            if(tmp_str[0] != '-') {
-                if(strcmp(tmp_str,"PT01") == 0){
-                    portType[0] = 'I';
-                } else if(strcmp(tmp_str, "PT02") == 0){
-                    portType[0] = 'O';
-                } else if(strcmp(tmp_str, "PT03") == 0){
-                    portType[0] = 'C';
-                }
+        db_fetchRow(dbs, &row);
+        /* 0:PORT_ID 1:PORT_TYPE 2:SCANNER_ID 3:STK_ID */
+        db_colStr(&row, 0, portName);
+        db_colStr(&row, 3, stkName);
+        if( !DB_ISNULL(&row, 1) ){
+            col = &row.col[1];
+            if( col->len == 4 && DB_COLCMP(col, "PT01", 4) ){
+                portType[0] = 'I';
+            } else if( col->len == 4 && DB_COLCMP(col, "PT02", 4) ){
+                portType[0] = 'O';
+            } else if( col->len == 4 && DB_COLCMP(col, "PT03", 4) ){
+                portType[0] = 'C';
             }
         }
-        if( getSubstr(resultSet, "^SCANNER_ID=", "^", tmp_str) == SUCCESS ){
-            if(tmp_str[0] != '-') strcpy( bcrName, tmp_str );
-        }
+        db_colStr(&row, 2, bcrName);
     } else {
-        sprintf(errmsg, "ERROR: GetBcrInfoByBcrIP Fail BCRIP[%s]::%s",bcrIP, resultSet);
+        sprintf(errmsg, "ERROR: GetBcrInfoByBcrIP Fail BCRIP[%s]::%s",bcrIP, dbs->sqlframe.result_str);
+        db_release(dbs);
         return -1;
     }
+    db_release(dbs);
     return true;
 }
 
@@ -4208,46 +8098,32 @@ int GetBcrInfoByBcrIP(char *bcrIP, char *stkName, char *bcrName, char *portName,
 int GetLocationByBcrID(char *bcrID, char* location, char* portID, char *errmsg)
 {
     int ret_i;
-    char tmp_str[MAX_ITEMS]={0,};
-    char resultSet[BUFSIZ]={0,};
+    DB_SESSION *dbs;
+    DB_ROW row;
     
-    pthread_mutex_lock(&msg_mtx);	
-    memset( &ga_sqlframe_stt, NULL, sizeof(SQLFRAME) );
-    memset( &ga_bindframe_stt, NULL, sizeof(BINDFRAME) );
-    
-    sprintf(ga_sqlframe_stt.sqlstat_str,
-        "SELECT RTRIM(CST_ID) CST_ID, RTRIM(LOCATION) LOCATION, RTRIM(PORT_ID) PORT_ID FROM LTSCST WHERE CST_ID=:v1");
+    dbs = db_lease();	
         /*
         "SELECT CST_ID, LOCATION, PORT_ID FROM LTSCST WHERE CST_ID=:v1");
         */
-    strcpy( ga_bindframe_stt.bind_str[0], bcrID );
-    ret_i = eDB_query( SQL_COMMAND, (char *)0, 1 );
-    memcpy(resultSet, ga_sqlframe_stt.result_str, strlen(ga_sqlframe_stt.result_str));
-	pthread_mutex_unlock(&msg_mtx);
+    strcpy( dbs->bindframe.bind_str[0], bcrID );
+    ret_i = db_exec( dbs, STMT_LOCATION, 1 );
    
     if( ret_i > 0 ){
-        if( getSubstr(resultSet, "^LOCATION=", "^", tmp_str) == SUCCESS ){
-            if(tmp_str[0] != '-') {
-                strcpy(location, tmp_str);   
-            } else {
-                sprintf(errmsg, "ERROR: CSTID[%s] location is null",bcrID);
-                location[0] = NULL;
-                return true;
-            }
-        }
-        if( getSubstr(resultSet, "^PORT_ID=", "^", tmp_str) == SUCCESS ){
-            if(tmp_str[0] != '-') {
-                strcpy(portID, tmp_str);   
-            } else {
-                sprintf(errmsg, "ERROR: CSTID[%s] location port is null",bcrID);
-                portID[0] = NULL;
-                return true;
-            }
+        db_fetchRow(dbs, &row);
+        /* 0:CST_ID 1:LOCATION 2:PORT_ID */
+        if( db_colStr(&row, 1, location) == DB_COL_NULL ){
+            sprintf(errmsg, "ERROR: CSTID[%s] location is null",bcrID);
+            location[0] = NULL;
+        } else if( db_colStr(&row, 2, portID) == DB_COL_NULL ){
+            sprintf(errmsg, "ERROR: CSTID[%s] location port is null",bcrID);
+            portID[0] = NULL;
         }
     } else {
-        sprintf(errmsg, "ERROR: GetLocationByBcrID Fail CSTID[%s]::%s", bcrID, resultSet);
+        sprintf(errmsg, "ERROR: GetLocationByBcrID Fail CSTID[%s]::%s", bcrID, dbs->sqlframe.result_str);
+        db_release(dbs);
         return false;
     }
+    db_release(dbs);
      return true;
 }
 
@@ -4263,40 +8139,29 @@ int GetLocationByBcrID(char *bcrID, char* location, char* portID, char *errmsg)
 int GetCurrentHistoryByBcrID(char *bcrID, char* location, char* logicalID, char *errmsg)
 {
     int ret_i;
-    char tmp_str[MAX_ITEMS]={0,};
-    char resultSet[BUFSIZ]={0,};
-    
-    pthread_mutex_lock(&msg_mtx);	
-    memset( &ga_sqlframe_stt, NULL, sizeof(SQLFRAME) );
-    memset( &ga_bindframe_stt, NULL, sizeof(BINDFRAME) );
-    
-    sprintf(ga_sqlframe_stt.sqlstat_str,
-        "SELECT RTRIM(LOGICAL_ID) LOGICAL_ID, RTRIM(LOCATION) LOCATION FROM LTSINOUT_HIST \
-            WHERE CST_ID=:v1 \
-            AND LOCATION=:v2 \
-            AND BOUND='IN'   \
-            AND CREATE_DATE = (SELECT MAX(CREATE_DATE) FROM LTSINOUT_HIST WHERE CST_ID=:v3)");
-
-    strcpy( ga_bindframe_stt.bind_str[0], bcrID );
-    strcpy( ga_bindframe_stt.bind_str[1], location );
-    strcpy( ga_bindframe_stt.bind_str[2], bcrID );
-    ret_i = eDB_query( SQL_COMMAND, (char *)0, 1 );
-    memcpy(resultSet, ga_sqlframe_stt.result_str, strlen(ga_sqlframe_stt.result_str));
-	pthread_mutex_unlock(&msg_mtx);
+    DB_SESSION *dbs;
+    DB_ROW row;
+    
+    dbs = db_lease();	
+    strcpy( dbs->bindframe.bind_str[0], bcrID );
+    strcpy( dbs->bindframe.bind_str[1], location );
+    strcpy( dbs->bindframe.bind_str[2], bcrID );
+    ret_i = db_exec( dbs, STMT_CUR_HIST, 1 );
    
     if( ret_i > 0 ){
-        if( getSubstr(resultSet, "^LOGICAL_ID=", "^", tmp_str) == SUCCESS ){
-            if(tmp_str[0] != '-') {
-                strcpy(logicalID, tmp_str);   
-            } else {
-                sprintf(errmsg, "ERROR: CSTID[%s] is not input state STK[%s]",bcrID, location);
-                return false;
-            }
+        db_fetchRow(dbs, &row);
+        /* 0:LOGICAL_ID 1:LOCATION */
+        if( db_colStr(&row, 0, logicalID) == DB_COL_NULL ){
+            sprintf(errmsg, "ERROR: CSTID[%s] is not input state STK[%s]",bcrID, location);
+            db_release(dbs);
+            return false;
         }
     } else {
-        sprintf(errmsg, "ERROR: GetCurrentHistoryByBcrID Fail CSTID[%s],STK[%s]::%s", bcrID, location, resultSet);
+        sprintf(errmsg, "ERROR: GetCurrentHistoryByBcrID Fail CSTID[%s],STK[%s]::%s", bcrID, location, dbs->sqlframe.result_str);
+        db_release(dbs);
         return false;
     }
+    db_release(dbs);
      return true;
 }
 
@@ -4311,49 +8176,40 @@ int GetCurrentHistoryByBcrID(char *bcrID, char* location, char* logicalID, char
 int GetStkTypeByIP(char *stkIP, char *stkName, char *errmsg)
 {
     int ret_i;
-    char tmp_str[MAX_ITEMS]={0,};
-    char resultSet[BUFSIZ]={0,};
+    DB_SESSION *dbs;
+    DB_ROW row;
+    DB_COL *col;
     
-    pthread_mutex_lock(&msg_mtx);
-    
-    memset( &ga_sqlframe_stt, NULL, sizeof(SQLFRAME) );
-    memset( &ga_bindframe_stt, NULL, sizeof(BINDFRAME) );
-    
-    sprintf(ga_sqlframe_stt.sqlstat_str,
-        "SELECT STK_TYPE, STK_ID FROM LTSSTK WHERE IP_ADDR=:v1");
-    strcpy( ga_bindframe_stt.bind_str[0], stkIP );         
+    dbs = db_lease();
+    strcpy( dbs->bindframe.bind_str[0], stkIP );         
 	
-    ret_i = eDB_query( SQL_COMMAND, (char *)0, 1 );
-    
-    memcpy(resultSet, ga_sqlframe_stt.result_str, strlen(ga_sqlframe_stt.result_str));
-	pthread_mutex_unlock(&msg_mtx);
+    ret_i = db_exec( dbs, STMT_STK_BY_IP, 1 );
 	
-    if( ret_i > 0 ){
-        if( getSubstr(resultSet, "^STK_ID=", "^", tmp_str) == SUCCESS ){
-            if(tmp_str[0] != '-') strcpy( stkName, tmp_str );
-        }
-        if( getSubstr(resultSet, "^STK_TYPE=", "^", tmp_str) == SUCCESS ){
-            if(tmp_str[0] != '-') {
-                if(memcmp(tmp_str, "ST01", 4) == 0){
-                    return LOTPODTYPE;
-                } else if(memcmp(tmp_str, "ST02", 4) == 0){
-                    return RETICLEPODTYPE;
-                } else if(memcmp(tmp_str, "ST03", 4) == 0){
-                    return RETICLEBARETYPE;
-                } else {
-                    sprintf(errmsg, "ERROR: STKIP[%s] is not stocker or stocker type",stkIP);
-                    return false;
-                }
+    if( ret_i > 0 ){
+        db_fetchRow(dbs, &row);
+        /* 0:STK_TYPE 1:STK_ID */
+        db_colStr(&row, 1, stkName);
+        if( row.ncol > 0 ){
+            col = &row.col[0];
+            if( !col->isNull && DB_COLCMP(col, "ST01", 4) ){
+                ret_i = LOTPODTYPE;
+            } else if( !col->isNull && DB_COLCMP(col, "ST02", 4) ){
+                ret_i = RETICLEPODTYPE;
+            } else if( !col->isNull && DB_COLCMP(col, "ST03", 4) ){
+                ret_i = RETICLEBARETYPE;
             } else {
                 sprintf(errmsg, "ERROR: STKIP[%s] is not stocker or stocker type",stkIP);
-                return false;
+                ret_i = false;
             }
         } else {
-            sprintf(errmsg,"ERROR: QUERY[%s] parsing resultset error",resultSet);
-            return false;
+            sprintf(errmsg,"ERROR: QUERY[%s] parsing resultset error",dbs->sqlframe.result_str);
+            ret_i = false;
         }
+        db_release(dbs);
+        return ret_i;
     } else {
-        sprintf(errmsg, "ERROR: GetStkTypeByIP Fail STKIP[%s]::%s", stkIP, resultSet);
+        sprintf(errmsg, "ERROR: GetStkTypeByIP Fail STKIP[%s]::%s", stkIP, dbs->sqlframe.result_str);
+        db_release(dbs);
         return false;
     }
     return true;
@@ -4369,47 +8225,40 @@ int GetStkTypeByIP(char *stkIP, char *stkName, char *errmsg)
 int GetStkTypeByStkName(char *stkName, char *errmsg)
 {
     int ret_i;
-    char tmp_str[MAX_ITEMS]={0,};
-    char resultSet[BUFSIZ]={0,};
+    DB_SESSION *dbs;
+    DB_ROW row;
+    DB_COL *col;
 
-    pthread_mutex_lock(&msg_mtx);
-    
-    memset( &ga_sqlframe_stt, NULL, sizeof(SQLFRAME) );
-    memset( &ga_bindframe_stt, NULL, sizeof(BINDFRAME) );
-    
-    sprintf(ga_sqlframe_stt.sqlstat_str,
-        "SELECT STK_TYPE, STK_ID FROM LTSSTK WHERE STK_ID=:v1");
-    strcpy( ga_bindframe_stt.bind_str[0], stkName);         
+    dbs = db_lease();
+    strcpy( dbs->bindframe.bind_str[0], stkName);         
 	
-    ret_i = eDB_query( SQL_COMMAND, (char *)0, 1 );
-    
-    memcpy(resultSet, ga_sqlframe_stt.result_str, strlen(ga_sqlframe_stt.result_str));
-	pthread_mutex_unlock(&msg_mtx);
+    ret_i = db_exec( dbs, STMT_STK_BY_NAME, 1 );
 
     if( ret_i > 0 ){
-        if( getSubstr(resultSet, "^STK_TYPE=", "^", tmp_str) == SUCCESS ){
-            if(tmp_str[0] != '-') {
-                if(memcmp(tmp_str, "ST01", 4) == 0){
-                    return LOTPODTYPE;
-                } else if(memcmp(tmp_str, "ST02", 4) == 0){
-                    return RETICLEPODTYPE;
-                } else if(memcmp(tmp_str, "ST03", 4) == 0){
-                    return RETICLEBARETYPE;
-                } else {
-                    sprintf(errmsg, "ERROR: STK[%s] is not stocker or stocker type",stkName);
-                    return false;
-                }
+        db_fetchRow(dbs, &row);
+        /* 0:STK_TYPE 1:STK_ID */
+        if( row.ncol > 0 ){
+            col = &row.col[0];
+            if( !col->isNull && DB_COLCMP(col, "ST01", 4) ){
+                ret_i = LOTPODTYPE;
+            } else if( !col->isNull && DB_COLCMP(col, "ST02", 4) ){
+                ret_i = RETICLEPODTYPE;
+            } else if( !col->isNull && DB_COLCMP(col, "ST03", 4) ){
+                ret_i = RETICLEBARETYPE;
             } else {
                 sprintf(errmsg, "ERROR: STK[%s] is not stocker or stocker type",stkName);
-                return false;
+                ret_i = false;
             }
         } else {
-            sprintf(errmsg,"ERROR: QUERY[%s] parsing resultset error",resultSet);
-            return false;
+            sprintf(errmsg,"ERROR: QUERY[%s] parsing resultset error",dbs->sqlframe.result_str);
+            ret_i = false;
         }
+        db_release(dbs);
+        return ret_i;
     } else {
         sprintf(errmsg, "ERROR: GetStkTypeByStkName Fail STKNAME[%s]::%s",
-                                                                    stkName, resultSet);
+                                                                    stkName, dbs->sqlframe.result_str);
+        db_release(dbs);
         return false;
     }
     return true;
@@ -4426,38 +8275,32 @@ int GetStkTypeByStkName(char *stkName, char *errmsg)
 int GetTagIDByBcrID(char *bcrID, char *tagID, char *errmsg)
 {
     int ret_i;
-    char tmp_str[MAX_ITEMS]={0,};
-    char resultSet[BUFSIZ]={0,};
+    DB_SESSION *dbs;
+    DB_ROW row;
     
-    pthread_mutex_lock(&msg_mtx);
-    memset( &ga_sqlframe_stt, NULL, sizeof(SQLFRAME) );
-    memset( &ga_bindframe_stt, NULL, sizeof(BINDFRAME) );
-    
-    sprintf(ga_sqlframe_stt.sqlstat_str,
-        "SELECT TAG_ID FROM LTSBCRTAG WHERE BARCODE=:v1");
-        
-    strcpy( ga_bindframe_stt.bind_str[0], bcrID );         
+    dbs = db_lease();
+    strcpy( dbs->bindframe.bind_str[0], bcrID );
 	
-    ret_i = eDB_query( SQL_COMMAND, (char *)0, 1 );
-    memcpy(resultSet, ga_sqlframe_stt.result_str, strlen(ga_sqlframe_stt.result_str));
-	pthread_mutex_unlock(&msg_mtx);
+    ret_i = db_exec( dbs, STMT_TAG_ID, 1 );
 	
     if( ret_i > 0 ){
-        if( getSubstr(resultSet, "^TAG_ID=", "^", tmp_str) == SUCCESS ){
-            if(tmp_str[0] != '-') {
-                strcpy(tagID, tmp_str);   
-            } else {
-                sprintf(errmsg, "ERROR: BCRID[%s] is not mapping Tag ID",bcrID);
-                return false;
-            }
-        } else {
-            sprintf(errmsg,"ERROR: QUERY[%s] parsing resultset error",resultSet);
+        db_fetchRow(dbs, &row);
+        ret_i = db_colStr(&row, 0, tagID);
+        if( ret_i == DB_COL_NULL ){
+            sprintf(errmsg, "ERROR: BCRID[%s] is not mapping Tag ID",bcrID);
+            db_release(dbs);
+            return false;
+        } else if( ret_i == DB_COL_NONE ){
+            sprintf(errmsg,"ERROR: QUERY[%s] parsing resultset error",dbs->sqlframe.result_str);
+            db_release(dbs);
             return false;
         }
     } else {
-        sprintf(errmsg, "ERROR: GetTagIDByBcrID Fail CSTID[%s]::%s",bcrID, resultSet);
+        sprintf(errmsg, "ERROR: GetTagIDByBcrID Fail CSTID[%s]::%s", bcrID, dbs->sqlframe.result_str);
+        db_release(dbs);
         return false;
     }
+    db_release(dbs);
     return true;
 }
 
@@ -4472,38 +8315,32 @@ int GetTagIDByBcrID(char *bcrID, char *tagID, char *errmsg)
 int GetBcrIDByTagID(char *tagID, char *bcrID, char *errmsg)
 {
     int ret_i;
-    char tmp_str[MAX_ITEMS]={0,};
-    char resultSet[BUFSIZ]={0,};
+    DB_SESSION *dbs;
+    DB_ROW row;
     
-    pthread_mutex_lock(&msg_mtx);
-    memset( &ga_sqlframe_stt, NULL, sizeof(SQLFRAME) );
-    memset( &ga_bindframe_stt, NULL, sizeof(BINDFRAME) );
-    
-    sprintf(ga_sqlframe_stt.sqlstat_str,
-        "SELECT BARCODE FROM LTSBCRTAG WHERE TAG_ID=:v1");
-        
-    strcpy( ga_bindframe_stt.bind_str[0], tagID );         
+    dbs = db_lease();
+    strcpy( dbs->bindframe.bind_str[0], tagID );
 	
-    ret_i = eDB_query( SQL_COMMAND, (char *)0, 1 );
-    memcpy(resultSet, ga_sqlframe_stt.result_str, strlen(ga_sqlframe_stt.result_str));
-	pthread_mutex_unlock(&msg_mtx);
+    ret_i = db_exec( dbs, STMT_BCR_BY_TAG, 1 );
 	
     if( ret_i > 0 ){
-        if( getSubstr(resultSet, "^BARCODE=", "^", tmp_str) == SUCCESS ){
-            if(tmp_str[0] != '-') {
-                strcpy(bcrID, tmp_str);   
-            } else {
-                sprintf(errmsg, "ERROR: TAG[%s] is not mapping Tag ID",tagID);
-                return false;
-            }
-        } else {
-            sprintf(errmsg,"ERROR: QUERY[%s] parsing resultset error",resultSet);
+        db_fetchRow(dbs, &row);
+        ret_i = db_colStr(&row, 0, bcrID);
+        if( ret_i == DB_COL_NULL ){
+            sprintf(errmsg, "ERROR: TAG[%s] is not mapping Tag ID",tagID);
+            db_release(dbs);
+            return false;
+        } else if( ret_i == DB_COL_NONE ){
+            sprintf(errmsg,"ERROR: QUERY[%s] parsing resultset error",dbs->sqlframe.result_str);
+            db_release(dbs);
             return false;
         }
     } else {
-        sprintf(errmsg, "ERROR: GetBcrIDByTagID Fail TAGID[%s]::%s", tagID, resultSet);
+        sprintf(errmsg, "ERROR: GetBcrIDByTagID Fail TAGID[%s]::%s", tagID, dbs->sqlframe.result_str);
+        db_release(dbs);
         return false;
     }
+    db_release(dbs);
     return true;
 }
 
@@ -4518,173 +8355,39 @@ int GetBcrIDByTagID(char *tagID, char *bcrID, char *errmsg)
 int GetBcrIDByLogicalID(char *logicalID, char *bcrID, char *errmsg)
 {
     int ret_i;
-    char tmp_str[MAX_ITEMS]={0,};
-    char resultSet[BUFSIZ]={0,};
-    
-    pthread_mutex_lock(&msg_mtx);
-    memset( &ga_sqlframe_stt, NULL, sizeof(SQLFRAME) );
-    memset( &ga_bindframe_stt, NULL, sizeof(BINDFRAME) );
-    
-    sprintf(ga_sqlframe_stt.sqlstat_str,
-        //"SELECT RTRIM(CST_ID) CST_ID, RTRIM(LOGICAL_ID) LOGICAL_ID FROM LTSLOGICAL WHERE RTRIM(LOGICAL_ID)=RTRIM(:v1)");
-        /*2022.12.05  Bar Code Reading     ϴ  ߻. RTRIM ʿ */
-        "SELECT RTRIM(CST_ID) CST_ID, RTRIM(LOGICAL_ID) LOGICAL_ID FROM LTSLOGICAL WHERE LOGICAL_ID=RTRIM(:v1)");
-        
-    strcpy( ga_bindframe_stt.bind_str[0], logicalID );
-	
-    ret_i = eDB_query( SQL_COMMAND, (char *)0, 1 );
-    memcpy(resultSet, ga_sqlframe_stt.result_str, strlen(ga_sqlframe_stt.result_str));
-	pthread_mutex_unlock(&msg_mtx);
-	
-    if( ret_i > 0 ){
-        if( getSubstr(resultSet, "^CST_ID=", "^", tmp_str) == SUCCESS ){
-            if(tmp_str[0] != '-') {
-                strcpy(bcrID, tmp_str);   
-            } else {
-                bcrID[0] = NULL;
-                return true;
-            }
-        } else {
-            sprintf(errmsg,"ERROR: QUERY[%s] parsing resultset error",resultSet);
-            return false;
-        }
-    } else {
-        sprintf(errmsg, "ERROR: GetBcrIDByLogicalID Fail LOGICALID[%s]::%s",logicalID, resultSet);
-        return false;
-    }
-    return true;
-}
-
-/*****************************************************************************/
-/* 1. Function Name: GetNextCleanData                                       */
-/* 2. Description  :   ǥ                                         */
-/* 3. Parameters   : char *logicalID - Logical ID                            */
-/*                   char *bcrID     - Cassete ID                            */
-/*                   char *errmsg    - Error Message                         */
-/* 4. Return Value : int                                                     */
-/*****************************************************************************/
-int GetNextCleanData (char *logicalID, char *NextCleanData, char *tmpCstID, char *errmsg)
-{
-    int ret_i;
-	/*
-	char tmpCstID[12]={0,};
-	*/
-    char tmp_str[MAX_ITEMS]={0,};
-    char resultSet[BUFSIZ]={0,};
-    
-    pthread_mutex_lock(&msg_mtx);
-    memset( &ga_sqlframe_stt, NULL, sizeof(SQLFRAME) );
-    memset( &ga_bindframe_stt, NULL, sizeof(BINDFRAME) );
-    
-    sprintf(ga_sqlframe_stt.sqlstat_str,
-        //"SELECT RTRIM(CST_ID) CST_ID, RTRIM(LOGICAL_ID) LOGICAL_ID FROM LTSLOGICAL WHERE RTRIM(LOGICAL_ID)=RTRIM(:v1)");
-        /*2022.12.05  Bar Code Reading     ϴ  ߻. RTRIM ʿ */
-        "SELECT RTRIM(CST_ID) CST_ID, RTRIM(LOGICAL_ID) LOGICAL_ID FROM LTSLOGICAL WHERE LOGICAL_ID=RTRIM(:v1)");
-        
-    strcpy( ga_bindframe_stt.bind_str[0], logicalID );
-	
-    ret_i = eDB_query( SQL_COMMAND, (char *)0, 1 );
-    memcpy(resultSet, ga_sqlframe_stt.result_str, strlen(ga_sqlframe_stt.result_str));
-	pthread_mutex_unlock(&msg_mtx);
-	
-    if( ret_i > 0 ){
-        if( getSubstr(resultSet, "^CST_ID=", "^", tmp_str) == SUCCESS ){
-            if(tmp_str[0] != '-') {
-                strcpy(tmpCstID, tmp_str);
-				/*
-			    sprintf(errmsg, "DEBUG : GetNextCleanData1 LOT[%s] CST_ID [%s] info:%s ", logicalID, tmpCstID, resultSet);
-				logMessage(DEBUG, errmsg);
-				*/
-
-            } else {
-				/*
-			    sprintf(errmsg, "DEBUG : GetNextCleanData2 LOT[%s] CST_ID [%s] info:%s ", logicalID, tmpCstID, resultSet);
-				logMessage(DEBUG, errmsg);
-				*/
-
-                tmpCstID[0] = NULL;
-				NextCleanData[0] = NULL;
-                return true;
-            }
-        } else {
-			/*
-		    sprintf(errmsg, "DEBUG : GetNextCleanData3 LOT[%s] CST_ID [%s] info:%s ", logicalID, tmpCstID, resultSet);
-			logMessage(DEBUG, errmsg);
-			*/
-
-            sprintf(errmsg,"ERROR: QUERY[%s] parsing resultset error",resultSet);
-            return false;
-        }
-    } else {
-        sprintf(errmsg, "ERROR: GetNextCleanData Fail1 LOGICALID[%s]::%s",logicalID, resultSet);
-        return false;
-    }
-	/*
-    sprintf(errmsg, "DEBUG : GetNextCleanData4 LOT[%s] CST_ID [%s] info:%s ", logicalID, tmpCstID, resultSet);
-    logMessage(DEBUG, errmsg);
-	*/
-
-    pthread_mutex_lock(&msg_mtx);
-    memset( &ga_sqlframe_stt, NULL, sizeof(SQLFRAME) );
-    memset( &ga_bindframe_stt, NULL, sizeof(BINDFRAME) );
+    DB_SESSION *dbs;
+    DB_ROW row;
     
-    sprintf(ga_sqlframe_stt.sqlstat_str,
-        "SELECT TO_CHAR (SYSDATE + NVL(RTRIM(CST_CMF_3),0) ,'YYYY/MM/DD') NEXT_CLEAN FROM LTSCST WHERE CST_ID = :v1");
-        
-    strcpy( ga_bindframe_stt.bind_str[0], tmpCstID );
+    dbs = db_lease();
+    strcpy( dbs->bindframe.bind_str[0], logicalID );
 	
-    ret_i = eDB_query( SQL_COMMAND, (char *)0, 1 );
-    memcpy(resultSet, ga_sqlframe_stt.result_str, strlen(ga_sqlframe_stt.result_str));
-	pthread_mutex_unlock(&msg_mtx);
+    ret_i = db_exec( dbs, STMT_BCR_BY_LOGICAL, 1 );
 	
     if( ret_i > 0 ){
-        if( getSubstr(resultSet, "^NEXT_CLEAN=", "^", tmp_str) == SUCCESS ){
-            if(tmp_str[0] != '-') {
-                strcpy(NextCleanData, tmp_str);
-				/*
-				sprintf(errmsg, "DEBUG : GetNextCleanData5 LOT[%s] CST_ID [%s] NEXT [%s] info:%s ", logicalID, tmpCstID, NextCleanData, resultSet);
-				logMessage(DEBUG, errmsg);
-				*/
-
-            } else {
-				/*
-				sprintf(errmsg, "DEBUG : GetNextCleanData6 LOT[%s] CST_ID [%s] NEXT [%s] info:%s ", logicalID, tmpCstID, NextCleanData, resultSet);
-				logMessage(DEBUG, errmsg);
-				*/
-
-				NextCleanData[0] = NULL;
-                return true;
-            }
-        } else {
-			/*
-			sprintf(errmsg, "DEBUG : GetNextCleanData7 LOT[%s] CST_ID [%s] NEXT [%s] info:%s ", logicalID, tmpCstID, NextCleanData, resultSet);
-			logMessage(DEBUG, errmsg);
-			*/
-			
-			sprintf(errmsg,"ERROR: QUERY[%s] parsing resultset error",resultSet);
+        db_fetchRow(dbs, &row);
+        ret_i = db_colStr(&row, 0, bcrID);
+        if( ret_i == DB_COL_NULL ){
+            bcrID[0] = NULL;
+            db_release(dbs);
+            return true;
+        } else if( ret_i == DB_COL_NONE ){
+            sprintf(errmsg,"ERROR: QUERY[%s] parsing resultset error",dbs->sqlframe.result_str);
+            db_release(dbs);
             return false;
         }
     } else {
-		/*
-		sprintf(errmsg, "DEBUG : GetNextCleanData8 LOT[%s] CST_ID [%s] NEXT [%s] info:%s ", logicalID, tmpCstID, NextCleanData, resultSet);
-		logMessage(DEBUG, errmsg);
-		*/
-
-        sprintf(errmsg, "ERROR: GetNextCleanData Fail2 LOGICALID[%s]::%s",logicalID, resultSet);
+        sprintf(errmsg, "ERROR: GetBcrIDByLogicalID Fail LOGICALID[%s]::%s", logicalID, dbs->sqlframe.result_str);
+        db_release(dbs);
         return false;
     }
-	
-	/*
-    sprintf(errmsg, "DEBUG : GetNextCleanData9 LOT[%s] CST_ID [%s] NEXT [%s] info:%s ", logicalID, tmpCstID, NextCleanData, resultSet);
-    logMessage(DEBUG, errmsg);
-	*/
-
+    db_release(dbs);
     return true;
 }
 
 /*****************************************************************************/
 /* 1. Function Name: GetLotInfo                                              */
 /* 2. Description  : LOT info DB query Լ                                  */
+/*                   hold/priority/recipe/ϱ STMT_LOT_PAGE 1ȸ ȸ  */
 /* 3. Parameters   : char *lotID     - LOT ID                                */
 /*                   char* lotInfo   - LOT Info                              */
 /*                   char *errmsg    - Error Message                         */
@@ -4693,8 +8396,9 @@ int GetNextCleanData (char *logicalID, char *NextCleanData, char *tmpCstID, char
 int GetLotInfo(char *lotID, char* lotInfo, char* errmsg)
 {
     int ret_i;
-    char tmp_str[MAX_ITEMS]={0,};
-    char resultSet[BUFSIZ]={0,};
+    int rcpLevel = 0;
+    DB_SESSION *dbs;
+    DB_ROW row;
     char qty[20]={0,};
     char operation[12+1]={0,};
     char opDesc[50+1]={0,};
@@ -4709,7 +8413,8 @@ int GetLotInfo(char *lotID, char* lotInfo, char* errmsg)
     char temp_count[5]={0,};
     char tmpNextCleanData[12]={0,};
 	char cstID[12]={0,};
-	int lot_found_flag = 0;
+    char nextStk[10]={0,};
+    char tmpRcp[3][30+1];
 
     if ( 0 == memcmp (lotID, "ZZEMPTY-", strlen ("ZZEMPTY-")))
     {
@@ -4721,536 +8426,762 @@ int GetLotInfo(char *lotID, char* lotInfo, char* errmsg)
 		return true;    
     }
 
-    
-    pthread_mutex_lock(&msg_mtx);
-    memset( &ga_sqlframe_stt, NULL, sizeof(SQLFRAME) );
-    memset( &ga_bindframe_stt, NULL, sizeof(BINDFRAME) );
-    
-    sprintf(ga_sqlframe_stt.sqlstat_str,
-       "SELECT A.LOT_ID, RTRIM(A.QTY_1) QUANTITY, \
-        '['||DECODE(A.LOT_PRIORITY,'8','8','7','7','9','D1','6','D2','5','5',' ')||'] ' LOT_PRI, \
-         A.OPER OPERATION, \
-         C.OPER_DESC DESCRIPTION , \
-         A.RECIPE RECIPEID, A.FLOW BLOCK, B.FLOW_DESC DESCRIPTION2, \
-         A.LOT_DESC PRODUCT, \
-		 A.HOLD_CODE HOLD_CODE \
-         FROM MWIPLOTSTS A,MWIPFLWDEF B,MWIPOPRDEF C \
-         WHERE  A.FLOW = B.FLOW \
-         AND A.OPER = C.OPER \
-         AND A.FACTORY=B.FACTORY \
-         AND A.FACTORY=C.FACTORY \
-         AND A.LOT_ID = :v1");
-
-        /*    
-        "SELECT L.WORKNAME,A.QUANTITY,L.OPERATION, O.DESCRIPTION,L.RECIPEID,L.BLOCK, \
-                B.DESCRIPTION DESCRIPTION2 ,L.PRODUCT \
-         FROM   WORK L, OPERATION O, AMOUNT A, BLOCK B \
-         WHERE  L.WORKNAME  = :v1 \
-         AND	L.WORKNAME  = A.WORKNAME(+) \
-         AND	L.BLOCK	   = B.BLOCK \
-         AND	L.OPERATION = O.OPERATION ");
-        */
-        
-    strcpy( ga_bindframe_stt.bind_str[0], lotID );         
+    dbs = db_lease();
+    strcpy( dbs->bindframe.bind_str[0], lotID );         
 	
-    ret_i = eDB_query( SQL_COMMAND, (char *)0, 1 );
-    memcpy(resultSet, ga_sqlframe_stt.result_str, strlen(ga_sqlframe_stt.result_str));
-	pthread_mutex_unlock(&msg_mtx);
+    ret_i = db_exec( dbs, STMT_LOT_PAGE, 1 );
 	
-	if( ret_i > 0 ){
+	if( ret_i <= 0 ){
+        sprintf(errmsg, "ERROR: LOT[%s] is not found. GetLotInfo Fail::%s", lotID, dbs->sqlframe.result_str);
+        db_release(dbs);
+        return false;
+    }
+    /* 0:LOT_ID 1:QUANTITY 2:LOT_PRI 3:OPERATION 4:DESCRIPTION 5:RECIPEID    */
+    /* 6:BLOCK 7:DESCRIPTION2 8:PRODUCT 9:HOLD_CODE 10:TEMP_COUNT            */
+    /* 11:NEXT_STK 12:RCP_LOT 13:RCP_MFO1 14:RCP_MFO2 15:CST_ID 16:NEXT_CLEAN */
+    if( db_fetchRow(dbs, &row) < 17 ){
+        sprintf(errmsg, "ERROR: LOT[%s] info parsing error msg:%s", lotID, dbs->sqlframe.result_str);
+        db_release(dbs);
+        return false;
+    }
+    if( db_colStr(&row, 1, qty) != DB_COL_OK )       qty[0] = NULL;
+    if( db_colStr(&row, 3, operation) != DB_COL_OK ) operation[0] = NULL;
+    if( db_colStr(&row, 2, lot_pri) != DB_COL_OK )   lot_pri[0] = NULL;
+    if( db_colStr(&row, 4, opDesc) != DB_COL_OK )    opDesc[0] = NULL;
+    if( db_colStr(&row, 5, recipe) != DB_COL_OK )    recipe[0] = NULL;
+    if( db_colStr(&row, 6, block) != DB_COL_OK )     block[0] = NULL;
+    if( db_colStr(&row, 7, blDesc) != DB_COL_OK )    blDesc[0] = NULL;
+    if( db_colStr(&row, 8, device) != DB_COL_OK )    device[0] = NULL;
+    //2021.04.12 ENGR, DMHD Hold   ߻ϴ 찡 ־ DMHD   ϵ . ̿ å û
+    //2021.04.11 DMHD  CUST Hold Dipslay û ̿ å 
+    if( db_colStr(&row, 9, hold_code) != DB_COL_OK ) hold_code[0] = NULL;
+    if( db_colStr(&row, 10, temp_count) != DB_COL_OK ) temp_count[0] = NULL;
+    if( db_colStr(&row, 11, nextStk) != DB_COL_OK )  nextStk[0] = NULL;
+    if( db_colStr(&row, 12, tmpRcp[0]) != DB_COL_OK ) tmpRcp[0][0] = NULL;
+    if( db_colStr(&row, 13, tmpRcp[1]) != DB_COL_OK ) tmpRcp[1][0] = NULL;
+    if( db_colStr(&row, 14, tmpRcp[2]) != DB_COL_OK ) tmpRcp[2][0] = NULL;
+    if( db_colStr(&row, 15, cstID) != DB_COL_OK )    cstID[0] = NULL;
+    if( db_colStr(&row, 16, tmpNextCleanData) != DB_COL_OK ) tmpNextCleanData[0] = NULL;
+
+    sprintf(errmsg, "DEBUG: LOT[%s] info:%s ", lotID, dbs->sqlframe.result_str);
+    logMessage(DEBUG, errmsg);
+    db_release(dbs);
 
-        if( getSubstr(resultSet, "^QUANTITY=", "^", tmp_str) == SUCCESS ){
-            if(tmp_str[0] != '-') {
-                strcpy(qty, tmp_str);
-            } else {
-                qty[0] = NULL;
-            }
-        } else {
-            sprintf(errmsg, "ERROR: LOT[%s] info parsing error msg:%s", lotID,resultSet);
-            return false;
-        }
-        if( getSubstr(resultSet, "^OPERATION=", "^", tmp_str) == SUCCESS ){
-            if(tmp_str[0] != '-') {
-                strcpy(operation, tmp_str);
-            } else {
-                operation[0] = NULL;
-            }
-        } else {
-            sprintf(errmsg, "ERROR: LOT[%s] info parsing error msg:%s", lotID,resultSet);
-            return false;
-        }
-        if( getSubstr(resultSet, "^LOT_PRI=", "^", tmp_str) == SUCCESS ){
-            if(tmp_str[0] != '-') {
-                strcpy(lot_pri, tmp_str);
-            } else {
-                lot_pri[0] = NULL;
-            }
-        } else {
-            sprintf(errmsg, "ERROR: LOT[%s] info parsing error msg:%s", lotID,resultSet);
-            return false;
-        }
-        if( getSubstr(resultSet, "^DESCRIPTION=", "^", tmp_str) == SUCCESS ){
-            if(tmp_str[0] != '-') {
-                strcpy(opDesc, tmp_str);
-            } else {
-                opDesc[0] = NULL;
-            }
-        } else {
-            sprintf(errmsg, "ERROR: LOT[%s] info parsing error msg:%s", lotID,resultSet);
-            return false;
-        }
-        if( getSubstr(resultSet, "^RECIPEID=", "^", tmp_str) == SUCCESS ){
-            if(tmp_str[0] != '-') {
-                strcpy(recipe, tmp_str);
-            } else {
-                recipe[0] = NULL;
-            }
-        } else {
-            sprintf(errmsg, "ERROR: LOT[%s] info parsing error msg:%s", lotID,resultSet);
-            return false;
-        }
-        if( getSubstr(resultSet, "^BLOCK=", "^", tmp_str) == SUCCESS ){
-            if(tmp_str[0] != '-') {
-                strcpy(block, tmp_str);
-            } else {
-                block[0] = NULL;
-            }
-        } else {
-            sprintf(errmsg, "ERROR: LOT[%s] info parsing error msg:%s", lotID,resultSet);
-            return false;
-        }
-        if( getSubstr(resultSet, "^DESCRIPTION2=", "^", tmp_str) == SUCCESS ){
-            if(tmp_str[0] != '-') {
-                strcpy(blDesc, tmp_str);
-            } else {
-                blDesc[0] = NULL;
-            }
-        } else {
-            sprintf(errmsg, "ERROR: LOT[%s] info parsing error msg:%s", lotID,resultSet);
-            return false;
-        }
-        if( getSubstr(resultSet, "^PRODUCT=", "^", tmp_str) == SUCCESS ){
-            if(tmp_str[0] != '-') {
-                strcpy(device, tmp_str);
-            } else {
-                device[0] = NULL;
-            }
+    /* Lot PRI  */
+    if ( 0 == memcmp(lot_pri, "[5]", 3) && 0 == memcmp(temp_count, "P3",2) ) {
+        sprintf (lot_pri, "[%s]","D3");
+    }
+    sprintf (operation_merge, "%s %s",  lot_pri, operation);
+
+    /*2007.07.12 Recipe Query κ  */
+    /* Update Recipe >  Recipe >  Recipe > LOT Recipe */
+    for(ret_i = 0; ret_i < 3; ret_i++){
+        if(tmpRcp[ret_i][0] == NULL) continue;
+        if (nextStk[0] != NULL ){
+            sprintf (recipe,"%.20s-%.6s",tmpRcp[ret_i], nextStk);
         } else {
-            sprintf(errmsg, "ERROR: LOT[%s] info parsing error msg:%s", lotID,resultSet);
-            return false;
+            sprintf (recipe,"%.20s",tmpRcp[ret_i]);
         }
-        if( getSubstr(resultSet, "^HOLD_CODE=", "^", tmp_str) == SUCCESS ){
-            if(tmp_str[0] != '-') {
-                strcpy(hold_code, tmp_str);
-            } else {
-                hold_code[0] = NULL;
-            }
-        } else {
-            sprintf(errmsg, "ERROR: LOT[%s] info parsing error msg:%s", lotID,resultSet);
-            return false;
-		}
+        rcpLevel = ret_i + 1;
+        break;
+    }
 
-		lot_found_flag = 1;
-	}
-	else
-	{
-		lot_found_flag = 0;
-	}
+    //2021.03.31  Host 2  STK 1ٷ ǥõ
+    //Host  32 Bye Download  񿡼 ִ 21  ν
+    //STK  21  x 5  ν
 
+    sprintf(errmsg, "DEBUG: LOT[%s] recipe:[%s][%d]", lotID,recipe,rcpLevel);
+    logMessage(DEBUG, errmsg);
+    /*
+    sprintf(lotInfo,"%-12s %-19s%-5s %-26s%12s%-.20s%-10s%-22s%15s%-.17s",
+                     lotID, qty, operation, opDesc, recipe, empty, block, blDesc, product, empty);
+    */
+    /*
+    sprintf(lotInfo,"%-12s %-19s%-10s %-21s%-32s%-10s%-22s%15s%-.17s",
+                     lotID, qty, operation_merge, opDesc, recipe, block, blDesc, product, empty);
+    */
+    /*
+    sprintf(lotInfo,"%-12s %-19s%-10s %-21s%-32s%-10s%-22s%15s %-10s%-.6s",
+                     lotID, qty, operation_merge, opDesc, recipe, block, blDesc, product, tmpNextCleanData, empty);
+    */
+    /*
+    sprintf(lotInfo,"%-12s %-19s%-10s %-21s%-32s%-10s%-22s     %-4s %-10s%-.12s",
+                     lotID, qty, operation_merge, opDesc, recipe, block, blDesc, product, tmpNextCleanData, empty);
+    */
+    /*
+    sprintf(lotInfo,"%-12s%-3s%-17s%-10s %-21s%-32s%-10s%-22s     %-4s %-10s%-.12s",
+                     lotID, qty, cstID, operation_merge, opDesc, recipe, block, blDesc, product, tmpNextCleanData, empty);
+    */
+
+    sprintf(lotInfo,"%-12s%-3s%-17s%-11s%-21s%-32s%-10s%-22s%-5s%-5s%-10s%-.12s",
+                     lotID, qty, cstID, operation_merge, opDesc, recipe, block, blDesc, hold_code, device, tmpNextCleanData, empty);
+
+    sprintf(errmsg, "DEBUG: LOT[%s] LotInfo[%s]", lotID, lotInfo);
+    logMessage(DEBUG, errmsg);
 
-	if ( lot_found_flag == 1)
-	{
-		//2021.04.12 ENGR, DMHD Hold   ߻ϴ 찡 ־ DMHD   ϵ . ̿ å û
-		//2021.04.11 DMHD  CUST Hold Dipslay û ̿ å 
-
-		memset (hold_code, 0x00, sizeof (hold_code));
-	      
-		pthread_mutex_lock(&msg_mtx);
-		memset( &ga_sqlframe_stt, NULL, sizeof(SQLFRAME) );
-		memset( &ga_bindframe_stt, NULL, sizeof(BINDFRAME) );
-	    
-		// SELECT HOLD_CODE FROM MESMGR.MWIPMHDSTS WHERE LOT_ID = '7146660' ORDER BY DECODE (HOLD_CODE, 'DMHD', 1, 'CUST', 2, 3); 
-
-		sprintf(ga_sqlframe_stt.sqlstat_str,
-			"SELECT HOLD_CODE FROM (SELECT HOLD_CODE FROM MESMGR.MWIPMHDSTS WHERE LOT_ID = :V1 AND HOLD_CODE IN ('CUST', 'DMHD') ORDER BY HOLD_CODE DESC) WHERE ROWNUM = 1");
-	        
-		strcpy( ga_bindframe_stt.bind_str[0], lotID );         
-		
-		ret_i = eDB_query( SQL_COMMAND, (char *)0, 1 );
-		memcpy(resultSet, ga_sqlframe_stt.result_str, strlen(ga_sqlframe_stt.result_str));
-  		pthread_mutex_unlock(&msg_mtx);
-		
-		if( ret_i > 0 ){
-			if( getSubstr(resultSet, "^HOLD_CODE=", "^", tmp_str) == SUCCESS ){
-				if(tmp_str[0] != '-') {
-					strcpy(hold_code, tmp_str);
-				} else {
-					hold_code[0] = NULL;
-				}
-			} else {
-				hold_code[0] = NULL;
-			}
-		}
+    return true;
+}
 
-		/* Lot PRI  */
-		if ( 0 == memcmp(lot_pri, "[5]", 3)) 
-		{
-			pthread_mutex_lock(&msg_mtx);
-			memset( &ga_sqlframe_stt, NULL, sizeof(SQLFRAME) );
-			memset( &ga_bindframe_stt, NULL, sizeof(BINDFRAME) );
-	    
-			sprintf(ga_sqlframe_stt.sqlstat_str,
-				 "SELECT SUBSTR(A.PRIORITY,1,2) TEMP_COUNT \
-				  FROM CERSABNINS A, MWIPLOTSTS B \
-				  WHERE \
-				  A.LOT_ID = B.LOT_ID \
-				  AND A.FLOW = B.FLOW \
-				  AND A.OPER = B.OPER \
-				  AND A.LOT_ID = :v1");
-		        
-			strcpy( ga_bindframe_stt.bind_str[0], lotID );         
-			
-			ret_i = eDB_query( SQL_COMMAND, (char *)0, 1 );
-			memcpy(resultSet, ga_sqlframe_stt.result_str, strlen(ga_sqlframe_stt.result_str));
-  			pthread_mutex_unlock(&msg_mtx);
-		
-			if( ret_i > 0 ){
-				if( getSubstr(resultSet, "^TEMP_COUNT=", "^", tmp_str) == SUCCESS ){
-					if(tmp_str[0] != '-') {
-						strcpy(temp_count, tmp_str);
-					} else {
-						temp_count[0] = NULL;
-					}
-				} else {
-						temp_count[0] = NULL;
-				}
-			}
+/*****************************************************************************/
+/* 1. Function Name: lot_prefetch                                            */
+/* 2. Description  : LOT (GetLotInfo)  񵿱 ̸ ȸ              */
+/*                   reactor mode  executor, thread mode   thread    */
+/*                   slot/queue    (rReadMemory   ȸ)    */
+/* 3. Parameters   : char *lotID     - LOT ID                                */
+/* 4. Return Value : None                                                    */
+/*****************************************************************************/
+void lot_prefetch(char *lotID)
+{
+    LOT_PREFETCH *pf = NULL, *old = NULL;
+    pthread_t tid;
+    time_t now = time(NULL);
+    int i, ok;
+
+    if(gLotPrefetch == 0 || strlen(lotID) >= sizeof(pf->lotID)) return;
+    /*  cache  ̹  ȸ ʿ */
+    if(lotc_read(lotID, 0, 0, NULL) == true) return;
+
+    pthread_mutex_lock(&gLotPfMtx);
+    for(i = 0; i < LOTPF_MAX; i++){
+        if(gLotPf[i].state == LOTPF_EMPTY){
+            if(pf == NULL) pf = &gLotPf[i];
+            continue;
+        }
+        if(strcmp(gLotPf[i].lotID, lotID) == 0){
+            /* ̹ ̰ų غ page   */
+            if(gLotPf[i].state == LOTPF_PENDING || now - gLotPf[i].time < LOTPF_TTL){
+                pthread_mutex_unlock(&gLotPfMtx);
+                return;
+            }
+            pf = &gLotPf[i];
+            break;
+        }
+        if(gLotPf[i].state == LOTPF_READY && (old == NULL || gLotPf[i].time < old->time)){
+            old = &gLotPf[i];
+        }
+    }
+    if(pf == NULL) pf = old;
+    if(pf == NULL){
+        ++gLotPfSkip;
+        pthread_mutex_unlock(&gLotPfMtx);
+        return;
+    }
+    if(pf->state == LOTPF_READY) ++gLotPfWasted;
+    memset(pf, 0x00, sizeof(LOT_PREFETCH));
+    strcpy(pf->lotID, lotID);
+    pf->gen   = lotc_gen(lotID);
+    pf->state = LOTPF_PENDING;
+    pf->time  = now;
+    ++gLotPfIssue;
+    pthread_mutex_unlock(&gLotPfMtx);
 
-			  if ( 0 == memcmp(temp_count, "P3",2) ) {
-      			   sprintf (lot_pri, "[%s]","D3");
-			  }
-		}
-	    
-		sprintf (operation_merge, "%s %s",  lot_pri, operation);
-	    
-			sprintf(errmsg, "DEBUG: LOT[%s] info:%s ", lotID,resultSet);
-			logMessage(DEBUG, errmsg);
-
-			/*2007.07.12 Recipe Query κ  */
-			ret_i = getRecipe ( lotID, recipe );
-    		ret_i = GetNextCleanData (lotID, tmpNextCleanData, cstID, errmsg);
-
-			//2021.03.31  Host 2  STK 1ٷ ǥõ
-			//Host  32 Bye Download  񿡼 ִ 21  ν
-			//STK  21  x 5  ν
-
-
-			sprintf(errmsg, "DEBUG: LOT[%s] recipe:[%s][%d]", lotID,recipe,ret_i);
-			logMessage(DEBUG, errmsg);
-			/*
-			sprintf(lotInfo,"%-12s %-19s%-5s %-26s%12s%-.20s%-10s%-22s%15s%-.17s",
-							 lotID, qty, operation, opDesc, recipe, empty, block, blDesc, product, empty);
-			*/
-			/*
-			sprintf(lotInfo,"%-12s %-19s%-10s %-21s%-32s%-10s%-22s%15s%-.17s",
-							 lotID, qty, operation_merge, opDesc, recipe, block, blDesc, product, empty);
-			*/
-			/*
-			sprintf(lotInfo,"%-12s %-19s%-10s %-21s%-32s%-10s%-22s%15s %-10s%-.6s",
-							 lotID, qty, operation_merge, opDesc, recipe, block, blDesc, product, tmpNextCleanData, empty);
-			*/
-			/*
-			sprintf(lotInfo,"%-12s %-19s%-10s %-21s%-32s%-10s%-22s     %-4s %-10s%-.12s",
-							 lotID, qty, operation_merge, opDesc, recipe, block, blDesc, product, tmpNextCleanData, empty);
-			*/
-			/*
-			sprintf(lotInfo,"%-12s%-3s%-17s%-10s %-21s%-32s%-10s%-22s     %-4s %-10s%-.12s",
-							 lotID, qty, cstID, operation_merge, opDesc, recipe, block, blDesc, product, tmpNextCleanData, empty);
-			*/
-
-			sprintf(lotInfo,"%-12s%-3s%-17s%-11s%-21s%-32s%-10s%-22s%-5s%-5s%-10s%-.12s",
-							 lotID, qty, cstID, operation_merge, opDesc, recipe, block, blDesc, hold_code, device, tmpNextCleanData, empty);
-
-			sprintf(errmsg, "DEBUG: LOT[%s] LotInfo[%s]", lotID, lotInfo);
-			logMessage(DEBUG, errmsg);
-
-			return true;                         
-	} else {
-        sprintf(errmsg, "ERROR: LOT[%s] is not found. GetLotInfo Fail::%s", lotID,resultSet);
-        return false;
-    }	
+    if(gIoMode == IOMODE_REACTOR){
+        ok = exec_trySubmit(lot_prefetchTask, (void *)pf);
+    } else {
+        ok = (pthread_create(&tid, NULL, lot_prefetchThread, (void *)pf) == 0);
+    }
+    if(!ok){
+        pthread_mutex_lock(&gLotPfMtx);
+        pf->state = LOTPF_EMPTY;
+        --gLotPfIssue;
+        ++gLotPfSkip;
+        pthread_cond_broadcast(&gLotPfCond);
+        pthread_mutex_unlock(&gLotPfMtx);
+    }
+}
 
-    return true;
+/*****************************************************************************/
+/* 1. Function Name: lot_prefetchTask                                        */
+/* 2. Description  : prefetch slot  LOT  ȸ  READY           */
+/* 3. Parameters   : LOT_PREFETCH *pf - PENDING slot                         */
+/* 4. Return Value : None                                                    */
+/*****************************************************************************/
+void lot_prefetchTask(void *arg)
+{
+    LOT_PREFETCH *pf = (LOT_PREFETCH *)arg;
+    char lotID[24];
+    char page[LOTINFO_SIZE];
+    char errmsg[BUFSIZ]={0,};
+    int  ret;
+
+    /* PENDING slot   Ƿ lotID/gen  ״ ȿ */
+    strcpy(lotID, pf->lotID);
+    memset(page, 0x00, sizeof(page));
+    ret = GetLotInfo(lotID, page, errmsg);
+    if(ret == true){
+        lotc_put(lotID, page, pf->gen);
+    }
+
+    pthread_mutex_lock(&gLotPfMtx);
+    memcpy(pf->page, page, sizeof(page));
+    strncpy(pf->errmsg, errmsg, sizeof(pf->errmsg) - 1);
+    pf->result = ret;
+    pf->time   = time(NULL);
+    pf->state  = LOTPF_READY;
+    pthread_cond_broadcast(&gLotPfCond);
+    pthread_mutex_unlock(&gLotPfMtx);
 }
 
 /*****************************************************************************/
-/* 1. Function Name: InsertBcrTagMapping                                     */
-/* 2. Description  : Bcr Tag mapping table Insert                            */
-/* 3. Parameters   : char* bcrID     - Barcode ID                            */
-/*                   char* tagID     - Teltag ID                             */
-/*                   char* stkName   - stocker Name                          */
-/*                   char* errmsg    - error message                         */
-/* 4. Return Value : int                                                     */
+/* 1. Function Name: lot_prefetchThread                                      */
+/* 2. Description  : thread mode  lot_prefetchTask  thread             */
+/* 3. Parameters   : LOT_PREFETCH *pf - PENDING slot                         */
+/* 4. Return Value : None                                                    */
 /*****************************************************************************/
-int InsertBcrTagMapping(char *bcrID, char *tagID, char *stkName, char *errmsg)
+void * lot_prefetchThread(void *arg)
 {
-    int ret_i;
-    int resultset[BUFSIZ]={0,};
-    
-    pthread_mutex_lock(&msg_mtx);
-    memset( &ga_sqlframe_stt, NULL, sizeof(SQLFRAME) );
-    memset( &ga_bindframe_stt, NULL, sizeof(BINDFRAME) );    
-
-    sprintf(ga_sqlframe_stt.sqlstat_str,
-            "INSERT INTO LTSBCRTAG VALUES(:v1, :v2, :v3, sysdate)");
-    strcpy( ga_bindframe_stt.bind_str[0], bcrID );  
-    strcpy( ga_bindframe_stt.bind_str[1], tagID );  
-    strcpy( ga_bindframe_stt.bind_str[2], stkName );
-    memcpy(resultset, ga_sqlframe_stt.result_str, strlen(ga_sqlframe_stt.result_str));
-    pthread_mutex_unlock(&msg_mtx);
-    
-    ret_i = eDB_update();
-    if( ret_i == FAIL )
-    {
-         sprintf(errmsg, "ERROR: InsertBcrTagMapping Fail BCRID[%s] TAGID[%s]::%s",bcrID,tagID,resultset);
-         return false;
-    }
-    return true;
+    pthread_detach(pthread_self());
+    lot_prefetchTask(arg);
+    return NULL;
 }
 
 /*****************************************************************************/
-/* 1. Function Name: stk_rConnect_hton                                       */
-/* 2. Description  : host -> network  Endian ȯ                            */
-/* 3. Parameters   : rConnectRequest *req   - host byte ü               */
-/* 4. Return Value : int                                                     */
+/* 1. Function Name: lot_prefetchTake                                        */
+/* 2. Description  : lotID  prefetch                           */
+/*                   ̸ LOTPF_WAIT ʱ ϷḦ ٸ            */
+/* 3. Parameters   : char *lotID     - LOT ID                                */
+/*                   char *lotInfo   - LOT Info (LOTINFO_SIZE)               */
+/*                   char *errmsg    - Error Message                         */
+/* 4. Return Value : GetLotInfo , prefetch   -1                  */
 /*****************************************************************************/
-int stk_rConnect_hton(rConnectRequest *req)
+int lot_prefetchTake(char *lotID, char *lotInfo, char *errmsg)
 {
-    req->msgLen     = bigToLitts(req->msgLen);   
-    return 0;
+    LOT_PREFETCH *pf = NULL;
+    struct timespec ts;
+    time_t now = time(NULL);
+    int i, ret = -1, waited = 0;
+    int logFlag = 0;
+    char statmsg[BUFSIZ];
+
+    pthread_mutex_lock(&gLotPfMtx);
+    for(i = 0; i < LOTPF_MAX; i++){
+        if(gLotPf[i].state == LOTPF_EMPTY) continue;
+        if(strcmp(gLotPf[i].lotID, lotID) == 0){
+            pf = &gLotPf[i];
+        } else if(gLotPf[i].state == LOTPF_READY && now - gLotPf[i].time >= LOTPF_TTL){
+            gLotPf[i].state = LOTPF_EMPTY;
+            ++gLotPfWasted;
+        }
+    }
+    if(pf != NULL && pf->state == LOTPF_PENDING){
+        ts.tv_sec  = now + LOTPF_WAIT;
+        ts.tv_nsec = 0;
+        waited = 1;
+        while(pf->state == LOTPF_PENDING && strcmp(pf->lotID, lotID) == 0){
+            if(pthread_cond_timedwait(&gLotPfCond, &gLotPfMtx, &ts) == ETIMEDOUT) break;
+        }
+    }
+    if(pf != NULL && pf->state == LOTPF_READY && strcmp(pf->lotID, lotID) == 0 &&
+       time(NULL) - pf->time < LOTPF_TTL && pf->gen == lotc_gen(lotID)){
+        memcpy(lotInfo, pf->page, LOTINFO_SIZE);
+        strcpy(errmsg, pf->errmsg);
+        ret = pf->result;
+        pf->state = LOTPF_EMPTY;
+        if(waited) ++gLotPfWaitHit;
+        else       ++gLotPfHit;
+    } else {
+        if(pf != NULL && pf->state == LOTPF_READY && strcmp(pf->lotID, lotID) == 0){
+            /*  Ǵ ȸ invalidate   */
+            pf->state = LOTPF_EMPTY;
+            ++gLotPfWasted;
+        }
+        ++gLotPfMiss;
+    }
+    if(now - gLotPfStatTime >= DB_STAT_INTERVAL){
+        gLotPfStatTime = now;
+        sprintf(statmsg, "INFO : LOT prefetch issue[%ld] hit[%ld] wait_hit[%ld] miss[%ld] wasted[%ld] skip[%ld]",
+                gLotPfIssue, gLotPfHit, gLotPfWaitHit, gLotPfMiss, gLotPfWasted, gLotPfSkip);
+        logFlag = 1;
+    }
+    pthread_mutex_unlock(&gLotPfMtx);
+
+    if(logFlag) logMessage(INFO, statmsg);
+    return ret;
 }
 
 /*****************************************************************************/
-/* 1. Function Name: stk_rClose_hton                                         */
-/* 2. Description  : host -> network  Endian ȯ                            */
-/* 3. Parameters   : rSimpleRequest *req    - host byte ü               */
+/* 1. Function Name: lotc_init                                               */
+/* 2. Description  :  LOT page cache                                 */
+/* 3. Parameters   : int size        - cache entry  (0 : ̻)           */
+/*                   char *msg       - error message                         */
 /* 4. Return Value : int                                                     */
 /*****************************************************************************/
-int stk_rClose_hton(rSimpleRequest *req)
+int lotc_init(int size, char *msg)
 {
-    req->msgLen     = bigToLitts(req->msgLen);
-    return 0;
+    memset(gLotcHead, 0xff, sizeof(gLotcHead));
+    gLotcStatTime = time(NULL);
+    if(size == 0) return true;
+
+    if((gLotc = (LOT_CACHE *)calloc(size, sizeof(LOT_CACHE))) == NULL){
+        sprintf(msg, "ERROR: LOT page cache [%d] alloc fail", size);
+        return false;
+    }
+    return true;
 }
 
 /*****************************************************************************/
-/* 1. Function Name: stk_rPhysicalToLogicalSensor_hton                       */
-/* 2. Description  : host -> network  Endian ȯ                            */
-/* 3. Parameters   : rGenRequest* req    - host byte ü                  */
-/* 4. Return Value : int                                                     */
+/* 1. Function Name: lotc_hash                                               */
+/* 2. Description  : LOT ID hash Լ                                        */
+/* 3. Parameters   : char *lotID     - LOT ID                                */
+/* 4. Return Value : bucket index                                            */
 /*****************************************************************************/
-int stk_rPhysicalToLogicalSensor_hton(rGenRequest* req)
+unsigned int lotc_hash(char *lotID)
 {
-    req->msgLen     = bigToLitts(req->msgLen);
-    req->itemType   = bigToLittl(req->itemType);
-    req->period     = bigToLittl(req->period);
-    
-    return 0;
+    unsigned int h = 5381;
+
+    while(*lotID != 0x00){
+        h = (h << 5) + h + (unsigned char)*lotID++;
+    }
+    return h & (LOTC_HASHSIZE - 1);
 }
 
 /*****************************************************************************/
-/* 1. Function Name: stk_rListUnitAtIrt_hton                                 */
-/* 2. Description  : host -> network  Endian ȯ                            */
-/* 3. Parameters   : rQuerySensorRequest* req    - host byte ü          */
-/* 4. Return Value : int                                                     */
+/* 1. Function Name: lotc_find                                               */
+/* 2. Description  : LOT ID  cache entry ˻ (gLotcMtx ȿ ȣ)       */
+/* 3. Parameters   : char *lotID     - LOT ID                                */
+/* 4. Return Value : entry index,  -1                                  */
 /*****************************************************************************/
-int stk_rListUnitAtIrt_hton(rQuerySensorRequest* req)
+int lotc_find(char *lotID)
 {
-    req->msgLen     = bigToLitts(req->msgLen);
-    req->pingTime   = bigToLittl(req->pingTime);
-    req->numItems   = bigToLittl(req->numItems);
-    
-    return 0;
+    int i;
+
+    for(i = gLotcHead[lotc_hash(lotID)]; i >= 0; i = gLotc[i].next){
+        if(strcmp(gLotc[i].lotID, lotID) == 0) return i;
+    }
+    return -1;
 }
 
 /*****************************************************************************/
-/* 1. Function Name: stk_rReadMemory_hton                                    */
-/* 2. Description  : host -> network  Endian ȯ                            */
-/* 3. Parameters   : rReadRAMRequest* req    - host byte ü              */
-/* 4. Return Value : int                                                     */
+/* 1. Function Name: lotc_unlink                                             */
+/* 2. Description  : cache entry  hash chain   (gLotcMtx )       */
+/* 3. Parameters   : int idx         - entry index                           */
+/* 4. Return Value : None                                                    */
 /*****************************************************************************/
-int stk_rReadMemory_hton(rReadRAMRequest* req)
+void lotc_unlink(int idx)
 {
-    req->msgLen     = bigToLitts(req->msgLen);
-    req->period     = bigToLittl(req->period);
-    req->addr       = bigToLittl(req->addr);
-    
-    return 0;
+    int *pp = &gLotcHead[lotc_hash(gLotc[idx].lotID)];
+
+    while(*pp >= 0 && *pp != idx){
+        pp = &gLotc[*pp].next;
+    }
+    if(*pp == idx) *pp = gLotc[idx].next;
+    gLotc[idx].used = 0;
+    gLotc[idx].next = -1;
+    gLotcCnt--;
 }
 
 /*****************************************************************************/
-/* 1. Function Name: stk_rDisplayMsg_hton                                    */
-/* 2. Description  : host -> network  Endian ȯ                            */
-/* 3. Parameters   : rPostLineRequest *req    - host byte ü             */
-/* 4. Return Value : int                                                     */
+/* 1. Function Name: lotc_gen                                                */
+/* 2. Description  : LOT  invalidation generation                          */
+/*                   ȸ  ޾ ξٰ lotc_put  ѱ, ȸ ߿   */
+/*                   invalidate   cache   ʴ´               */
+/* 3. Parameters   : char *lotID     - LOT ID                                */
+/* 4. Return Value : generation                                              */
 /*****************************************************************************/
-int stk_rDisplayMsg_hton(rPostLineRequest *req)
+int lotc_gen(char *lotID)
 {
-    req->msgLen     = bigToLitts(req->msgLen);
-    req->line       = bigToLittl(req->line);
-    req->period     = bigToLittl(req->period);
-    
-    return 0;
+    int gen;
+
+    pthread_mutex_lock(&gLotcMtx);
+    gen = gLotcGen[lotc_hash(lotID)];
+    pthread_mutex_unlock(&gLotcMtx);
+    return gen;
 }
 
 /*****************************************************************************/
-/* 1. Function Name: stk_rAssociateUnit_hton                                 */
-/* 2. Description  : host -> network  Endian ȯ                            */
-/* 3. Parameters   : rGenRequest* req   - host byte ü                   */
-/* 4. Return Value : int                                                     */
+/* 1. Function Name: lotc_read                                               */
+/* 2. Description  : cache  LOT page image  off  len byte      */
+/*                   len  0 ̸  θ ȮѴ                      */
+/* 3. Parameters   : char *lotID     - LOT ID                                */
+/*                   int off         - page image offset                     */
+/*                   int len         -                               */
+/*                   char *out       -  buffer                         */
+/* 4. Return Value : true - hit, false - miss/                           */
 /*****************************************************************************/
-int stk_rAssociateUnit_hton(rGenRequest* req)
+int lotc_read(char *lotID, int off, int len, char *out)
 {
-    req->msgLen     = bigToLitts(req->msgLen);
-    req->itemType   = bigToLittl(req->itemType);
-    req->period     = bigToLittl(req->period);
-    
-    return 0;
+    int i, ret = false;
+    int logFlag = 0;
+    time_t now;
+    char statmsg[BUFSIZ];
+
+    if(gLotc == NULL || off < 0 || off + len > LOTINFO_SIZE) return false;
+
+    now = time(NULL);
+    pthread_mutex_lock(&gLotcMtx);
+    if((i = lotc_find(lotID)) >= 0){
+        if(now - gLotc[i].loadTime >= gLotcTTL){
+            lotc_unlink(i);
+        } else {
+            if(len > 0) memcpy(out, gLotc[i].page + off, len);
+            gLotc[i].lastUse = now;
+            ret = true;
+        }
+    }
+    if(len > 0){
+        if(ret == true) ++gLotcHit;
+        else            ++gLotcMiss;
+    }
+    if(now - gLotcStatTime >= DB_STAT_INTERVAL){
+        gLotcStatTime = now;
+        sprintf(statmsg, "INFO : LOT cache size[%d/%d] hit[%ld] miss[%ld] put[%ld] stale[%ld] inval[%ld] evict[%ld]",
+                gLotcCnt, gLotcSize, gLotcHit, gLotcMiss, gLotcPut, gLotcStale, gLotcInval, gLotcEvict);
+        logFlag = 1;
+    }
+    pthread_mutex_unlock(&gLotcMtx);
+
+    if(logFlag) logMessage(INFO, statmsg);
+    return ret;
 }
 
 /*****************************************************************************/
-/* 1. Function Name: stk_rDisassociateUnit_hton                              */
-/* 2. Description  : host -> network  Endian ȯ                            */
-/* 3. Parameters   : rGenRequest* req   - host byte ü                   */
-/* 4. Return Value : int                                                     */
+/* 1. Function Name: lotc_put                                                */
+/* 2. Description  : LOT page image .       entry  */
+/*                   üѴ                                                */
+/* 3. Parameters   : char *lotID     - LOT ID                                */
+/*                   char *page      - LOT page image (LOTINFO_SIZE)         */
+/*                   int gen         - ȸ  lotc_gen                    */
+/* 4. Return Value : None                                                    */
 /*****************************************************************************/
-int stk_rDisassociateUnit_hton(rGenRequest* req)
+void lotc_put(char *lotID, char *page, int gen)
 {
-    req->msgLen     = bigToLitts(req->msgLen);
-    req->itemType   = bigToLittl(req->itemType);
-    req->period     = bigToLittl(req->period);
-    
-    return 0;
+    int i, h;
+    time_t now;
+
+    if(gLotc == NULL || strlen(lotID) >= sizeof(gLotc[0].lotID)) return;
+
+    now = time(NULL);
+    h = lotc_hash(lotID);
+    pthread_mutex_lock(&gLotcMtx);
+    if(gLotcGen[h] != gen){
+        ++gLotcStale;
+        pthread_mutex_unlock(&gLotcMtx);
+        return;
+    }
+    if((i = lotc_find(lotID)) < 0){
+        if(gLotcCnt < gLotcSize){
+            for(i = 0; gLotc[i].used; i++);
+        } else {
+            for(i = 0, h = 1; h < gLotcSize; h++){
+                if(gLotc[h].lastUse < gLotc[i].lastUse) i = h;
+            }
+            lotc_unlink(i);
+            ++gLotcEvict;
+        }
+        strcpy(gLotc[i].lotID, lotID);
+        gLotc[i].used = 1;
+        h = lotc_hash(lotID);
+        gLotc[i].next = gLotcHead[h];
+        gLotcHead[h] = i;
+        gLotcCnt++;
+    }
+    memcpy(gLotc[i].page, page, LOTINFO_SIZE);
+    gLotc[i].loadTime = now;
+    gLotc[i].lastUse  = now;
+    ++gLotcPut;
+    pthread_mutex_unlock(&gLotcMtx);
 }
 
 /*****************************************************************************/
-/* 1. Function Name: stk_rListUnitAtIrt_ntoh                                 */
-/* 2. Description  : network -> host  Endian ȯ                            */
-/* 3. Parameters   : rQuerySensorReply *rep - network byte ü            */
-/* 4. Return Value : int                                                     */
+/* 1. Function Name: lotc_invalidate                                         */
+/* 2. Description  : LTS / ó LOT  cache entry           */
+/*                   LTSsvr ȯ  ۵ GetLotInfo   page     */
+/*                   ʵ ȣ ȯ  (/ ) θ   */
+/* 3. Parameters   : char *lotID     - LOT ID (logical ID)                   */
+/* 4. Return Value : None                                                    */
 /*****************************************************************************/
-int stk_rListUnitAtIrt_ntoh(rQuerySensorReply *rep)
-{
-    rep->msgLen     = bigToLitts(rep->msgLen);
-    rep->result	    = bigToLittl(rep->result);
-    rep->totalNum	= bigToLittl(rep->totalNum);
-    rep->numItems	= bigToLittl(rep->numItems); 
-	rep->responseMsg.unittype		= bigToLitts(rep->responseMsg.unittype);
-	rep->responseMsg.updateTime	    = bigToLittl(rep->responseMsg.updateTime);
-	rep->responseMsg.moveTime		= bigToLittl(rep->responseMsg.moveTime);
-	rep->responseMsg.motionTime	    = bigToLittl(rep->responseMsg.motionTime);
-	rep->responseMsg.unitCategory	= bigToLittl(rep->responseMsg.unitCategory);
-	rep->responseMsg.sensorCategory = bigToLitts(rep->responseMsg.sensorCategory);
-	
-	return 0;
-} 
+void lotc_invalidate(char *lotID)
+{
+    int i;
+
+    pthread_mutex_lock(&gLotcMtx);
+    gLotcGen[lotc_hash(lotID)]++;
+    if(gLotc != NULL && (i = lotc_find(lotID)) >= 0){
+        lotc_unlink(i);
+        ++gLotcInval;
+    }
+    pthread_mutex_unlock(&gLotcMtx);
+}
 
 /*****************************************************************************/
-/* 1. Function Name: stk_rReadMemory_ntoh                                    */
-/* 2. Description  : network -> host  Endian ȯ                            */
-/* 3. Parameters   : rReadRAMReply *rep - network byte ü                */
-/* 4. Return Value : int                                                     */
+/* 1. Function Name: logq_start                                              */
+/* 2. Description  : LOGsvr  ring   shipping thread            */
+/*                   STKinf.log.queue  0 ̸ ó  Ѵ       */
+/* 3. Parameters   : pthread_attr_t *attr -  Ӽ                      */
+/*                   char *msg            - error message                    */
+/* 4. Return Value : 0 - , -1 -                                      */
 /*****************************************************************************/
-int stk_rReadMemory_ntoh(rReadRAMReply *rep)
+int logq_start(pthread_attr_t *attr, char *msg)
 {
-    rep->msgLen     = bigToLitts(rep->msgLen);
-	rep->result	    = bigToLitts(rep->result);
-	rep->addr       = bigToLittl(rep->addr);
-	return 0;
+    pthread_t tid;
+    unsigned int i, size;
+
+    if(gLogqSize == 0){
+        sprintf(msg, "INFO : LOGsvr queue disabled (synchronous log write)");
+        logMessage(INFO, msg);
+        return 0;
+    }
+    /* index  mask  ڸ  2^n  ø */
+    for(size = 1; size < (unsigned int)gLogqSize; size <<= 1);
+    if((gLogq = (LOG_REC *)calloc(size, sizeof(LOG_REC))) == NULL){
+        sprintf(msg, "ERROR: LOGsvr queue [%u] alloc fail errno[%d]", size, errno);
+        return -1;
+    }
+    for(i = 0; i < size; i++){
+        gLogq[i].seq = i;
+    }
+    gLogqMask = size - 1;
+    gLogqSize = size;
+    if(pthread_create(&tid, attr, logq_thread, NULL) != 0){
+        sprintf(msg, "ERROR: LOGsvr shipping thread create fail errno[%d]", errno);
+        return -1;
+    }
+    return 0;
 }
 
 /*****************************************************************************/
-/* 1. Function Name: stk_rAssociateUnit_ntoh                                 */
-/* 2. Description  : network -> host  Endian ȯ                            */
-/* 3. Parameters   : rGenReply *rep - network byte ü                    */
-/* 4. Return Value : int                                                     */
+/* 1. Function Name: logq_push                                               */
+/* 2. Description  : LOGsvr  ring  record ߰ (lock )             */
+/* 3. Parameters   : char *dest      - LOGsvr  ǥ                      */
+/*                   char *name      - message name                          */
+/*                   char *body      - message body                          */
+/* 4. Return Value : true - , false - queue full                         */
 /*****************************************************************************/
-int stk_rAssociateUnit_ntoh(rGenReply *rep)
+int logq_push(char *dest, char *name, char *body)
 {
-    rep->msgLen	    = bigToLitts(rep->msgLen);
-	rep->result	    = bigToLittl(rep->result);
-	return 0;
+    LOG_REC *rec;
+    unsigned int pos, depth;
+    int diff, high;
+
+    pos = gLogqEnq;
+    while(1){
+        rec  = &gLogq[pos & gLogqMask];
+        diff = (int)(rec->seq - pos);
+        if(diff == 0){
+            if(__sync_bool_compare_and_swap(&gLogqEnq, pos, pos + 1)) break;
+        } else if(diff < 0){
+            return false;
+        }
+        pos = gLogqEnq;
+    }
+    snprintf(rec->dest, sizeof(rec->dest), "%s", dest);
+    snprintf(rec->name, sizeof(rec->name), "%s", name);
+    snprintf(rec->body, sizeof(rec->body), "%s", body);
+    __sync_synchronize();
+    rec->seq = pos + 1;
+
+    __sync_fetch_and_add(&gLogqIn, 1);
+    /* Խ ڿ ȮϹǷ logq_wait   queue   ٸ
+     * ⼭ ݵ gLogqSleep   */
+    __sync_synchronize();
+    if(gLogqSleep){
+        pthread_mutex_lock(&gLogqMtx);
+        pthread_cond_signal(&gLogqCond);
+        pthread_mutex_unlock(&gLogqMtx);
+    }
+    depth = pos + 1 - gLogqDeq;
+    while((high = gLogqHigh) < (int)depth){
+        if(__sync_bool_compare_and_swap(&gLogqHigh, high, (int)depth)) break;
+    }
+    return true;
 }
 
 /*****************************************************************************/
-/* 1. Function Name: stk_rDisassociateUnit_ntoh                              */
-/* 2. Description  : network -> host  Endian ȯ                            */
-/* 3. Parameters   : rGenReply *rep - network byte ü                    */
-/* 4. Return Value : int                                                     */
+/* 1. Function Name: logq_pop                                                */
+/* 2. Description  : LOGsvr  ring    record          */
+/* 3. Parameters   : LOG_REC *out    -  record (NULL ̸ )        */
+/* 4. Return Value : true - , false - queue empty                        */
 /*****************************************************************************/
-int stk_rDisassociateUnit_ntoh(rGenReply *rep)
+int logq_pop(LOG_REC *out)
 {
-    rep->msgLen	    = bigToLitts(rep->msgLen);
-	rep->result	    = bigToLittl(rep->result);
-	return 0;
+    LOG_REC *rec;
+    unsigned int pos;
+    int diff;
+
+    pos = gLogqDeq;
+    while(1){
+        rec  = &gLogq[pos & gLogqMask];
+        diff = (int)(rec->seq - (pos + 1));
+        if(diff == 0){
+            if(__sync_bool_compare_and_swap(&gLogqDeq, pos, pos + 1)) break;
+        } else if(diff < 0){
+            return false;
+        }
+        pos = gLogqDeq;
+    }
+    if(out != NULL){
+        memcpy(out->dest, rec->dest, sizeof(rec->dest));
+        memcpy(out->name, rec->name, sizeof(rec->name));
+        strcpy(out->body, rec->body);
+    }
+    __sync_synchronize();
+    rec->seq = pos + gLogqMask + 1;
+    return true;
 }
 
 /*****************************************************************************/
-/* 1. Function Name: stk_rPhysicalToLogicalSensor_ntoh                       */
-/* 2. Description  : network -> host  Endian ȯ                            */
-/* 3. Parameters   : rGenReply *rep - network byte ü                    */
-/* 4. Return Value : int                                                     */
+/* 1. Function Name: logq_ship                                               */
+/* 2. Description  : LOGsvr α . queue  enqueue  ϰ ٷ     */
+/*                   ư,      record     */
+/* 3. Parameters   : char *dest      - LOGsvr  ǥ                      */
+/*                   char *name      - message name                          */
+/*                   char *body      - message body                          */
+/*                   char *msg       - Error Message                         */
+/* 4. Return Value : true - , false -                                */
 /*****************************************************************************/
-int stk_rPhysicalToLogicalSensor_ntoh(rGenReply *rep)
+int logq_ship(char *dest, char *name, char *body, char *msg)
 {
-    rep->msgLen	    = bigToLitts(rep->msgLen);
-	rep->result	    = bigToLittl(rep->result);
-	
-	return 0;    
+    int logsock, i;
+
+    if(gLogq == NULL){
+        if((logsock = connSocket_unix(logFile, msg)) == false){
+            return false;
+        }
+        if(sendLogMessage(logsock, SERVER_NAME, dest, name, body, msg) < 0){
+            close(logsock);
+            return false;
+        }
+        close(logsock);
+        return true;
+    }
+    for(i = 0; i < LOGQ_SPIN; i++){
+        if(logq_push(dest, name, body) == true) return true;
+        if(logq_pop(NULL) == true){
+            __sync_fetch_and_add(&gLogqDrop, 1);
+        }
+    }
+    /* ٸ producer  slot  ä ̸  record   */
+    __sync_fetch_and_add(&gLogqDrop, 1);
+    return true;
 }
 
 /*****************************************************************************/
-/* 1. Function Name: stk_rDisplayMsg_ntoh                                    */
-/* 2. Description  : network -> host  Endian ȯ                            */
-/* 3. Parameters   : rSimpleReply *rep - network byte ü                 */
-/* 4. Return Value : int                                                     */
+/* 1. Function Name: logq_thread                                             */
+/* 2. Description  : LOGsvr  ϳ ϸ wakeup  queue       */
+/*                   LOGQ_BATCH    .  н   */
+/*                   ش record  1ȸ ϰ,  ϸ        */
+/* 3. Parameters   : None                                                    */
+/* 4. Return Value : None                                                    */
 /*****************************************************************************/
-int stk_rDisplayMsg_ntoh(rSimpleReply *rep)
+void * logq_thread(void *arg)
 {
-    rep->msgLen	    = bigToLitts(rep->msgLen);
-	rep->result	    = bigToLitts(rep->result);
-	
-    return 0;
+    LOG_REC *batch;
+    char errmsg[BUFSIZ];
+    int logsock = -1;
+    int i = 0, n = 0, retry = 0, connFail = 0;
+    time_t now, statTime = 0;
+
+    pthread_detach(pthread_self());
+    if((batch = (LOG_REC *)malloc(sizeof(LOG_REC) * LOGQ_BATCH)) == NULL){
+        sprintf(errmsg, "FATAL: LOGsvr shipping buffer alloc fail");
+        logMessage(ERROR, errmsg);
+        exit(1);
+    }
+    while(1){
+        now = time(NULL);
+        if(now - statTime >= DB_STAT_INTERVAL){
+            statTime = now;
+            sprintf(errmsg, "INFO : LOGsvr queue depth[%u/%d] high[%d] in[%ld] sent[%ld] drop[%ld] fail[%ld] reconnect[%ld]",
+                    gLogqEnq - gLogqDeq, gLogqSize, gLogqHigh, gLogqIn, gLogqSent, gLogqDrop, gLogqFail, gLogqReconn);
+            logMessage(INFO, errmsg);
+        }
+        if(i >= n){
+            for(i = 0, n = 0; n < LOGQ_BATCH && logq_pop(&batch[n]) == true; n++);
+            if(n == 0){
+                logq_wait();
+                continue;
+            }
+            retry = 0;
+        }
+        if(logsock < 0){
+            if((logsock = connSocket_unix(logFile, errmsg)) == false){
+                logsock = -1;
+                /* LOGsvr  ȿ  1ȸ  */
+                if(connFail++ == 0) logMessage(ERROR, errmsg);
+                sleep(LOGQ_RETRY);
+                continue;
+            }
+            if(connFail > 0 || gLogqSent > 0) ++gLogqReconn;
+            connFail = 0;
+        }
+        /*  record      */
+        while(i < n){
+            if(sendLogMessage(logsock, SERVER_NAME, batch[i].dest, batch[i].name, batch[i].body, errmsg) < 0){
+                logMessage(ERROR, errmsg);
+                close(logsock);
+                logsock = -1;
+                ++gLogqFail;
+                /*   1ȸ ϰ, ٽ ϸ  */
+                if(retry++ > 0){
+                    __sync_fetch_and_add(&gLogqDrop, 1);
+                    retry = 0;
+                    i++;
+                }
+                break;
+            }
+            ++gLogqSent;
+            retry = 0;
+            i++;
+        }
+    }
+    return NULL;
 }
 
 /*****************************************************************************/
-/* 1. Function Name: stk_rConnect_ntoh                                       */
-/* 2. Description  : network -> host  Endian ȯ                            */
-/* 3. Parameters   : rConnectReply *rep - network byte ü                */
-/* 4. Return Value : int                                                     */
+/* 1. Function Name: logq_wait                                               */
+/* 2. Description  : queue    logq_push  signal  ٸ    */
+/*                    log   ִ 1ʸ ٸ                    */
+/* 3. Parameters   : None                                                    */
+/* 4. Return Value : None                                                    */
 /*****************************************************************************/
-int stk_rConnect_ntoh(rConnectReply *rep)
+void logq_wait(void)
 {
-    rep->msgLen	    = bigToLitts(rep->msgLen);
-	rep->result	    = bigToLitts(rep->result);
-	rep->major	    = bigToLitts(rep->major);
-	rep->minor	    = bigToLitts(rep->minor);
-	rep->point	    = bigToLitts(rep->point);
-	
-	return 0;
+    struct timespec ts;
+    unsigned int pos;
+
+    pthread_mutex_lock(&gLogqMtx);
+    gLogqSleep = 1;
+    __sync_synchronize();
+    pos = gLogqDeq;
+    if(gLogq[pos & gLogqMask].seq != pos + 1){
+        ts.tv_sec  = time(NULL) + 1;
+        ts.tv_nsec = 0;
+        pthread_cond_timedwait(&gLogqCond, &gLogqMtx, &ts);
+    }
+    gLogqSleep = 0;
+    pthread_mutex_unlock(&gLogqMtx);
 }
 
 /*****************************************************************************/
-/* 1. Function Name: stk_rClose_ntoh                                         */
-/* 2. Description  : network -> host  Endian ȯ                            */
-/* 3. Parameters   : rSimpleReply *rep - network byte ü                 */
+/* 1. Function Name: InsertBcrTagMapping                                     */
+/* 2. Description  : Bcr Tag mapping table Insert                            */
+/* 3. Parameters   : char* bcrID     - Barcode ID                            */
+/*                   char* tagID     - Teltag ID                             */
+/*                   char* stkName   - stocker Name                          */
+/*                   char* errmsg    - error message                         */
 /* 4. Return Value : int                                                     */
 /*****************************************************************************/
-int stk_rClose_ntoh(rSimpleReply *rep)
+int InsertBcrTagMapping(char *bcrID, char *tagID, char *stkName, char *errmsg)
 {
-    rep->msgLen	    = bigToLitts(rep->msgLen);
-	rep->result	    = bigToLitts(rep->result);
-	
-	return 0;
+    int ret_i;
+    DB_SESSION *dbs;
+    int resultset[BUFSIZ]={0,};
+    
+    dbs = db_lease();
+
+    strcpy( dbs->bindframe.bind_str[0], bcrID );  
+    strcpy( dbs->bindframe.bind_str[1], tagID );  
+    strcpy( dbs->bindframe.bind_str[2], stkName );
+    ret_i = db_exec( dbs, STMT_BCRTAG_INS, 0 );
+    memcpy(resultset, dbs->sqlframe.result_str, strlen(dbs->sqlframe.result_str));
+    db_release(dbs);
+    
+    if( ret_i == FAIL )
+    {
+         sprintf(errmsg, "ERROR: InsertBcrTagMapping Fail BCRID[%s] TAGID[%s]::%s",bcrID,tagID,resultset);
+         return false;
+    }
+    return true;
 }
 
 /*****************************************************************************/
@@ -5261,12 +9192,7 @@ int stk_rClose_ntoh(rSimpleReply *rep)
 /*****************************************************************************/
 unsigned short bigToLitts(unsigned short num)
 {
-    unsigned short a,b;
-    a = b = num;
-    a = a >> 8;
-    b = b << 8;
-    b = a | b;
-    return b;
+    return __builtin_bswap16(num);
 }
 
 /*****************************************************************************/
@@ -5277,31 +9203,23 @@ unsigned short bigToLitts(unsigned short num)
 /*****************************************************************************/
 unsigned int bigToLittl(unsigned int num)
 {
-    char    temp[4];
-    unsigned int ret;
-    
-    temp[0] = ((char*)&num)[3];
-    temp[1] = ((char*)&num)[2];
-    temp[2] = ((char*)&num)[1];
-    temp[3] = ((char*)&num)[0];
-    
-    memcpy(&ret,temp,sizeof(int));
-    return ret;
+    return __builtin_bswap32(num);
 }
 
 /*****************************************************************************/
 /* 1. Function Name: lts_rAssociateUnit                                      */
 /* 2. Description  : Logical ID connect ó                                 */
-/* 3. Parameters   : int   stkType   - STK Type                              */
-/*                   char *stkName   - STK name                              */
+/* 3. Parameters   : STK_PROFILE *prof - STK profile                         */
 /*                   char *cstID     - Cassete ID                            */
 /*                   char *logicalID - Logical ID                            */
 /*                   char *irtName   - STK PORT name                         */
 /*                   char *errmsg    - Error Message                         */
 /* 4. Return Value : int                                                     */
 /*****************************************************************************/
-int lts_rAssociateUnit(int stkType, char* stkName, char* cstID, char* logicalID, char* irtName, char* errmsg)
+int lts_rAssociateUnit(STK_PROFILE *prof, char* cstID, char* logicalID, char* irtName, char* errmsg)
 {
+    char *stkName = prof->stkName;      /* profile  STK name */
+    int  stkType = prof->stkType;       /* profile  STK type */
     char recvMsgName[7]={0,};
     char sendMsgName[7]={0,};
     char recvBuf[BUFSIZ]={0,};
@@ -5312,10 +9230,12 @@ int lts_rAssociateUnit(int stkType, char* stkName, char* cstID, char* logicalID,
     char rtnCode[3]={0,};
     char errorMsg[200]={0,};
     int msgID = 99;
+    int ret;
     char type;
     
     sprintf(errmsg, "INFO : STK[%s] connect start CSTID[%s] LOGICALID[%s]", stkName, cstID, logicalID);
     logMessage(INFO, errmsg);
+    lotc_invalidate(logicalID);
     
     if(memcmp(logicalID, "EMPTY", 5) == 0){
         sprintf(errmsg, "INFO : STK[%s] connect end CSTID[%s] LOGICALID[%s]", stkName, cstID, logicalID);
@@ -5337,7 +9257,9 @@ int lts_rAssociateUnit(int stkType, char* stkName, char* cstID, char* logicalID,
             sprintf(sendBuf, "CST_ID=%s|LOGICAL_ID=%s|TYPE=%c|SOURCE=%s|EMP_ID=%s|HHT_NAME=%s", 
                                                 tmpCstID, logicalID, type, SERVER_NAME, stkName, stkName);
     
-            if(lts_SendRecv(msgID, sendMsgName, sendBuf, recvMsgName, recvBuf, errmsg) == false){
+            ret = lts_SendRecv(msgID, sendMsgName, sendBuf, recvMsgName, recvBuf, errmsg);
+            lotc_invalidate(logicalID);
+            if(ret == false){
                 sprintf(errmsg,"ERROR: STK[%s] reticle disconnect request ltssvr fail",stkName);
                 return false;
             } else {
@@ -5366,7 +9288,9 @@ int lts_rAssociateUnit(int stkType, char* stkName, char* cstID, char* logicalID,
             sprintf(sendBuf, "CST_ID=%s|LOGICAL_ID=%s|TYPE=%c|SOURCE=%s|EMP_ID=%s|HHT_NAME=%s", 
                                                 cstID, tmpLogicalID, type, SERVER_NAME, stkName, stkName);
     
-            if(lts_SendRecv(msgID, sendMsgName, sendBuf, recvMsgName, recvBuf, errmsg) == false){
+            ret = lts_SendRecv(msgID, sendMsgName, sendBuf, recvMsgName, recvBuf, errmsg);
+            lotc_invalidate(tmpLogicalID);
+            if(ret == false){
                 sprintf(errmsg,"ERROR: STK[%s] reticle disconnect request ltssvr fail",stkName);
                 return false;
             } else {
@@ -5396,7 +9320,9 @@ int lts_rAssociateUnit(int stkType, char* stkName, char* cstID, char* logicalID,
     sprintf(sendBuf, "CST_ID=%s|LOGICAL_ID=%s|TYPE=%c|SOURCE=%s|EMP_ID=%s|HHT_NAME=%s", 
                                         cstID, logicalID, type, SERVER_NAME, stkName, stkName);
 
-    if(lts_SendRecv(msgID, sendMsgName, sendBuf, recvMsgName, recvBuf, errmsg) == false){
+    ret = lts_SendRecv(msgID, sendMsgName, sendBuf, recvMsgName, recvBuf, errmsg);
+    lotc_invalidate(logicalID);
+    if(ret == false){
         sprintf(errmsg,"ERROR: STK[%s] reticle connect request ltssvr fail",stkName);
         return false;
     } else {
@@ -5421,16 +9347,17 @@ int lts_rAssociateUnit(int stkType, char* stkName, char* cstID, char* logicalID,
 /*****************************************************************************/
 /* 1. Function Name: lts_rDisassociateUnit                                   */
 /* 2. Description  : Logical ID disconnect ó                              */
-/* 3. Parameters   : int   stkType   - STK Type                              */
-/*                   char *stkName   - STK name                              */
+/* 3. Parameters   : STK_PROFILE *prof - STK profile                         */
 /*                   char *cstID     - Cassete ID                            */
 /*                   char *logicalID - Logical ID                            */
 /*                   char *irtName   - STK PORT name                         */
 /*                   char *errmsg    - Error Message                         */
 /* 4. Return Value : int                                                     */
 /*****************************************************************************/
-int lts_rDisassociateUnit(int stkType, char* stkName, char* cstID, char* logicalID, char* irtName, char* errmsg)
+int lts_rDisassociateUnit(STK_PROFILE *prof, char* cstID, char* logicalID, char* irtName, char* errmsg)
 {
+    char *stkName = prof->stkName;      /* profile  STK name */
+    int  stkType = prof->stkType;       /* profile  STK type */
     char recvMsgName[7]={0,};
     char sendMsgName[7]={0,};
     char recvBuf[BUFSIZ]={0,};
@@ -5442,10 +9369,12 @@ int lts_rDisassociateUnit(int stkType, char* stkName, char* cstID, char* logical
     char tmpCstID[12]={0,};
     
     int msgID = 99;
+    int ret;
     char type;
     
     sprintf(errmsg, "INFO : STK[%s] disconnect start CSTID[%s] LOGICALID[%s]", stkName, cstID, logicalID);
     logMessage(INFO, errmsg);
+    lotc_invalidate(logicalID);
     
     if(memcmp(logicalID, "EMPTY", 5) == 0){
         sprintf(errmsg, "INFO : STK[%s] disconnect end CSTID[%s] LOGICALID[%s]", stkName, cstID, logicalID);
@@ -5465,7 +9394,9 @@ int lts_rDisassociateUnit(int stkType, char* stkName, char* cstID, char* logical
     sprintf(sendBuf, "CST_ID=%s|LOGICAL_ID=%s|TYPE=%c|SOURCE=%s|EMP_ID=%s|HHT_NAME=%s", 
                                         cstID, logicalID, type, SERVER_NAME, stkName, stkName);
 
-    if(lts_SendRecv(msgID, sendMsgName, sendBuf, recvMsgName, recvBuf, errmsg) == false){
+    ret = lts_SendRecv(msgID, sendMsgName, sendBuf, recvMsgName, recvBuf, errmsg);
+    lotc_invalidate(logicalID);
+    if(ret == false){
         sprintf(errmsg,"ERROR: STK[%s] LOGICALID[%s] disconnect request ltssvr fail",stkName,logicalID);
         return false;
     } else {
@@ -5489,16 +9420,17 @@ int lts_rDisassociateUnit(int stkType, char* stkName, char* cstID, char* logical
 /*****************************************************************************/
 /* 1. Function Name: lts_inputRequest                                        */
 /* 2. Description  : LOT/Reticle ԰ ó                                   */
-/* 3. Parameters   : int   stkType   - STK Type                              */
-/*                   char *stkName   - STK name                              */
+/* 3. Parameters   : STK_PROFILE *prof - STK profile                         */
 /*                   char *cstID     - Cassete ID                            */
 /*                   char *logicalID - Logical ID                            */
 /*                   char *irtName   - STK PORT name                         */
 /*                   char *errmsg    - Error Message                         */
 /* 4. Return Value : int                                                     */
 /*****************************************************************************/
-int lts_inputRequest(int stkType, char* stkName, char* cstID, char* logicalID, char* irtName, char* errmsg)
+int lts_inputRequest(STK_PROFILE *prof, char* cstID, char* logicalID, char* irtName, char* errmsg)
 {
+    char *stkName = prof->stkName;      /* profile  STK name */
+    int  stkType = prof->stkType;       /* profile  STK type */
     char recvMsgName[7]={0,};
     char sendMsgName[7]={0,};
     char recvBuf[BUFSIZ]={0,};
@@ -5507,6 +9439,7 @@ int lts_inputRequest(int stkType, char* stkName, char* cstID, char* logicalID, c
     char errorMsg[200]={0,};
     
     int msgID = 99;
+    int ret;
     char type;
     
     if(stkType == LOTPODTYPE){
@@ -5516,9 +9449,10 @@ int lts_inputRequest(int stkType, char* stkName, char* cstID, char* logicalID, c
     } else if(stkType == RETICLEBARETYPE){
         type = 'R';
     }
+    lotc_invalidate(logicalID);
 
 	//2017.07.20 ġ  Update  EAP  ȯ Ǿ Logic 
-	if ( 0 == memcmp (stkName, "CPST", strlen ("CPST")))
+	if ( prof->ltsSkip == 1 )
 	{
 	    sprintf(errmsg, "INFO : STK[%s] inputRequest Skip CSTID[%s] LOGICALID[%s]", stkName, cstID, logicalID);
 		logMessage(INFO, errmsg);
@@ -5533,7 +9467,9 @@ int lts_inputRequest(int stkType, char* stkName, char* cstID, char* logicalID, c
     sprintf(sendBuf, "CST_ID=%s|LOGICAL_ID=%s|LOCATION=%s|PORT_ID=%s|TERMINAL_ID=%s|EQ_TYPE=STOCK|SOURCE=%s|EMP_ID=%s|HHT_NAME=%s",
                        cstID, logicalID, stkName, irtName, stkName, SERVER_NAME, stkName, stkName);
 
-    if(lts_SendRecv(msgID, sendMsgName, sendBuf, recvMsgName, recvBuf, errmsg) == false){
+    ret = lts_SendRecv(msgID, sendMsgName, sendBuf, recvMsgName, recvBuf, errmsg);
+    lotc_invalidate(logicalID);
+    if(ret == false){
         sprintf(errmsg,"ERROR: STK[%s] lts input request fail..",stkName);
         return false;
     } else {
@@ -5557,16 +9493,17 @@ int lts_inputRequest(int stkType, char* stkName, char* cstID, char* logicalID, c
 /*****************************************************************************/
 /* 1. Function Name: lts_outputRequest                                       */
 /* 2. Description  : LOT/Reticle  ó                                   */
-/* 3. Parameters   : int   stkType   - STK Type                              */
-/*                   char *stkName   - STK name                              */
+/* 3. Parameters   : STK_PROFILE *prof - STK profile                         */
 /*                   char *cstID     - Cassete ID                            */
 /*                   char *logicalID - Logical ID                            */
 /*                   char *irtName   - STK PORT name                         */
 /*                   char *errmsg    - Error Message                         */
 /* 4. Return Value : int                                                     */
 /*****************************************************************************/
-int lts_outputRequest(int stkType, char* stkName, char* cstID, char* logicalID, char* irtName, char* errmsg)
+int lts_outputRequest(STK_PROFILE *prof, char* cstID, char* logicalID, char* irtName, char* errmsg)
 {
+    char *stkName = prof->stkName;      /* profile  STK name */
+    int  stkType = prof->stkType;       /* profile  STK type */
     char recvMsgName[7]={0,};
     char sendMsgName[7]={0,};
     char recvBuf[BUFSIZ]={0,};
@@ -5575,6 +9512,7 @@ int lts_outputRequest(int stkType, char* stkName, char* cstID, char* logicalID,
     char errorMsg[200]={0,};
     
     int msgID = 99;
+    int ret;
     char type;
     
     if(stkType == LOTPODTYPE){
@@ -5584,9 +9522,10 @@ int lts_outputRequest(int stkType, char* stkName, char* cstID, char* logicalID,
     } else if(stkType == RETICLEBARETYPE){
         type = 'R';
     }
+    lotc_invalidate(logicalID);
 
 	//2017.07.20 ġ  Update  EAP  ȯ Ǿ Logic 
-	if ( 0 == memcmp (stkName, "CPST", strlen ("CPST")))
+	if ( prof->ltsSkip == 1 )
 	{
 	    sprintf(errmsg, "INFO : STK[%s] outRequest Skip CSTID[%s] LOGICALID[%s]", stkName, cstID, logicalID);
 		logMessage(INFO, errmsg);
@@ -5601,7 +9540,9 @@ int lts_outputRequest(int stkType, char* stkName, char* cstID, char* logicalID,
     sprintf(sendMsgName, "LOPR");
     sprintf(sendBuf, "CST_ID=%s|LOGICAL_ID=%s|LOCATION=%s|PORT_ID=%s|TERMINAL_ID=%s|EQ_TYPE=STOCK|SOURCE=%s|EMP_ID=%s|HHT_NAME=%s",
                        cstID, logicalID, stkName, irtName, stkName, SERVER_NAME, stkName, stkName);
-    if(lts_SendRecv(msgID, sendMsgName, sendBuf, recvMsgName, recvBuf, errmsg) == false){
+    ret = lts_SendRecv(msgID, sendMsgName, sendBuf, recvMsgName, recvBuf, errmsg);
+    lotc_invalidate(logicalID);
+    if(ret == false){
         sprintf(errmsg, "ERROR: STK[%s] output request ltssvr fail", stkName);
         return false;
     } else {
@@ -5625,7 +9566,8 @@ int lts_outputRequest(int stkType, char* stkName, char* cstID, char* logicalID,
 /*****************************************************************************/
 /* 1. Function Name: lts_SendRecv                                            */
 /* 2. Description  : LTSsvr                                          */
-/* 3. Parameters   : int   msgID     - message ID                            */
+/*                   pool   pool ,  û  ó   */
+/* 3. Parameters   : int   msgID     - message ID (û ῡ )   */
 /*                   char *s_msgName - LTSsvr send  message name           */
 /*                   char *sendBuf   - LTSsvr send  message buffer         */
 /*                   char *r_msgName - LTSsvr recv  message name           */
@@ -5634,24 +9576,274 @@ int lts_outputRequest(int stkType, char* stkName, char* cstID, char* logicalID,
 /* 4. Return Value : int                                                     */
 /*****************************************************************************/
 int lts_SendRecv(int msgID, char *s_msgName, char *sendBuf, char *r_msgName, char *recvBuf, char* errMsg)
+{
+    int result;
+    struct timespec ts;
+
+    memset(errMsg, 0x00, BUFSIZ);
+    trace_now(&ts);
+    result = lts_poolSendRecv(s_msgName, sendBuf, r_msgName, recvBuf, errMsg);
+    if(result == -1){
+        __sync_fetch_and_add(&gLtsDirect, 1);
+        result = lts_directSendRecv(msgID, s_msgName, sendBuf, r_msgName, recvBuf, errMsg);
+    }
+    trace_span("ltssvr", &ts);
+    if(result != true){
+        return false;
+    }
+    if(logq_ship("<-LTSsvr", r_msgName, recvBuf, errMsg) == false){
+        logMessage(ERROR, errMsg);
+    }
+    return true;
+}
+
+/*****************************************************************************/
+/* 1. Function Name: lts_poolStart                                           */
+/* 2. Description  : LTSsvr pool Ằ  / thread          */
+/*                    thread  background  δ´                   */
+/* 3. Parameters   : pthread_attr_t *attr -  Ӽ                      */
+/*                   char *msg            - error message                    */
+/* 4. Return Value : 0 - , -1 -                                      */
+/*****************************************************************************/
+int lts_poolStart(pthread_attr_t *attr, char *msg)
+{
+    pthread_t tid;
+    int i;
+
+    for(i = 0; i < LTS_MAXPEND; i++){
+        pthread_cond_init(&gLtsPend[i].cond, NULL);
+    }
+    if(gLtsPoolSize == 0){
+        sprintf(msg, "INFO : LTSsvr connection pool disabled");
+        logMessage(INFO, msg);
+        return 0;
+    }
+    for(i = 0; i < gLtsPoolSize; i++){
+        gLtsConn[i].idx  = i;
+        gLtsConn[i].sock = -1;
+        pthread_mutex_init(&gLtsConn[i].wmtx, NULL);
+        if(pthread_create(&tid, attr, lts_connThread, &gLtsConn[i]) != 0){
+            sprintf(msg, "ERROR: LTSsvr connection thread[%d] create fail errno[%d]", i, errno);
+            return -1;
+        }
+    }
+    return 0;
+}
+
+/*****************************************************************************/
+/* 1. Function Name: lts_connThread                                          */
+/* 2. Description  : LTSsvr pool  ϳ   thread                */
+/*                    msgID   request  ã ѱ,      */
+/*                     request   ó  Ѵ      */
+/* 3. Parameters   : void *arg       - LTS_CONN *                            */
+/* 4. Return Value : None                                                    */
+/*****************************************************************************/
+void * lts_connThread(void *arg)
+{
+    LTS_CONN *conn = (LTS_CONN *)arg;
+    LTS_PEND *pend;
+    char errmsg[BUFSIZ];
+    char r_msgName[7];
+    char recvBuf[BUFSIZ];
+    int sock, msgID, i, connFail = 0, connected = 0;
+
+    pthread_detach(pthread_self());
+    while(1){
+        if((sock = connSocket_unix(ltsFile, errmsg)) == false){
+            /* LTSsvr  ȿ  1ȸ  */
+            if(connFail++ == 0) logMessage(ERROR, errmsg);
+            sleep(LTS_RETRY);
+            continue;
+        }
+        connFail = 0;
+        pthread_mutex_lock(&conn->wmtx);
+        pthread_mutex_lock(&gLtsMtx);
+        conn->sock = sock;
+        if(connected++ > 0) ++gLtsReconn;
+        pthread_mutex_unlock(&gLtsMtx);
+        pthread_mutex_unlock(&conn->wmtx);
+        sprintf(errmsg, "INFO : LTSsvr pool connection[%d] connected", conn->idx);
+        logMessage(INFO, errmsg);
+
+        while(1){
+            memset(r_msgName, 0x00, sizeof(r_msgName));
+            memset(recvBuf, 0x00, sizeof(recvBuf));
+            if(recvMessage(sock, &msgID, r_msgName, recvBuf, errmsg) < 0){
+                break;
+            }
+            pthread_mutex_lock(&gLtsMtx);
+            for(i = 0, pend = NULL; i < LTS_MAXPEND; i++){
+                if(gLtsPend[i].used && gLtsPend[i].done == 0 &&
+                   gLtsPend[i].conn == conn->idx && gLtsPend[i].msgID == msgID){
+                    pend = &gLtsPend[i];
+                    break;
+                }
+            }
+            if(pend != NULL){
+                memcpy(pend->r_msgName, r_msgName, sizeof(r_msgName));
+                memcpy(pend->recvBuf, recvBuf, sizeof(recvBuf));
+                pend->done = 1;
+                pthread_cond_signal(&pend->cond);
+            } else {
+                ++gLtsOrphan;
+            }
+            pthread_mutex_unlock(&gLtsMtx);
+        }
+
+        sprintf(errmsg, "ERROR: LTSsvr pool connection[%d] closed [%s]", conn->idx, strerror(errno));
+        logMessage(ERROR, errmsg);
+        pthread_mutex_lock(&conn->wmtx);
+        pthread_mutex_lock(&gLtsMtx);
+        conn->sock = -1;
+        close(sock);
+        for(i = 0; i < LTS_MAXPEND; i++){
+            if(gLtsPend[i].used && gLtsPend[i].done == 0 && gLtsPend[i].conn == conn->idx){
+                gLtsPend[i].done = -1;
+                pthread_cond_signal(&gLtsPend[i].cond);
+            }
+        }
+        pthread_mutex_unlock(&gLtsMtx);
+        pthread_mutex_unlock(&conn->wmtx);
+    }
+    return NULL;
+}
+
+/*****************************************************************************/
+/* 1. Function Name: lts_poolSendRecv                                        */
+/* 2. Description  :  Ⱑ   pool          */
+/*                   msgID  pool  οϰ  msgID  ¦    */
+/* 3. Parameters   : char *s_msgName - LTSsvr send  message name           */
+/*                   char *sendBuf   - LTSsvr send  message buffer         */
+/*                   char *r_msgName - LTSsvr recv  message name           */
+/*                   char *recvBuf   - LTSsvr recv  message buffer         */
+/*                   char *errMsg    - Error Message                         */
+/* 4. Return Value : true - , false -                                */
+/*                   -1 - pool  Ұ/۽  (û  ó)    */
+/*****************************************************************************/
+int lts_poolSendRecv(char *s_msgName, char *sendBuf, char *r_msgName, char *recvBuf, char *errMsg)
+{
+    LTS_CONN *conn = NULL;
+    LTS_PEND *pend = NULL;
+    struct timespec ts;
+    time_t now;
+    int i, sock, msgID, sent, result, logFlag = 0;
+    char statmsg[BUFSIZ];
+
+    if(gLtsPoolSize == 0) return -1;
+
+    now = time(NULL);
+    pthread_mutex_lock(&gLtsMtx);
+    for(i = 0; i < gLtsPoolSize; i++){
+        if(gLtsConn[i].sock < 0) continue;
+        if(conn == NULL || gLtsConn[i].inflight < conn->inflight) conn = &gLtsConn[i];
+    }
+    for(i = 0; conn != NULL && i < LTS_MAXPEND; i++){
+        if(gLtsPend[i].used == 0){
+            pend = &gLtsPend[i];
+            break;
+        }
+    }
+    if(pend == NULL){
+        pthread_mutex_unlock(&gLtsMtx);
+        return -1;
+    }
+    if(++gLtsMsgID > LTS_MSGID_MAX) gLtsMsgID = 1;
+    msgID = gLtsMsgID;
+    pend->used      = 1;
+    pend->msgID     = msgID;
+    pend->conn      = conn->idx;
+    pend->done      = 0;
+    memset(r_msgName, 0x00, 7);
+    memset(recvBuf, 0x00, BUFSIZ);
+    pend->r_msgName = r_msgName;
+    pend->recvBuf   = recvBuf;
+    conn->inflight++;
+    ++gLtsReq;
+    if(++gLtsInflight > gLtsHigh) gLtsHigh = gLtsInflight;
+    if(now - gLtsStatTime >= DB_STAT_INTERVAL){
+        gLtsStatTime = now;
+        sprintf(statmsg, "INFO : LTSsvr pool inflight[%d] high[%d] req[%ld] direct[%ld] timeout[%ld] fail[%ld] orphan[%ld] reconnect[%ld]",
+                gLtsInflight, gLtsHigh, gLtsReq, gLtsDirect, gLtsTimeout, gLtsFail, gLtsOrphan, gLtsReconn);
+        logFlag = 1;
+    }
+    pthread_mutex_unlock(&gLtsMtx);
+    if(logFlag) logMessage(INFO, statmsg);
+
+    pthread_mutex_lock(&conn->wmtx);
+    if((sock = conn->sock) < 0){
+        /*     : û  ó */
+        sent = -1;
+    } else if(sendMessage(sock, msgID, s_msgName, sendBuf, errMsg) < 0){
+        /*  thread    üϰ Ѵ */
+        shutdown(sock, SHUT_RDWR);
+        sent = false;
+    } else {
+        sent = true;
+    }
+    pthread_mutex_unlock(&conn->wmtx);
+    if(sent == true && logq_ship("->LTSsvr", s_msgName, sendBuf, errMsg) == false){
+        logMessage(ERROR, errMsg);
+    }
+
+    pthread_mutex_lock(&gLtsMtx);
+    if(sent == true){
+        ts.tv_sec  = time(NULL) + LTS_TIMEOUT;
+        ts.tv_nsec = 0;
+        while(pend->done == 0){
+            if(pthread_cond_timedwait(&pend->cond, &gLtsMtx, &ts) == ETIMEDOUT) break;
+        }
+        if(pend->done == 1){
+            result = true;
+        } else if(pend->done == 0){
+            ++gLtsTimeout;
+            sprintf(errMsg, "ERROR: LTSsvr MSG[%-6s] msgID[%d] reply timeout", s_msgName, msgID);
+            result = false;
+        } else {
+            /* ۽      : LTSsvr ó θ   Ƿ
+             * LIPR/LOPR/LLDR  ι ݿ ʰ  ʴ´ */
+            ++gLtsFail;
+            sprintf(errMsg, "ERROR: LTSsvr MSG[%-6s] msgID[%d] connection[%d] closed before reply, outcome unknown", s_msgName, msgID, conn->idx);
+            result = false;
+        }
+    } else {
+        /* ۽  request  û  ó */
+        if(sent == false) ++gLtsFail;
+        result = -1;
+    }
+    pend->used = 0;
+    conn->inflight--;
+    gLtsInflight--;
+    pthread_mutex_unlock(&gLtsMtx);
+
+    if(result != true && errMsg[0] != 0x00){
+        logMessage(ERROR, errMsg);
+        if(result == -1) memset(errMsg, 0x00, BUFSIZ);
+    }
+    return result;
+}
+
+/*****************************************************************************/
+/* 1. Function Name: lts_directSendRecv                                      */
+/* 2. Description  : LTSsvr û   (pool ̻/ Ұ)       */
+/* 3. Parameters   : int   msgID     - message ID                            */
+/*                   char *s_msgName - LTSsvr send  message name           */
+/*                   char *sendBuf   - LTSsvr send  message buffer         */
+/*                   char *r_msgName - LTSsvr recv  message name           */
+/*                   char *recvBuf   - LTSsvr recv  message buffer         */
+/*                   char *errMsg    - Error Message                         */
+/* 4. Return Value : int                                                     */
+/*****************************************************************************/
+int lts_directSendRecv(int msgID, char *s_msgName, char *sendBuf, char *r_msgName, char *recvBuf, char* errMsg)
 {
     int ltssock;
-    int logsock;
     int result;
     int count = 0;
 
-    if ( (logsock = connSocket_unix(logFile, errMsg) ) == false ) {
-		logMessage(errMsg);
-    }
-    memset(errMsg, 0x00, BUFSIZ);
     while(1){
         if ( (ltssock = connSocket_unix(ltsFile, errMsg) ) == false ) {
 		    logMessage(ERROR, errMsg);
     		count++;
     		if(count > RETRY){
-    		    if(logsock >= 0){
-                    close(logsock);
-                }
     		    return false;
     		}
         } else {
@@ -5663,15 +9855,10 @@ int lts_SendRecv(int msgID, char *s_msgName, char *sendBuf, char *r_msgName, cha
     if(result < 0){
         logMessage(ERROR, errMsg);
         close(ltssock);
-        if(logsock >= 0){
-            close(logsock);
-        }
         return false;
     }
-    if(logsock >= 0){
-        if(sendLogMessage(logsock, SERVER_NAME, "->LTSsvr", s_msgName, sendBuf, errMsg) < 0){
-            logMessage(ERROR, errMsg);
-        }
+    if(logq_ship("->LTSsvr", s_msgName, sendBuf, errMsg) == false){
+        logMessage(ERROR, errMsg);
     }
     memset(r_msgName, 0x00, 7);
     memset(recvBuf, 0x00, BUFSIZ);
@@ -5679,70 +9866,13 @@ int lts_SendRecv(int msgID, char *s_msgName, char *sendBuf, char *r_msgName, cha
     if(result < 0){
         logMessage(ERROR, errMsg);
         close(ltssock);
-        if(logsock != false){
-            close(logsock);
-        }
         return false;
     }
     close(ltssock);
-    if(logsock >= 0){
-        if(sendLogMessage(logsock, SERVER_NAME, "<-LTSsvr", r_msgName, recvBuf, errMsg) < 0){
-            logMessage(ERROR, errMsg);
-        }
-    }
-    if(logsock >= 0){
-        close(logsock);
-    }
     return true;
 }
 
 int msgVerify(char msgType)
 {
-    switch(msgType){  
-        case msgTypeConnectRequest :
-        {
-            return true;
-        }
-        case msgTypeCloseRequest :
-        {
-            return true;
-        }
-        case msgTypePTLSensor :
-        {
-            return true;
-        }
-        case msgTypeLTPSensor :
-        {
-            return true;
-        }
-        case msgTypeQuerySensorLoc :
-        {    
-            return true;
-        }
-        case msgTypeReadMemory :
-        {
-            return true;
-        }
-        case msgTypeAssociateUnit :
-        {            
-            return true;
-        }
-        case msgTypeDisassociateUnit :
-        {
-            return true;
-        }
-        case msgTypeDisplayMsg :
-        {
-            return true;
-        }
-        case msgTypeLTPUnit :
-        {
-            return true;
-        }
-        default :
-        {
-            return false;
-        }
-    }
-    return false;
+    return (wire_find(msgType) != NULL) ? true : false;
 }
@@ -1,4 +1,7 @@
+/* STK_NO_COMMON : message structs only (test tools built without common.h) */
+#ifndef STK_NO_COMMON
 #include "common.h"
+#endif
 
 #define logicalNameLen                 24
 #define physicalNameLen                12
@@ -386,4 +389,15 @@ typedef struct _BCRTHREADINFO {
     int sock;
     pthread_t msg_tid;
     pthread_attr_t attr;
-} BCRTHREADINFO;      
\ No newline at end of file
+} BCRTHREADINFO;
+
+/* STK profile (resolved once at rConnect, passed to handlers) */
+typedef struct _STK_PROFILE {
+    int     stkType;                /* LOTPODTYPE / RETICLExxx    */
+    int     parallel;               /* ridian parallel maint      */
+    int     asmlCheck;              /* CRST : ASML interlock      */
+    int     ltsSkip;                /* CPST : LTS in/out skip     */
+    int     podTrans;               /* CPST : Pod ID -> CST ID    */
+    int     emptyLot;               /* CPST : empty cst lookup    */
+    char    stkName[15];
+} STK_PROFILE;
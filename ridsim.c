@@ -0,0 +1,927 @@
+/*****************************************************************************/
+/* 1.System Name  : STKinf (LTS's STK interface processing Server)           */
+/* 2.Program ID   : ridsim.c                                                 */
+/* 3.Description  : Ridian server simulator (STKinf / )        */
+/*                  rid_SendRecv   frame (host order ü,  2 byte */
+/*                   msgLen)  û ޾ ޸ port/tag model    */
+/*                  Ѵ.  û   (FIFO),  , */
+/*                  ̰ Ʋ frame,  byte, ū frame,  ⸦    */
+/*                  Ȯ   ִ                                      */
+/*                  usage : ridsim -p port [-f model] [-n ports] [-l dist]   */
+/*                                 [-s pct:ms] [-S] [-d pct] [-g pct]        */
+/*                                 [-j pct] [-o pct] [-i sec]                */
+/*                    -f model  : PORT <name> <id> [tag] / TAG <tag> [lot]   */
+/*                    -n ports  : PORTnnnn/IRTnnnn/Tnnnnnn/LOTnnnnnn ڵ*/
+/*                    -l dist   : fixed:ms | uniform:min:max | exp:mean      */
+/*                                | lognorm:median:sigma  (ms, ⺻ fixed:0) */
+/*                    -s pct:ms : pct% 信 ms ŭ ߰  (tail)       */
+/*                    -S        :   û ó (⺻  ó)   */
+/*                    -d pct    :                          */
+/*                    -g pct    : ̰ Ʋ  frame                     */
+/*                    -j pct    :  տ frame  ƴ byte         */
+/*                    -o pct    : maxClientMessageLen ũ  frame      */
+/*                    -i sec    :   ֱ (⺻ 10, 0 :  )    */
+/* 4.In/Out Table : None                                                     */
+/* 5.Functions    :                                                          */
+/*    main - ridsim main function                                            */
+/*    sim_usage - usage print function                                       */
+/*    sim_pct - percent option parse function                                */
+/*    sim_parseDist - latency distribution option parse function             */
+/*    sim_hash - model key hash function                                     */
+/*    sim_findPort - model port search function                              */
+/*    sim_findTag - model tag search function                                */
+/*    sim_findLot - model tag search by logical ID function                  */
+/*    sim_addPort - model port add function                                  */
+/*    sim_addTag - model tag add function                                    */
+/*    sim_loadModel - model file load function                               */
+/*    sim_genModel - model generate function                                 */
+/*    sim_reply - request to reply function                                  */
+/*    sim_rand - per thread uniform random function                          */
+/*    sim_delay - latency sample function                                    */
+/*    sim_readn - socket n byte read function                                */
+/*    sim_writen - socket n byte write function                              */
+/*    sim_connThread - connection read thread function                       */
+/*    sim_sendThread - connection reply write thread function                */
+/*    sim_statThread - statistics print thread function                      */
+/* 6.Notification :                                                          */
+/*                  build : gcc -O2 -o ridsim ridsim.c -lpthread -lm         */
+/*****************************************************************************/
+
+/*---------------------------------------------------------------------------*/
+/* System Include Files                                                      */
+/*---------------------------------------------------------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <math.h>
+#include <time.h>
+#include <unistd.h>
+#include <signal.h>
+#include <pthread.h>
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <arpa/inet.h>
+/*---------------------------------------------------------------------------*/
+/* Application Include Files                                                 */
+/*---------------------------------------------------------------------------*/
+/* message ü Ƿ common.h  build Ѵ. BIG/LITTLE_ENDIAN 
+ * msgstruct.h  ٸ  ϹǷ system Ǹ  */
+#define STK_NO_COMMON
+#undef  BIG_ENDIAN
+#undef  LITTLE_ENDIAN
+#include "msgstruct.h"
+/*---------------------------------------------------------------------------*/
+/* Constants, Macro Declaration                                              */
+/*---------------------------------------------------------------------------*/
+#ifndef true
+#define true                1
+#define false               0
+#endif
+#define HEADERSIZE          3
+#define TYPEBYTE            2
+#define LENGTHSIZE          2
+
+#define SIM_MAXPORT         65536       /* model port ִ           */
+#define SIM_MAXTAG          65536       /* model tag ִ            */
+#define SIM_HASH            131072      /* hash bucket  (2^n)      */
+#define SIM_MAXQ            256         /*    ִ     */
+#define SIM_REPMAX          512         /* Ϲ  ִ ũ       */
+#define SIM_MAXTYPE         128
+
+#define DIST_FIXED          0
+#define DIST_UNIFORM        1
+#define DIST_EXP            2
+#define DIST_LOGNORM        3
+
+#define FAULT_NONE          0
+#define FAULT_DROP          1           /*                   */
+#define FAULT_GARBAGE       2           /* ̰ Ʋ           */
+#define FAULT_JUNK          3           /* frame   byte      */
+#define FAULT_OVERSIZE      4           /* ū  frame             */
+
+/*---------------------------------------------------------------------------*/
+/* Structure Declaration                                                     */
+/*---------------------------------------------------------------------------*/
+typedef struct _SIM_PORT {
+    char   name[logicalNameLen+1];      /* port ̸ (IRT name)      */
+    char   id[physicalNameLen+1];       /* IRT ID                    */
+    char   tag[physicalNameLen+1];      /* port  ִ tag ( "") */
+    int    next;                        /* hash chain                */
+} SIM_PORT;
+
+typedef struct _SIM_TAG {
+    char   id[physicalNameLen+1];       /* tag ID                    */
+    char   lot[logicalNameLen+1];       /*  logical ID         */
+    int    next;                        /* tag hash chain            */
+} SIM_TAG;
+
+typedef struct _SIM_DIST {
+    int    kind;                        /* DIST_xxx                  */
+    double a;
+    double b;
+} SIM_DIST;
+
+/*   ׸. due  Ǹ sim_sendThread    */
+typedef struct _SIM_REP {
+    struct timespec due;
+    int    len;
+    int    fault;                       /* FAULT_xxx                 */
+    char   buf[SIM_REPMAX];
+} SIM_REP;
+
+typedef struct _SIM_CONN {
+    int    sock;
+    int    closed;                      /* 1 :               */
+    int    ref;                         /*  thread   free  */
+    int    head;
+    int    cnt;
+    struct timespec last;               /*    due      */
+    pthread_mutex_t mtx;
+    pthread_cond_t  cond;
+    SIM_REP q[SIM_MAXQ];
+} SIM_CONN;
+
+/*---------------------------------------------------------------------------*/
+/* Function Declaration                                                      */
+/*---------------------------------------------------------------------------*/
+void sim_usage(char *);
+int sim_pct(char *, double *);
+int sim_parseDist(char *, SIM_DIST *);
+unsigned int sim_hash(char *);
+SIM_PORT * sim_findPort(char *);
+SIM_TAG * sim_findTag(char *);
+SIM_TAG * sim_findLot(char *);
+SIM_PORT * sim_addPort(char *, char *, char *);
+SIM_TAG * sim_addTag(char *, char *);
+int sim_loadModel(char *);
+void sim_genModel(int );
+int sim_reply(char *, char *);
+double sim_rand(unsigned int *);
+double sim_delay(unsigned int *);
+int sim_readn(int , char *, int );
+int sim_writen(int , char *, int );
+void * sim_connThread(void *arg);
+void * sim_sendThread(void *arg);
+void * sim_statThread(void *arg);
+
+/*---------------------------------------------------------------------------*/
+/* Global Variable Declaration                                               */
+/*---------------------------------------------------------------------------*/
+SIM_PORT *gPort;                        /* model port                */
+SIM_TAG  *gTag;                         /* model tag                 */
+int  gPortCnt = 0;
+int  gTagCnt  = 0;
+int  *gPortHash;                        /* port name -> gPort index  */
+int  *gTagHash;                         /* tag ID -> gTag index      */
+pthread_mutex_t gModelMtx = PTHREAD_MUTEX_INITIALIZER;
+
+SIM_DIST gDist = { DIST_FIXED, 0, 0 };  /* -l                        */
+double gSpikePct = 0;                   /* -s pct                    */
+double gSpikeMs  = 0;                   /* -s ms                     */
+int    gSerial   = 0;                   /* -S                        */
+double gDropPct  = 0;                   /* -d                        */
+double gGarbPct  = 0;                   /* -g                        */
+double gJunkPct  = 0;                   /* -j                        */
+double gOverPct  = 0;                   /* -o                        */
+int    gStatIntv = 10;                  /* -i                        */
+
+long gReq[SIM_MAXTYPE];                 /* type  û            */
+long gConnCnt = 0;                      /*                 */
+long gAccept  = 0;
+long gFault[5];                         /* FAULT_xxx  ߻       */
+long gBadReq  = 0;                      /* 𸣴 type/ û     */
+
+/*****************************************************************************/
+/* 1.Function Name: main                                                     */
+/* 2.Description  : option/model  а listen Ͽ Ḷ thread     */
+/* 3.Parameters   : int argc, char *argv[]                                   */
+/* 4.Return Value : int                                                      */
+/*****************************************************************************/
+int main(int argc, char *argv[])
+{
+    int  port = 0, genPorts = 0, opt, lsock, csock, on = 1;
+    char *model = NULL;
+    struct sockaddr_in addr;
+    SIM_CONN *conn;
+    pthread_t tid;
+    char *p;
+
+    while((opt = getopt(argc, argv, "p:f:n:l:s:Sd:g:j:o:i:")) != -1){
+        switch(opt){
+            case 'p' : port = atoi(optarg);                     break;
+            case 'f' : model = optarg;                          break;
+            case 'n' : genPorts = atoi(optarg);                 break;
+            case 'S' : gSerial = 1;                             break;
+            case 'i' : gStatIntv = atoi(optarg);                break;
+            case 'l' :
+                if(sim_parseDist(optarg, &gDist) == false) sim_usage(argv[0]);
+                break;
+            case 's' :
+                if((p = strchr(optarg, ':')) == NULL) sim_usage(argv[0]);
+                *p = 0x00;
+                if(sim_pct(optarg, &gSpikePct) == false) sim_usage(argv[0]);
+                gSpikeMs = atof(p + 1);
+                break;
+            case 'd' : if(sim_pct(optarg, &gDropPct) == false) sim_usage(argv[0]); break;
+            case 'g' : if(sim_pct(optarg, &gGarbPct) == false) sim_usage(argv[0]); break;
+            case 'j' : if(sim_pct(optarg, &gJunkPct) == false) sim_usage(argv[0]); break;
+            case 'o' : if(sim_pct(optarg, &gOverPct) == false) sim_usage(argv[0]); break;
+            default  : sim_usage(argv[0]);
+        }
+    }
+    if(port <= 0) sim_usage(argv[0]);
+
+    gPort     = (SIM_PORT *)calloc(SIM_MAXPORT, sizeof(SIM_PORT));
+    gTag      = (SIM_TAG *)calloc(SIM_MAXTAG, sizeof(SIM_TAG));
+    gPortHash = (int *)malloc(sizeof(int) * SIM_HASH);
+    gTagHash  = (int *)malloc(sizeof(int) * SIM_HASH);
+    if(gPort == NULL || gTag == NULL || gPortHash == NULL || gTagHash == NULL){
+        fprintf(stderr, "ERROR: model memory alloc fail\n");
+        return 1;
+    }
+    memset(gPortHash, -1, sizeof(int) * SIM_HASH);
+    memset(gTagHash, -1, sizeof(int) * SIM_HASH);
+
+    if(model != NULL && sim_loadModel(model) == false) return 1;
+    if(genPorts > 0) sim_genModel(genPorts);
+    printf("INFO : ridsim model PORT[%d] TAG[%d]\n", gPortCnt, gTagCnt);
+
+    signal(SIGPIPE, SIG_IGN);
+    if((lsock = socket(AF_INET, SOCK_STREAM, 0)) < 0){
+        fprintf(stderr, "ERROR: socket create fail errno[%d]\n", errno);
+        return 1;
+    }
+    setsockopt(lsock, SOL_SOCKET, SO_REUSEADDR, &on, sizeof(on));
+    memset(&addr, 0x00, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(port);
+    addr.sin_addr.s_addr = htonl(INADDR_ANY);
+    if(bind(lsock, (struct sockaddr *)&addr, sizeof(addr)) < 0 || listen(lsock, 128) < 0){
+        fprintf(stderr, "ERROR: PORT[%d] bind/listen fail errno[%d]\n", port, errno);
+        return 1;
+    }
+    printf("INFO : ridsim listen PORT[%d]\n", port);
+    fflush(stdout);
+
+    if(gStatIntv > 0 && pthread_create(&tid, NULL, sim_statThread, NULL) == 0){
+        pthread_detach(tid);
+    }
+    while(1){
+        if((csock = accept(lsock, NULL, NULL)) < 0){
+            if(errno != EINTR) sleep(1);
+            continue;
+        }
+        setsockopt(csock, IPPROTO_TCP, TCP_NODELAY, &on, sizeof(on));
+        if((conn = (SIM_CONN *)calloc(1, sizeof(SIM_CONN))) == NULL){
+            close(csock);
+            continue;
+        }
+        conn->sock = csock;
+        conn->ref  = 2;
+        pthread_mutex_init(&conn->mtx, NULL);
+        pthread_cond_init(&conn->cond, NULL);
+        if(pthread_create(&tid, NULL, sim_sendThread, (void *)conn) != 0){
+            close(csock);
+            free(conn);
+            continue;
+        }
+        pthread_detach(tid);
+        if(pthread_create(&tid, NULL, sim_connThread, (void *)conn) != 0){
+            /* send thread  closed   Ѵ */
+            pthread_mutex_lock(&conn->mtx);
+            conn->closed = 1;
+            conn->ref--;
+            pthread_cond_signal(&conn->cond);
+            pthread_mutex_unlock(&conn->mtx);
+            continue;
+        }
+        pthread_detach(tid);
+        __sync_fetch_and_add(&gAccept, 1);
+        __sync_fetch_and_add(&gConnCnt, 1);
+    }
+    return 0;
+}
+
+/*****************************************************************************/
+/* 1.Function Name: sim_usage                                                */
+/* 2.Description  : usage                                          */
+/* 3.Parameters   : char *prog       - program ̸                          */
+/* 4.Return Value : None                                                     */
+/*****************************************************************************/
+void sim_usage(char *prog)
+{
+    fprintf(stderr, "usage : %s -p port [-f model] [-n ports] [-l dist] [-s pct:ms] [-S]\n"
+                    "          [-d pct] [-g pct] [-j pct] [-o pct] [-i sec]\n"
+                    "  dist : fixed:ms | uniform:min:max | exp:mean | lognorm:median:sigma\n", prog);
+    exit(1);
+}
+
+/*****************************************************************************/
+/* 1.Function Name: sim_pct                                                  */
+/* 2.Description  : 0~100 percent option ؼ                                */
+/* 3.Parameters   : char *s          - option ڿ                         */
+/*                  double *pct      -                                   */
+/* 4.Return Value : true - , false -                             */
+/*****************************************************************************/
+int sim_pct(char *s, double *pct)
+{
+    *pct = atof(s);
+    return (*pct >= 0 && *pct <= 100) ? true : false;
+}
+
+/*****************************************************************************/
+/* 1.Function Name: sim_parseDist                                            */
+/* 2.Description  : -l   option ؼ ( ms)                       */
+/* 3.Parameters   : char *s          - option ڿ                         */
+/*                  SIM_DIST *d      -                                   */
+/* 4.Return Value : true - , false -                             */
+/*****************************************************************************/
+int sim_parseDist(char *s, SIM_DIST *d)
+{
+    memset(d, 0x00, sizeof(SIM_DIST));
+    if(sscanf(s, "fixed:%lf", &d->a) == 1){
+        d->kind = DIST_FIXED;
+    } else if(sscanf(s, "uniform:%lf:%lf", &d->a, &d->b) == 2 && d->a <= d->b){
+        d->kind = DIST_UNIFORM;
+    } else if(sscanf(s, "exp:%lf", &d->a) == 1){
+        d->kind = DIST_EXP;
+    } else if(sscanf(s, "lognorm:%lf:%lf", &d->a, &d->b) == 2){
+        d->kind = DIST_LOGNORM;
+    } else {
+        return false;
+    }
+    return (d->a >= 0 && d->b >= 0) ? true : false;
+}
+
+/*****************************************************************************/
+/* 1.Function Name: sim_hash                                                 */
+/* 2.Description  : model key ( ձ) hash                             */
+/* 3.Parameters   : char *key        - port ̸ Ǵ tag ID                 */
+/* 4.Return Value : unsigned int - bucket                                    */
+/*****************************************************************************/
+unsigned int sim_hash(char *key)
+{
+    unsigned int h = 2166136261u;
+
+    for(; *key != 0x00 && *key != ' '; key++){
+        h = (h ^ (unsigned char)*key) * 16777619u;
+    }
+    return h & (SIM_HASH - 1);
+}
+
+/*****************************************************************************/
+/* 1.Function Name: sim_findPort                                             */
+/* 2.Description  : port ̸ model port ˻                            */
+/* 3.Parameters   : char *name       - port ̸                             */
+/* 4.Return Value : SIM_PORT * - port, NULL -                            */
+/*****************************************************************************/
+SIM_PORT * sim_findPort(char *name)
+{
+    int i;
+
+    for(i = gPortHash[sim_hash(name)]; i >= 0; i = gPort[i].next){
+        if(strcmp(gPort[i].name, name) == 0) return &gPort[i];
+    }
+    return NULL;
+}
+
+/*****************************************************************************/
+/* 1.Function Name: sim_findTag                                              */
+/* 2.Description  : tag ID  model tag ˻                                 */
+/* 3.Parameters   : char *id         - tag ID                                */
+/* 4.Return Value : SIM_TAG * - tag, NULL -                              */
+/*****************************************************************************/
+SIM_TAG * sim_findTag(char *id)
+{
+    int i;
+
+    for(i = gTagHash[sim_hash(id)]; i >= 0; i = gTag[i].next){
+        if(strcmp(gTag[i].id, id) == 0) return &gTag[i];
+    }
+    return NULL;
+}
+
+/*****************************************************************************/
+/* 1.Function Name: sim_findLot                                              */
+/* 2.Description  : logical ID   tag ˻ (rLogicalToPhysicalUnit,   */
+/*                  rDisassociateUnit ,  Ը  ˻)             */
+/* 3.Parameters   : char *lot        - logical ID                            */
+/* 4.Return Value : SIM_TAG * - tag, NULL -                              */
+/*****************************************************************************/
+SIM_TAG * sim_findLot(char *lot)
+{
+    int i;
+
+    if(lot[0] == 0x00) return NULL;
+    for(i = 0; i < gTagCnt; i++){
+        if(strcmp(gTag[i].lot, lot) == 0) return &gTag[i];
+    }
+    return NULL;
+}
+
+/*****************************************************************************/
+/* 1.Function Name: sim_addPort                                              */
+/* 2.Description  : model  port ߰ ( ̸̸ )                  */
+/* 3.Parameters   : char *name, char *id, char *tag (NULL )              */
+/* 4.Return Value : SIM_PORT * - port, NULL - model                    */
+/*****************************************************************************/
+SIM_PORT * sim_addPort(char *name, char *id, char *tag)
+{
+    SIM_PORT *pt;
+    unsigned int h;
+
+    if((pt = sim_findPort(name)) == NULL){
+        if(gPortCnt >= SIM_MAXPORT) return NULL;
+        pt = &gPort[gPortCnt];
+        strncpy(pt->name, name, logicalNameLen);
+        h = sim_hash(name);
+        pt->next = gPortHash[h];
+        gPortHash[h] = gPortCnt++;
+    }
+    strncpy(pt->id, id, physicalNameLen);
+    if(tag != NULL){
+        strncpy(pt->tag, tag, physicalNameLen);
+        if(sim_findTag(tag) == NULL) sim_addTag(tag, NULL);
+    }
+    return pt;
+}
+
+/*****************************************************************************/
+/* 1.Function Name: sim_addTag                                               */
+/* 2.Description  : model  tag ߰ ( ID  logical ID )           */
+/* 3.Parameters   : char *id, char *lot (NULL )                          */
+/* 4.Return Value : SIM_TAG * - tag, NULL - model                      */
+/*****************************************************************************/
+SIM_TAG * sim_addTag(char *id, char *lot)
+{
+    SIM_TAG *tg;
+    unsigned int h;
+
+    if((tg = sim_findTag(id)) == NULL){
+        if(gTagCnt >= SIM_MAXTAG) return NULL;
+        tg = &gTag[gTagCnt];
+        strncpy(tg->id, id, physicalNameLen);
+        h = sim_hash(id);
+        tg->next = gTagHash[h];
+        gTagHash[h] = gTagCnt++;
+    }
+    if(lot != NULL){
+        strncpy(tg->lot, lot, logicalNameLen);
+    }
+    return tg;
+}
+
+/*****************************************************************************/
+/* 1.Function Name: sim_loadModel                                            */
+/* 2.Description  : model file . '#'  ּ                             */
+/*                    PORT <port ̸> <IRT ID> [tag ID]                     */
+/*                    TAG  <tag ID> [logical ID]                             */
+/* 3.Parameters   : char *file       - model file                            */
+/* 4.Return Value : true - , false -                                 */
+/*****************************************************************************/
+int sim_loadModel(char *file)
+{
+    FILE *fp;
+    char line[256], kind[16], a[64], b[64], c[64];
+    int  n, lineNo = 0;
+
+    if((fp = fopen(file, "r")) == NULL){
+        fprintf(stderr, "ERROR: model file [%s] open fail errno[%d]\n", file, errno);
+        return false;
+    }
+    while(fgets(line, sizeof(line), fp) != NULL){
+        lineNo++;
+        if(line[0] == '#' || line[0] == '\n') continue;
+        n = sscanf(line, "%15s %63s %63s %63s", kind, a, b, c);
+        if(n >= 3 && strcmp(kind, "PORT") == 0){
+            if(sim_addPort(a, b, (n == 4) ? c : NULL) == NULL) break;
+        } else if(n >= 2 && strcmp(kind, "TAG") == 0){
+            if(sim_addTag(a, (n >= 3) ? b : NULL) == NULL) break;
+        } else {
+            fprintf(stderr, "ERROR: model file [%s] line[%d] invalid\n", file, lineNo);
+            fclose(fp);
+            return false;
+        }
+    }
+    fclose(fp);
+    return true;
+}
+
+/*****************************************************************************/
+/* 1.Function Name: sim_genModel                                             */
+/* 2.Description  :   model . port i  tag i  ְ tag i  */
+/*                  LOTi  Ǿ ִ                                    */
+/* 3.Parameters   : int n            - port                                */
+/* 4.Return Value : None                                                     */
+/*****************************************************************************/
+void sim_genModel(int n)
+{
+    char name[32], id[32], tag[32], lot[32];
+    int i;
+
+    for(i = 0; i < n; i++){
+        sprintf(name, "PORT%04d", i);
+        sprintf(id, "IRT%04d", i);
+        sprintf(tag, "T%06d", i);
+        sprintf(lot, "LOT%06d", i);
+        if(sim_addTag(tag, lot) == NULL || sim_addPort(name, id, tag) == NULL) break;
+    }
+}
+
+/*****************************************************************************/
+/* 1.Function Name: sim_reply                                                */
+/* 2.Description  : host order û  host order                */
+/*                  model  (associate/disassociate)  gModelMtx ȿ  */
+/* 3.Parameters   : char *req        - û frame                            */
+/*                  char *rep        -  (SIM_REPMAX)                     */
+/* 4.Return Value : int -  , -1 - 𸣴 û                        */
+/*****************************************************************************/
+int sim_reply(char *req, char *rep)
+{
+    unsigned char type = (unsigned char)req[TYPEBYTE];
+    SIM_PORT *pt;
+    SIM_TAG *tg;
+
+    memset(rep, 0x00, SIM_REPMAX);
+    pthread_mutex_lock(&gModelMtx);
+    switch(type){
+        case msgTypeLTPSensor :
+        {
+            rGenRequest *rq = (rGenRequest *)req;
+            rGenReply *rp = (rGenReply *)rep;
+            rp->msgLen  = sizeof(rGenReply);
+            rp->msgType = type;
+            memcpy(rp->logicalName, rq->logicalName, sizeof(rp->logicalName));
+            if((pt = sim_findPort(rq->logicalName)) == NULL){
+                rp->result = 1;
+            } else {
+                strcpy(rp->physicalID, pt->id);
+            }
+            break;
+        }
+        case msgTypeQuerySensorLoc :
+        {
+            rQuerySensorRequest *rq = (rQuerySensorRequest *)req;
+            rQuerySensorReply *rp = (rQuerySensorReply *)rep;
+            rp->msgLen   = sizeof(rQuerySensorReply);
+            rp->msgType  = type;
+            rp->lastFlag = 1;
+            rp->totalNum = 1;
+            rp->numItems = 1;
+            rp->responseMsg.unittype = 1;
+            rp->responseMsg.unitCategory = 1;
+            rp->responseMsg.sensorCategory = 1;
+            rp->responseMsg.updateTime = time(NULL);
+            rp->responseMsg.moveTime   = rp->responseMsg.updateTime;
+            rp->responseMsg.motionTime = rp->responseMsg.updateTime;
+            snprintf(rp->responseMsg.sensorName, logicalNameLen + 1, "%.*s", logicalNameLen, rq->nameList.name);
+            if((pt = sim_findPort(rq->nameList.name)) != NULL){
+                strcpy(rp->responseMsg.sensorID, pt->id);
+                strcpy(rp->responseMsg.unitID, pt->tag);
+                if(pt->tag[0] != 0x00 && (tg = sim_findTag(pt->tag)) != NULL){
+                    strcpy(rp->responseMsg.unitName, tg->lot);
+                }
+            }
+            break;
+        }
+        case msgTypeLTPUnit :
+        {
+            rGenRequest *rq = (rGenRequest *)req;
+            rGenReply *rp = (rGenReply *)rep;
+            rp->msgLen  = sizeof(rGenReply);
+            rp->msgType = type;
+            memcpy(rp->logicalName, rq->logicalName, sizeof(rp->logicalName));
+            if((tg = sim_findLot(rq->logicalName)) == NULL){
+                rp->result = 1;
+            } else {
+                strcpy(rp->physicalID, tg->id);
+            }
+            break;
+        }
+        case msgTypeAssociateUnit :
+        {
+            rGenRequest *rq = (rGenRequest *)req;
+            rGenReply *rp = (rGenReply *)rep;
+            rp->msgLen  = sizeof(rGenReply);
+            rp->msgType = type;
+            memcpy(rp->physicalID, rq->physicalID, sizeof(rp->physicalID));
+            memcpy(rp->logicalName, rq->logicalName, sizeof(rp->logicalName));
+            /*  logical ID  ٸ tag   ű */
+            if((tg = sim_findLot(rq->logicalName)) != NULL) tg->lot[0] = 0x00;
+            if(sim_addTag(rq->physicalID, rq->logicalName) == NULL) rp->result = 1;
+            break;
+        }
+        case msgTypeDisassociateUnit :
+        {
+            rGenRequest *rq = (rGenRequest *)req;
+            rGenReply *rp = (rGenReply *)rep;
+            rp->msgLen  = sizeof(rGenReply);
+            rp->msgType = type;
+            memcpy(rp->logicalName, rq->logicalName, sizeof(rp->logicalName));
+            if((tg = sim_findLot(rq->logicalName)) == NULL){
+                rp->result = 1;
+            } else {
+                strcpy(rp->physicalID, tg->id);
+                tg->lot[0] = 0x00;
+            }
+            break;
+        }
+        case msgTypeDisplayMsg :
+        case msgTypeCloseRequest :
+        {
+            rSimpleReply *rp = (rSimpleReply *)rep;
+            rp->msgLen   = sizeof(rSimpleReply);
+            rp->msgType  = type;
+            rp->numItems = (type == msgTypeDisplayMsg) ? 1 : 0;
+            break;
+        }
+        default :
+        {
+            pthread_mutex_unlock(&gModelMtx);
+            return -1;
+        }
+    }
+    pthread_mutex_unlock(&gModelMtx);
+    return ((rSimpleReply *)rep)->msgLen;
+}
+
+/*****************************************************************************/
+/* 1.Function Name: sim_rand                                                 */
+/* 2.Description  : thread  seed  (0,1) յ                         */
+/* 3.Parameters   : unsigned int *seed - thread seed                         */
+/* 4.Return Value : double                                                   */
+/*****************************************************************************/
+double sim_rand(unsigned int *seed)
+{
+    return ((double)rand_r(seed) + 1.0) / ((double)RAND_MAX + 2.0);
+}
+
+/*****************************************************************************/
+/* 1.Function Name: sim_delay                                                */
+/* 2.Description  : -l  -s tail    ϳ ̴´             */
+/* 3.Parameters   : unsigned int *seed - thread seed                         */
+/* 4.Return Value : double -  (ms)                                       */
+/*****************************************************************************/
+double sim_delay(unsigned int *seed)
+{
+    double ms = 0, u1, u2;
+
+    switch(gDist.kind){
+        case DIST_FIXED :
+            ms = gDist.a;
+            break;
+        case DIST_UNIFORM :
+            ms = gDist.a + (gDist.b - gDist.a) * sim_rand(seed);
+            break;
+        case DIST_EXP :
+            ms = -gDist.a * log(sim_rand(seed));
+            break;
+        case DIST_LOGNORM :
+            u1 = sim_rand(seed);
+            u2 = sim_rand(seed);
+            ms = gDist.a * exp(gDist.b * sqrt(-2.0 * log(u1)) * cos(2.0 * M_PI * u2));
+            break;
+    }
+    if(gSpikePct > 0 && sim_rand(seed) * 100 < gSpikePct){
+        ms += gSpikeMs;
+    }
+    return ms;
+}
+
+/*****************************************************************************/
+/* 1.Function Name: sim_readn                                                */
+/* 2.Description  : n byte   д´                                    */
+/* 3.Parameters   : int sock, char *buf, int n                               */
+/* 4.Return Value : true - , false -  /                      */
+/*****************************************************************************/
+int sim_readn(int sock, char *buf, int n)
+{
+    int r;
+
+    while(n > 0){
+        if((r = recv(sock, buf, n, 0)) <= 0){
+            if(r < 0 && errno == EINTR) continue;
+            return false;
+        }
+        buf += r;
+        n -= r;
+    }
+    return true;
+}
+
+/*****************************************************************************/
+/* 1.Function Name: sim_writen                                               */
+/* 2.Description  : n byte                                         */
+/* 3.Parameters   : int sock, char *buf, int n                               */
+/* 4.Return Value : true - , false -                                 */
+/*****************************************************************************/
+int sim_writen(int sock, char *buf, int n)
+{
+    int r;
+
+    while(n > 0){
+        if((r = send(sock, buf, n, 0)) <= 0){
+            if(r < 0 && errno == EINTR) continue;
+            return false;
+        }
+        buf += r;
+        n -= r;
+    }
+    return true;
+}
+
+/*****************************************************************************/
+/* 1.Function Name: sim_connThread                                           */
+/* 2.Description  :  û о  ,  fault     */
+/*                   queue  ִ´. ⺻ û   帣 */
+/*                  ( ó), -S     ں  帥   */
+/* 3.Parameters   : void *arg        - SIM_CONN                              */
+/* 4.Return Value : None                                                     */
+/*****************************************************************************/
+void * sim_connThread(void *arg)
+{
+    SIM_CONN *c = (SIM_CONN *)arg;
+    char req[maxClientMessageLen];
+    unsigned short msgLen;
+    unsigned int seed = (unsigned int)time(NULL) ^ (unsigned int)c->sock;
+    struct timespec now, base;
+    SIM_REP *r;
+    double ms, u;
+    long ns;
+
+    while(1){
+        if(sim_readn(c->sock, req, HEADERSIZE) == false) break;
+        memcpy(&msgLen, req, LENGTHSIZE);
+        if(msgLen < HEADERSIZE || msgLen > sizeof(req)){
+            __sync_fetch_and_add(&gBadReq, 1);
+            break;
+        }
+        if(sim_readn(c->sock, req + HEADERSIZE, msgLen - HEADERSIZE) == false) break;
+        __sync_fetch_and_add(&gReq[(unsigned char)req[TYPEBYTE] % SIM_MAXTYPE], 1);
+
+        pthread_mutex_lock(&c->mtx);
+        while(c->cnt >= SIM_MAXQ && c->closed == 0){
+            pthread_cond_wait(&c->cond, &c->mtx);
+        }
+        if(c->closed){
+            pthread_mutex_unlock(&c->mtx);
+            break;
+        }
+        r = &c->q[(c->head + c->cnt) % SIM_MAXQ];
+        pthread_mutex_unlock(&c->mtx);
+
+        if((r->len = sim_reply(req, r->buf)) < 0){
+            __sync_fetch_and_add(&gBadReq, 1);
+            break;
+        }
+        u = sim_rand(&seed) * 100;
+        r->fault = FAULT_NONE;
+        if((u -= gDropPct) < 0)        r->fault = FAULT_DROP;
+        else if((u -= gGarbPct) < 0)   r->fault = FAULT_GARBAGE;
+        else if((u -= gJunkPct) < 0)   r->fault = FAULT_JUNK;
+        else if((u -= gOverPct) < 0)   r->fault = FAULT_OVERSIZE;
+
+        clock_gettime(CLOCK_MONOTONIC, &now);
+        base = now;
+        if(gSerial && (c->last.tv_sec > now.tv_sec ||
+                      (c->last.tv_sec == now.tv_sec && c->last.tv_nsec > now.tv_nsec))){
+            base = c->last;
+        }
+        ms = sim_delay(&seed);
+        ns = base.tv_nsec + (long)(ms * 1000000);
+        r->due.tv_sec  = base.tv_sec + ns / 1000000000;
+        r->due.tv_nsec = ns % 1000000000;
+        c->last = r->due;
+
+        pthread_mutex_lock(&c->mtx);
+        c->cnt++;
+        pthread_cond_signal(&c->cond);
+        pthread_mutex_unlock(&c->mtx);
+        if(req[TYPEBYTE] == msgTypeCloseRequest) break;
+    }
+
+    pthread_mutex_lock(&c->mtx);
+    c->closed = 1;
+    pthread_cond_broadcast(&c->cond);
+    if(--c->ref == 0){
+        pthread_mutex_unlock(&c->mtx);
+        free(c);
+    } else {
+        pthread_mutex_unlock(&c->mtx);
+    }
+    return NULL;
+}
+
+/*****************************************************************************/
+/* 1.Function Name: sim_sendThread                                           */
+/* 2.Description  :  queue   due ð  (FIFO). fault   */
+/*                     ϸ,           */
+/* 3.Parameters   : void *arg        - SIM_CONN                              */
+/* 4.Return Value : None                                                     */
+/*****************************************************************************/
+void * sim_sendThread(void *arg)
+{
+    SIM_CONN *c = (SIM_CONN *)arg;
+    static char over[maxClientMessageLen];
+    char junk[32];
+    unsigned int seed = (unsigned int)time(NULL) ^ ((unsigned int)c->sock << 8);
+    unsigned short len;
+    SIM_REP *r;
+    int i, n, ok = true, bye = false;
+
+    while(ok && !bye){
+        pthread_mutex_lock(&c->mtx);
+        while(c->cnt == 0 && c->closed == 0){
+            pthread_cond_wait(&c->cond, &c->mtx);
+        }
+        if(c->cnt == 0){
+            pthread_mutex_unlock(&c->mtx);
+            break;
+        }
+        r = &c->q[c->head];
+        pthread_mutex_unlock(&c->mtx);
+
+        while(clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &r->due, NULL) == EINTR);
+
+        __sync_fetch_and_add(&gFault[r->fault], 1);
+        switch(r->fault){
+            case FAULT_DROP :
+                ok = false;
+                break;
+            case FAULT_GARBAGE :
+                /* type  ° ̸ ٸ frame */
+                len = r->len + 1 + rand_r(&seed) % 16;
+                memcpy(r->buf, &len, LENGTHSIZE);
+                for(i = r->len; i < len && i < SIM_REPMAX; i++) r->buf[i] = rand_r(&seed);
+                ok = sim_writen(c->sock, r->buf, len);
+                break;
+            case FAULT_JUNK :
+                n = 1 + rand_r(&seed) % sizeof(junk);
+                for(i = 0; i < n; i++) junk[i] = rand_r(&seed);
+                ok = sim_writen(c->sock, junk, n) && sim_writen(c->sock, r->buf, r->len);
+                break;
+            case FAULT_OVERSIZE :
+                len = maxClientMessageLen;
+                memcpy(over, &len, LENGTHSIZE);
+                over[TYPEBYTE] = r->buf[TYPEBYTE];
+                ok = sim_writen(c->sock, over, len);
+                break;
+            default :
+                ok = sim_writen(c->sock, r->buf, r->len);
+                break;
+        }
+        if(r->buf[TYPEBYTE] == msgTypeCloseRequest) bye = true;
+
+        pthread_mutex_lock(&c->mtx);
+        c->head = (c->head + 1) % SIM_MAXQ;
+        c->cnt--;
+        pthread_cond_signal(&c->cond);
+        pthread_mutex_unlock(&c->mtx);
+    }
+
+    /*  thread    ϰ  ݴ´ */
+    shutdown(c->sock, SHUT_RDWR);
+    pthread_mutex_lock(&c->mtx);
+    c->closed = 1;
+    pthread_cond_broadcast(&c->cond);
+    close(c->sock);
+    __sync_fetch_and_sub(&gConnCnt, 1);
+    if(--c->ref == 0){
+        pthread_mutex_unlock(&c->mtx);
+        free(c);
+    } else {
+        pthread_mutex_unlock(&c->mtx);
+    }
+    return NULL;
+}
+
+/*****************************************************************************/
+/* 1.Function Name: sim_statThread                                           */
+/* 2.Description  : -i ֱ  , type  û , fault          */
+/* 3.Parameters   : void *arg        - ̻                                */
+/* 4.Return Value : None                                                     */
+/*****************************************************************************/
+void * sim_statThread(void *arg)
+{
+    char line[1024];
+    int i, len;
+
+    (void)arg;
+
+    while(1){
+        sleep(gStatIntv);
+        len = sprintf(line, "STAT : CONN[%ld] ACCEPT[%ld] BAD[%ld]", gConnCnt, gAccept, gBadReq);
+        for(i = 0; i < SIM_MAXTYPE; i++){
+            if(gReq[i] == 0) continue;
+            len += sprintf(line + len, " T%d[%ld]", i, gReq[i]);
+        }
+        sprintf(line + len, " DROP[%ld] GARBAGE[%ld] JUNK[%ld] OVERSIZE[%ld]",
+                gFault[FAULT_DROP], gFault[FAULT_GARBAGE], gFault[FAULT_JUNK], gFault[FAULT_OVERSIZE]);
+        printf("%s\n", line);
+        fflush(stdout);
+    }
+    return NULL;
+}
@@ -0,0 +1,690 @@
+/*****************************************************************************/
+/* 1.System Name  : STKinf (LTS's STK interface processing Server)           */
+/* 2.Program ID   : stkload.c                                                */
+/* 3.Description  : Stocker fleet load generator (STKinf  )        */
+/*                  N   STK  STKinf main port  Ͽ  STK */
+/*                     big-endian û                   */
+/*                    rConnect                                               */
+/*                    (carrier ) rPhysicalToLogicalSensor ->             */
+/*                    rListUnitAtIrt -> rReadMemory 0x400~0x490 ->           */
+/*                    [RETICLE] rAssociateUnit -> rDisplayMsg                */
+/*                    rClose                                                 */
+/*                  STKinf   IP  STK type  ϹǷ (STK_BY_IP)    */
+/*                  LOT/RETICLE STK   -L/-R ּҺ ϳ      */
+/*                  source IP  Ѵ (loopback alias  ʿ)         */
+/*                  usage : stkload -h host -p port [-n stk] [-m pct]        */
+/*                                  [-L ip] [-R ip] [-P ports] [-I fmt]      */
+/*                                  [-t ms] [-r rate] [-c cycles] [-T sec]   */
+/*                                  [-i sec]                                 */
+/*                    -n stk    :  STK  (⺻ 1)                       */
+/*                    -m pct    : RETICLE STK  (⺻ 0)                  */
+/*                    -L/-R ip  : LOT/RETICLE STK ù source IP               */
+/*                    -P ports  : STK  port  (⺻ 4)                    */
+/*                    -I fmt    : IRT ID  (⺻ IRT%04d, ȣ          */
+/*                                STK ȣ * ports + port ȣ)              */
+/*                    -t ms     : carrier   think time ()    */
+/*                    -r rate   : fleet ü carrier/sec ( -t )    */
+/*                    -c cycles : Ӵ carrier ,  rClose   */
+/*                                (⺻ 0 :    )             */
+/*                    -T sec    :  ð (⺻ 60)                        */
+/*                    -i sec    : ߰   ֱ (⺻ 10, 0 : )    */
+/* 4.In/Out Table : None                                                     */
+/* 5.Functions    :                                                          */
+/*    main - stkload main function                                           */
+/*    ld_usage - usage print function                                        */
+/*    ld_now - monotonic clock microsecond function                          */
+/*    ld_put - big-endian field write function                               */
+/*    ld_get - big-endian field read function                                */
+/*    ld_bucket - latency to histogram bucket function                       */
+/*    ld_upper - histogram bucket upper bound function                       */
+/*    ld_record - latency record function                                    */
+/*    ld_pct - histogram percentile function                                 */
+/*    ld_readn - socket n byte read function                                 */
+/*    ld_connect - stocker connect function                                  */
+/*    ld_call - request send and reply receive function                      */
+/*    ld_think - think time function                                         */
+/*    ld_cycle - one carrier sequence function                               */
+/*    ld_stkThread - virtual stocker thread function                         */
+/*    ld_report - statistics print function                                  */
+/* 6.Notification :                                                          */
+/*                  build : gcc -O2 -o stkload stkload.c -lpthread -lm       */
+/*****************************************************************************/
+
+/*---------------------------------------------------------------------------*/
+/* System Include Files                                                      */
+/*---------------------------------------------------------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <stddef.h>
+#include <string.h>
+#include <errno.h>
+#include <math.h>
+#include <time.h>
+#include <unistd.h>
+#include <signal.h>
+#include <pthread.h>
+#include <sys/types.h>
+#include <sys/time.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <arpa/inet.h>
+/*---------------------------------------------------------------------------*/
+/* Application Include Files                                                 */
+/*---------------------------------------------------------------------------*/
+/* message ü Ƿ common.h  build Ѵ. BIG/LITTLE_ENDIAN 
+ * msgstruct.h  ٸ  ϹǷ system Ǹ  */
+#define STK_NO_COMMON
+#undef  BIG_ENDIAN
+#undef  LITTLE_ENDIAN
+#include "msgstruct.h"
+/*---------------------------------------------------------------------------*/
+/* Constants, Macro Declaration                                              */
+/*---------------------------------------------------------------------------*/
+#ifndef true
+#define true                1
+#define false               0
+#endif
+#define HEADERSIZE          3
+#define TYPEBYTE            2
+#define LENGTHSIZE          2
+
+#define LOTPODTYPE          1
+#define RETICLEBARETYPE     3
+
+#define LD_MAXTYPE          128
+#define LD_REPMAX           512         /*  ִ ũ            */
+#define LD_TIMEOUT          30          /*   ()            */
+#define LD_SWEEPFROM        0x400       /* rReadMemory sweep     */
+#define LD_SWEEPTO          0x490       /* rReadMemory sweep       */
+#define LD_SWEEPSTEP        0x10
+#define LD_LONGWIRE         4           /* osLong field  wire    */
+
+/* latency histogram (us). 32 ̸ 1us ,   2   32
+ *   (  3%) */
+#define LD_SUBBITS          5
+#define LD_SUB              (1 << LD_SUBBITS)
+#define LD_HIST             (LD_SUB + 36 * LD_SUB)
+
+/* WF : ü field  offset  ũ */
+#define WF(T, f)            offsetof(T, f), sizeof(((T *)0)->f)
+
+/*---------------------------------------------------------------------------*/
+/* Structure Declaration                                                     */
+/*---------------------------------------------------------------------------*/
+typedef struct _LD_STAT {
+    long   cnt;                         /*                 */
+    long   err;                         /* result != 0               */
+    long   fail;                        /* timeout//type     */
+    long   hist[LD_HIST];
+} LD_STAT;
+
+typedef struct _LD_STK {
+    int    no;                          /* STK ȣ                  */
+    int    type;                        /* LOTPODTYPE/RETICLEBARETYPE*/
+    char   name[logicalNameLen+1];      /* rConnect name             */
+    struct in_addr src;                 /* source IP (0 :  ) */
+    int    sock;
+    unsigned int seed;
+} LD_STK;
+
+/*---------------------------------------------------------------------------*/
+/* Function Declaration                                                      */
+/*---------------------------------------------------------------------------*/
+void ld_usage(char *);
+long ld_now(void);
+void ld_put(void *, long , int );
+long ld_get(void *, int );
+int ld_bucket(long );
+long ld_upper(int );
+void ld_record(int , long , int );
+long ld_pct(LD_STAT *, double );
+int ld_readn(int , char *, int );
+int ld_connect(LD_STK *);
+int ld_call(LD_STK *, void *, int , char *, int , int , int );
+int ld_think(LD_STK *);
+int ld_cycle(LD_STK *, int );
+void * ld_stkThread(void *arg);
+void ld_report(char *, double );
+
+/*---------------------------------------------------------------------------*/
+/* Global Variable Declaration                                               */
+/*---------------------------------------------------------------------------*/
+struct sockaddr_in gSvrAddr;            /* STKinf main port          */
+int    gStkCnt   = 1;                   /* -n                        */
+double gRetPct   = 0;                   /* -m                        */
+int    gPorts    = 4;                   /* -P                        */
+char  *gIrtFmt   = "IRT%04d";           /* -I                        */
+double gThinkMs  = 0;                   /* -t                        */
+double gRate     = 0;                   /* -r                        */
+int    gCycles   = 0;                   /* -c                        */
+int    gRunSec   = 60;                  /* -T                        */
+int    gStatIntv = 10;                  /* -i                        */
+volatile int gStop = 0;                 /*                   */
+
+LD_STAT gStat[LD_MAXTYPE];              /* msgType             */
+long   gCarrier = 0;                    /*  carrier sequence   */
+long   gConnect = 0;                    /*   ( )     */
+long   gConnFail = 0;                   /*                 */
+
+char  *gTypeName[LD_MAXTYPE] = {
+    [msgTypeConnectRequest]   = "rConnect",
+    [msgTypePTLSensor]        = "rPhysicalToLogicalSensor",
+    [msgTypeQuerySensorLoc]   = "rListUnitAtIrt",
+    [msgTypeReadMemory]       = "rReadMemory",
+    [msgTypeAssociateUnit]    = "rAssociateUnit",
+    [msgTypeDisplayMsg]       = "rDisplayMsg",
+    [msgTypeCloseRequest]     = "rClose",
+};
+
+/*****************************************************************************/
+/* 1.Function Name: main                                                     */
+/* 2.Description  : option  а  STK thread    -T     */
+/*                                                                       */
+/* 3.Parameters   : int argc, char *argv[]                                   */
+/* 4.Return Value : int                                                      */
+/*****************************************************************************/
+int main(int argc, char *argv[])
+{
+    char *host = NULL, *lotIP = NULL, *retIP = NULL;
+    int  port = 0, opt, i, nRet, iLot = 0, iRet = 0;
+    long start, now, last, lastCarrier = 0;
+    LD_STK *stk;
+    pthread_t *tid;
+
+    while((opt = getopt(argc, argv, "h:p:n:m:L:R:P:I:t:r:c:T:i:")) != -1){
+        switch(opt){
+            case 'h' : host = optarg;                   break;
+            case 'p' : port = atoi(optarg);             break;
+            case 'n' : gStkCnt = atoi(optarg);          break;
+            case 'm' : gRetPct = atof(optarg);          break;
+            case 'L' : lotIP = optarg;                  break;
+            case 'R' : retIP = optarg;                  break;
+            case 'P' : gPorts = atoi(optarg);           break;
+            case 'I' : gIrtFmt = optarg;                break;
+            case 't' : gThinkMs = atof(optarg);         break;
+            case 'r' : gRate = atof(optarg);            break;
+            case 'c' : gCycles = atoi(optarg);          break;
+            case 'T' : gRunSec = atoi(optarg);          break;
+            case 'i' : gStatIntv = atoi(optarg);        break;
+            default  : ld_usage(argv[0]);
+        }
+    }
+    if(host == NULL || port <= 0 || gStkCnt <= 0 || gPorts <= 0 ||
+       gRetPct < 0 || gRetPct > 100 || gRunSec <= 0){
+        ld_usage(argv[0]);
+    }
+
+    memset(&gSvrAddr, 0x00, sizeof(gSvrAddr));
+    gSvrAddr.sin_family = AF_INET;
+    gSvrAddr.sin_port = htons(port);
+    gSvrAddr.sin_addr.s_addr = inet_addr(host);
+
+    stk = (LD_STK *)calloc(gStkCnt, sizeof(LD_STK));
+    tid = (pthread_t *)calloc(gStkCnt, sizeof(pthread_t));
+    if(stk == NULL || tid == NULL){
+        fprintf(stderr, "ERROR: stocker memory alloc fail\n");
+        return 1;
+    }
+    signal(SIGPIPE, SIG_IGN);
+
+    /* տ nRet  RETICLE STK */
+    nRet = (int)(gStkCnt * gRetPct / 100 + 0.5);
+    for(i = 0; i < gStkCnt; i++){
+        stk[i].no   = i;
+        stk[i].type = (i < nRet) ? RETICLEBARETYPE : LOTPODTYPE;
+        stk[i].seed = (unsigned int)time(NULL) ^ (i * 2654435761u);
+        if(stk[i].type == RETICLEBARETYPE){
+            sprintf(stk[i].name, "R-%05d", iRet);
+            if(retIP != NULL) stk[i].src.s_addr = htonl(ntohl(inet_addr(retIP)) + iRet);
+            iRet++;
+        } else {
+            sprintf(stk[i].name, "L-%05d", iLot);
+            if(lotIP != NULL) stk[i].src.s_addr = htonl(ntohl(inet_addr(lotIP)) + iLot);
+            iLot++;
+        }
+    }
+    printf("INFO : stkload STK[%d] LOT[%d] RETICLE[%d] TARGET[%s:%d] TIME[%d]s\n",
+           gStkCnt, iLot, iRet, host, port, gRunSec);
+    fflush(stdout);
+
+    start = last = ld_now();
+    for(i = 0; i < gStkCnt; i++){
+        if(pthread_create(&tid[i], NULL, ld_stkThread, (void *)&stk[i]) != 0){
+            fprintf(stderr, "ERROR: STK[%s] thread create fail\n", stk[i].name);
+            tid[i] = 0;
+        }
+    }
+
+    while((now = ld_now()) - start < (long)gRunSec * 1000000){
+        usleep(100000);
+        if(gStatIntv > 0 && ld_now() - last >= (long)gStatIntv * 1000000){
+            now = ld_now();
+            printf("STAT : %lds CONN[%ld] CONNFAIL[%ld] CARRIER[%ld] %.1f/s\n",
+                   (now - start) / 1000000, gConnect, gConnFail, gCarrier,
+                   (gCarrier - lastCarrier) * 1000000.0 / (now - last));
+            fflush(stdout);
+            lastCarrier = gCarrier;
+            last = now;
+        }
+    }
+    gStop = 1;
+    for(i = 0; i < gStkCnt; i++){
+        if(tid[i] != 0) pthread_join(tid[i], NULL);
+    }
+    ld_report(host, (ld_now() - start) / 1000000.0);
+    return 0;
+}
+
+/*****************************************************************************/
+/* 1.Function Name: ld_usage                                                 */
+/* 2.Description  : usage                                          */
+/* 3.Parameters   : char *prog       - program ̸                          */
+/* 4.Return Value : None                                                     */
+/*****************************************************************************/
+void ld_usage(char *prog)
+{
+    fprintf(stderr, "usage : %s -h host -p port [-n stk] [-m reticlePct] [-L lotIP] [-R reticleIP]\n"
+                    "          [-P ports] [-I irtFmt] [-t thinkMs] [-r carrierPerSec]\n"
+                    "          [-c cyclesPerConnect] [-T sec] [-i sec]\n", prog);
+    exit(1);
+}
+
+/*****************************************************************************/
+/* 1.Function Name: ld_now                                                   */
+/* 2.Description  : CLOCK_MONOTONIC  ð                                */
+/* 3.Parameters   : None                                                     */
+/* 4.Return Value : long - us                                                */
+/*****************************************************************************/
+long ld_now(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1000000L + ts.tv_nsec / 1000;
+}
+
+/*****************************************************************************/
+/* 1.Function Name: ld_put                                                   */
+/* 2.Description  :  field  big-endian   (STK û frame)      */
+/* 3.Parameters   : void *p          - field ġ                            */
+/*                  long val         -                                     */
+/*                  int width        - field ũ (2, 4, 8)                  */
+/* 4.Return Value : None                                                     */
+/*****************************************************************************/
+void ld_put(void *p, long val, int width)
+{
+    unsigned char *b = (unsigned char *)p;
+    int i;
+
+    for(i = width - 1; i >= 0; i--){
+        b[i] = (unsigned char)(val & 0xFF);
+        val >>= 8;
+    }
+}
+
+/*****************************************************************************/
+/* 1.Function Name: ld_get                                                   */
+/* 2.Description  : big-endian  field  д´ (ȣ Ȯ)              */
+/* 3.Parameters   : void *p          - field ġ                            */
+/*                  int width        - field ũ (2, 4, 8)                  */
+/* 4.Return Value : long -                                                 */
+/*****************************************************************************/
+long ld_get(void *p, int width)
+{
+    unsigned char *b = (unsigned char *)p;
+    long val = (b[0] & 0x80) ? -1 : 0;
+    int i;
+
+    for(i = 0; i < width; i++){
+        val = (val << 8) | b[i];
+    }
+    return val;
+}
+
+/*****************************************************************************/
+/* 1.Function Name: ld_bucket                                                */
+/* 2.Description  : latency  histogram bucket                              */
+/* 3.Parameters   : long us          - latency                               */
+/* 4.Return Value : int - bucket                                             */
+/*****************************************************************************/
+int ld_bucket(long us)
+{
+    int e;
+
+    if(us < LD_SUB) return (us < 0) ? 0 : (int)us;
+    e = 63 - __builtin_clzl((unsigned long)us);
+    if(e - LD_SUBBITS >= 36) return LD_HIST - 1;
+    return LD_SUB + (e - LD_SUBBITS) * LD_SUB + (int)((us >> (e - LD_SUBBITS)) - LD_SUB);
+}
+
+/*****************************************************************************/
+/* 1.Function Name: ld_upper                                                 */
+/* 2.Description  : histogram bucket                                   */
+/* 3.Parameters   : int b            - bucket                                */
+/* 4.Return Value : long - us                                                */
+/*****************************************************************************/
+long ld_upper(int b)
+{
+    int e, sub;
+
+    if(b < LD_SUB) return b;
+    e   = (b - LD_SUB) / LD_SUB;
+    sub = (b - LD_SUB) % LD_SUB;
+    return ((long)(LD_SUB + sub + 1) << e) - 1;
+}
+
+/*****************************************************************************/
+/* 1.Function Name: ld_record                                                */
+/* 2.Description  : msgType   latency                            */
+/* 3.Parameters   : int type         - msgType                               */
+/*                  long us          - latency (fail ̸ )              */
+/*                  int res          - 0 : , 1 : result , -1 : fail  */
+/* 4.Return Value : None                                                     */
+/*****************************************************************************/
+void ld_record(int type, long us, int res)
+{
+    LD_STAT *s = &gStat[type % LD_MAXTYPE];
+
+    if(res < 0){
+        __sync_fetch_and_add(&s->fail, 1);
+        return;
+    }
+    if(res > 0) __sync_fetch_and_add(&s->err, 1);
+    __sync_fetch_and_add(&s->cnt, 1);
+    __sync_fetch_and_add(&s->hist[ld_bucket(us)], 1);
+}
+
+/*****************************************************************************/
+/* 1.Function Name: ld_pct                                                   */
+/* 2.Description  : histogram  percentile (bucket )                    */
+/* 3.Parameters   : LD_STAT *s       -                                   */
+/*                  double q         - 0~1                                   */
+/* 4.Return Value : long - us                                                */
+/*****************************************************************************/
+long ld_pct(LD_STAT *s, double q)
+{
+    long want, sum = 0;
+    int b;
+
+    want = (long)ceil(q * s->cnt);
+    if(want < 1) want = 1;
+    for(b = 0; b < LD_HIST; b++){
+        sum += s->hist[b];
+        if(sum >= want) return ld_upper(b);
+    }
+    return ld_upper(LD_HIST - 1);
+}
+
+/*****************************************************************************/
+/* 1.Function Name: ld_readn                                                 */
+/* 2.Description  : n byte   д´ (SO_RCVTIMEO  timeout)           */
+/* 3.Parameters   : int sock, char *buf, int n                               */
+/* 4.Return Value : true - , false - timeout/                        */
+/*****************************************************************************/
+int ld_readn(int sock, char *buf, int n)
+{
+    int r;
+
+    while(n > 0){
+        if((r = recv(sock, buf, n, 0)) <= 0){
+            if(r < 0 && errno == EINTR) continue;
+            return false;
+        }
+        buf += r;
+        n -= r;
+    }
+    return true;
+}
+
+/*****************************************************************************/
+/* 1.Function Name: ld_connect                                               */
+/* 2.Description  : source IP  bind Ͽ STKinf  ϰ rConnect       */
+/* 3.Parameters   : LD_STK *s        -  STK                              */
+/* 4.Return Value : true - , false -                                 */
+/*****************************************************************************/
+int ld_connect(LD_STK *s)
+{
+    struct sockaddr_in src;
+    struct timeval tv;
+    rConnectRequest req;
+    char rep[LD_REPMAX];
+    int on = 1;
+
+    if((s->sock = socket(AF_INET, SOCK_STREAM, 0)) < 0) return false;
+    setsockopt(s->sock, IPPROTO_TCP, TCP_NODELAY, &on, sizeof(on));
+    tv.tv_sec  = LD_TIMEOUT;
+    tv.tv_usec = 0;
+    setsockopt(s->sock, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+    if(s->src.s_addr != 0){
+        memset(&src, 0x00, sizeof(src));
+        src.sin_family = AF_INET;
+        src.sin_addr = s->src;
+        if(bind(s->sock, (struct sockaddr *)&src, sizeof(src)) < 0){
+            fprintf(stderr, "ERROR: STK[%s] bind [%s] fail errno[%d]\n",
+                    s->name, inet_ntoa(s->src), errno);
+            close(s->sock);
+            return false;
+        }
+    }
+    if(connect(s->sock, (struct sockaddr *)&gSvrAddr, sizeof(gSvrAddr)) < 0){
+        close(s->sock);
+        return false;
+    }
+    __sync_fetch_and_add(&gConnect, 1);
+
+    memset(&req, 0x00, sizeof(req));
+    req.msgType   = msgTypeConnectRequest;
+    req.byteOrder = BIG_ENDIAN;
+    strcpy(req.name, s->name);
+    if(ld_call(s, &req, sizeof(req), rep, sizeof(rConnectReply), WF(rConnectReply, result)) < 0){
+        close(s->sock);
+        return false;
+    }
+    return true;
+}
+
+/*****************************************************************************/
+/* 1.Function Name: ld_call                                                  */
+/* 2.Description  : û msgLen  ä   type   ޾    */
+/*                  latency  result  Ѵ                            */
+/* 3.Parameters   : LD_STK *s        -  STK                              */
+/*                  void *req        - û (msgLen  field  big-endian)  */
+/*                  int reqLen       - û ũ                             */
+/*                  char *rep        -  (LD_REPMAX)                      */
+/*                  int repLen       -   ũ                        */
+/*                  int resOff       -  result offset                    */
+/*                  int resWidth     -  result ũ                      */
+/* 4.Return Value : 0 - , 1 - result , -1 - timeout//    */
+/*****************************************************************************/
+int ld_call(LD_STK *s, void *req, int reqLen, char *rep, int repLen, int resOff, int resWidth)
+{
+    int type = ((unsigned char *)req)[TYPEBYTE];
+    int len, res;
+    long t0;
+
+    ld_put(req, reqLen, LENGTHSIZE);
+    t0 = ld_now();
+    if(send(s->sock, req, reqLen, 0) != reqLen){
+        ld_record(type, 0, -1);
+        return -1;
+    }
+    if(ld_readn(s->sock, rep, HEADERSIZE) == false){
+        ld_record(type, 0, -1);
+        return -1;
+    }
+    len = (int)(unsigned short)ld_get(rep, LENGTHSIZE);
+    if(len != repLen || len > LD_REPMAX || (unsigned char)rep[TYPEBYTE] != type ||
+       ld_readn(s->sock, rep + HEADERSIZE, len - HEADERSIZE) == false){
+        ld_record(type, 0, -1);
+        return -1;
+    }
+    res = (int)ld_get(rep + resOff, resWidth);
+    res = (res != 0) ? 1 : 0;
+    ld_record(type, ld_now() - t0, res);
+    return res;
+}
+
+/*****************************************************************************/
+/* 1.Function Name: ld_think                                                 */
+/* 2.Description  :  carrier  . -r ̸ fleet ü rate      */
+/*                  ǵ STK   n/rate , ƴϸ  -t ms        */
+/*                   (open loop   )                      */
+/* 3.Parameters   : LD_STK *s        -  STK                              */
+/* 4.Return Value : true - , false -                             */
+/*****************************************************************************/
+int ld_think(LD_STK *s)
+{
+    double meanUs, u;
+    long until, left;
+
+    meanUs = (gRate > 0) ? gStkCnt * 1000000.0 / gRate : gThinkMs * 1000.0;
+    if(meanUs <= 0) return gStop ? false : true;
+    u = ((double)rand_r(&s->seed) + 1.0) / ((double)RAND_MAX + 2.0);
+    until = ld_now() + (long)(-meanUs * log(u));
+    /* Ḧ  ʰ  100ms   ܴ */
+    while(!gStop && (left = until - ld_now()) > 0){
+        usleep((left > 100000) ? 100000 : left);
+    }
+    return gStop ? false : true;
+}
+
+/*****************************************************************************/
+/* 1.Function Name: ld_cycle                                                 */
+/* 2.Description  : carrier Ѱ û . IRT ID  STK  port    */
+/*                                                                   */
+/* 3.Parameters   : LD_STK *s        -  STK                              */
+/*                  int k            - carrier ȣ                          */
+/* 4.Return Value : true -  (result  ), false -          */
+/*****************************************************************************/
+int ld_cycle(LD_STK *s, int k)
+{
+    rGenRequest gen;
+    rQuerySensorRequest qs;
+    rReadRAMRequest rr;
+    rPostLineRequest pl;
+    char rep[LD_REPMAX];
+    char irtName[logicalNameLen+1] = {0,};
+    char unitID[physicalNameLen+1] = {0,};
+    char lot[logicalNameLen+1] = {0,};
+    int addr;
+
+    memset(&gen, 0x00, sizeof(gen));
+    gen.msgType = msgTypePTLSensor;
+    snprintf(gen.physicalID, sizeof(gen.physicalID), gIrtFmt, s->no * gPorts + k % gPorts);
+    if(ld_call(s, &gen, sizeof(gen), rep, sizeof(rGenReply), WF(rGenReply, result)) < 0) return false;
+    snprintf(irtName, sizeof(irtName), "%.*s", logicalNameLen, ((rGenReply *)rep)->logicalName);
+    if(irtName[0] == 0x00) strcpy(irtName, gen.physicalID);
+
+    memset(&qs, 0x00, sizeof(qs));
+    qs.msgType      = msgTypeQuerySensorLoc;
+    qs.requestType  = 1;
+    qs.responseType = 1;
+    qs.lastFlag     = 1;
+    /* osLong  STKinf   4 byte  BE32  д´ (WIRE_LEGACY) */
+    ld_put(&qs.numItems, 1, LD_LONGWIRE);
+    strcpy(qs.nameList.name, irtName);
+    if(ld_call(s, &qs, sizeof(qs), rep, sizeof(rQuerySensorReply), WF(rQuerySensorReply, result)) < 0) return false;
+    snprintf(unitID, sizeof(unitID), "%.*s", physicalNameLen, ((rQuerySensorReply *)rep)->responseMsg.unitID);
+    snprintf(lot, sizeof(lot), "%.*s", logicalNameLen, ((rQuerySensorReply *)rep)->responseMsg.unitName);
+    if(lot[0] == 0x00) sprintf(lot, "%.5s%06d", s->name, k);
+
+    for(addr = LD_SWEEPFROM; addr <= LD_SWEEPTO; addr += LD_SWEEPSTEP){
+        memset(&rr, 0x00, sizeof(rr));
+        rr.msgType = msgTypeReadMemory;
+        ld_put(&rr.addr, addr, sizeof(rr.addr));
+        strcpy(rr.unitName, lot);
+        if(ld_call(s, &rr, sizeof(rr), rep, sizeof(rReadRAMReply), WF(rReadRAMReply, result)) < 0) return false;
+    }
+
+    if(s->type == RETICLEBARETYPE){
+        memset(&gen, 0x00, sizeof(gen));
+        gen.msgType = msgTypeAssociateUnit;
+        strcpy(gen.physicalID, (unitID[0] != 0x00) ? unitID : "B0000000");
+        strcpy(gen.logicalName, lot);
+        if(ld_call(s, &gen, sizeof(gen), rep, sizeof(rGenReply), WF(rGenReply, result)) < 0) return false;
+    }
+
+    memset(&pl, 0x00, sizeof(pl));
+    pl.msgType = msgTypeDisplayMsg;
+    ld_put(&pl.line, 1, sizeof(pl.line));
+    strcpy(pl.unitName, lot);
+    snprintf(pl.msg, sizeof(pl.msg), "%.20s %.20s", irtName, lot);
+    if(ld_call(s, &pl, sizeof(pl), rep, sizeof(rSimpleReply), WF(rSimpleReply, result)) < 0) return false;
+
+    __sync_fetch_and_add(&gCarrier, 1);
+    return true;
+}
+
+/*****************************************************************************/
+/* 1.Function Name: ld_stkThread                                             */
+/* 2.Description  :  STK.  -> carrier ݺ -> rClose,      */
+/*                  1                                              */
+/* 3.Parameters   : void *arg        - LD_STK                                */
+/* 4.Return Value : None                                                     */
+/*****************************************************************************/
+void * ld_stkThread(void *arg)
+{
+    LD_STK *s = (LD_STK *)arg;
+    rSimpleRequest req;
+    char rep[LD_REPMAX];
+    int k = 0, n;
+
+    /* ÿ   ʵ ó think time ŭ  ´ */
+    if(ld_think(s) == false) return NULL;
+    while(!gStop){
+        if(ld_connect(s) == false){
+            __sync_fetch_and_add(&gConnFail, 1);
+            sleep(1);
+            continue;
+        }
+        for(n = 0; !gStop && (gCycles == 0 || n < gCycles); n++){
+            if(ld_cycle(s, k++) == false) break;
+            if(ld_think(s) == false) break;
+        }
+        if(gStop || n == gCycles){
+            memset(&req, 0x00, sizeof(req));
+            req.msgType = msgTypeCloseRequest;
+            ld_call(s, &req, sizeof(req), rep, sizeof(rSimpleReply), WF(rSimpleReply, result));
+        } else {
+            sleep(1);
+        }
+        close(s->sock);
+    }
+    return NULL;
+}
+
+/*****************************************************************************/
+/* 1.Function Name: ld_report                                                */
+/* 2.Description  : msgType  ó p50/p99/p999                     */
+/* 3.Parameters   : char *host       -                                   */
+/*                  double sec       -  ð                             */
+/* 4.Return Value : None                                                     */
+/*****************************************************************************/
+void ld_report(char *host, double sec)
+{
+    LD_STAT *s;
+    long maxUs;
+    int t, b;
+
+    printf("RESULT : TARGET[%s] TIME[%.1f]s STK[%d] CONN[%ld] CONNFAIL[%ld] CARRIER[%ld] %.1f/s\n",
+           host, sec, gStkCnt, gConnect, gConnFail, gCarrier, gCarrier / sec);
+    printf("%-26s %9s %10s %7s %7s %9s %9s %9s %9s\n",
+           "MSG", "COUNT", "PER_SEC", "ERR", "FAIL", "P50_US", "P99_US", "P999_US", "MAX_US");
+    for(t = 0; t < LD_MAXTYPE; t++){
+        s = &gStat[t];
+        if(s->cnt == 0 && s->fail == 0) continue;
+        maxUs = 0;
+        for(b = LD_HIST - 1; b >= 0; b--){
+            if(s->hist[b] > 0){
+                maxUs = ld_upper(b);
+                break;
+            }
+        }
+        printf("%-26s %9ld %10.1f %7ld %7ld %9ld %9ld %9ld %9ld\n",
+               gTypeName[t] ? gTypeName[t] : "?", s->cnt, s->cnt / sec, s->err, s->fail,
+               s->cnt ? ld_pct(s, 0.50) : 0, s->cnt ? ld_pct(s, 0.99) : 0,
+               s->cnt ? ld_pct(s, 0.999) : 0, maxUs);
+    }
+    fflush(stdout);
+}